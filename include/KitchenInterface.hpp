@@ -2,8 +2,12 @@
 #define KITCHENINTERFACE_H
 
 #include "../include/Order.hpp"
+#include "../include/KitchenTicketStore.hpp"
+#include "../include/MenuItem.hpp"
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <chrono>
 #include <Wt/Json/Object.h>
@@ -29,6 +33,11 @@
  * The KitchenInterface class handles communication between the POS system and kitchen
  * display systems, order tracking, and kitchen workflow management. It provides
  * real-time updates, queue management, and integration points for kitchen equipment.
+ *
+ * With station routing set, each order also gets one sub-ticket per station
+ * (grill, fryer, ...) that prepares some of its items. Every station has its
+ * own queue, wait estimate and busy state; the order's ticket becomes ready
+ * once all of its sub-tickets are.
  */
 class KitchenInterface {
 public:
@@ -43,6 +52,8 @@ public:
         SERVED              ///< Order served to customer
     };
     
+    static constexpr std::size_t KITCHEN_STATUS_COUNT = SERVED + 1;
+    
     /**
      * @struct KitchenTicket
      * @brief Represents a kitchen ticket with order information
@@ -55,10 +66,18 @@ public:
         std::chrono::system_clock::time_point timestamp; ///< Ticket creation time
         KitchenStatus status;       ///< Current kitchen status
         int estimatedPrepTime;      ///< Estimated preparation time in minutes
+        std::string station;        ///< Station preparing it; empty for a whole-order ticket
         
         KitchenTicket() : orderId(0), tableNumber(0), status(ORDER_RECEIVED), estimatedPrepTime(0) {}
     };
     
+    using TicketStore = KitchenTicketStore<KitchenTicket, KITCHEN_STATUS_COUNT>;
+    
+    /**
+     * @brief Tickets iterated in place; valid until a ticket it reaches is removed
+     */
+    using TicketView = TicketStore::View;
+    
     /**
      * @brief Constructs a new KitchenInterface
      */
@@ -91,17 +110,38 @@ public:
     Wt::Json::Object getKitchenQueueStatus();
     
     /**
-     * @brief Gets all active kitchen tickets
+     * @brief Gets a copy of all active kitchen tickets, oldest first
+     *
+     * Copies every ticket with its item names; prefer getTickets() to
+     * read them in place.
+     *
      * @return Vector of active kitchen tickets
      */
     std::vector<KitchenTicket> getActiveTickets();
     
+    /**
+     * @brief Gets all active kitchen tickets without copying, oldest first
+     */
+    TicketView getTickets() const { return tickets_.queue(); }
+    
+    /**
+     * @brief Gets the tickets with one status without copying
+     * @param status Kitchen status to list
+     */
+    TicketView getTicketsWithStatus(KitchenStatus status) const { return tickets_.withStatus(status); }
+    
+    /**
+     * @brief Gets the number of tickets with one status
+     * @param status Kitchen status to count
+     */
+    size_t getTicketCount(KitchenStatus status) const { return tickets_.count(status); }
+    
     /**
      * @brief Gets kitchen ticket for a specific order
      * @param orderId Order ID to look up
      * @return Pointer to kitchen ticket, or nullptr if not found
      */
-    const KitchenTicket* getTicketByOrderId(int orderId);
+    const KitchenTicket* getTicketByOrderId(int orderId) const;
     
     /**
      * @brief Removes a completed ticket from the kitchen queue
@@ -120,17 +160,136 @@ public:
      * @brief Gets the number of orders currently in kitchen queue
      * @return Number of active kitchen tickets
      */
-    size_t getQueueLength() const { return activeTickets_.size(); }
+    size_t getQueueLength() const { return tickets_.size(); }
     
     /**
      * @brief Checks if kitchen is currently busy
-     * @param threshold Maximum queue length before considered busy (default: 5)
+     * @return True if kitchen queue exceeds the configured busy threshold
+     */
+    bool isKitchenBusy() const { 
+        return isKitchenBusy(busyThreshold_); 
+    }
+    
+    /**
+     * @brief Checks if kitchen is busy against an explicit threshold
+     * @param threshold Maximum queue length before considered busy
      * @return True if kitchen queue exceeds threshold
      */
-    bool isKitchenBusy(size_t threshold = 5) const { 
-        return activeTickets_.size() > threshold; 
+    bool isKitchenBusy(size_t threshold) const { 
+        return tickets_.size() > threshold; 
     }
     
+    /**
+     * @brief Sets the queue length above which the kitchen counts as busy
+     *
+     * Can be changed while tickets are queued (e.g. on configuration reload);
+     * onKitchenBusy()/onKitchenFree() fire if the busy state flips.
+     *
+     * @param threshold Maximum queue length before considered busy
+     */
+    void setBusyThreshold(size_t threshold);
+    
+    size_t getBusyThreshold() const { return busyThreshold_; }
+    
+    // =================================================================
+    // Station routing
+    // =================================================================
+    
+    /**
+     * @struct StationRouting
+     * @brief Which station prepares each menu item
+     *
+     * An item goes to the station of its id if listed, otherwise to the
+     * station of its category, otherwise to defaultStation. Without any
+     * route, orders are not split into station tickets.
+     */
+    struct StationRouting {
+        std::map<MenuItem::Category, std::string> byCategory;   ///< Category routes
+        std::unordered_map<int, std::string> byItemId;          ///< Overrides by menu item id
+        std::string defaultStation = "kitchen";                 ///< For items no route matches
+        
+        bool empty() const { return byCategory.empty() && byItemId.empty(); }
+        
+        /**
+         * @brief Reads kitchen.station_routes and kitchen.item_stations entries
+         * @param categoryRoutes "<category>=<station>", categories named as in
+         *        kitchen.prep_times ("main_course")
+         * @param itemRoutes "<menu item id>=<station>"
+         * @param rejected Receives the entries that could not be read, if not null
+         * @return Routing with the entries that could be read
+         */
+        static StationRouting parse(const std::vector<std::string>& categoryRoutes,
+                                    const std::vector<std::string>& itemRoutes,
+                                    std::vector<std::string>* rejected = nullptr);
+    };
+    
+    /**
+     * @brief Sets the station routing for orders sent from now on
+     *
+     * Stations named by the routing get a queue right away, so their screens
+     * can show an empty queue. Tickets already queued stay where they are;
+     * a station dropped from the routing goes once its queue is empty.
+     *
+     * @param routing Routing to apply; an empty one stops station tickets
+     */
+    void setStationRouting(StationRouting routing);
+    
+    const StationRouting& getStationRouting() const { return routing_; }
+    
+    /**
+     * @brief Gets the station that prepares a menu item
+     */
+    std::string routeItem(const MenuItem& item) const;
+    
+    /**
+     * @brief Gets the names of the stations with a queue, in name order
+     */
+    std::vector<std::string> getStationNames() const;
+    
+    /**
+     * @brief Gets a station's sub-tickets without copying, oldest first
+     * @param station Station name
+     * @return The station's tickets, or an empty view for an unknown station
+     */
+    TicketView getStationTickets(const std::string& station) const;
+    
+    /**
+     * @brief Gets the sub-ticket of an order at a station
+     * @return Pointer to the sub-ticket, or nullptr if the station has none
+     */
+    const KitchenTicket* getStationTicket(const std::string& station, int orderId) const;
+    
+    /**
+     * @brief Updates the status of an order's sub-ticket at one station
+     *
+     * The order's own ticket follows: it moves to PREP_STARTED when a
+     * station starts on it, and to READY_FOR_PICKUP (recombined) when every
+     * sub-ticket is ready. Sub-tickets stay in the station queues, showing
+     * their status, until the order is SERVED or its ticket is removed.
+     *
+     * @param station Station name
+     * @param orderId Order ID of the sub-ticket
+     * @param status New kitchen status
+     * @return True if the station had a sub-ticket for the order
+     */
+    bool updateStationStatus(const std::string& station, int orderId, KitchenStatus status);
+    
+    /**
+     * @brief Gets the number of sub-tickets queued at a station
+     */
+    size_t getStationQueueLength(const std::string& station) const;
+    
+    /**
+     * @brief Gets the estimated wait for new work at a station
+     * @return Estimated wait time in minutes
+     */
+    int getStationWaitTime(const std::string& station) const;
+    
+    /**
+     * @brief Checks if a station's queue exceeds the busy threshold
+     */
+    bool isStationBusy(const std::string& station) const;
+    
     /**
      * @brief Gets the string representation of a kitchen status
      * @param status Kitchen status to convert
@@ -179,6 +338,26 @@ public:
      * @param queueLength Current queue length
      */
     virtual void onKitchenFree(size_t queueLength) {}
+    
+    /**
+     * @brief Called when a station's queue becomes busy
+     * @param station Station name
+     * @param queueLength Station queue length
+     */
+    virtual void onStationBusy(const std::string& station, size_t queueLength) {}
+    
+    /**
+     * @brief Called when a station's queue becomes free
+     * @param station Station name
+     * @param queueLength Station queue length
+     */
+    virtual void onStationFree(const std::string& station, size_t queueLength) {}
+    
+    /**
+     * @brief Called when every station ticket of an order is ready
+     * @param orderId Order ID, now READY_FOR_PICKUP
+     */
+    virtual void onOrderRecombined(int orderId) {}
 
 protected:
     /**
@@ -188,6 +367,13 @@ protected:
      */
     virtual KitchenTicket createKitchenTicket(std::shared_ptr<Order> order);
     
+    /**
+     * @brief Splits an order into one ticket per station
+     * @param order Order to split
+     * @return Tickets by station name, each with the items routeItem() sends there
+     */
+    virtual std::map<std::string, KitchenTicket> createStationTickets(std::shared_ptr<Order> order);
+    
     /**
      * @brief Broadcasts JSON message to kitchen displays
      * @param message JSON message to broadcast
@@ -210,14 +396,50 @@ private:
     std::string getCurrentTimestamp();
     
     /**
-     * @brief Finds ticket index by order ID
-     * @param orderId Order ID to search for
-     * @return Index of ticket, or -1 if not found
+     * @brief Whether tickets with this status still add to the wait
      */
-    int findTicketIndex(int orderId);
+    static bool isWaiting(KitchenStatus status) {
+        return status == ORDER_RECEIVED || status == PREP_STARTED;
+    }
+    
+    /**
+     * @brief Queue of one station
+     */
+    struct Station {
+        TicketStore tickets;
+        int waitingPrepTime = 0;                ///< Sum of estimatedPrepTime of waiting tickets
+        bool wasBusy = false;
+    };
+    
+    // Ticket changes that keep a waiting-time sum in step with the store
+    static void insertTicket(TicketStore& store, int& waitingPrepTime, const KitchenTicket& ticket);
+    static bool eraseTicket(TicketStore& store, int& waitingPrepTime, int orderId);
+    static bool setTicketStatus(TicketStore& store, int& waitingPrepTime, int orderId,
+                                KitchenStatus status, KitchenStatus& oldStatus);
+    
+    /**
+     * @brief Wait estimate shared by the kitchen and the stations
+     */
+    static int estimateWait(size_t queueLength, int waitingPrepTime);
+    
+    /**
+     * @brief Adds an order line to a ticket's items and instructions
+     */
+    static void addItemToTicket(KitchenTicket& ticket, const OrderItem& item);
+    
+    const Station* findStation(const std::string& name) const;
+    Station& stationFor(const std::string& name);
+    void updateStationBusy(const std::string& name, Station& station);
+    void removeStationTickets(int orderId);
+    void markStationTicketsReady(int orderId);
+    void dropUnroutedStations();
     
-    std::vector<KitchenTicket> activeTickets_;  ///< Active kitchen tickets
+    TicketStore tickets_;                       ///< Active kitchen tickets
+    int waitingPrepTime_;                       ///< Sum of estimatedPrepTime of waiting tickets
     bool wasKitchenBusy_;                       ///< Track kitchen busy state for notifications
+    size_t busyThreshold_;                      ///< Queue length above which the kitchen is busy
+    StationRouting routing_;                    ///< Empty: no station tickets
+    std::map<std::string, std::unique_ptr<Station>> stations_; ///< Station queues by name
 };
 
 #endif // KITCHENINTERFACE_H
@@ -0,0 +1,259 @@
+#ifndef KITCHENTICKETSTORE_H
+#define KITCHENTICKETSTORE_H
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @file KitchenTicketStore.hpp
+ * @brief Indexed container for the tickets of a kitchen queue
+ *
+ * Tickets are found by order id through a hash index, and each one is
+ * linked into two intrusive lists: the list of its status and the queue,
+ * which keeps tickets in timestamp order. Lookups, inserts at the back of
+ * the queue, status changes and removals are O(1); no other ticket moves.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class KitchenTicketStore
+ * @brief Kitchen tickets by order id, by status and in arrival order
+ *
+ * @tparam Ticket Ticket type with orderId, status (an enum below
+ *         StatusCount) and timestamp members
+ * @tparam StatusCount Number of ticket statuses
+ *
+ * Readers iterate queue() or withStatus() in place instead of copying.
+ * A view, and pointers from find(), stay valid until the ticket they
+ * reach is erased; changing a ticket's status moves it to another status
+ * list, so do not change statuses while iterating withStatus().
+ */
+template<typename Ticket, std::size_t StatusCount>
+class KitchenTicketStore {
+    struct Node {
+        Ticket ticket;
+        Node* statusPrev = nullptr;
+        Node* statusNext = nullptr;
+        Node* queuePrev = nullptr;
+        Node* queueNext = nullptr;
+    };
+
+    struct List {
+        Node* head = nullptr;
+        Node* tail = nullptr;
+        std::size_t size = 0;
+    };
+
+public:
+    /**
+     * @class View
+     * @brief Forward range over tickets of one list, without copying them
+     */
+    class View {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Ticket;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Ticket*;
+            using reference = const Ticket&;
+
+            iterator() = default;
+
+            reference operator*() const { return node_->ticket; }
+            pointer operator->() const { return &node_->ticket; }
+
+            iterator& operator++() {
+                node_ = node_->*next_;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const iterator& other) const { return node_ == other.node_; }
+            bool operator!=(const iterator& other) const { return node_ != other.node_; }
+
+        private:
+            friend class View;
+            iterator(const Node* node, Node* Node::* next) : node_(node), next_(next) {}
+
+            const Node* node_ = nullptr;
+            Node* Node::* next_ = nullptr;
+        };
+
+        View() = default;
+
+        iterator begin() const { return iterator(head_, next_); }
+        iterator end() const { return iterator(nullptr, next_); }
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+    private:
+        friend class KitchenTicketStore;
+        View(const Node* head, Node* Node::* next, std::size_t size) : head_(head), next_(next), size_(size) {}
+
+        const Node* head_ = nullptr;
+        Node* Node::* next_ = &Node::queueNext;
+        std::size_t size_ = 0;
+    };
+
+    KitchenTicketStore() = default;
+
+    // The lists point into the nodes of the index: copies would point back here
+    KitchenTicketStore(const KitchenTicketStore&) = delete;
+    KitchenTicketStore& operator=(const KitchenTicketStore&) = delete;
+
+    /**
+     * @brief Adds a ticket to its status list and to the queue
+     *
+     * Tickets normally arrive in timestamp order and go to the back of the
+     * queue; an older one is walked forward from the back to its place.
+     *
+     * @return False if a ticket for the same order id is already held
+     */
+    bool insert(Ticket ticket) {
+        const int orderId = ticket.orderId;
+        auto [it, inserted] = nodes_.try_emplace(orderId);
+        if (!inserted) {
+            return false;
+        }
+        Node* node = &it->second;
+        node->ticket = std::move(ticket);
+        linkStatus(node);
+        linkQueue(node);
+        return true;
+    }
+
+    /**
+     * @brief Finds the ticket of an order
+     * @return The ticket, or nullptr if none is held
+     */
+    const Ticket* find(int orderId) const {
+        auto it = nodes_.find(orderId);
+        return it != nodes_.end() ? &it->second.ticket : nullptr;
+    }
+
+    /**
+     * @brief Moves a ticket to another status list, keeping its queue place
+     * @param orderId Order id of the ticket
+     * @param status New status
+     * @param oldStatus Receives the previous status if not null
+     * @return False if no ticket is held for orderId
+     */
+    template<typename Status>
+    bool setStatus(int orderId, Status status, Status* oldStatus = nullptr) {
+        auto it = nodes_.find(orderId);
+        if (it == nodes_.end()) {
+            return false;
+        }
+        Node* node = &it->second;
+        if (oldStatus) {
+            *oldStatus = node->ticket.status;
+        }
+        if (node->ticket.status != status) {
+            unlinkStatus(node);
+            node->ticket.status = status;
+            linkStatus(node);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes the ticket of an order
+     * @return False if no ticket is held for orderId
+     */
+    bool erase(int orderId) {
+        auto it = nodes_.find(orderId);
+        if (it == nodes_.end()) {
+            return false;
+        }
+        unlinkStatus(&it->second);
+        unlinkQueue(&it->second);
+        nodes_.erase(it);
+        return true;
+    }
+
+    void clear() {
+        nodes_.clear();
+        statuses_ = {};
+        queue_ = List();
+    }
+
+    /**
+     * @brief Every ticket, oldest first
+     */
+    View queue() const {
+        return View(queue_.head, &Node::queueNext, queue_.size);
+    }
+
+    /**
+     * @brief Tickets with one status, in the order they reached it
+     */
+    template<typename Status>
+    View withStatus(Status status) const {
+        const List& list = statuses_[static_cast<std::size_t>(status)];
+        return View(list.head, &Node::statusNext, list.size);
+    }
+
+    template<typename Status>
+    std::size_t count(Status status) const {
+        return statuses_[static_cast<std::size_t>(status)].size;
+    }
+
+    std::size_t size() const { return nodes_.size(); }
+    bool empty() const { return nodes_.empty(); }
+
+private:
+    void linkStatus(Node* node) {
+        List& list = statuses_[static_cast<std::size_t>(node->ticket.status)];
+        node->statusPrev = list.tail;
+        node->statusNext = nullptr;
+        (list.tail ? list.tail->statusNext : list.head) = node;
+        list.tail = node;
+        ++list.size;
+    }
+
+    void unlinkStatus(Node* node) {
+        List& list = statuses_[static_cast<std::size_t>(node->ticket.status)];
+        (node->statusPrev ? node->statusPrev->statusNext : list.head) = node->statusNext;
+        (node->statusNext ? node->statusNext->statusPrev : list.tail) = node->statusPrev;
+        node->statusPrev = node->statusNext = nullptr;
+        --list.size;
+    }
+
+    void linkQueue(Node* node) {
+        // Insert after the newest ticket not newer than this one
+        Node* after = queue_.tail;
+        while (after && node->ticket.timestamp < after->ticket.timestamp) {
+            after = after->queuePrev;
+        }
+        node->queuePrev = after;
+        node->queueNext = after ? after->queueNext : queue_.head;
+        (after ? after->queueNext : queue_.head) = node;
+        (node->queueNext ? node->queueNext->queuePrev : queue_.tail) = node;
+        ++queue_.size;
+    }
+
+    void unlinkQueue(Node* node) {
+        (node->queuePrev ? node->queuePrev->queueNext : queue_.head) = node->queueNext;
+        (node->queueNext ? node->queueNext->queuePrev : queue_.tail) = node->queuePrev;
+        node->queuePrev = node->queueNext = nullptr;
+        --queue_.size;
+    }
+
+    std::unordered_map<int, Node> nodes_;          ///< Owns the tickets; nodes never move
+    std::array<List, StatusCount> statuses_{};
+    List queue_;
+};
+
+#endif // KITCHENTICKETSTORE_H
@@ -7,6 +7,7 @@
 #include <string>
 #include <chrono>
 #include <memory>
+#include <atomic>
 #include <Wt/Json/Object.h>
 #include <Wt/Json/Array.h>
 #include <Wt/Json/Value.h>
@@ -264,6 +265,28 @@ public:
      * @return Vector of valid table identifier patterns
      */
     static std::vector<std::string> getTableIdentifierOptions();
+    
+    /**
+     * @brief Gets the legacy table number of a table identifier
+     * @param identifier Table identifier, e.g. "table 5"
+     * @return Table number or 0 if not applicable
+     */
+    static int tableNumberOf(const std::string& identifier);
+    
+    /**
+     * @brief Sets the tax rate applied when order totals are calculated
+     * @param rate Tax rate as a fraction (restaurant.tax_rate)
+     * 
+     * Shared by every order in the process. Existing orders keep their
+     * totals until their items change.
+     */
+    static void setTaxRate(double rate);
+    
+    /**
+     * @brief Gets the tax rate applied to new totals
+     * @return Tax rate as a fraction (0.08 until configured)
+     */
+    static double getTaxRate();
 
 private:
     /**
@@ -286,7 +309,33 @@ private:
     double total_;                      ///< Total amount
     std::chrono::system_clock::time_point timestamp_; ///< Creation timestamp
     
-    static constexpr double TAX_RATE = 0.08; ///< Tax rate (8% - configurable)
+    static std::atomic<double> taxRate_; ///< Tax rate (restaurant.tax_rate, 8% by default)
+};
+
+/**
+ * @struct OrderSummary
+ * @brief What order lists show of an order, without its items
+ *
+ * Filled from a sparse API read (see OrderRepository::summaryView()) or
+ * from a local Order, so list screens can show orders without loading
+ * every item.
+ */
+struct OrderSummary {
+    int orderId = 0;
+    std::string tableIdentifier;
+    int tableNumber = 0;                                ///< Legacy number (see Order::getTableNumber())
+    Order::Status status = Order::PENDING;
+    int itemCount = 0;                                  ///< Order lines
+    double total = 0.0;                                 ///< Including tax
+    std::chrono::system_clock::time_point createdAt;
+
+    OrderSummary() = default;
+
+    /**
+     * @brief Summarizes a complete order
+     * @param order Order to summarize
+     */
+    explicit OrderSummary(const Order& order);
 };
 
 #endif // ORDER_H
@@ -6,19 +6,27 @@
 #define APICLIENT_H
 
 #include "APIConfiguration.hpp"
+#include "AsyncResult.hpp"
+#include "CircuitBreaker.hpp"
+#include "HttpTransport.hpp"
+#include "ResponseCache.hpp"
+#include "../utils/Logging.hpp"
 
-#include <Wt/Http/Client.h>
-#include <Wt/Http/Message.h>
 #include <Wt/Json/Object.h>
 #include <Wt/Json/Array.h>
 #include <Wt/Json/Value.h>
 #include <Wt/Json/Parser.h>
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <memory>
 #include <functional>
+#include <chrono>
 #include <map>
 #include <future>
+#include <utility>
+#include <vector>
 
 /**
  * @class APIClient
@@ -26,6 +34,34 @@
  * 
  * Handles all HTTP communication with the JSON:API middleware including
  * authentication, request/response formatting, and error handling.
+ * 
+ * Requests go out through the shared HttpTransport and never block the
+ * caller. When a request is made from a Wt session, its callback is posted
+ * back into that session (WServer::post), so it runs under the session lock
+ * like any other event handler; callbacks for sessions that have ended are
+ * dropped. Outside a session the callback runs on the transport thread.
+ * 
+ * Failed requests are retried with exponential backoff and jitter when that
+ * is safe: idempotent methods (and writes carrying an Idempotency-Key) after
+ * no response or a 429/502/503/504, other methods only if the request never
+ * reached the server. Retries share the
+ * request's timeout, so a caller never waits longer than one timeout.
+ * Outages also feed the process-wide CircuitBreaker (one circuit per
+ * resource); while a circuit is open its requests fail at once.
+ * 
+ * GETs of resources registered with enableResponseCache() go through the
+ * shared ResponseCache: a cached copy is delivered at once while a
+ * conditional request (If-None-Match / If-Modified-Since) revalidates it in
+ * the background, and a 304 answer counts as a hit. Successful writes to a
+ * resource drop its cached responses.
+ * 
+ * Identical GETs (same URL and auth scope) made while one is in flight are
+ * merged by the process-wide RequestCoalescer: one request goes upstream
+ * and every caller gets the same decoded response.
+ * 
+ * batch() sends several writes as one JSON:API atomic operations request,
+ * or as individual requests in parallel where the middleware lacks the
+ * extension.
  */
 class APIClient {
 public:
@@ -40,6 +76,7 @@ public:
         Wt::Json::Object data;
         Wt::Json::Array dataArray;
         Wt::Json::Object meta;
+        Wt::Json::Object links;     ///< JSON:API links (e.g. "next" for paged collections)
         Wt::Json::Array included;
         
         APIResponse() : success(false), statusCode(0) {}
@@ -50,6 +87,36 @@ public:
      */
     using ResponseCallback = std::function<void(const APIResponse&)>;
     
+    /**
+     * @struct Operation
+     * @brief One write of a batch()
+     */
+    struct Operation {
+        std::string method;          ///< "POST", "PUT", "PATCH" or "DELETE"
+        std::string endpoint;        ///< e.g. "/Order" for POST, "/Order/1001" otherwise
+        std::string body;            ///< Serialized resource object (empty for DELETE)
+        std::string idempotencyKey;  ///< Optional, as for sendIdempotent()
+    };
+    
+    /**
+     * @struct BatchResponse
+     * @brief Results of a batch(), one per operation and in the same order
+     */
+    struct BatchResponse {
+        bool atomic = false;              ///< Applied all-or-nothing in one request
+        std::vector<APIResponse> results;
+        
+        bool success() const {
+            return std::all_of(results.begin(), results.end(),
+                               [](const APIResponse& result) { return result.success; });
+        }
+    };
+    
+    /**
+     * @brief Batch callback type
+     */
+    using BatchCallback = std::function<void(const BatchResponse&)>;
+    
     /**
      * @brief Constructs API client
      * @param baseUrl Base URL for the API (e.g., "http://localhost:5656/api")
@@ -113,9 +180,68 @@ public:
     void delete_(const std::string& endpoint,
                 ResponseCallback callback = nullptr);
     
+    /**
+     * @brief Performs a write that the middleware applies at most once
+     *
+     * The request carries an Idempotency-Key header, so it is retried like
+     * a PUT and may be sent again later (e.g. after a restart) with the
+     * same key.
+     *
+     * @param method "POST", "PUT", "PATCH" or "DELETE"
+     * @param endpoint API endpoint
+     * @param body Serialized request body (empty for DELETE)
+     * @param idempotencyKey Key identifying this write
+     * @param callback Response callback
+     */
+    void sendIdempotent(const std::string& method,
+                        const std::string& endpoint,
+                        const std::string& body,
+                        const std::string& idempotencyKey,
+                        ResponseCallback callback = nullptr);
+    
+    /**
+     * @brief Performs several writes in one round trip where possible
+     *
+     * The writes are sent as one JSON:API atomic operations request
+     * (https://jsonapi.org/ext/atomic) and applied all-or-nothing. If the
+     * middleware rejects one of them, that result carries the error and the
+     * others fail with 424 (Failed Dependency), as none was applied.
+     *
+     * If the middleware does not support the extension, the writes are sent
+     * as individual requests, all at once except that writes to the same
+     * resource wait for each other. BatchResponse::atomic is false then, and
+     * a write whose predecessor on the same resource failed is not sent
+     * (424). Support is detected on the first batch and remembered.
+     *
+     * @param operations Writes, in the order they must be applied
+     * @param callback Batch callback
+     */
+    void batch(std::vector<Operation> operations, BatchCallback callback = nullptr);
+    
+    // =================================================================
+    // Composable Methods
+    // =================================================================
+    // Same requests as above, returning an AsyncResult instead of taking a
+    // callback. Results settle in the calling Wt session (if any), with the
+    // response's success flag.
+    
+    /**
+     * @brief Response shared by every caller a GET was coalesced for
+     */
+    using SharedResponse = std::shared_ptr<const APIResponse>;
+    
+    AsyncResult<SharedResponse> getAsync(const std::string& endpoint,
+                                         const std::map<std::string, std::string>& params = {});
+    AsyncResult<SharedResponse> postAsync(const std::string& endpoint, const Wt::Json::Object& data);
+    AsyncResult<SharedResponse> putAsync(const std::string& endpoint, const Wt::Json::Object& data);
+    AsyncResult<SharedResponse> patchAsync(const std::string& endpoint, const Wt::Json::Object& data);
+    AsyncResult<SharedResponse> deleteAsync(const std::string& endpoint);
+    AsyncResult<std::shared_ptr<const BatchResponse>> batchAsync(std::vector<Operation> operations);
+    
     // =================================================================
     // Synchronous Methods (for backward compatibility)
     // =================================================================
+    // These block the calling thread until the response or the timeout.
     
     /**
      * @brief Synchronous GET request
@@ -147,10 +273,58 @@ public:
     
     /**
      * @brief Sets request timeout
-     * @param seconds Timeout in seconds
+     * @param seconds Timeout in seconds, covering all retries of a request
      */
     void setTimeout(int seconds);
     
+    /**
+     * @brief Sets the retry policy
+     * @param maxRetries Retries after the first attempt (0 disables retrying)
+     * @param retryDelayMs Delay before the first retry, doubled for each further one
+     */
+    void setRetryPolicy(int maxRetries, int retryDelayMs);
+    
+    /**
+     * @brief Sets how batch() sends its writes
+     * @param enabled False to always send writes individually
+     * @param endpoint Endpoint of the middleware's atomic operations
+     */
+    void setAtomicOperations(bool enabled,
+                             const std::string& endpoint = APIConfiguration::Defaults::DEFAULT_OPERATIONS_ENDPOINT);
+    
+    /**
+     * @brief Sets how bodies are compressed on the wire (needs a build with zlib)
+     * @param acceptCompressed Ask for gzip/deflate responses
+     * @param compressRequestsAbove Gzip request bodies larger than this many
+     *        bytes (0: never); the middleware must accept Content-Encoding
+     */
+    void setCompression(bool acceptCompressed, std::size_t compressRequestsAbove = 0);
+    
+    /**
+     * @brief Serves GETs of a resource through the shared response cache
+     * @param endpoint Resource endpoint (e.g. "/MenuItem"); covers its sub-paths
+     * @param staleWhileRevalidate How long after going stale a cached copy is
+     *        still delivered at once (while it is revalidated in the background)
+     */
+    void enableResponseCache(const std::string& endpoint, std::chrono::seconds staleWhileRevalidate);
+    
+    /**
+     * @brief Makes the next GETs of a resource wait for revalidation
+     *
+     * Cached copies are kept, so unchanged data still costs only a 304.
+     *
+     * @param endpoint Resource endpoint
+     */
+    void expireCachedResponses(const std::string& endpoint);
+    
+    /**
+     * @brief Checks whether requests would currently be sent
+     * @param endpoint API endpoint, or empty for any endpoint of this API
+     * @return False while the endpoint's circuit (or, for an empty endpoint,
+     *         any circuit of this API) is open and requests fail fast
+     */
+    bool isAvailable(const std::string& endpoint = "") const;
+    
     /**
      * @brief Sets custom headers
      * @param headers Map of header name to value
@@ -159,6 +333,12 @@ public:
     
     /**
      * @brief Enables/disables debug logging
+     *
+     * Overrides the "api.APIClient" log component to DEBUG without changing
+     * the level of any other component. The level in effect before debug mode
+     * was turned on (e.g. a configured logging.level.api.APIClient) is
+     * restored when it is turned off again.
+     *
      * @param enabled True to enable debug output
      */
     void setDebugMode(bool enabled);
@@ -174,17 +354,20 @@ protected:
                         const std::map<std::string, std::string>& params = {});
     
     /**
-     * @brief Adds authentication headers to message
-     * @param message HTTP message to modify
+     * @brief Builds the request headers, including authentication
+     * @return Header name/value pairs
      */
-    void addAuthHeaders(Wt::Http::Message& message);
+    std::vector<std::pair<std::string, std::string>> buildHeaders() const;
     
     /**
      * @brief Parses JSON:API response
+     *
+     * Runs on the transport thread, so it must not use client state.
+     *
      * @param response Raw HTTP response
      * @return Parsed API response
      */
-    APIResponse parseResponse(const Wt::Http::Message& response);
+    static APIResponse parseResponse(const HttpTransport::Response& response);
     
     /**
      * @brief Handles HTTP errors
@@ -192,7 +375,7 @@ protected:
      * @param body Response body
      * @return Error response
      */
-    APIResponse handleError(int statusCode, const std::string& body);
+    static APIResponse handleError(int statusCode, const std::string& body);
     
     /**
      * @brief Logs debug information
@@ -201,18 +384,66 @@ protected:
     void debugLog(const std::string& message);
 
 private:
+    struct Call;
+    struct Pipeline;
+    
+    // Takes a shared response so one decoded result can reach many sessions
+    using Delivery = std::function<void(std::shared_ptr<const APIResponse>)>;
+    using BatchDelivery = std::function<void(std::shared_ptr<const BatchResponse>)>;
+    
+    // Whether the middleware takes atomic operations; shared with requests in flight
+    enum class AtomicSupport { Unknown, Supported, Unsupported };
+    
     std::string baseUrl_;
     std::string authToken_;
     int timeoutSeconds_;
+    int maxRetries_;
+    int retryDelayMs_;
+    std::map<std::string, std::chrono::seconds> cachedResources_;
     std::map<std::string, std::string> defaultHeaders_;
     bool debugMode_;
-    
-    std::unique_ptr<Wt::Http::Client> httpClient_;
+    bool hadLevelBeforeDebug_;
+    LogLevel levelBeforeDebug_;
+    bool acceptCompressed_;
+    std::size_t compressRequestsAbove_;
+    std::string operationsEndpoint_;
+    std::shared_ptr<std::atomic<AtomicSupport>> atomicSupport_;
+    LogComponent& logger_;
     
     // Helper methods
     void initializeDefaults();
+    void sendGet(const std::string& endpoint, const std::map<std::string, std::string>& params,
+                 Delivery deliver);
+    void sendRequest(const std::string& method, const std::string& endpoint, const std::string& url,
+                     std::string body, Delivery deliver, const std::string& idempotencyKey = std::string());
+    void sendBatch(std::vector<Operation> operations, BatchDelivery deliver);
+    APIResponse sendSync(const std::string& method, const std::string& endpoint,
+                         const std::string& url, std::string body);
+    void sendCachedGet(const std::string& endpoint, const std::string& url,
+                       std::chrono::seconds staleWhileRevalidate, Delivery deliver);
+    
+    // Cached bodies are parsed once; every later hit shares the result
+    static std::shared_ptr<const APIResponse> applyToCache(const std::string& key, HttpTransport::Response response);
+    static std::shared_ptr<const APIResponse> decodeCached(const std::string& key,
+                                                           const ResponseCache::Lookup& cached);
+    void execute(const std::string& endpoint, HttpTransport::Request request,
+                 HttpTransport::Completion done) const;
+    std::shared_ptr<Call> makeCall(const std::string& endpoint, HttpTransport::Request request) const;
+    static void dispatch(std::shared_ptr<Call> call);
+    std::shared_ptr<Pipeline> makePipeline(const std::vector<Operation>& operations);
+    static void startPipeline(std::shared_ptr<Pipeline> pipeline, BatchDelivery deliver);
+    static void runPipelined(std::shared_ptr<Pipeline> pipeline, std::size_t index);
+    HttpTransport::Request makeRequest(const std::string& method, const std::string& url,
+                                       std::string body) const;
+    std::string resourceFor(const std::string& endpoint) const;
+    std::string authScope() const;
+    static Delivery bindToSession(ResponseCallback callback);
+    static BatchDelivery bindToSession(BatchCallback callback);
+    template<typename Response>
+    static std::function<void(std::shared_ptr<const Response>)>
+        postToSession(std::function<void(std::shared_ptr<const Response>)> deliver);
+    static Delivery settleInSession(const AsyncResult<SharedResponse>& result);
     std::string encodeQueryParams(const std::map<std::string, std::string>& params);
-    bool isValidJson(const std::string& json);
 };
 
 #endif // APICLIENT_H
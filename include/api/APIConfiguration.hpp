@@ -25,14 +25,34 @@ public:
         static constexpr int API_TIMEOUT = 30;              ///< Default timeout in seconds
         static constexpr int MAX_RETRIES = 3;               ///< Default max retry attempts
         static constexpr int RETRY_DELAY_MS = 1000;         ///< Default retry delay in milliseconds
+        static constexpr int MAX_RETRY_DELAY_MS = 8000;     ///< Cap on the exponential retry delay
+        static constexpr int CIRCUIT_FAILURE_THRESHOLD = 5; ///< Consecutive failures that open a circuit
+        static constexpr int CIRCUIT_OPEN_SECONDS = 15;     ///< Time an open circuit fails fast
         static constexpr bool DEBUG_MODE = false;           ///< Default debug mode setting
         static constexpr bool ENABLE_CACHING = true;        ///< Default caching setting
         static constexpr int CACHE_TIMEOUT_MINUTES = 5;     ///< Default cache timeout
+        static constexpr int CACHE_STALE_MINUTES = 30;      ///< How long stale cached responses are served while revalidating
+        static constexpr int PAGE_SIZE = 100;               ///< Entities per page for paged collection reads
+        static constexpr int MAX_PAGES = 10000;             ///< Hard cap on the pages one paged read requests
+        static constexpr bool ENABLE_IDENTITY_MAP = true;   ///< One shared object per entity id in the repositories
+        static constexpr int IDENTITY_MAP_TTL_SECONDS = 30; ///< How long an entity read answers repeated reads
+        static constexpr bool ENABLE_DELTA_SYNC = true;     ///< Refresh active orders with only what changed
+        static constexpr int ORDER_FULL_SYNC_SECONDS = 300; ///< How often a delta sync of orders loads them all again
+        static constexpr int COALESCE_WINDOW_MS = 0;        ///< How long a GET response answers identical GETs (0: in flight only)
+        static constexpr bool ENABLE_OUTBOX = true;         ///< Queue order writes locally and send them in the background
+        static constexpr int OUTBOX_BATCH_SIZE = 16;        ///< Queued writes sent at once
+        static constexpr int OUTBOX_RETRY_MS = 5000;        ///< Wait before resending queued writes after an outage
+        static constexpr bool ENABLE_ATOMIC_OPERATIONS = true; ///< Send write batches as one JSON:API atomic request
+        static constexpr bool ENABLE_COMPRESSION = true;    ///< Ask the middleware for gzip/deflate responses
+        static constexpr int COMPRESS_REQUESTS_ABOVE = 0;   ///< Gzip request bodies larger than this many bytes (0: never)
+        static constexpr bool ENABLE_SPARSE_FIELDSETS = true; ///< List views ask only for the attributes they show
         
         // Default URLs
         static const char* DEFAULT_BASE_URL;                 ///< Default API base URL
         static const char* DEFAULT_AUTH_ENDPOINT;            ///< Default authentication endpoint
         static const char* DEFAULT_VERSION;                 ///< Default API version
+        static const char* DEFAULT_OUTBOX_PATH;             ///< Default write-behind journal file
+        static const char* DEFAULT_OPERATIONS_ENDPOINT;     ///< Default JSON:API atomic operations endpoint
     };
     
     /**
@@ -47,6 +67,7 @@ public:
         static const char* X_API_KEY;                       ///< API Key header
         static const char* X_REQUEST_ID;                    ///< Request ID header
         static const char* X_CLIENT_VERSION;                ///< Client version header
+        static const char* IDEMPOTENCY_KEY;                 ///< Idempotency key header
     };
     
     /**
@@ -56,6 +77,7 @@ public:
     struct ContentTypes {
         static const char* JSON;                            ///< JSON content type
         static const char* JSON_API;                        ///< JSON:API content type
+        static const char* JSON_API_ATOMIC;                 ///< JSON:API with the atomic operations extension
         static const char* FORM_URLENCODED;                 ///< Form URL encoded content type
         static const char* MULTIPART_FORM;                  ///< Multipart form content type
     };
@@ -72,11 +94,18 @@ public:
         static constexpr int UNAUTHORIZED = 401;             ///< Unauthorized
         static constexpr int FORBIDDEN = 403;                ///< Forbidden
         static constexpr int NOT_FOUND = 404;                ///< Not Found
+        static constexpr int METHOD_NOT_ALLOWED = 405;       ///< Method Not Allowed
+        static constexpr int REQUEST_TIMEOUT = 408;          ///< Request Timeout
         static constexpr int CONFLICT = 409;                 ///< Conflict
+        static constexpr int UNSUPPORTED_MEDIA_TYPE = 415;   ///< Unsupported Media Type
         static constexpr int UNPROCESSABLE_ENTITY = 422;     ///< Unprocessable Entity
+        static constexpr int FAILED_DEPENDENCY = 424;        ///< Failed Dependency
+        static constexpr int TOO_MANY_REQUESTS = 429;        ///< Too Many Requests
         static constexpr int INTERNAL_SERVER_ERROR = 500;    ///< Internal Server Error
+        static constexpr int NOT_IMPLEMENTED = 501;          ///< Not Implemented
         static constexpr int BAD_GATEWAY = 502;              ///< Bad Gateway
         static constexpr int SERVICE_UNAVAILABLE = 503;      ///< Service Unavailable
+        static constexpr int GATEWAY_TIMEOUT = 504;          ///< Gateway Timeout
     };
     
     // =================================================================
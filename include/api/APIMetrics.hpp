@@ -0,0 +1,132 @@
+//============================================================================
+// include/api/APIMetrics.hpp - Per-Endpoint Request Metrics of the API Client
+//============================================================================
+
+#ifndef APIMETRICS_H
+#define APIMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/**
+ * @class APIMetrics
+ * @brief Process-wide request counters of APIClient, per route and method
+ *
+ * Every request sent to the middleware is counted once, however many
+ * attempts it takes: requests, errors (no answer or status >= 400),
+ * requests in flight and a latency histogram. Requests answered from
+ * ResponseCache or RequestCoalescer never reach the middleware and are
+ * not counted; calls refused by an open circuit are counted as rejected.
+ *
+ * Endpoints are reduced to routes so ids do not make new series:
+ * "/Order/1001?include=items" is counted as "/Order/{id}". A series is
+ * registered on first use and never removed; past MAX_SERIES routes,
+ * requests are counted under the route "other".
+ *
+ * Recording and rendering only touch atomics; the mutex is taken when a
+ * route is seen for the first time. A scrape never waits for requests and
+ * requests never wait for a scrape. Thread-safe.
+ */
+class APIMetrics {
+public:
+    static constexpr std::size_t MAX_SERIES = 256;
+    static constexpr std::size_t BUCKETS = 11;
+
+    /**
+     * @brief Upper bounds of the latency histogram buckets, in seconds
+     */
+    static const std::array<double, BUCKETS> BUCKET_BOUNDS;
+
+    /**
+     * @class Series
+     * @brief Counters of one route and method
+     */
+    class Series {
+    public:
+        Series(std::string method, std::string route);
+
+        /**
+         * @brief Marks a request as sent (before its first attempt)
+         */
+        void start();
+
+        /**
+         * @brief Records the outcome of a request passed to start()
+         * @param elapsed Time since start(), retries included
+         * @param failed No answer, or status >= 400
+         */
+        void finish(std::chrono::steady_clock::duration elapsed, bool failed);
+
+        /**
+         * @brief Records a request refused by an open circuit (never sent)
+         */
+        void reject();
+
+        const std::string& getMethod() const { return method_; }
+        const std::string& getRoute() const { return route_; }
+
+    private:
+        friend class APIMetrics;
+
+        const std::string method_;
+        const std::string route_;
+        const std::size_t hash_;
+
+        std::atomic<std::uint64_t> requests_{0};
+        std::atomic<std::uint64_t> errors_{0};
+        std::atomic<std::uint64_t> rejected_{0};
+        std::atomic<std::int64_t> inFlight_{0};
+        std::atomic<std::uint64_t> latencyMicros_{0};                   // Sum of finished requests
+        std::array<std::atomic<std::uint64_t>, BUCKETS + 1> buckets_{}; // Per bucket, last one is +Inf
+    };
+
+    /**
+     * @brief Gets the process-wide metrics
+     */
+    static APIMetrics& getInstance();
+
+    // Prevent copying
+    APIMetrics(const APIMetrics&) = delete;
+    APIMetrics& operator=(const APIMetrics&) = delete;
+
+    /**
+     * @brief Gets the series of a request, registering it on first use
+     * @param method HTTP method
+     * @param endpoint API endpoint, e.g. "/Order/1001"
+     * @return Series that lives as long as the process
+     */
+    Series& series(const std::string& method, const std::string& endpoint);
+
+    /**
+     * @brief Writes every series in Prometheus text format
+     *
+     * Families: pos_api_requests_total, pos_api_errors_total,
+     * pos_api_rejected_total, pos_api_requests_in_flight and
+     * pos_api_request_duration_seconds, labelled with route and method.
+     */
+    void render(std::ostream& out) const;
+
+    /**
+     * @brief Reduces an endpoint to its route ("/Order/17?x=1" -> "/Order/{id}")
+     */
+    static std::string routeFor(const std::string& endpoint);
+
+private:
+    APIMetrics();
+
+    Series* find(std::size_t hash, const std::string& method, const std::string& route) const;
+
+    std::mutex registerMutex_;                                 // Taken to add a series only
+    std::array<std::unique_ptr<Series>, MAX_SERIES> series_;   // Slots below count_ are never changed
+    std::atomic<std::size_t> count_{0};
+    Series overflow_;
+};
+
+#endif // APIMETRICS_H
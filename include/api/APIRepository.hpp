@@ -6,21 +6,74 @@
 #define APIREPOSITORY_H
 
 #include "APIClient.hpp"
+#include "AsyncResult.hpp"
+#include "JsonFields.hpp"
 #include <Wt/Json/Object.h>
 #include <Wt/Json/Array.h>
 #include <Wt/Json/Value.h>
+#include <Wt/Json/Serializer.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <map>
 #include <string>
 #include <functional>
 
+/**
+ * @struct APIView
+ * @brief What one screen needs of a resource, for the GETs that feed it
+ *
+ * Sent as JSON:API sparse fieldsets (fields[Order]=status,total) and an
+ * include list, so a list screen does not download attributes and related
+ * resources it never shows. A middleware without sparse fieldsets sends
+ * every attribute; decoders of a view must accept that. An empty view
+ * asks for everything.
+ */
+struct APIView {
+    std::map<std::string, std::vector<std::string>> fields;   ///< Resource type -> attributes to send
+    std::vector<std::string> include;                          ///< Related resources to embed
+
+    bool empty() const { return fields.empty() && include.empty(); }
+
+    /**
+     * @brief Adds the fields[...] and include parameters to a query
+     */
+    void applyTo(std::map<std::string, std::string>& params) const {
+        for (const auto& [type, attributes] : fields) {
+            params["fields[" + type + "]"] = join(attributes);
+        }
+        if (!include.empty()) {
+            params["include"] = join(include);
+        }
+    }
+
+private:
+    static std::string join(const std::vector<std::string>& names) {
+        std::string joined;
+        for (const auto& name : names) {
+            joined += (joined.empty() ? "" : ",") + name;
+        }
+        return joined;
+    }
+};
+
 /**
  * @class APIRepository
  * @brief Base class for API-based repositories
  * 
  * Provides common CRUD operations and JSON:API handling for all entities.
  * Uses the repository pattern to abstract API communication details.
+ *
+ * With the identity map enabled, findShared() and findAllShared() hand out
+ * one canonical shared_ptr per id: an entity that has not changed keeps its
+ * pointer, so callers can compare pointers to detect changes. Entries
+ * younger than the TTL answer findShared() and findById() without a request.
+ * Canonical entities are shared; copy one before changing it.
  */
 template<typename T>
 class APIRepository {
@@ -52,32 +105,94 @@ public:
         
         client_->get(endpoint_, params, [this, callback](const APIClient::APIResponse& response) {
             std::vector<T> entities;
-            
             if (response.success) {
-                // Check if we have array data
-                if (!response.dataArray.empty()) {
-                    for (const auto& item : response.dataArray) {
-                        auto entity = fromJson(item);
-                        if (entity) {
-                            entities.push_back(*entity);
-                        }
-                    }
-                }
-                // Also check if single data object exists
-                else if (!response.data.empty()) {
-                    auto entity = fromJson(response.data);
-                    if (entity) {
-                        entities.push_back(*entity);
-                    }
-                }
+                entities = decodeAll(response);
             }
             
             if (callback) {
-                callback(entities, response.success);
+                callback(std::move(entities), response.success);
             }
         });
     }
     
+    /**
+     * @class PagedQuery
+     * @brief Handle to a findAllPaged() in progress
+     */
+    class PagedQuery {
+    public:
+        /**
+         * @brief Stops the query; no further callbacks are made
+         */
+        void cancel() { cancelled_ = true; }
+        
+        bool isCancelled() const { return cancelled_; }
+        
+        /**
+         * @brief Number of pages delivered so far
+         */
+        int getPagesDelivered() const { return pagesDelivered_; }
+        
+    private:
+        friend class APIRepository;
+        std::atomic<bool> cancelled_{false};
+        std::atomic<int> pagesDelivered_{0};
+        
+        // Touched only by the response handler of the current page; the
+        // next page is not requested before it returns
+        int pagesRequested_ = 0;
+        std::string previousFirstId_;
+    };
+    
+    /**
+     * @brief Page callback type; receives one page of entities
+     */
+    using PageCallback = std::function<void(std::vector<T> page)>;
+    
+    /**
+     * @brief Called once after the last page, or on the first failure
+     */
+    using PagingDoneCallback = std::function<void(bool success)>;
+    
+    /**
+     * @brief Finds all entities a page at a time
+     *
+     * Requests page[limit]/page[offset] pages and delivers each one as soon
+     * as it arrives. The next page is requested before the current one is
+     * decoded and delivered, so the network fetch overlaps the caller's
+     * work, while at most one page waits in memory. If the server sends
+     * JSON:API links, its "next" link is followed instead (which also
+     * covers cursor-based paging); otherwise paging ends with the first
+     * page that is not full. A server that ignores page[...] cannot make it
+     * loop: without links, paging also ends after a page larger than
+     * pageSize, and a page starting with the previous page's first entity
+     * ends it without being delivered. No query requests more than
+     * APIConfiguration::Defaults::MAX_PAGES pages.
+     *
+     * @param params Query parameters for filtering
+     * @param onPage Callback for each page, in order
+     * @param onDone Callback after the last page or on failure
+     * @param pageSize Entities per page
+     * @return Handle for cancelling the query
+     */
+    virtual std::shared_ptr<PagedQuery> findAllPaged(const std::map<std::string, std::string>& params,
+                                                     PageCallback onPage,
+                                                     PagingDoneCallback onDone = nullptr,
+                                                     int pageSize = APIConfiguration::Defaults::PAGE_SIZE) {
+        auto query = std::make_shared<PagedQuery>();
+        
+        pageSize = std::max(pageSize, 1);
+        std::map<std::string, std::string> firstPage = params;
+        firstPage["page[limit]"] = std::to_string(pageSize);
+        firstPage["page[offset]"] = "0";
+        
+        query->pagesRequested_ = 1;
+        requestPage(query, std::move(firstPage), pageSize,
+                    std::make_shared<const PageCallback>(std::move(onPage)),
+                    std::make_shared<const PagingDoneCallback>(std::move(onDone)));
+        return query;
+    }
+    
     /**
      * @brief Finds entity by ID
      * @param id Entity ID
@@ -86,6 +201,15 @@ public:
     virtual void findById(const std::string& id,
                          std::function<void(std::unique_ptr<T>, bool success)> callback = nullptr) {
         
+        if (isIdentityMapEnabled()) {
+            findShared(id, [callback](std::shared_ptr<T> entity, bool success) {
+                if (callback) {
+                    callback(entity ? std::make_unique<T>(*entity) : nullptr, success);
+                }
+            });
+            return;
+        }
+        
         std::string url = endpoint_ + "/" + id;
         
         client_->get(url, {}, [this, callback](const APIClient::APIResponse& response) {
@@ -111,6 +235,74 @@ public:
         findById(std::to_string(id), callback);
     }
     
+    /**
+     * @brief Finds the canonical entity for an ID
+     *
+     * Answered at once from the identity map if the entry is younger than
+     * its TTL; otherwise fetched. Without the identity map every call
+     * fetches and returns a new object.
+     *
+     * @param id Entity ID
+     * @param callback Callback with the shared entity
+     */
+    void findShared(const std::string& id,
+                    std::function<void(std::shared_ptr<T>, bool success)> callback = nullptr) {
+        if (auto entity = lookup(id)) {
+            if (callback) callback(std::move(entity), true);
+            return;
+        }
+        
+        client_->get(endpoint_ + "/" + id, {}, [this, id, callback](const APIClient::APIResponse& response) {
+            std::shared_ptr<T> entity;
+            if (response.success && !response.data.empty()) {
+                entity = intern(response.data, fromJson(response.data));
+            } else if (response.statusCode == APIConfiguration::StatusCodes::NOT_FOUND) {
+                forget(id);
+            }
+            
+            if (callback) {
+                callback(std::move(entity), response.success);
+            }
+        });
+    }
+    
+    void findShared(int id, std::function<void(std::shared_ptr<T>, bool success)> callback = nullptr) {
+        findShared(std::to_string(id), callback);
+    }
+    
+    /**
+     * @brief Finds entities as canonical shared objects
+     *
+     * Always fetched; every entity received refreshes its identity map
+     * entry, keeping its pointer if it did not change.
+     *
+     * @param params Query parameters for filtering/pagination
+     * @param callback Callback with results
+     */
+    void findAllShared(const std::map<std::string, std::string>& params,
+                       std::function<void(std::vector<std::shared_ptr<T>>, bool success)> callback = nullptr) {
+        client_->get(endpoint_, params, [this, callback](const APIClient::APIResponse& response) {
+            std::vector<std::shared_ptr<T>> entities;
+            if (response.success) {
+                entities.reserve(response.dataArray.size());
+                for (const auto& item : response.dataArray) {
+                    if (auto entity = intern(item, fromJson(item))) {
+                        entities.push_back(std::move(entity));
+                    }
+                }
+                if (response.dataArray.empty() && !response.data.empty()) {
+                    if (auto entity = intern(response.data, fromJson(response.data))) {
+                        entities.push_back(std::move(entity));
+                    }
+                }
+            }
+            
+            if (callback) {
+                callback(std::move(entities), response.success);
+            }
+        });
+    }
+    
     /**
      * @brief Creates new entity
      * @param entity Entity to create
@@ -126,6 +318,7 @@ public:
             
             if (response.success && !response.data.empty()) {
                 createdEntity = fromJson(response.data);
+                remember(response.data, createdEntity);
             }
             
             if (callback) {
@@ -146,11 +339,14 @@ public:
         std::string url = endpoint_ + "/" + id;
         auto jsonData = toJson(entity);
         
-        client_->put(url, jsonData, [this, callback](const APIClient::APIResponse& response) {
+        client_->put(url, jsonData, [this, id, callback](const APIClient::APIResponse& response) {
             std::unique_ptr<T> updatedEntity = nullptr;
             
             if (response.success && !response.data.empty()) {
                 updatedEntity = fromJson(response.data);
+                remember(response.data, updatedEntity);
+            } else {
+                invalidate(id);     // Unknown what the middleware holds now
             }
             
             if (callback) {
@@ -180,7 +376,12 @@ public:
         
         std::string url = endpoint_ + "/" + id;
         
-        client_->delete_(url, [callback](const APIClient::APIResponse& response) {
+        client_->delete_(url, [this, id, callback](const APIClient::APIResponse& response) {
+            if (response.success) {
+                forget(id);
+            } else {
+                invalidate(id);
+            }
             if (callback) {
                 callback(response.success);
             }
@@ -197,6 +398,25 @@ public:
         delete_(std::to_string(id), callback);
     }
     
+    // =================================================================
+    // Composable Reads
+    // =================================================================
+    // The reads above, returning an AsyncResult instead of taking a callback
+    
+    AsyncResult<std::vector<T>> findAllAsync(const std::map<std::string, std::string>& params = {}) {
+        return AsyncResult<std::vector<T>>::from([&](auto settle) { findAll(params, settle); });
+    }
+    
+    AsyncResult<std::vector<std::shared_ptr<T>>> findAllSharedAsync(const std::map<std::string, std::string>& params = {}) {
+        return AsyncResult<std::vector<std::shared_ptr<T>>>::from([&](auto settle) { findAllShared(params, settle); });
+    }
+    
+    AsyncResult<std::shared_ptr<T>> findSharedAsync(const std::string& id) {
+        return AsyncResult<std::shared_ptr<T>>::from([&](auto settle) { findShared(id, settle); });
+    }
+    
+    AsyncResult<std::shared_ptr<T>> findSharedAsync(int id) { return findSharedAsync(std::to_string(id)); }
+    
     // =================================================================
     // Utility Methods
     // =================================================================
@@ -207,6 +427,13 @@ public:
      */
     const std::string& getEndpoint() const { return endpoint_; }
     
+    /**
+     * @brief Builds the body create() and update() send for an entity
+     * @param entity Entity to serialize
+     * @return JSON:API resource object
+     */
+    Wt::Json::Object toResource(const T& entity) { return toJson(entity); }
+    
     /**
      * @brief Gets the API client
      * @return Shared pointer to API client
@@ -218,6 +445,79 @@ public:
      * @return True if client is available
      */
     bool isInitialized() const { return client_ != nullptr; }
+    
+    // =================================================================
+    // Identity Map
+    // =================================================================
+    
+    /**
+     * @struct IdentityMapStats
+     * @brief Counters for monitoring
+     */
+    struct IdentityMapStats {
+        std::uint64_t hits = 0;            ///< Answered from memory
+        std::uint64_t misses = 0;          ///< Not held, or older than the TTL
+        std::uint64_t unchanged = 0;       ///< Refetched and kept the same pointer
+        std::uint64_t invalidations = 0;   ///< Entries dropped by invalidate()/invalidateAll()
+        std::size_t entries = 0;
+    };
+    
+    /**
+     * @brief Turns the identity map on or off
+     * @param enabled False drops all entries and makes every read fetch
+     * @param ttl How long an entry answers reads without a request
+     */
+    void setIdentityMap(bool enabled,
+                        std::chrono::seconds ttl = std::chrono::seconds(APIConfiguration::Defaults::IDENTITY_MAP_TTL_SECONDS)) {
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        identityMapEnabled_ = enabled;
+        identityTtl_ = ttl;
+        if (!enabled) {
+            identities_.clear();
+        }
+    }
+    
+    bool isIdentityMapEnabled() const {
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        return identityMapEnabled_;
+    }
+    
+    /**
+     * @brief Makes the next read of an ID fetch it
+     *
+     * The entity is kept to compare with, so an unchanged refetch still
+     * returns the same pointer.
+     */
+    void invalidate(const std::string& id) {
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        auto it = identities_.find(id);
+        if (it != identities_.end() && it->second.fresh) {
+            it->second.fresh = false;
+            ++identityStats_.invalidations;
+        }
+    }
+    
+    void invalidate(int id) { invalidate(std::to_string(id)); }
+    
+    /**
+     * @brief Makes the next read of every ID fetch it
+     */
+    void invalidateAll() {
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        for (auto& [id, identity] : identities_) {
+            if (identity.fresh) {
+                identity.fresh = false;
+                ++identityStats_.invalidations;
+            }
+        }
+    }
+    
+    IdentityMapStats getIdentityMapStats() const {
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        IdentityMapStats stats = identityStats_;
+        stats.entries = identities_.size();
+        return stats;
+    }
 
 protected:
     /**
@@ -234,17 +534,221 @@ protected:
      */
     virtual Wt::Json::Object toJson(const T& entity) = 0;
     
+    /**
+     * @brief Decodes a JSON:API resource's attributes through a field table
+     * @tparam Record Attribute record with a JsonFields table
+     * @param json Resource object from an API response
+     * @param attributes Receives the decoded attributes
+     * @return The resource object (for its "id"), or nullptr if json is not
+     *         a resource with an attributes object
+     */
+    template<typename Record>
+    static const Wt::Json::Object* readResource(const Wt::Json::Value& json, Record& attributes) {
+        if (json.type() != Wt::Json::Type::Object) {
+            return nullptr;
+        }
+        const auto& resource = static_cast<const Wt::Json::Object&>(json);
+        
+        auto it = resource.find("attributes");
+        if (it == resource.end() || it->second.type() != Wt::Json::Type::Object) {
+            return nullptr;
+        }
+        
+        attributes = JsonFields::decode<Record>(static_cast<const Wt::Json::Object&>(it->second));
+        return &resource;
+    }
+    
+    /**
+     * @brief Encodes a JSON:API resource from an attribute record
+     * @param type Resource type
+     * @param id Resource ID, omitted if empty
+     * @param attributes Attribute record with a JsonFields table
+     * @return JSON object in JSON:API format
+     */
+    template<typename Record>
+    static Wt::Json::Object writeResource(const std::string& type, const std::string& id,
+                                          const Record& attributes) {
+        Wt::Json::Object resource;
+        resource["type"] = Wt::Json::Value(type);
+        if (!id.empty()) {
+            resource["id"] = Wt::Json::Value(id);
+        }
+        resource["attributes"] = Wt::Json::Value(JsonFields::encode(attributes));
+        return resource;
+    }
+    
+    /**
+     * @brief Makes a decoded entity canonical
+     *
+     * If the identity map holds the same ID with the same attributes, that
+     * entity is returned and the new one discarded; otherwise the new one
+     * replaces it. Without the identity map the entity is only wrapped.
+     *
+     * @param json Resource object the entity was decoded from
+     * @param entity Decoded entity (may be nullptr)
+     * @return Canonical entity, or nullptr if entity was nullptr
+     */
+    std::shared_ptr<T> intern(const Wt::Json::Value& json, std::unique_ptr<T> entity) {
+        if (!entity) {
+            return nullptr;
+        }
+        std::shared_ptr<T> shared(std::move(entity));
+        
+        std::string id, version;
+        if (!isIdentityMapEnabled() || !identify(json, id, version)) {
+            return shared;
+        }
+        
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        const auto now = std::chrono::steady_clock::now();
+        sweepIdentities(now);
+        
+        Identity& identity = identities_[id];
+        if (identity.entity && identity.version == version) {
+            ++identityStats_.unchanged;
+        } else {
+            identity.entity = std::move(shared);
+            identity.version = std::move(version);
+        }
+        identity.loadedAt = now;
+        identity.fresh = true;
+        return identity.entity;
+    }
+    
+    /**
+     * @brief Drops an ID from the identity map, e.g. after it was deleted
+     */
+    void forget(const std::string& id) {
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        identities_.erase(id);
+    }
+    
+    /**
+     * @brief Decodes every entity of a collection (or single-resource) response
+     * @param response Successful API response
+     * @return Entities, moved out of the response's parse tree
+     */
+    std::vector<T> decodeAll(const APIClient::APIResponse& response) {
+        std::vector<T> entities;
+        
+        if (!response.dataArray.empty()) {
+            entities.reserve(response.dataArray.size());
+            for (const auto& item : response.dataArray) {
+                auto entity = fromJson(item);
+                if (entity) {
+                    entities.push_back(std::move(*entity));
+                }
+            }
+        }
+        // Also check if single data object exists
+        else if (!response.data.empty()) {
+            auto entity = fromJson(response.data);
+            if (entity) {
+                entities.push_back(std::move(*entity));
+            }
+        }
+        
+        return entities;
+    }
+    
+    /**
+     * @brief Works out the query parameters of the page after a response
+     * @param response Response for the current page
+     * @param pageSize Requested page size
+     * @param params Current page's parameters, updated to the next page's
+     * @param paging Query whose page count and previous first ID are updated
+     * @return False if the response was the last page
+     */
+    static bool nextPage(const APIClient::APIResponse& response, int pageSize,
+                         std::map<std::string, std::string>& params, PagedQuery& paging) {
+        if (paging.pagesRequested_ >= APIConfiguration::Defaults::MAX_PAGES) {
+            return false;
+        }
+        
+        if (!response.links.empty()) {
+            auto next = response.links.find("next");
+            if (next == response.links.end() || next->second.type() != Wt::Json::Type::String) {
+                return false;
+            }
+            
+            // Take the page[...] parameters from the link, so offsets and
+            // opaque cursors both work
+            const std::string link = static_cast<std::string>(next->second);
+            std::size_t query = link.find('?');
+            bool advanced = false;
+            while (query != std::string::npos) {
+                std::size_t end = link.find('&', query + 1);
+                std::string pair = link.substr(query + 1, end == std::string::npos ? std::string::npos : end - query - 1);
+                std::size_t equals = pair.find('=');
+                std::string key = APIConfiguration::urlDecode(pair.substr(0, equals));
+                if (key.compare(0, 5, "page[") == 0 && equals != std::string::npos) {
+                    std::string value = APIConfiguration::urlDecode(pair.substr(equals + 1));
+                    if (params[key] != value) {
+                        params[key] = value;
+                        advanced = true;
+                    }
+                }
+                query = end;
+            }
+            // A "next" link that points at the same page would never end
+            if (advanced) {
+                ++paging.pagesRequested_;
+            }
+            return advanced;
+        }
+        
+        // A server that ignores page[limit] sends the whole collection
+        if (static_cast<int>(response.dataArray.size()) != pageSize) {
+            return false;
+        }
+        paging.previousFirstId_ = resourceId(response.dataArray.front());
+        
+        params["page[offset]"] = std::to_string(std::stoll(params["page[offset]"]) + pageSize);
+        ++paging.pagesRequested_;
+        return true;
+    }
+    
+    /**
+     * @brief Checks if a page without links starts where the previous one did
+     */
+    static bool repeatsPreviousPage(const APIClient::APIResponse& response, const PagedQuery& paging) {
+        if (!response.links.empty() || paging.previousFirstId_.empty() || response.dataArray.empty()) {
+            return false;
+        }
+        return resourceId(response.dataArray.front()) == paging.previousFirstId_;
+    }
+    
+    /**
+     * @brief Reads a resource's "id" as a string
+     * @return The ID, or an empty string if json has none
+     */
+    static std::string resourceId(const Wt::Json::Value& json) {
+        if (json.type() != Wt::Json::Type::Object) {
+            return std::string();
+        }
+        const auto& resource = static_cast<const Wt::Json::Object&>(json);
+        auto idIt = resource.find("id");
+        if (idIt == resource.end()) {
+            return std::string();
+        }
+        if (idIt->second.type() == Wt::Json::Type::String) {
+            return static_cast<std::string>(idIt->second);
+        }
+        if (idIt->second.type() == Wt::Json::Type::Number) {
+            return std::to_string(static_cast<long long>(idIt->second));
+        }
+        return std::string();
+    }
+    
     /**
      * @brief Helper method to safely get JSON object value
      * @param obj JSON object
      * @param key Key to look for
-     * @return JSON value or null value if not found
+     * @return Reference into obj, or to the null value if not found
      */
-    Wt::Json::Value safeGetValue(const Wt::Json::Object& obj, const std::string& key) const {
-        if (obj.contains(key)) {
-            return obj.get(key);
-        }
-        return Wt::Json::Value();
+    const Wt::Json::Value& safeGetValue(const Wt::Json::Object& obj, const std::string& key) const {
+        auto it = obj.find(key);
+        return it != obj.end() ? it->second : Wt::Json::Value::Null;
     }
     
     /**
@@ -256,7 +760,7 @@ protected:
      */
     std::string safeGetString(const Wt::Json::Object& obj, const std::string& key, 
                              const std::string& defaultValue = "") const {
-        auto value = safeGetValue(obj, key);
+        const auto& value = safeGetValue(obj, key);
         if (value.type() == Wt::Json::Type::String) {
             return static_cast<std::string>(value);
         }
@@ -265,6 +769,9 @@ protected:
     
     /**
      * @brief Helper method to safely get integer from JSON object
+     *
+     * Integer strings are accepted too: JSON:API resource ids are strings.
+     *
      * @param obj JSON object
      * @param key Key to look for
      * @param defaultValue Default value if key not found
@@ -272,10 +779,18 @@ protected:
      */
     int safeGetInt(const Wt::Json::Object& obj, const std::string& key, 
                    int defaultValue = 0) const {
-        auto value = safeGetValue(obj, key);
+        const auto& value = safeGetValue(obj, key);
         if (value.type() == Wt::Json::Type::Number) {
             return static_cast<int>(value);
         }
+        if (value.type() == Wt::Json::Type::String) {
+            const std::string text = value;
+            int parsed = 0;
+            auto result = std::from_chars(text.data(), text.data() + text.size(), parsed);
+            if (result.ec == std::errc() && result.ptr == text.data() + text.size() && !text.empty()) {
+                return parsed;
+            }
+        }
         return defaultValue;
     }
     
@@ -288,7 +803,7 @@ protected:
      */
     double safeGetDouble(const Wt::Json::Object& obj, const std::string& key, 
                         double defaultValue = 0.0) const {
-        auto value = safeGetValue(obj, key);
+        const auto& value = safeGetValue(obj, key);
         if (value.type() == Wt::Json::Type::Number) {
             return static_cast<double>(value);
         }
@@ -304,7 +819,7 @@ protected:
      */
     bool safeGetBool(const Wt::Json::Object& obj, const std::string& key, 
                      bool defaultValue = false) const {
-        auto value = safeGetValue(obj, key);
+        const auto& value = safeGetValue(obj, key);
         if (value.type() == Wt::Json::Type::Bool) {
             return static_cast<bool>(value);
         }
@@ -312,8 +827,149 @@ protected:
     }
 
 private:
+    struct Identity {
+        std::shared_ptr<T> entity;
+        std::string version;        ///< See identify()
+        std::chrono::steady_clock::time_point loadedAt;
+        bool fresh = false;         ///< False once invalidated
+    };
+    
+    /**
+     * @brief Reads a resource's ID and a version string of its attributes
+     *
+     * The version is the server's own when it sends one: meta.etag, else
+     * updated_at with the number of attributes (a sparse read of the same
+     * row is another version). Only resources with neither are serialized.
+     */
+    static bool identify(const Wt::Json::Value& json, std::string& id, std::string& version) {
+        if (json.type() != Wt::Json::Type::Object) {
+            return false;
+        }
+        const auto& resource = static_cast<const Wt::Json::Object&>(json);
+        auto idIt = resource.find("id");
+        auto attributes = resource.find("attributes");
+        if (idIt == resource.end() || attributes == resource.end() ||
+            attributes->second.type() != Wt::Json::Type::Object) {
+            return false;
+        }
+        
+        if (idIt->second.type() == Wt::Json::Type::String) {
+            id = static_cast<std::string>(idIt->second);
+        } else if (idIt->second.type() == Wt::Json::Type::Number) {
+            id = std::to_string(static_cast<long long>(idIt->second));
+        } else {
+            return false;
+        }
+        
+        const auto& values = static_cast<const Wt::Json::Object&>(attributes->second);
+        auto meta = resource.find("meta");
+        if (meta != resource.end() && meta->second.type() == Wt::Json::Type::Object) {
+            const Wt::Json::Value& etag = static_cast<const Wt::Json::Object&>(meta->second).get("etag");
+            if (etag.type() == Wt::Json::Type::String) {
+                version = "etag:" + static_cast<std::string>(etag);
+                return true;
+            }
+        }
+        const Wt::Json::Value& updatedAt = values.get("updated_at");
+        if (updatedAt.type() == Wt::Json::Type::String) {
+            version = "updated_at:" + static_cast<std::string>(updatedAt) + "/" + std::to_string(values.size());
+            return true;
+        }
+        version = Wt::Json::serialize(values, 0);
+        return true;
+    }
+    
+    /**
+     * @brief Returns the entity for an ID if it is fresh, counting the lookup
+     */
+    std::shared_ptr<T> lookup(const std::string& id) {
+        std::lock_guard<std::mutex> lock(identityMutex_);
+        if (!identityMapEnabled_) {
+            return nullptr;
+        }
+        
+        auto it = identities_.find(id);
+        if (it != identities_.end() && it->second.fresh &&
+            std::chrono::steady_clock::now() - it->second.loadedAt < identityTtl_) {
+            ++identityStats_.hits;
+            return it->second.entity;
+        }
+        ++identityStats_.misses;
+        return nullptr;
+    }
+    
+    /**
+     * @brief Puts a copy of a written entity in the identity map
+     */
+    void remember(const Wt::Json::Value& json, const std::unique_ptr<T>& entity) {
+        if (entity && isIdentityMapEnabled()) {
+            intern(json, std::make_unique<T>(*entity));
+        }
+    }
+    
+    /**
+     * @brief Drops entries past their TTL that nobody else holds, at most
+     *        once per TTL; identityMutex_ is held
+     *
+     * Entities still held outside the map stay, so they keep their
+     * identity for as long as they are in use.
+     */
+    void sweepIdentities(std::chrono::steady_clock::time_point now) {
+        if (now - lastSweep_ < identityTtl_) {
+            return;
+        }
+        lastSweep_ = now;
+        for (auto it = identities_.begin(); it != identities_.end();) {
+            const bool unused = it->second.entity.use_count() == 1 && now - it->second.loadedAt >= identityTtl_;
+            it = unused ? identities_.erase(it) : std::next(it);
+        }
+    }
+    
+    void requestPage(std::shared_ptr<PagedQuery> query, std::map<std::string, std::string> params, int pageSize,
+                     std::shared_ptr<const PageCallback> onPage, std::shared_ptr<const PagingDoneCallback> onDone) {
+        client_->get(endpoint_, params,
+            [this, query, params, pageSize, onPage, onDone](const APIClient::APIResponse& response) mutable {
+                if (query->isCancelled()) {
+                    return;
+                }
+                if (!response.success) {
+                    if (*onDone) (*onDone)(false);
+                    return;
+                }
+                
+                // A server that ignores page[offset] sends the previous page
+                // again, which was delivered already
+                if (repeatsPreviousPage(response, *query)) {
+                    if (*onDone) (*onDone)(true);
+                    return;
+                }
+                
+                // Prefetch: the next page is on its way while this one is
+                // decoded and handed over
+                bool more = nextPage(response, pageSize, params, *query);
+                if (more) {
+                    requestPage(query, std::move(params), pageSize, onPage, onDone);
+                }
+                
+                std::vector<T> page = decodeAll(response);
+                ++query->pagesDelivered_;
+                if (*onPage) (*onPage)(std::move(page));
+                
+                if (!more && !query->isCancelled() && *onDone) {
+                    (*onDone)(true);
+                }
+            });
+    }
+    
     std::shared_ptr<APIClient> client_;
     std::string endpoint_;
+    
+    mutable std::mutex identityMutex_;
+    bool identityMapEnabled_ = false;
+    std::chrono::seconds identityTtl_{APIConfiguration::Defaults::IDENTITY_MAP_TTL_SECONDS};
+    std::map<std::string, Identity> identities_;
+    std::chrono::steady_clock::time_point lastSweep_;
+    IdentityMapStats identityStats_;
 };
 
 #endif // APIREPOSITORY_H
@@ -82,8 +82,23 @@ public:
         config.apiBaseUrl = configManager->getValue<std::string>("api.base_url", "http://localhost:5656/api");
         config.authToken = configManager->getValue<std::string>("api.auth_token", "");
         config.apiTimeout = configManager->getValue<int>("api.timeout", 30);
+        config.maxRetries = configManager->getValue<int>("api.max_retries", APIConfiguration::Defaults::MAX_RETRIES);
+        config.retryDelayMs = configManager->getValue<int>("api.retry_delay_ms", APIConfiguration::Defaults::RETRY_DELAY_MS);
+        config.coalesceWindowMs = configManager->getValue<int>("api.coalesce_window_ms", APIConfiguration::Defaults::COALESCE_WINDOW_MS);
         config.enableCaching = configManager->getValue<bool>("api.enable_caching", true);
         config.debugMode = configManager->getValue<bool>("api.debug_mode", false);
+        config.enableOutbox = configManager->getValue<bool>("api.outbox_enabled", APIConfiguration::Defaults::ENABLE_OUTBOX);
+        config.outboxPath = configManager->getValue<std::string>("api.outbox_path", APIConfiguration::Defaults::DEFAULT_OUTBOX_PATH);
+        config.outboxBatchSize = configManager->getValue<int>("api.outbox_batch_size", APIConfiguration::Defaults::OUTBOX_BATCH_SIZE);
+        config.outboxRetryMs = configManager->getValue<int>("api.outbox_retry_ms", APIConfiguration::Defaults::OUTBOX_RETRY_MS);
+        config.enableAtomicOperations = configManager->getValue<bool>("api.atomic_operations", APIConfiguration::Defaults::ENABLE_ATOMIC_OPERATIONS);
+        config.enableCompression = configManager->getValue<bool>("api.compression", APIConfiguration::Defaults::ENABLE_COMPRESSION);
+        config.compressRequestsAbove = configManager->getValue<int>("api.compress_requests_above", APIConfiguration::Defaults::COMPRESS_REQUESTS_ABOVE);
+        config.enableSparseFieldsets = configManager->getValue<bool>("api.sparse_fieldsets", APIConfiguration::Defaults::ENABLE_SPARSE_FIELDSETS);
+        config.enableDeltaSync = configManager->getValue<bool>("api.delta_sync", APIConfiguration::Defaults::ENABLE_DELTA_SYNC);
+        config.orderFullSyncSeconds = configManager->getValue<int>("api.order_full_sync_seconds", APIConfiguration::Defaults::ORDER_FULL_SYNC_SECONDS);
+        config.enableIdentityMap = configManager->getValue<bool>("api.identity_map", APIConfiguration::Defaults::ENABLE_IDENTITY_MAP);
+        config.identityMapTtlSeconds = configManager->getValue<int>("api.identity_map_ttl_seconds", APIConfiguration::Defaults::IDENTITY_MAP_TTL_SECONDS);
         
         try {
             auto service = std::make_shared<EnhancedPOSService>(eventManager, config);
@@ -0,0 +1,275 @@
+//============================================================================
+// include/api/AsyncResult.hpp - Composable Results of Asynchronous API Calls
+//============================================================================
+
+#ifndef ASYNCRESULT_H
+#define ASYNCRESULT_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<typename T>
+class AsyncResult;
+
+namespace AsyncResultDetail {
+    template<typename R>
+    struct IsAsyncResult : std::false_type {};
+
+    template<typename U>
+    struct IsAsyncResult<AsyncResult<U>> : std::true_type {};
+}
+
+/**
+ * @class AsyncResult
+ * @brief A value and a success flag that an asynchronous call delivers later
+ *
+ * Replaces nested callbacks with a flat chain:
+ *
+ *     orderRepository->findSharedAsync(id)
+ *         .then([client](std::shared_ptr<Order> order, bool success) {
+ *             return client->putAsync("/Order/" + ..., ...);
+ *         })
+ *         .then(guard, [this](APIClient::SharedResponse response, bool success) { ... });
+ *
+ * A continuation receives (value, success), the same arguments as the
+ * callbacks of APIClient and the repositories, and returns either nothing
+ * or the next AsyncResult. It runs on the thread that settles the result.
+ * For API calls made inside a Wt session, that is the session itself:
+ * APIClient posts responses to it with WServer::post. A result that has
+ * already settled runs its continuation at once.
+ *
+ * Each result takes one continuation; the value is moved into it. Use
+ * whenAll() to wait for several results at once. Thread-safe.
+ *
+ * @tparam T Value type; must be default-constructible and movable
+ */
+template<typename T>
+class AsyncResult {
+public:
+    /**
+     * @brief Callback that settles a result
+     */
+    using Resolver = std::function<void(T value, bool success)>;
+
+    AsyncResult() : state_(std::make_shared<State>()) {}
+
+    /**
+     * @brief Creates a result that has already settled
+     */
+    static AsyncResult ready(T value, bool success = true) {
+        AsyncResult result;
+        result.state_->settle(std::move(value), success);
+        return result;
+    }
+
+    /**
+     * @brief Starts a callback-style call and returns its result
+     * @param start Called with the Resolver to pass as the call's callback
+     */
+    template<typename Start>
+    static AsyncResult from(Start&& start) {
+        AsyncResult result;
+        start(result.resolver());
+        return result;
+    }
+
+    /**
+     * @brief Gets a callback that settles this result (only the first call counts)
+     */
+    Resolver resolver() const {
+        std::shared_ptr<State> state = state_;
+        return [state](T value, bool success) { state->settle(std::move(value), success); };
+    }
+
+    /**
+     * @brief Adds the continuation
+     * @param continuation Callable (T value, bool success) returning void or
+     *        an AsyncResult
+     * @return Nothing, or an AsyncResult settled with the one the
+     *         continuation returns
+     */
+    template<typename F>
+    auto then(F continuation) const {
+        using Next = std::invoke_result_t<F, T, bool>;
+        static_assert(std::is_void_v<Next> || AsyncResultDetail::IsAsyncResult<Next>::value,
+                      "A continuation returns void or an AsyncResult");
+
+        if constexpr (std::is_void_v<Next>) {
+            state_->onSettled(std::move(continuation));
+        } else {
+            Next next;
+            auto settleNext = next.resolver();
+            state_->onSettled([continuation = std::move(continuation), settleNext](T value, bool success) mutable {
+                continuation(std::move(value), success).then(settleNext);
+            });
+            return next;
+        }
+    }
+
+    /**
+     * @brief Adds a continuation that is skipped once guard has expired
+     *
+     * Use the owner's lifetime token as guard instead of capturing a raw
+     * this that may be gone when the result settles. A skipped continuation
+     * that returns an AsyncResult settles it with failure.
+     *
+     * @param guard Lifetime token of the object the continuation uses
+     * @param continuation As for then(continuation)
+     */
+    template<typename F>
+    auto then(std::weak_ptr<const void> guard, F continuation) const {
+        using Next = std::invoke_result_t<F, T, bool>;
+        return then([guard = std::move(guard), continuation = std::move(continuation)](T value, bool success) mutable {
+            auto owner = guard.lock();
+            if constexpr (std::is_void_v<Next>) {
+                if (owner) {
+                    continuation(std::move(value), success);
+                }
+            } else {
+                return owner ? continuation(std::move(value), success)
+                             : Next::ready(typename Next::ValueType{}, false);
+            }
+        });
+    }
+
+    bool isSettled() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->settled;
+    }
+
+    using ValueType = T;
+
+private:
+    struct State {
+        std::mutex mutex;
+        bool settled = false;
+        bool success = false;
+        std::optional<T> value;
+        Resolver continuation;
+
+        void settle(T result, bool succeeded) {
+            Resolver next;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (settled) {
+                    return;
+                }
+                settled = true;
+                success = succeeded;
+                if (!continuation) {
+                    value.emplace(std::move(result));
+                    return;
+                }
+                next = std::move(continuation);
+            }
+            next(std::move(result), succeeded);
+        }
+
+        void onSettled(Resolver next) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!settled) {
+                    continuation = std::move(next);
+                    return;
+                }
+            }
+            T result = std::move(*value);
+            value.reset();
+            next(std::move(result), success);
+        }
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+namespace AsyncResultDetail {
+    template<typename Tuple>
+    struct Join {
+        std::mutex mutex;
+        Tuple values;
+        std::size_t remaining = 0;
+        bool success = true;
+        typename AsyncResult<Tuple>::Resolver settle;
+
+        /**
+         * @brief Records one settled input; the last one settles the join
+         */
+        template<typename Store>
+        void arrive(bool succeeded, Store&& store) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                store(values);
+                success = success && succeeded;
+                if (--remaining > 0) {
+                    return;
+                }
+            }
+            settle(std::move(values), success);
+        }
+    };
+
+    template<typename... Ts, std::size_t... Is>
+    AsyncResult<std::tuple<Ts...>> whenAll(std::index_sequence<Is...>, const AsyncResult<Ts>&... results) {
+        AsyncResult<std::tuple<Ts...>> all;
+        auto join = std::make_shared<Join<std::tuple<Ts...>>>();
+        join->remaining = sizeof...(Ts);
+        join->settle = all.resolver();
+
+        (results.then([join](Ts value, bool success) {
+            join->arrive(success, [&value](std::tuple<Ts...>& values) { std::get<Is>(values) = std::move(value); });
+        }), ...);
+        return all;
+    }
+}
+
+/**
+ * @brief Waits for several results that run concurrently
+ *
+ * The calls behind the results are all in flight already; whenAll() only
+ * joins them. The joined result succeeds if every input succeeded.
+ *
+ *     whenAll(menuItemRepository->findAllSharedAsync({}),
+ *             orderRepository->syncActiveAsync())
+ *         .then([](std::tuple<std::vector<std::shared_ptr<MenuItem>>,
+ *                             std::vector<std::shared_ptr<Order>>> loaded, bool success) { ... });
+ *
+ * @return Result with every value, in argument order
+ */
+template<typename... Ts>
+AsyncResult<std::tuple<Ts...>> whenAll(const AsyncResult<Ts>&... results) {
+    static_assert(sizeof...(Ts) > 0, "whenAll() needs at least one result");
+    return AsyncResultDetail::whenAll(std::index_sequence_for<Ts...>(), results...);
+}
+
+/**
+ * @brief Waits for any number of results of one type
+ * @return Result with every value, in input order (settled at once if empty)
+ */
+template<typename T>
+AsyncResult<std::vector<T>> whenAll(const std::vector<AsyncResult<T>>& results) {
+    if (results.empty()) {
+        return AsyncResult<std::vector<T>>::ready({}, true);
+    }
+
+    AsyncResult<std::vector<T>> all;
+    auto join = std::make_shared<AsyncResultDetail::Join<std::vector<T>>>();
+    join->values.resize(results.size());
+    join->remaining = results.size();
+    join->settle = all.resolver();
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        results[i].then([join, i](T value, bool success) {
+            join->arrive(success, [&value, i](std::vector<T>& values) { values[i] = std::move(value); });
+        });
+    }
+    return all;
+}
+
+#endif // ASYNCRESULT_H
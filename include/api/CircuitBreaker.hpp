@@ -0,0 +1,115 @@
+//============================================================================
+// include/api/CircuitBreaker.hpp - Per-Endpoint Circuit Breaker
+//============================================================================
+
+#ifndef CIRCUITBREAKER_H
+#define CIRCUITBREAKER_H
+
+#include "../utils/Logging.hpp"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * @class CircuitBreaker
+ * @brief Process-wide record of which middleware endpoints are failing
+ *
+ * Each circuit (one per API resource, e.g. "http://host:5656/api/Order")
+ * is CLOSED while requests succeed. After a run of consecutive outage
+ * failures (no response or a 5xx) it OPENs, and requests to it fail at once
+ * instead of waiting for the timeout. Once the open period has passed the
+ * circuit is HALF_OPEN: one probe request goes through, and its outcome
+ * closes the circuit or opens it again.
+ *
+ * Shared by all sessions, so one session discovering an outage spares the
+ * others. Thread-safe.
+ */
+class CircuitBreaker {
+public:
+    enum class State {
+        CLOSED,
+        OPEN,
+        HALF_OPEN
+    };
+
+    /**
+     * @struct Settings
+     * @brief When circuits open and for how long
+     */
+    struct Settings {
+        int failureThreshold;                   ///< Consecutive failures that open a circuit
+        std::chrono::milliseconds openDuration; ///< Time before a probe is let through
+
+        Settings();
+    };
+
+    /**
+     * @brief Gets the process-wide circuit breaker
+     */
+    static CircuitBreaker& getInstance();
+
+    // Prevent copying
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+    /**
+     * @brief Asks to send a request on a circuit
+     *
+     * An open circuit whose open period has passed turns half-open and lets
+     * this caller through as the probe.
+     *
+     * @param circuit Circuit name
+     * @return False if the request must fail fast
+     */
+    bool tryAcquire(const std::string& circuit);
+
+    /**
+     * @brief Records the outcome of a request let through by tryAcquire()
+     * @param circuit Circuit name
+     * @param success False for an outage (no response or a 5xx status)
+     */
+    void recordResult(const std::string& circuit, bool success);
+
+    /**
+     * @brief Whether requests on a circuit would currently fail fast
+     */
+    bool isOpen(const std::string& circuit) const;
+
+    /**
+     * @brief Whether any circuit whose name starts with prefix would fail fast
+     */
+    bool isAnyOpen(const std::string& prefix) const;
+
+    State getState(const std::string& circuit) const;
+
+    void setSettings(const Settings& settings);
+    Settings getSettings() const;
+
+    /**
+     * @brief Closes all circuits
+     */
+    void reset();
+
+    static std::string stateToString(State state);
+
+private:
+    struct Circuit {
+        State state = State::CLOSED;
+        int consecutiveFailures = 0;
+        bool probeInFlight = false;
+        std::chrono::steady_clock::time_point openedAt;
+    };
+
+    CircuitBreaker();
+
+    bool failsFast(const Circuit& circuit, std::chrono::steady_clock::time_point now) const;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Circuit> circuits_;
+    Settings settings_;
+    LogComponent& logger_;
+};
+
+#endif // CIRCUITBREAKER_H
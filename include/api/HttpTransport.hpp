@@ -0,0 +1,148 @@
+//============================================================================
+// include/api/HttpTransport.hpp - Pooled Asynchronous HTTP/1.1 Transport
+//============================================================================
+
+#ifndef HTTPTRANSPORT_H
+#define HTTPTRANSPORT_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class HttpTransport
+ * @brief Process-wide non-blocking HTTP client with keep-alive pooling
+ *
+ * All sessions share one transport thread. Connections are kept alive and
+ * pooled per scheme/host/port, the number of requests in flight is capped
+ * (further requests wait in FIFO order), and every request carries its own
+ * timeout, which also covers time spent waiting for a free slot.
+ *
+ * A request with acceptCompressed set asks for a gzip or deflate body, and
+ * the response body is decoded before the completion runs. Request bodies
+ * above compressBodyAbove are sent gzipped, for servers that accept
+ * Content-Encoding on requests. Both need a build with zlib; without it,
+ * bodies travel uncompressed.
+ *
+ * Completions run on the transport thread and must not block; APIClient
+ * forwards them to the owning Wt session.
+ */
+class HttpTransport {
+public:
+    /**
+     * @struct Request
+     * @brief One HTTP request
+     */
+    struct Request {
+        std::string method;                                       ///< "GET", "POST", ...
+        std::string url;                                          ///< http[s]://host[:port]/path?query
+        std::vector<std::pair<std::string, std::string>> headers; ///< Extra request headers
+        std::string body;                                         ///< Request body (may be empty)
+        std::chrono::milliseconds timeout{std::chrono::seconds(30)}; ///< Total time allowed
+        bool acceptCompressed = false;                            ///< Ask for a gzip/deflate body (needs zlib)
+        std::size_t compressBodyAbove = 0;                        ///< Gzip larger bodies; 0 never (needs zlib)
+    };
+
+    /**
+     * @struct Response
+     * @brief Result of a request
+     */
+    struct Response {
+        int statusCode = 0;                           ///< 0 if no response was received
+        std::map<std::string, std::string> headers;   ///< Header names in lower case
+        std::string body;                             ///< Decoded if it came gzip/deflate encoded
+        std::string error;                            ///< Transport error, empty on success
+        bool requestSent = false;                     ///< False if the server cannot have seen the request
+
+        /**
+         * @brief Gets a header value
+         * @param lowerCaseName Header name in lower case
+         * @return Header value, or an empty string if absent
+         */
+        std::string header(const std::string& lowerCaseName) const;
+    };
+
+    using Completion = std::function<void(Response)>;
+
+    /**
+     * @struct Limits
+     * @brief Pool and concurrency limits
+     */
+    struct Limits {
+        std::size_t maxInFlight = 32;                         ///< Requests on the wire at once
+        std::size_t maxIdlePerHost = 8;                       ///< Idle keep-alive connections kept per host
+        std::chrono::seconds idleTimeout{std::chrono::seconds(4)}; ///< Close idle connections after this
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters for monitoring
+     */
+    struct Stats {
+        std::uint64_t requests = 0;
+        std::uint64_t connectionsOpened = 0;
+        std::uint64_t connectionsReused = 0;
+        std::uint64_t timeouts = 0;
+        std::size_t inFlight = 0;
+        std::size_t queued = 0;
+        std::uint64_t bodyBytesReceived = 0;      ///< Response bodies as sent on the wire
+        std::uint64_t bodyBytesDecoded = 0;       ///< The same bodies after decoding
+    };
+
+    /**
+     * @brief Gets the process-wide transport (starts its thread on first use)
+     */
+    static HttpTransport& getInstance();
+
+    // Prevent copying
+    HttpTransport(const HttpTransport&) = delete;
+    HttpTransport& operator=(const HttpTransport&) = delete;
+
+    /**
+     * @brief Sends a request without blocking
+     * @param request Request to send
+     * @param completion Called exactly once on the transport thread
+     */
+    void send(Request request, Completion completion);
+
+    /**
+     * @brief Runs a task on the transport thread after a delay
+     *
+     * Used to space out retries without holding a thread.
+     */
+    void schedule(std::chrono::milliseconds delay, std::function<void()> task);
+
+    /**
+     * @brief Replaces the pool and concurrency limits
+     */
+    void setLimits(const Limits& limits);
+
+    Stats getStats() const;
+
+    /**
+     * @brief Whether https:// URLs are supported (built with OpenSSL)
+     */
+    static bool isTlsAvailable();
+
+    /**
+     * @brief Whether bodies can be gzip/deflate encoded (built with zlib)
+     */
+    static bool isCompressionAvailable();
+
+private:
+    class Exchange;
+    struct Impl;
+
+    HttpTransport();
+    ~HttpTransport();
+
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif // HTTPTRANSPORT_H
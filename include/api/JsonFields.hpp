@@ -0,0 +1,186 @@
+//============================================================================
+// include/api/JsonFields.hpp - Compile-Time JSON Attribute Field Tables
+//============================================================================
+
+#ifndef JSONFIELDS_H
+#define JSONFIELDS_H
+
+#include <Wt/Json/Object.h>
+#include <Wt/Json/Array.h>
+#include <Wt/Json/Value.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace JsonFields
+ * @brief Declarative mapping between JSON attributes and record members
+ *
+ * A record is a plain struct holding one entity's attributes, with member
+ * initializers as the defaults for missing attributes. It declares its
+ * mapping once, as a constexpr table:
+ *
+ * @code
+ * struct Attributes {
+ *     std::string name;
+ *     bool available = true;
+ *
+ *     static constexpr auto fields() {
+ *         return std::make_tuple(
+ *             JsonFields::field("name", &Attributes::name),
+ *             JsonFields::field("available", &Attributes::available));
+ *     }
+ * };
+ * @endcode
+ *
+ * decode() walks a JSON object once and stores each attribute it knows
+ * into its member; attributes of the wrong type keep the default, as the
+ * safeGet* helpers did. encode() writes the same table back, so both
+ * directions always cover the same attributes. Supported member types are
+ * std::string, int, double, bool and std::vector of another record.
+ */
+namespace JsonFields {
+
+    /**
+     * @struct Field
+     * @brief One attribute name bound to a record member
+     */
+    template<typename Record, typename T>
+    struct Field {
+        std::string_view name;
+        T Record::*member;
+        bool omitEmpty;     ///< Not written when the member is empty
+    };
+
+    template<typename Record, typename T>
+    constexpr Field<Record, T> field(std::string_view name, T Record::*member, bool omitEmpty = false) {
+        return Field<Record, T>{name, member, omitEmpty};
+    }
+
+    template<typename Record>
+    Record decode(const Wt::Json::Object& json);
+
+    template<typename Record>
+    Wt::Json::Object encode(const Record& record);
+
+    namespace detail {
+
+        inline void read(const Wt::Json::Value& value, std::string& out) {
+            if (value.type() == Wt::Json::Type::String) {
+                out = static_cast<std::string>(value);
+            }
+        }
+
+        inline void read(const Wt::Json::Value& value, int& out) {
+            if (value.type() == Wt::Json::Type::Number) {
+                out = static_cast<int>(value);
+            }
+        }
+
+        inline void read(const Wt::Json::Value& value, double& out) {
+            if (value.type() == Wt::Json::Type::Number) {
+                out = static_cast<double>(value);
+            }
+        }
+
+        inline void read(const Wt::Json::Value& value, bool& out) {
+            if (value.type() == Wt::Json::Type::Bool) {
+                out = static_cast<bool>(value);
+            }
+        }
+
+        template<typename Record>
+        void read(const Wt::Json::Value& value, std::vector<Record>& out) {
+            if (value.type() != Wt::Json::Type::Array) {
+                return;
+            }
+            const auto& array = static_cast<const Wt::Json::Array&>(value);
+            out.reserve(array.size());
+            for (const auto& element : array) {
+                if (element.type() == Wt::Json::Type::Object) {
+                    out.push_back(decode<Record>(static_cast<const Wt::Json::Object&>(element)));
+                }
+            }
+        }
+
+        inline Wt::Json::Value write(const std::string& value) { return Wt::Json::Value(value); }
+        inline Wt::Json::Value write(int value) { return Wt::Json::Value(value); }
+        inline Wt::Json::Value write(double value) { return Wt::Json::Value(value); }
+        inline Wt::Json::Value write(bool value) { return Wt::Json::Value(value); }
+
+        template<typename Record>
+        Wt::Json::Value write(const std::vector<Record>& records) {
+            Wt::Json::Array array;
+            array.reserve(records.size());
+            for (const auto& record : records) {
+                array.push_back(Wt::Json::Value(encode(record)));
+            }
+            return Wt::Json::Value(std::move(array));
+        }
+
+        template<typename T>
+        bool isEmpty(const T&) { return false; }
+        inline bool isEmpty(const std::string& value) { return value.empty(); }
+        template<typename Record>
+        bool isEmpty(const std::vector<Record>& value) { return value.empty(); }
+
+        // Stores value into the first field named key; false if none is
+        template<typename Record, typename Fields, std::size_t... I>
+        bool readField(Record& record, const Fields& fields, const std::string& key,
+                       const Wt::Json::Value& value, std::index_sequence<I...>) {
+            return ((std::get<I>(fields).name == key
+                     && (read(value, record.*(std::get<I>(fields).member)), true)) || ...);
+        }
+
+        template<typename Record, typename T>
+        void writeField(const Record& record, const Field<Record, T>& field, Wt::Json::Object& json) {
+            const T& value = record.*(field.member);
+            if (!field.omitEmpty || !isEmpty(value)) {
+                json[std::string(field.name)] = write(value);
+            }
+        }
+
+        template<typename Record, typename Fields, std::size_t... I>
+        void writeFields(const Record& record, const Fields& fields, Wt::Json::Object& json,
+                         std::index_sequence<I...>) {
+            (writeField(record, std::get<I>(fields), json), ...);
+        }
+    }
+
+    /**
+     * @brief Decodes a JSON object into a record in one pass over its keys
+     * @tparam Record Record type with a static constexpr fields() table
+     * @param json JSON object (e.g. a JSON:API "attributes" member)
+     * @return Record with every known attribute set, defaults elsewhere
+     */
+    template<typename Record>
+    Record decode(const Wt::Json::Object& json) {
+        constexpr auto fields = Record::fields();
+        constexpr auto indices = std::make_index_sequence<std::tuple_size<decltype(fields)>::value>();
+
+        Record record;
+        for (const auto& attribute : json) {
+            detail::readField(record, fields, attribute.first, attribute.second, indices);
+        }
+        return record;
+    }
+
+    /**
+     * @brief Encodes a record as a JSON object using its field table
+     */
+    template<typename Record>
+    Wt::Json::Object encode(const Record& record) {
+        constexpr auto fields = Record::fields();
+
+        Wt::Json::Object json;
+        detail::writeFields(record, fields, json,
+                            std::make_index_sequence<std::tuple_size<decltype(fields)>::value>());
+        return json;
+    }
+}
+
+#endif // JSONFIELDS_H
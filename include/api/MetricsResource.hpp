@@ -0,0 +1,38 @@
+//============================================================================
+// include/api/MetricsResource.hpp - Prometheus Scrape Endpoint
+//============================================================================
+
+#ifndef METRICSRESOURCE_H
+#define METRICSRESOURCE_H
+
+#include <Wt/Http/Request.h>
+#include <Wt/Http/Response.h>
+#include <Wt/WResource.h>
+
+#include <ostream>
+
+/**
+ * @class MetricsResource
+ * @brief Serves the process metrics in Prometheus text format
+ *
+ * Mounted by main() at /metrics. A scrape reports APIMetrics (per route and
+ * method) together with the counters of HttpTransport, ResponseCache,
+ * RequestCoalescer and MutationOutbox and a few process_* metrics.
+ * APIMetrics is read from atomics; the other components are read with
+ * their getStats(), one short copy each. Nothing here runs in a session.
+ */
+class MetricsResource : public Wt::WResource {
+public:
+    MetricsResource();
+    ~MetricsResource() override;
+
+    /**
+     * @brief Writes every metric in Prometheus text format (version 0.0.4)
+     */
+    static void render(std::ostream& out);
+
+protected:
+    void handleRequest(const Wt::Http::Request& request, Wt::Http::Response& response) override;
+};
+
+#endif // METRICSRESOURCE_H
@@ -0,0 +1,255 @@
+//============================================================================
+// include/api/MutationOutbox.hpp - Durable Write-Behind Queue for API Writes
+//============================================================================
+
+#ifndef MUTATIONOUTBOX_H
+#define MUTATIONOUTBOX_H
+
+#include "APIClient.hpp"
+#include "../utils/Logging.hpp"
+
+#include <Wt/Json/Object.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class MutationOutbox
+ * @brief Process-wide queue of API writes, kept in a local journal
+ *
+ * enqueue() appends a write to an append-only journal file and returns; the
+ * caller does not wait for the middleware. A background worker sends queued
+ * writes in batches, each with an Idempotency-Key that stays the same across
+ * retries and restarts, so a write is applied at most once.
+ *
+ * Writes with the same group (e.g. "Order/1001") are sent one at a time in
+ * the order they were queued; a batch holds at most one write per group.
+ * A batch goes out through APIClient::batch(), so it costs one round trip
+ * if the middleware supports atomic operations.
+ * Consecutive PUTs of a group to the same endpoint replace each other, so
+ * only the newest of them is sent.
+ * Every write is sent with the auth token it was queued with, so sessions
+ * sharing the outbox never send each other's writes with their own
+ * credentials; a batch only holds writes with the same token. Tokens are
+ * kept in memory only: the journal names them, and writes left by an
+ * earlier run are sent with Settings::authToken.
+ * If the middleware cannot be reached, the writes stay queued and the worker
+ * tries again later. A write the middleware rejects (a 4xx other than
+ * 401/403/408/424/429) is dropped and reported to the conflict listeners;
+ * the rest of its atomic batch is sent again at once.
+ *
+ * Journal records are flushed to the operating system by enqueue(), so they
+ * survive a crash of the process. The worker syncs the file to disk before
+ * each batch. Thread-safe.
+ */
+class MutationOutbox {
+public:
+    /**
+     * @struct Mutation
+     * @brief One queued write
+     */
+    struct Mutation {
+        std::uint64_t sequence = 0;     ///< Position in the journal
+        std::string idempotencyKey;     ///< Sent as Idempotency-Key
+        std::string method;             ///< "POST", "PUT", "PATCH" or "DELETE"
+        std::string endpoint;           ///< e.g. "/Order/1001"
+        std::string group;              ///< Writes of one group keep their order
+        std::string body;               ///< Serialized JSON body
+        std::string credential;         ///< Names the token it is sent with (empty: Settings::authToken)
+    };
+
+    /**
+     * @struct Conflict
+     * @brief A queued write the middleware rejected
+     */
+    struct Conflict {
+        Mutation mutation;
+        int statusCode = 0;
+        std::string message;
+    };
+
+    /**
+     * @brief Called on the worker's thread for every rejected write
+     */
+    using ConflictListener = std::function<void(const Conflict&)>;
+
+    /**
+     * @struct Settings
+     * @brief Where the journal lives and how it is drained
+     */
+    struct Settings {
+        std::string journalPath;                 ///< Append-only journal file
+        std::string baseUrl;                     ///< Middleware base URL
+        std::string authToken;                   ///< For writes queued without a token
+        int timeoutSeconds;                      ///< Per request, retries included
+        std::size_t batchSize;                   ///< Writes sent at once
+        std::chrono::milliseconds retryInterval; ///< Wait after the middleware was unreachable
+        bool atomicOperations;                   ///< Send each batch as one atomic request
+        std::size_t compressRequestsAbove;       ///< Gzip batches larger than this (0: never)
+
+        Settings();
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters for monitoring
+     */
+    struct Stats {
+        std::uint64_t enqueued = 0;
+        std::uint64_t delivered = 0;     ///< Accepted by the middleware
+        std::uint64_t superseded = 0;    ///< PUTs replaced by a later PUT before sending
+        std::uint64_t conflicts = 0;     ///< Rejected and dropped
+        std::uint64_t deferred = 0;      ///< Batches stopped by an outage
+        std::size_t pending = 0;
+    };
+
+    /**
+     * @brief Gets the process-wide outbox
+     */
+    static MutationOutbox& getInstance();
+
+    // Prevent copying
+    MutationOutbox(const MutationOutbox&) = delete;
+    MutationOutbox& operator=(const MutationOutbox&) = delete;
+
+    ~MutationOutbox();
+
+    /**
+     * @brief Loads the journal and starts the worker
+     *
+     * Writes left in the journal by an earlier run are queued again. The
+     * settings are server-wide: if the outbox is already open, they are
+     * ignored.
+     *
+     * @param settings Journal path and middleware connection
+     * @return False if the journal cannot be opened
+     */
+    bool open(const Settings& settings);
+
+    /**
+     * @brief Stops the worker after its current batch and closes the journal
+     *
+     * Queued writes stay in the journal for the next open().
+     */
+    void close();
+
+    bool isOpen() const;
+
+    /**
+     * @brief Queues a write
+     * @param method HTTP method
+     * @param endpoint API endpoint
+     * @param group Ordering group (empty: no ordering with other writes)
+     * @param body JSON body (ignored for DELETE)
+     * @param authToken Token to send the write with (empty: Settings::authToken)
+     * @return Sequence number, or 0 if the outbox is closed or the journal
+     *         could not be written
+     */
+    std::uint64_t enqueue(const std::string& method, const std::string& endpoint,
+                          const std::string& group, const Wt::Json::Object& body,
+                          const std::string& authToken = std::string());
+
+    /**
+     * @brief Makes the worker try the middleware now instead of waiting
+     */
+    void wake();
+
+    /**
+     * @brief Number of queued writes, in one group or in all
+     */
+    std::size_t pendingCount(const std::string& group = std::string()) const;
+
+    /**
+     * @brief Moves queued writes from one auth token to another, e.g. after
+     *        a session refreshed its token
+     *
+     * Only writes queued with previous change; other sessions' writes keep
+     * their tokens. The journal is not rewritten: it does not hold tokens.
+     *
+     * @return Number of writes moved
+     */
+    std::size_t replaceAuthToken(const std::string& previous, const std::string& token);
+
+    /**
+     * @brief Registers a conflict listener
+     * @return Id for removeConflictListener()
+     */
+    int addConflictListener(ConflictListener listener);
+    void removeConflictListener(int id);
+
+    /**
+     * @brief Reads the counters without taking the outbox's lock
+     */
+    Stats getStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // A write to send and the queued writes its answer settles
+    struct Send {
+        Mutation mutation;
+        std::vector<std::uint64_t> settles;
+    };
+
+    struct Outcome {
+        bool delivered = false;
+        bool rejected = false;
+        int statusCode = 0;
+        std::string message;
+    };
+
+    MutationOutbox();
+
+    bool loadJournal(const std::string& path);
+    bool rewriteJournal();
+    bool appendRecord(const Wt::Json::Object& record);
+    void syncJournal();
+    std::vector<Send> nextBatch() const;
+    std::vector<Outcome> send(const std::vector<Send>& batch);
+    void settle(const std::vector<Send>& batch, const std::vector<Outcome>& outcomes,
+                std::vector<Conflict>& conflicts);
+    void run();
+
+    static Wt::Json::Object toRecord(const Mutation& mutation);
+    std::string credentialFor(const std::string& token);
+    std::string tokenFor(const std::string& credential) const;
+    static bool isRejection(int statusCode);
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    Settings settings_;
+    std::shared_ptr<APIClient> client_;
+    std::FILE* journal_ = nullptr;
+    std::deque<Mutation> queue_;
+    std::map<std::string, std::string> credentials_;  // Credential -> auth token, this run only
+    std::uint64_t lastSequence_ = 0;
+    Clock::time_point retryAt_;
+    bool open_ = false;
+    bool stopping_ = false;
+    std::thread worker_;
+    std::map<int, ConflictListener> listeners_;
+    int nextListenerId_ = 1;
+
+    // Written under mutex_, read by getStats() without it
+    std::atomic<std::uint64_t> enqueued_{0};
+    std::atomic<std::uint64_t> delivered_{0};
+    std::atomic<std::uint64_t> superseded_{0};
+    std::atomic<std::uint64_t> conflicts_{0};
+    std::atomic<std::uint64_t> deferred_{0};
+    std::atomic<std::size_t> pending_{0};
+    LogComponent& logger_;
+};
+
+#endif // MUTATIONOUTBOX_H
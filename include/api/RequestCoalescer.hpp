@@ -0,0 +1,132 @@
+//============================================================================
+// include/api/RequestCoalescer.hpp - Single-Flight Merging of Identical GETs
+//============================================================================
+
+#ifndef REQUESTCOALESCER_H
+#define REQUESTCOALESCER_H
+
+#include "APIClient.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class RequestCoalescer
+ * @brief Process-wide merging of identical GETs that are in flight
+ *
+ * When every session refreshes the same collection at about the same time,
+ * only the first GET for a URL and auth scope goes upstream; the others
+ * wait for it and receive the same decoded response. With a coalescing
+ * window set, a successful response also answers identical GETs made
+ * shortly after it arrived.
+ *
+ * Keys are ResponseCache::makeKey() keys, so sessions with different tokens
+ * never share responses. Thread-safe.
+ */
+class RequestCoalescer {
+public:
+    using Result = std::shared_ptr<const APIClient::APIResponse>;
+    using Waiter = std::function<void(Result)>;
+
+    /**
+     * @struct Flight
+     * @brief One upstream GET and the callers waiting for it
+     */
+    struct Flight {
+        std::vector<Waiter> waiters;
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters for monitoring
+     */
+    struct Stats {
+        std::uint64_t upstream = 0;     ///< GETs actually sent
+        std::uint64_t joined = 0;       ///< GETs answered by a request already in flight
+        std::uint64_t windowHits = 0;   ///< GETs answered by a response within the window
+        std::size_t inFlight = 0;
+    };
+
+    /**
+     * @brief Gets the process-wide coalescer
+     */
+    static RequestCoalescer& getInstance();
+
+    // Prevent copying
+    RequestCoalescer(const RequestCoalescer&) = delete;
+    RequestCoalescer& operator=(const RequestCoalescer&) = delete;
+
+    /**
+     * @brief Joins the GET for a key
+     *
+     * If an identical GET is in flight, waiter is attached to it; if one
+     * completed within the window, waiter is called at once. Otherwise the
+     * caller leads a new flight: it must send the request and pass the
+     * result to complete().
+     *
+     * @param key Cache key (URL and auth scope)
+     * @param waiter Receives the response (may be empty)
+     * @return The new flight if the caller leads it, else nullptr
+     */
+    std::shared_ptr<Flight> join(const std::string& key, Waiter waiter);
+
+    /**
+     * @brief Hands a flight's response to all its waiters
+     * @param key Key passed to join()
+     * @param flight Flight returned by join()
+     * @param result Decoded response
+     */
+    void complete(const std::string& key, const std::shared_ptr<Flight>& flight, Result result);
+
+    /**
+     * @brief Stops sharing responses for every key under urlPrefix
+     *
+     * Called after a write: GETs made from now on go upstream instead of
+     * joining a request that may have been answered before the write.
+     * Prefixes match on path boundaries, as in ResponseCache::invalidate().
+     */
+    void invalidate(const std::string& urlPrefix);
+
+    /**
+     * @brief Sets how long a successful response answers identical GETs
+     * @param window Zero (the default) shares only requests in flight
+     */
+    void setWindow(std::chrono::milliseconds window);
+    std::chrono::milliseconds getWindow() const;
+
+    /**
+     * @brief Reads the counters without taking the coalescer's lock
+     */
+    Stats getStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Recent {
+        Result result;
+        Clock::time_point completedAt;
+    };
+
+    RequestCoalescer() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<Flight>> flights_;
+    std::map<std::string, Recent> recent_;
+    std::chrono::milliseconds window_{0};
+
+    // Written under mutex_, read by getStats() without it
+    std::atomic<std::uint64_t> upstream_{0};
+    std::atomic<std::uint64_t> joined_{0};
+    std::atomic<std::uint64_t> windowHits_{0};
+    std::atomic<std::size_t> inFlight_{0};
+};
+
+#endif // REQUESTCOALESCER_H
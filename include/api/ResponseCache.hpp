@@ -0,0 +1,194 @@
+//============================================================================
+// include/api/ResponseCache.hpp - Shared Conditional-Request Response Cache
+//============================================================================
+
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include "HttpTransport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @class ResponseCache
+ * @brief Process-wide cache of GET responses with their validators
+ *
+ * Entries are keyed by URL and auth scope, so sessions with the same token
+ * share them and sessions with different tokens never see each other's
+ * data. Only 200 responses that carry an ETag, a Last-Modified date or a
+ * max-age are kept; "Cache-Control: no-store" and "no-cache" are honoured.
+ *
+ * An entry is fresh for its max-age (zero if the server sends none). After
+ * that it may still be served for the stale-while-revalidate window while
+ * one background request revalidates it with If-None-Match /
+ * If-Modified-Since. Thread-safe.
+ *
+ * Alongside the body an entry can hold its decoded form (APIClient keeps
+ * the parsed APIResponse), so a body is parsed once however many hits it
+ * serves. The cache does not look inside it; it is dropped with the body.
+ */
+class ResponseCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct Lookup
+     * @brief What the cache holds for a key
+     */
+    struct Lookup {
+        bool found = false;                ///< An entry exists (usable for validation)
+        bool servable = false;             ///< Fresh, or stale within the revalidation window
+        bool revalidate = false;           ///< Caller should revalidate it in the background
+        HttpTransport::Response response;  ///< Cached response; not copied when decoded is set
+        std::shared_ptr<const void> decoded;  ///< Decoded body, if one was attached
+        std::uint64_t version = 0;         ///< Identifies the stored body (see attachDecoded())
+        std::string etag;
+        std::string lastModified;
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters for monitoring
+     */
+    struct Stats {
+        std::uint64_t hits = 0;           ///< Served without waiting for the network
+        std::uint64_t notModified = 0;    ///< 304 answers to revalidations
+        std::uint64_t misses = 0;
+        std::uint64_t stores = 0;
+        std::size_t entries = 0;
+    };
+
+    /**
+     * @brief Gets the process-wide cache
+     */
+    static ResponseCache& getInstance();
+
+    // Prevent copying
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /**
+     * @brief Builds the cache key for a URL and an auth scope
+     */
+    static std::string makeKey(const std::string& url, const std::string& authScope);
+
+    /**
+     * @brief Looks up an entry
+     *
+     * When a stale but servable entry is returned with revalidate set, the
+     * entry is marked as revalidating until store(), refresh() or
+     * revalidationFailed() is called, so only one caller revalidates it.
+     *
+     * @param key Cache key
+     * @param staleWhileRevalidate Minimum window for serving stale entries
+     */
+    Lookup lookup(const std::string& key, std::chrono::seconds staleWhileRevalidate);
+
+    /**
+     * @brief Stores a 200 response if it is cacheable
+     *
+     * A 200 response that is not cacheable replaces (drops) the entry.
+     *
+     * @param key Cache key
+     * @param response The response
+     * @param decoded Its decoded body, if the caller already has it
+     * @return True if it was stored
+     */
+    bool store(const std::string& key, const HttpTransport::Response& response,
+               std::shared_ptr<const void> decoded = nullptr);
+
+    /**
+     * @brief Applies a 304 answer to an entry
+     * @param key Cache key
+     * @param notModified The 304 response (may carry new validators)
+     * @param cached Receives the entry, as lookup() would return it
+     * @return False if the entry has gone meanwhile
+     */
+    bool refresh(const std::string& key, const HttpTransport::Response& notModified, Lookup& cached);
+
+    /**
+     * @brief Keeps the decoded form of a cached body for later hits
+     *
+     * Ignored if the entry has been replaced since the lookup that returned
+     * version, so a decoded body never outlives its own body.
+     */
+    void attachDecoded(const std::string& key, std::uint64_t version, std::shared_ptr<const void> decoded);
+    /**
+     * @brief Ends a background revalidation that got no usable answer
+     */
+    void revalidationFailed(const std::string& key);
+
+    /**
+     * @brief Makes every entry under urlPrefix revalidate before its next
+     *        use (validators are kept)
+     */
+    void markStale(const std::string& urlPrefix);
+
+    /**
+     * @brief Drops every entry under urlPrefix
+     */
+    void invalidate(const std::string& urlPrefix);
+
+    /**
+     * @brief Whether a cache key's URL is urlPrefix or lies below it
+     *
+     * The URL must continue with '/' or '?' after the prefix (or end there),
+     * so "<base>/MenuItem" covers "<base>/MenuItem/3" but not
+     * "<base>/MenuItemGroup". A prefix ending in '/' covers everything below.
+     */
+    static bool isUnderPrefix(const std::string& key, const std::string& urlPrefix);
+
+    void clear();
+
+    /**
+     * @brief Reads the counters without taking the cache's lock
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Sets the maximum number of entries kept
+     */
+    void setMaxEntries(std::size_t maxEntries);
+
+private:
+    struct Entry {
+        HttpTransport::Response response;
+        std::shared_ptr<const void> decoded;
+        std::uint64_t version = 0;
+        std::string etag;
+        std::string lastModified;
+        Clock::time_point storedAt;
+        std::chrono::seconds maxAge{0};
+        std::chrono::seconds staleWhileRevalidate{0};
+        bool noCache = false;          ///< Server demands revalidation before every use
+        bool mustRevalidate = false;   ///< Marked stale by markStale()
+        bool revalidating = false;
+        Clock::time_point revalidationStarted;
+    };
+
+    ResponseCache();
+
+    static void applyCacheControl(const HttpTransport::Response& response, Entry& entry);
+    void evictIfFull();
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    std::size_t maxEntries_;
+    std::uint64_t nextVersion_;
+
+    // Written under mutex_, read by getStats() without it
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> notModified_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> stores_{0};
+    std::atomic<std::size_t> entryCount_{0};
+};
+
+#endif // RESPONSECACHE_H
@@ -83,7 +83,7 @@ public:
         
         findAll(params, [callback](std::vector<Employee> employees, bool success) {
             if (success && !employees.empty()) {
-                auto employee = std::make_unique<Employee>(employees[0]);
+                auto employee = std::make_unique<Employee>(std::move(employees[0]));
                 if (callback) callback(std::move(employee), true);
             } else {
                 if (callback) callback(nullptr, false);
@@ -106,49 +106,71 @@ public:
     }
 
 protected:
+    /**
+     * @struct Attributes
+     * @brief JSON:API attributes of an Employee resource
+     */
+    struct Attributes {
+        std::string employeeNumber;
+        std::string firstName;
+        std::string lastName;
+        std::string email;
+        std::string phone;
+        std::string role;
+        std::string locationId;
+        bool active = true;
+        std::string hiredDate;
+        double hourlyRate = 0.0;
+        std::string createdAt;
+        std::string updatedAt;
+        
+        static constexpr auto fields() {
+            return std::make_tuple(
+                JsonFields::field("employee_number", &Attributes::employeeNumber),
+                JsonFields::field("first_name", &Attributes::firstName),
+                JsonFields::field("last_name", &Attributes::lastName),
+                JsonFields::field("email", &Attributes::email),
+                JsonFields::field("phone", &Attributes::phone),
+                JsonFields::field("role", &Attributes::role),
+                JsonFields::field("location_id", &Attributes::locationId),
+                JsonFields::field("active", &Attributes::active),
+                JsonFields::field("hired_date", &Attributes::hiredDate),
+                JsonFields::field("hourly_rate", &Attributes::hourlyRate),
+                // Timestamps are set by the middleware; only sent back if known
+                JsonFields::field("created_at", &Attributes::createdAt, true),
+                JsonFields::field("updated_at", &Attributes::updatedAt, true));
+        }
+    };
+    
     /**
      * @brief Converts JSON:API data to Employee object
      * @param json JSON value from API response
      * @return Unique pointer to Employee or nullptr if conversion fails
      */
     std::unique_ptr<Employee> fromJson(const Wt::Json::Value& json) override {
-        // FIXED: Use safe JSON handling instead of direct type checking
-        if (json.type() != Wt::Json::Type::Object) {
+        Attributes attrs;
+        const auto* resource = readResource(json, attrs);
+        if (!resource) {
             return nullptr;
         }
         
-        auto jsonObj = static_cast<const Wt::Json::Object&>(json);
-        
         // Get the ID from the top level
-        std::string employeeId = safeGetString(jsonObj, "id");
+        std::string employeeId = safeGetString(*resource, "id");
         
-        // Get attributes object
-        auto attributesValue = safeGetValue(jsonObj, "attributes");
-        if (attributesValue.type() != Wt::Json::Type::Object) {
-            return nullptr;
-        }
-        
-        auto attrs = static_cast<const Wt::Json::Object&>(attributesValue);
-        
-        // Create employee object
         auto employee = std::make_unique<Employee>();
-        
-        // Set ID from top level
         employee->setEmployeeId(employeeId);
-        
-        // FIXED: Use safe getter methods from base class
-        employee->setEmployeeNumber(safeGetString(attrs, "employee_number"));
-        employee->setFirstName(safeGetString(attrs, "first_name"));
-        employee->setLastName(safeGetString(attrs, "last_name"));
-        employee->setEmail(safeGetString(attrs, "email"));
-        employee->setPhone(safeGetString(attrs, "phone"));
-        employee->setRole(safeGetString(attrs, "role"));
-        employee->setLocationId(safeGetString(attrs, "location_id"));
-        employee->setActive(safeGetBool(attrs, "active", true));
-        employee->setHiredDate(safeGetString(attrs, "hired_date"));
-        employee->setHourlyRate(safeGetDouble(attrs, "hourly_rate", 0.0));
-        employee->setCreatedAt(safeGetString(attrs, "created_at"));
-        employee->setUpdatedAt(safeGetString(attrs, "updated_at"));
+        employee->setEmployeeNumber(attrs.employeeNumber);
+        employee->setFirstName(attrs.firstName);
+        employee->setLastName(attrs.lastName);
+        employee->setEmail(attrs.email);
+        employee->setPhone(attrs.phone);
+        employee->setRole(attrs.role);
+        employee->setLocationId(attrs.locationId);
+        employee->setActive(attrs.active);
+        employee->setHiredDate(attrs.hiredDate);
+        employee->setHourlyRate(attrs.hourlyRate);
+        employee->setCreatedAt(attrs.createdAt);
+        employee->setUpdatedAt(attrs.updatedAt);
         
         // Validate the employee before returning
         if (!employee->isValid()) {
@@ -165,40 +187,21 @@ protected:
      * @return JSON object in JSON:API format
      */
     Wt::Json::Object toJson(const Employee& employee) override {
-        Wt::Json::Object jsonObj;
-        
-        // JSON:API structure
-        jsonObj["type"] = Wt::Json::Value("Employee");
-        
-        // Include ID if present
-        if (!employee.getEmployeeId().empty()) {
-            jsonObj["id"] = Wt::Json::Value(employee.getEmployeeId());
-        }
-        
-        // Create attributes object
-        Wt::Json::Object attributes;
-        attributes["employee_number"] = Wt::Json::Value(employee.getEmployeeNumber());
-        attributes["first_name"] = Wt::Json::Value(employee.getFirstName());
-        attributes["last_name"] = Wt::Json::Value(employee.getLastName());
-        attributes["email"] = Wt::Json::Value(employee.getEmail());
-        attributes["phone"] = Wt::Json::Value(employee.getPhone());
-        attributes["role"] = Wt::Json::Value(employee.getRole());
-        attributes["location_id"] = Wt::Json::Value(employee.getLocationId());
-        attributes["active"] = Wt::Json::Value(employee.isActive());
-        attributes["hired_date"] = Wt::Json::Value(employee.getHiredDate());
-        attributes["hourly_rate"] = Wt::Json::Value(employee.getHourlyRate());
-        
-        // Include timestamps if present
-        if (!employee.getCreatedAt().empty()) {
-            attributes["created_at"] = Wt::Json::Value(employee.getCreatedAt());
-        }
-        if (!employee.getUpdatedAt().empty()) {
-            attributes["updated_at"] = Wt::Json::Value(employee.getUpdatedAt());
-        }
-        
-        jsonObj["attributes"] = attributes;
-        
-        return jsonObj;
+        Attributes attrs;
+        attrs.employeeNumber = employee.getEmployeeNumber();
+        attrs.firstName = employee.getFirstName();
+        attrs.lastName = employee.getLastName();
+        attrs.email = employee.getEmail();
+        attrs.phone = employee.getPhone();
+        attrs.role = employee.getRole();
+        attrs.locationId = employee.getLocationId();
+        attrs.active = employee.isActive();
+        attrs.hiredDate = employee.getHiredDate();
+        attrs.hourlyRate = employee.getHourlyRate();
+        attrs.createdAt = employee.getCreatedAt();
+        attrs.updatedAt = employee.getUpdatedAt();
+        
+        return writeResource("Employee", employee.getEmployeeId(), attrs);
     }
 };
 
@@ -87,43 +87,40 @@ public:
     }
 
 protected:
+    /**
+     * @struct Attributes
+     * @brief JSON:API attributes of a MenuItem resource
+     */
+    struct Attributes {
+        std::string name;
+        double price = 0.0;
+        int category = MenuItem::MAIN_COURSE;   ///< Integer category mapping
+        bool available = true;
+        
+        static constexpr auto fields() {
+            return std::make_tuple(
+                JsonFields::field("name", &Attributes::name),
+                JsonFields::field("price", &Attributes::price),
+                JsonFields::field("category", &Attributes::category),
+                JsonFields::field("available", &Attributes::available));
+        }
+    };
+    
     /**
      * @brief Converts JSON:API data to MenuItem object
      * @param json JSON value from API response
      * @return Unique pointer to MenuItem or nullptr if conversion fails
      */
     std::unique_ptr<MenuItem> fromJson(const Wt::Json::Value& json) override {
-        if (json.type() != Wt::Json::Type::Object) {
-            return nullptr;
-        }
-        
-        auto jsonObj = static_cast<const Wt::Json::Object&>(json);
-        
-        // Get the ID from the top level
-        int itemId = safeGetInt(jsonObj, "id");
-        
-        // Get attributes object
-        auto attributesValue = safeGetValue(jsonObj, "attributes");
-        if (attributesValue.type() != Wt::Json::Type::Object) {
+        Attributes attrs;
+        const auto* resource = readResource(json, attrs);
+        if (!resource) {
             return nullptr;
         }
         
-        auto attrs = static_cast<const Wt::Json::Object&>(attributesValue);
-        
-        // Extract basic menu item information
-        std::string name = safeGetString(attrs, "name");
-        double price = safeGetDouble(attrs, "price");
-        
-        // Get category - use integer mapping for simplicity
-        int categoryInt = safeGetInt(attrs, "category", 2); // Default to MAIN_COURSE
-        MenuItem::Category category = static_cast<MenuItem::Category>(categoryInt);
-        
-        // Create menu item object using basic constructor
-        auto menuItem = std::make_unique<MenuItem>(itemId, name, price, category);
-        
-        // Set availability if provided
-        bool available = safeGetBool(attrs, "available", true);
-        menuItem->setAvailable(available);
+        auto menuItem = std::make_unique<MenuItem>(safeGetInt(*resource, "id"), attrs.name, attrs.price,
+                                                   static_cast<MenuItem::Category>(attrs.category));
+        menuItem->setAvailable(attrs.available);
         
         return menuItem;
     }
@@ -134,26 +131,13 @@ protected:
      * @return JSON object in JSON:API format
      */
     Wt::Json::Object toJson(const MenuItem& menuItem) override {
-        Wt::Json::Object jsonObj;
-        
-        // JSON:API structure
-        jsonObj["type"] = Wt::Json::Value("MenuItem");
-        
-        // Include ID if present
-        if (menuItem.getId() > 0) {
-            jsonObj["id"] = Wt::Json::Value(std::to_string(menuItem.getId()));
-        }
-        
-        // Create attributes object with basic properties
-        Wt::Json::Object attributes;
-        attributes["name"] = Wt::Json::Value(menuItem.getName());
-        attributes["price"] = Wt::Json::Value(menuItem.getPrice());
-        attributes["category"] = Wt::Json::Value(static_cast<int>(menuItem.getCategory()));
-        attributes["available"] = Wt::Json::Value(menuItem.isAvailable());
-        
-        jsonObj["attributes"] = attributes;
+        Attributes attrs;
+        attrs.name = menuItem.getName();
+        attrs.price = menuItem.getPrice();
+        attrs.category = static_cast<int>(menuItem.getCategory());
+        attrs.available = menuItem.isAvailable();
         
-        return jsonObj;
+        return writeResource("MenuItem", menuItem.getId() > 0 ? std::to_string(menuItem.getId()) : "", attrs);
     }
 
 private:
@@ -7,10 +7,17 @@
 
 #include "../APIRepository.hpp"
 #include "../../Order.hpp"
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <functional>
 #include <vector>
 #include <map>
+#include <memory>
+#include <mutex>
 
 /**
  * @class OrderRepository
@@ -73,6 +80,163 @@ public:
         findAll(params, callback);
     }
     
+    /**
+     * @struct SyncStats
+     * @brief Counters of syncActive()
+     */
+    struct SyncStats {
+        std::uint64_t fullLoads = 0;    ///< Loads of every active order
+        std::uint64_t deltaLoads = 0;   ///< Loads of changes only
+        std::uint64_t changed = 0;      ///< Orders received in delta loads
+        std::uint64_t removed = 0;      ///< Orders dropped: deleted or no longer active
+        std::size_t active = 0;         ///< Active orders held now
+    };
+    
+    /**
+     * @brief Brings the active orders up to date, fetching only what changed
+     *
+     * The first call loads every active order, like findActive(). Later
+     * calls ask only for orders whose updated_at is at or after the newest
+     * one seen (filter[updated_at][gte]) and merge them: orders no longer
+     * active, and ids the middleware lists in meta.deleted, are dropped.
+     * Orders that did not change keep their shared_ptr between calls; with
+     * the identity map on, it is the one findShared() returns.
+     *
+     * Every active order is loaded again after the full sync interval, so
+     * deletions the middleware does not report do not linger. A middleware
+     * whose orders have no updated_at gets a full load every time.
+     *
+     * @param callback Callback with the active orders, by id
+     */
+    void syncActive(std::function<void(std::vector<std::shared_ptr<Order>>, bool)> callback = nullptr) {
+        runSync<SyncedOrder, std::shared_ptr<Order>>(orderSync_, APIView(),
+            [this](const Wt::Json::Value& item, const std::map<int, SyncedOrder>& known,
+                   int& id, bool& active, SyncedOrder& entry) {
+                Attributes attrs;
+                std::shared_ptr<Order> order = intern(item, decode(item, attrs));
+                if (!order) {
+                    return false;
+                }
+                id = order->getOrderId();
+                active = isActive(order->getStatus());
+                
+                // Unchanged orders keep their object (intern() sees to that
+                // when the identity map is on)
+                auto existing = known.find(id);
+                if (!isIdentityMapEnabled() && existing != known.end() && !attrs.updatedAt.empty() &&
+                    existing->second.updatedAt == attrs.updatedAt) {
+                    entry = existing->second;
+                } else {
+                    entry = SyncedOrder{std::move(order), attrs.updatedAt};
+                }
+                return true;
+            },
+            [](const SyncedOrder& synced) { return synced.order; },
+            std::move(callback));
+    }
+    
+    AsyncResult<std::vector<std::shared_ptr<Order>>> syncActiveAsync() {
+        return AsyncResult<std::vector<std::shared_ptr<Order>>>::from([this](auto settle) { syncActive(settle); });
+    }
+    
+    /**
+     * @brief The attributes order lists show, without the items
+     *
+     * item_count and created_at are attributes the middleware derives;
+     * updated_at is asked for so summaries can be delta-synced. Order items
+     * are embedded attributes, not related resources, so there is nothing
+     * to include.
+     */
+    static APIView summaryView() {
+        APIView view;
+        view.fields["Order"] = {"table_identifier", "status", "item_count", "total", "created_at", "updated_at"};
+        return view;
+    }
+    
+    /**
+     * @brief Loads a summary of every active order
+     * @param callback Callback with the summaries, by id
+     * @param view Attributes to ask for; an empty view loads whole orders
+     *        and summarizes them here
+     */
+    void findActiveSummaries(std::function<void(std::vector<OrderSummary>, bool)> callback,
+                             const APIView& view = summaryView()) {
+        std::map<std::string, std::string> params;
+        params["filter[status]"] = "0,1,2,3"; // PENDING,SENT_TO_KITCHEN,PREPARING,READY
+        view.applyTo(params);
+        
+        getClient()->get(getEndpoint(), params, [this, callback](const APIClient::APIResponse& response) {
+            std::vector<OrderSummary> summaries;
+            if (response.success) {
+                summaries.reserve(response.dataArray.size());
+                for (const auto& item : response.dataArray) {
+                    SyncedSummary synced;
+                    if (decodeSummary(item, synced)) {
+                        summaries.push_back(std::move(synced.summary));
+                    }
+                }
+            }
+            if (callback) {
+                callback(std::move(summaries), response.success);
+            }
+        });
+    }
+    
+    /**
+     * @brief syncActive() for order lists: keeps summaries instead of orders
+     *
+     * Sends the same full and delta queries as syncActive(), with view's
+     * sparse fieldsets added, so both the first load and the refreshes
+     * carry only what a list shows. Independent of syncActive(): each keeps
+     * its own watermark.
+     *
+     * @param callback Callback with the active orders' summaries, by id
+     * @param view Attributes to ask for; must include updated_at for delta loads
+     */
+    void syncActiveSummaries(std::function<void(std::vector<OrderSummary>, bool)> callback,
+                             const APIView& view = summaryView()) {
+        runSync<SyncedSummary, OrderSummary>(summarySync_, view,
+            [this](const Wt::Json::Value& item, const std::map<int, SyncedSummary>&,
+                   int& id, bool& active, SyncedSummary& entry) {
+                if (!decodeSummary(item, entry)) {
+                    return false;
+                }
+                id = entry.summary.orderId;
+                active = isActive(entry.summary.status);
+                return true;
+            },
+            [](const SyncedSummary& synced) { return synced.summary; },
+            std::move(callback));
+    }
+    
+    /**
+     * @brief Forgets the synced orders; the next syncActive() and
+     *        syncActiveSummaries() load them all
+     */
+    void resetActiveSync() {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        orderSync_.reset();
+        summarySync_.reset();
+    }
+    
+    /**
+     * @brief Sets how often syncActive() loads every active order again
+     */
+    void setFullSyncInterval(std::chrono::seconds interval) {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        fullSyncInterval_ = interval;
+    }
+    
+    SyncStats getSyncStats() const {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        return orderSync_.stats;
+    }
+    
+    SyncStats getSummarySyncStats() const {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        return summarySync_.stats;
+    }
+    
     /**
      * @brief Finds orders by date range
      * @param startDate Start date (ISO format)
@@ -87,6 +251,28 @@ public:
         findAll(params, callback);
     }
     
+    /**
+     * @brief Streams orders in a date range a page at a time
+     *
+     * For ranges that may hold many orders: each page is delivered as soon
+     * as it arrives instead of after the whole range has been loaded.
+     *
+     * @param startDate Start date (ISO format)
+     * @param endDate End date (ISO format)
+     * @param onPage Callback for each page of orders
+     * @param onDone Callback after the last page or on failure
+     * @param pageSize Orders per page
+     * @return Handle for cancelling the query
+     */
+    std::shared_ptr<PagedQuery> findByDateRangePaged(const std::string& startDate, const std::string& endDate,
+                                                     PageCallback onPage, PagingDoneCallback onDone = nullptr,
+                                                     int pageSize = APIConfiguration::Defaults::PAGE_SIZE) {
+        std::map<std::string, std::string> params;
+        params["filter[created_at][gte]"] = startDate;
+        params["filter[created_at][lte]"] = endDate;
+        return findAllPaged(params, std::move(onPage), std::move(onDone), pageSize);
+    }
+    
     /**
      * @brief Finds orders above a certain total amount
      * @param minAmount Minimum total amount
@@ -100,68 +286,83 @@ public:
     }
 
 protected:
+    /**
+     * @struct ItemAttributes
+     * @brief One entry of an Order's "items" attribute
+     */
+    struct ItemAttributes {
+        int menuItemId = 0;
+        std::string name;
+        double price = 0.0;
+        int quantity = 1;
+        std::string specialInstructions;
+        
+        static constexpr auto fields() {
+            return std::make_tuple(
+                JsonFields::field("menu_item_id", &ItemAttributes::menuItemId),
+                JsonFields::field("name", &ItemAttributes::name),
+                JsonFields::field("price", &ItemAttributes::price),
+                JsonFields::field("quantity", &ItemAttributes::quantity),
+                JsonFields::field("special_instructions", &ItemAttributes::specialInstructions, true));
+        }
+    };
+    
+    /**
+     * @struct Attributes
+     * @brief JSON:API attributes of an Order resource
+     */
+    struct Attributes {
+        std::string tableIdentifier;
+        int status = Order::PENDING;    ///< Integer status mapping
+        std::vector<ItemAttributes> items;
+        double total = 0.0;             ///< Sent for the middleware; recomputed locally
+        std::string updatedAt;          ///< Set by the middleware; never sent
+        
+        static constexpr auto fields() {
+            return std::make_tuple(
+                JsonFields::field("table_identifier", &Attributes::tableIdentifier),
+                JsonFields::field("status", &Attributes::status),
+                JsonFields::field("items", &Attributes::items),
+                JsonFields::field("total", &Attributes::total),
+                JsonFields::field("updated_at", &Attributes::updatedAt, true));
+        }
+    };
+    
     /**
      * @brief Converts JSON:API data to Order object
      * @param json JSON value from API response
      * @return Unique pointer to Order or nullptr if conversion fails
      */
     std::unique_ptr<Order> fromJson(const Wt::Json::Value& json) override {
-        if (json.type() != Wt::Json::Type::Object) {
-            return nullptr;
-        }
-        
-        auto jsonObj = static_cast<const Wt::Json::Object&>(json);
-        
-        // Get the ID from the top level
-        int orderId = safeGetInt(jsonObj, "id");
-        
-        // Get attributes object
-        auto attributesValue = safeGetValue(jsonObj, "attributes");
-        if (attributesValue.type() != Wt::Json::Type::Object) {
+        Attributes attrs;
+        return decode(json, attrs);
+    }
+    
+    /**
+     * @brief Converts JSON:API data to an Order, keeping its attributes
+     * @param json JSON value from API response
+     * @param attrs Receives the decoded attributes
+     * @return Unique pointer to Order or nullptr if conversion fails
+     */
+    std::unique_ptr<Order> decode(const Wt::Json::Value& json, Attributes& attrs) {
+        const auto* resource = readResource(json, attrs);
+        if (!resource) {
             return nullptr;
         }
         
-        auto attrs = static_cast<const Wt::Json::Object&>(attributesValue);
-        
-        // Extract basic order information
-        std::string tableIdentifier = safeGetString(attrs, "table_identifier");
-        
-        // Create order object
-        auto order = std::make_unique<Order>(orderId, tableIdentifier);
+        auto order = std::make_unique<Order>(safeGetInt(*resource, "id"), attrs.tableIdentifier);
+        order->setStatus(static_cast<Order::Status>(attrs.status));
         
-        // Set status using integer mapping
-        int statusInt = safeGetInt(attrs, "status", 0); // Default to PENDING
-        Order::Status status = static_cast<Order::Status>(statusInt);
-        order->setStatus(status);
-        
-        // Parse order items if included
-        auto itemsValue = safeGetValue(attrs, "items");
-        if (itemsValue.type() == Wt::Json::Type::Array) {
-            auto itemsArray = static_cast<const Wt::Json::Array&>(itemsValue);
+        for (const auto& item : attrs.items) {
+            // Order items carry a simplified MenuItem
+            MenuItem menuItem(item.menuItemId, item.name, item.price, MenuItem::MAIN_COURSE);
             
-            for (const auto& itemJson : itemsArray) {
-                if (itemJson.type() == Wt::Json::Type::Object) {
-                    auto itemObj = static_cast<const Wt::Json::Object&>(itemJson);
-                    
-                    // Create a simplified MenuItem for the order item
-                    int menuItemId = safeGetInt(itemObj, "menu_item_id");
-                    std::string itemName = safeGetString(itemObj, "name");
-                    double price = safeGetDouble(itemObj, "price");
-                    
-                    // Create a basic MenuItem
-                    MenuItem menuItem(menuItemId, itemName, price, MenuItem::MAIN_COURSE);
-                    
-                    int quantity = safeGetInt(itemObj, "quantity", 1);
-                    std::string instructions = safeGetString(itemObj, "special_instructions");
-                    
-                    OrderItem orderItem(menuItem, quantity);
-                    if (!instructions.empty()) {
-                        orderItem.setSpecialInstructions(instructions);
-                    }
-                    
-                    order->addItem(orderItem);
-                }
+            OrderItem orderItem(menuItem, item.quantity);
+            if (!item.specialInstructions.empty()) {
+                orderItem.setSpecialInstructions(item.specialInstructions);
             }
+            
+            order->addItem(orderItem);
         }
         
         return order;
@@ -173,47 +374,243 @@ protected:
      * @return JSON object in JSON:API format
      */
     Wt::Json::Object toJson(const Order& order) override {
-        Wt::Json::Object jsonObj;
+        Attributes attrs;
+        attrs.tableIdentifier = order.getTableIdentifier();
+        attrs.status = static_cast<int>(order.getStatus());
+        attrs.total = order.getTotal();
         
-        // JSON:API structure
-        jsonObj["type"] = Wt::Json::Value("Order");
+        attrs.items.reserve(order.getItems().size());
+        for (const auto& item : order.getItems()) {
+            ItemAttributes itemAttrs;
+            itemAttrs.menuItemId = item.getMenuItem().getId();
+            itemAttrs.name = item.getMenuItem().getName();
+            itemAttrs.price = item.getMenuItem().getPrice();
+            itemAttrs.quantity = item.getQuantity();
+            itemAttrs.specialInstructions = item.getSpecialInstructions();
+            attrs.items.push_back(std::move(itemAttrs));
+        }
         
-        // Include ID if present
-        if (order.getOrderId() > 0) {
-            jsonObj["id"] = Wt::Json::Value(std::to_string(order.getOrderId()));
+        return writeResource("Order", order.getOrderId() > 0 ? std::to_string(order.getOrderId()) : "", attrs);
+    }
+
+private:
+    struct SyncedOrder {
+        std::shared_ptr<Order> order;
+        std::string updatedAt;
+    };
+    
+    struct SyncedSummary {
+        OrderSummary summary;
+        std::string updatedAt;
+    };
+    
+    /**
+     * @struct SummaryAttributes
+     * @brief Attributes of an Order resource read through summaryView()
+     */
+    struct SummaryAttributes {
+        std::string tableIdentifier;
+        int status = Order::PENDING;
+        int itemCount = -1;             ///< -1 if the middleware did not send it
+        double total = 0.0;
+        std::string createdAt;
+        std::string updatedAt;
+        
+        static constexpr auto fields() {
+            return std::make_tuple(
+                JsonFields::field("table_identifier", &SummaryAttributes::tableIdentifier),
+                JsonFields::field("status", &SummaryAttributes::status),
+                JsonFields::field("item_count", &SummaryAttributes::itemCount),
+                JsonFields::field("total", &SummaryAttributes::total),
+                JsonFields::field("created_at", &SummaryAttributes::createdAt),
+                JsonFields::field("updated_at", &SummaryAttributes::updatedAt));
         }
+    };
+    
+    /**
+     * @brief Active orders kept up to date by one of the sync methods
+     */
+    template<typename Entry>
+    struct ActiveSync {
+        std::map<int, Entry> active;
+        std::string watermark;          ///< Newest updated_at seen
+        std::chrono::steady_clock::time_point lastFullLoad;
+        std::uint64_t generation = 0;
+        SyncStats stats;
         
-        // Create attributes object
-        Wt::Json::Object attributes;
-        attributes["table_identifier"] = Wt::Json::Value(order.getTableIdentifier());
-        attributes["status"] = Wt::Json::Value(static_cast<int>(order.getStatus()));
+        void reset() {
+            active.clear();
+            watermark.clear();
+            ++generation;
+            stats.active = 0;
+        }
+    };
+    
+    static bool isActive(Order::Status status) {
+        return status == Order::PENDING || status == Order::SENT_TO_KITCHEN ||
+               status == Order::PREPARING || status == Order::READY;
+    }
+    
+    /**
+     * @brief Decodes an Order resource, whole or sparse, into a summary
+     * @return False if json is not an Order resource
+     */
+    bool decodeSummary(const Wt::Json::Value& json, SyncedSummary& synced) {
+        SummaryAttributes attrs;
+        const auto* resource = readResource(json, attrs);
+        if (!resource) {
+            return false;
+        }
         
-        // Add order items
-        Wt::Json::Array itemsArray;
-        for (const auto& item : order.getItems()) {
-            Wt::Json::Object itemObj;
-            itemObj["menu_item_id"] = Wt::Json::Value(item.getMenuItem().getId());
-            itemObj["name"] = Wt::Json::Value(item.getMenuItem().getName());
-            itemObj["price"] = Wt::Json::Value(item.getMenuItem().getPrice());
-            itemObj["quantity"] = Wt::Json::Value(item.getQuantity());
-            
-            if (!item.getSpecialInstructions().empty()) {
-                itemObj["special_instructions"] = Wt::Json::Value(item.getSpecialInstructions());
-            }
-            
-            itemsArray.push_back(itemObj);
+        OrderSummary& summary = synced.summary;
+        summary.orderId = safeGetInt(*resource, "id");
+        summary.tableIdentifier = attrs.tableIdentifier;
+        summary.tableNumber = Order::tableNumberOf(attrs.tableIdentifier);
+        summary.status = static_cast<Order::Status>(attrs.status);
+        summary.total = attrs.total;
+        summary.createdAt = parseTimestamp(attrs.createdAt);
+        summary.itemCount = attrs.itemCount;
+        if (summary.itemCount < 0) {
+            // A middleware without sparse fieldsets sends the items instead
+            const Wt::Json::Value& attributes = resource->get("attributes");
+            const Wt::Json::Value& items = static_cast<const Wt::Json::Object&>(attributes).get("items");
+            summary.itemCount = items.type() == Wt::Json::Type::Array
+                ? static_cast<int>(static_cast<const Wt::Json::Array&>(items).size()) : 0;
         }
-        attributes["items"] = itemsArray;
+        synced.updatedAt = attrs.updatedAt;
+        return true;
+    }
+    
+    /**
+     * @brief Parses an ISO-8601 UTC timestamp ("2025-03-01T12:00:00.000Z")
+     * @return The time, or now if text is empty or not a timestamp
+     */
+    static std::chrono::system_clock::time_point parseTimestamp(const std::string& text) {
+        std::tm parts{};
+        std::istringstream in(text);
+        in >> std::get_time(&parts, "%Y-%m-%dT%H:%M:%S");
+        if (text.empty() || in.fail()) {
+            return std::chrono::system_clock::now();
+        }
+        return std::chrono::system_clock::from_time_t(timegm(&parts));
+    }
+    
+    /**
+     * @brief Sends a full or delta load of active orders and merges the answer
+     * @param sync State of the sync method
+     * @param view Sparse fieldsets to add to the query
+     * @param decodeEntry (item, entries before this answer, id, active, entry)
+     *        -> false to skip item; called with syncMutex_ held
+     * @param project Turns an entry into what the callback receives
+     * @param callback Callback with the active entries, by id
+     */
+    template<typename Entry, typename Result, typename DecodeEntry, typename Project>
+    void runSync(ActiveSync<Entry>& sync, const APIView& view, DecodeEntry decodeEntry, Project project,
+                 std::function<void(std::vector<Result>, bool)> callback) {
+        std::unique_lock<std::mutex> lock(syncMutex_);
+        const bool full = sync.watermark.empty() ||
+            std::chrono::steady_clock::now() - sync.lastFullLoad >= fullSyncInterval_;
         
-        // Add total
-        attributes["total"] = Wt::Json::Value(order.getTotal());
+        std::map<std::string, std::string> params;
+        if (full) {
+            params["filter[status]"] = "0,1,2,3"; // PENDING,SENT_TO_KITCHEN,PREPARING,READY
+        } else {
+            // Inclusive: a change in the same instant as the watermark is not missed
+            params["filter[updated_at][gte]"] = sync.watermark;
+        }
+        view.applyTo(params);
         
-        jsonObj["attributes"] = attributes;
+        const std::uint64_t generation = sync.generation;
+        lock.unlock();
         
-        return jsonObj;
+        getClient()->get(getEndpoint(), params,
+            [this, &sync, callback, full, generation, decodeEntry, project](const APIClient::APIResponse& response) {
+                std::vector<Result> results;
+                bool current;
+                {
+                    std::lock_guard<std::mutex> lock(syncMutex_);
+                    // Answers to requests made before resetActiveSync() are dropped
+                    current = generation == sync.generation;
+                    if (response.success && current) {
+                        mergeActive(sync, response, full, decodeEntry);
+                    }
+                    if (callback) {
+                        results.reserve(sync.active.size());
+                        for (const auto& [id, entry] : sync.active) {
+                            results.push_back(project(entry));
+                        }
+                    }
+                }
+                
+                if (callback) {
+                    callback(std::move(results), response.success && current);
+                }
+            });
     }
-
-private:
+    
+    /**
+     * @brief Applies a sync answer to the synced entries; syncMutex_ is held
+     * @param sync State of the sync method
+     * @param response Successful response
+     * @param full True if it holds every active order
+     * @param decodeEntry As for runSync()
+     */
+    template<typename Entry, typename DecodeEntry>
+    void mergeActive(ActiveSync<Entry>& sync, const APIClient::APIResponse& response, bool full,
+                     DecodeEntry& decodeEntry) {
+        if (full) {
+            ++sync.stats.fullLoads;
+            sync.lastFullLoad = std::chrono::steady_clock::now();
+        } else {
+            ++sync.stats.deltaLoads;
+            sync.stats.changed += response.dataArray.size();
+        }
+        
+        std::map<int, Entry> previous;
+        if (full) {
+            previous.swap(sync.active);
+        }
+        
+        for (const auto& item : response.dataArray) {
+            int id = 0;
+            bool active = false;
+            Entry entry;
+            if (!decodeEntry(item, full ? previous : sync.active, id, active, entry)) {
+                continue;
+            }
+            // ISO-8601 UTC timestamps of one format order as text
+            if (entry.updatedAt > sync.watermark) {
+                sync.watermark = entry.updatedAt;
+            }
+            
+            if (active) {
+                sync.active[id] = std::move(entry);
+            } else {
+                sync.stats.removed += sync.active.erase(id);
+            }
+        }
+        for (const auto& [id, entry] : previous) {
+            sync.stats.removed += sync.active.count(id) == 0 ? 1 : 0;
+        }
+        
+        const Wt::Json::Value& deleted = response.meta.get("deleted");
+        if (deleted.type() == Wt::Json::Type::Array) {
+            for (const auto& id : static_cast<const Wt::Json::Array&>(deleted)) {
+                Wt::Json::Object reference;
+                reference["id"] = id;
+                const int removedId = safeGetInt(reference, "id");
+                sync.stats.removed += sync.active.erase(removedId);
+                forget(std::to_string(removedId));
+            }
+        }
+        sync.stats.active = sync.active.size();
+    }
+    
+    mutable std::mutex syncMutex_;
+    ActiveSync<SyncedOrder> orderSync_;
+    ActiveSync<SyncedSummary> summarySync_;
+    std::chrono::seconds fullSyncInterval_{APIConfiguration::Defaults::ORDER_FULL_SYNC_SECONDS};
+    
     /**
      * @brief Converts status enum to string for display
      * @param status Status enum
@@ -0,0 +1,89 @@
+#ifndef CONFIGFILEWATCHER_HPP
+#define CONFIGFILEWATCHER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @file ConfigFileWatcher.hpp
+ * @brief Process-wide inotify watcher for configuration files
+ *
+ * Every session owns a ConfigurationManager, so the watcher is a singleton:
+ * one background thread and one inotify descriptor serve all of them. The
+ * containing directory is watched rather than the file itself, so editors
+ * that save by writing a temporary file and renaming it are picked up too.
+ * Bursts of events for the same file are debounced into one callback.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class ConfigFileWatcher
+ * @brief Calls back on the watcher thread when a watched file changes
+ */
+class ConfigFileWatcher {
+public:
+    /**
+     * @brief Callback invoked on the watcher thread with the changed path
+     */
+    using ChangeCallback = std::function<void(const std::string& path)>;
+
+    using WatchId = std::size_t;
+
+    /**
+     * @brief Gets the process-wide watcher
+     */
+    static ConfigFileWatcher& getInstance();
+
+    // Prevent copying
+    ConfigFileWatcher(const ConfigFileWatcher&) = delete;
+    ConfigFileWatcher& operator=(const ConfigFileWatcher&) = delete;
+
+    /**
+     * @brief Starts watching a file (starts the watcher thread on first use)
+     * @param path File to watch
+     * @param callback Called after the file was written or replaced
+     * @return Watch id, or 0 if inotify is unavailable
+     */
+    WatchId watch(const std::string& path, ChangeCallback callback);
+
+    /**
+     * @brief Stops a watch
+     *
+     * Waits for a callback of this watch that is currently running, so the
+     * callback's owner can be destroyed safely afterwards.
+     */
+    void unwatch(WatchId id);
+
+private:
+    struct Watch {
+        std::string directory;
+        std::string fileName;
+        ChangeCallback callback;
+    };
+
+    ConfigFileWatcher();
+    ~ConfigFileWatcher();
+
+    bool startLocked();
+    int addDirectoryLocked(const std::string& directory);
+    bool isWatchedLocked(const std::string& directory, const std::string& fileName) const;
+    void watchLoop();
+    void dispatch(const std::string& directory, const std::string& fileName);
+
+    std::mutex mutex_;
+    std::map<WatchId, Watch> watches_;
+    std::map<int, std::string> directories_;   // inotify watch descriptor -> directory
+    WatchId nextId_;
+
+    int inotifyFd_;
+    int wakeFd_[2];
+    std::thread thread_;
+};
+
+#endif // CONFIGFILEWATCHER_HPP
@@ -6,6 +6,11 @@
 #include <vector>
 #include <memory>
 #include <any>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include <map>
 
 /**
  * @file ConfigurationManager.hpp
@@ -15,10 +20,167 @@
  * information, system settings, feature flags, and API integration.
  * 
  * @author Restaurant POS Team
- * @version 2.1.0 - Enhanced with API configuration
+ * @version 2.2.0 - Typed handles over atomically published snapshots
  */
 
- 
+/**
+ * @class ConfigSnapshot
+ * @brief Immutable copy of every configuration value
+ *
+ * ConfigurationManager builds a new snapshot on every change and publishes it
+ * with a single atomic pointer store. Readers never take a lock. Besides the
+ * section maps the snapshot carries a slot table: one pre-resolved value
+ * pointer per registered ConfigHandle key, so handle reads skip all lookups.
+ */
+class ConfigSnapshot {
+public:
+    using ConfigValue = std::any;
+    using ConfigSection = std::unordered_map<std::string, ConfigValue>;
+    
+    /**
+     * @brief Looks up a value by section and key
+     * @return Pointer to the value, or nullptr if not present
+     */
+    const ConfigValue* find(const std::string& sectionName, const std::string& keyName) const;
+    
+    /**
+     * @brief Gets a value by handle slot
+     * @return Pointer to the value, or nullptr if the key is not set
+     */
+    const ConfigValue* slot(std::size_t index) const {
+        return index < slots_.size() ? slots_[index] : nullptr;
+    }
+    
+    const std::unordered_map<std::string, ConfigSection>& getSections() const { return sections_; }
+    
+    /**
+     * @brief Gets the snapshot generation (increments on every change)
+     */
+    std::uint64_t getVersion() const { return version_; }
+
+private:
+    friend class ConfigurationManager;
+    
+    std::unordered_map<std::string, ConfigSection> sections_;
+    std::vector<const ConfigValue*> slots_;
+    std::uint64_t version_ = 0;
+};
+
+/**
+ * @class PublishedConfig
+ * @brief The current ConfigSnapshot, with reclamation of superseded ones
+ *
+ * Readers pin the current snapshot for the duration of a read: two counter
+ * updates and a pointer load, no lock. publish() swaps the pointer, waits for
+ * the readers that may still see the old snapshot (a grace period: each of
+ * two reader counters is flipped away from and drained once) and frees it,
+ * so exactly one snapshot is kept however often the configuration changes.
+ */
+class PublishedConfig {
+public:
+    /**
+     * @class Pin
+     * @brief Keeps the snapshot current at construction alive until destroyed
+     */
+    class Pin {
+    public:
+        explicit Pin(const PublishedConfig& owner)
+            : owner_(owner)
+            , counter_(owner.epoch_.load(std::memory_order_seq_cst) & 1u) {
+            owner_.readers_[counter_].count.fetch_add(1, std::memory_order_seq_cst);
+            snapshot_ = owner_.current_.load(std::memory_order_seq_cst);
+        }
+        
+        ~Pin() {
+            owner_.readers_[counter_].count.fetch_sub(1, std::memory_order_release);
+        }
+        
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+        
+        const ConfigSnapshot& operator*() const { return *snapshot_; }
+        const ConfigSnapshot* operator->() const { return snapshot_; }
+    
+    private:
+        const PublishedConfig& owner_;
+        unsigned counter_;
+        const ConfigSnapshot* snapshot_;
+    };
+    
+    PublishedConfig();
+    ~PublishedConfig();
+    
+    PublishedConfig(const PublishedConfig&) = delete;
+    PublishedConfig& operator=(const PublishedConfig&) = delete;
+    
+    /**
+     * @brief Pins the current snapshot; never returns an empty pin
+     */
+    Pin pin() const { return Pin(*this); }
+    
+    /**
+     * @brief Makes a snapshot current and frees the previous one
+     *
+     * Blocks until no reader can still use the previous snapshot. Writers
+     * must be serialized by the caller, and must not hold a Pin.
+     */
+    void publish(std::unique_ptr<const ConfigSnapshot> snapshot);
+
+private:
+    struct alignas(64) ReaderCount {
+        std::atomic<std::uint64_t> count{0};
+    };
+    
+    std::atomic<const ConfigSnapshot*> current_;
+    std::atomic<unsigned> epoch_;
+    mutable ReaderCount readers_[2];
+};
+
+/**
+ * @class ConfigHandle
+ * @brief Typed, pre-resolved accessor for one configuration key
+ *
+ * Obtained once from ConfigurationManager::getHandle(). get() pins the latest
+ * published snapshot, indexes its slot table, checks the type and copies the
+ * value out, so the result stays valid after the snapshot is replaced.
+ * Returns the default when the key is unset or holds a different type. A
+ * handle must not outlive its manager.
+ */
+template<typename T>
+class ConfigHandle {
+public:
+    ConfigHandle() : source_(nullptr), slot_(0), defaultValue_() {}
+    
+    T get() const {
+        if (source_) {
+            PublishedConfig::Pin snapshot = source_->pin();
+            if (const std::any* value = snapshot->slot(slot_)) {
+                if (const T* typed = std::any_cast<T>(value)) {
+                    return *typed;
+                }
+            }
+        }
+        return defaultValue_;
+    }
+    
+    T operator*() const { return get(); }
+    
+    const std::string& getKey() const { return key_; }
+    bool isBound() const { return source_ != nullptr; }
+
+private:
+    friend class ConfigurationManager;
+    
+    ConfigHandle(const PublishedConfig* source, std::size_t slot,
+                 const std::string& key, const T& defaultValue)
+        : source_(source), slot_(slot), key_(key), defaultValue_(defaultValue) {}
+    
+    const PublishedConfig* source_;
+    std::size_t slot_;
+    std::string key_;
+    T defaultValue_;
+};
+
 /**
  * @class ConfigurationManager
  * @brief Service for managing application configuration
@@ -45,9 +207,18 @@ public:
     ConfigurationManager();
     
     /**
-     * @brief Virtual destructor
+     * @brief Virtual destructor (stops hot reload)
      */
-    virtual ~ConfigurationManager() = default;
+    virtual ~ConfigurationManager();
+    
+    // Prevent copying
+    ConfigurationManager(const ConfigurationManager&) = delete;
+    ConfigurationManager& operator=(const ConfigurationManager&) = delete;
+    
+    /**
+     * @brief Default configuration file (shared with Wt and the Logger)
+     */
+    static constexpr const char* DEFAULT_CONFIG_FILE = "wt_config.xml";
     
     /**
      * @brief Initializes the configuration manager
@@ -57,6 +228,14 @@ public:
     
     /**
      * @brief Loads configuration from a file
+     *
+     * Reads <property name="section.key">value</property> entries from the
+     * shared PropertyTable, so a file already parsed by the Logger or another
+     * session is not parsed again. Values are converted to the type of the
+     * built-in default and validated; if any value is invalid nothing is
+     * applied. The result is defaults, then file values, then values set at
+     * runtime with setValue().
+     *
      * @param filePath Path to configuration file
      * @return True if file was loaded successfully, false otherwise
      */
@@ -103,6 +282,30 @@ public:
      */
     bool hasKey(const std::string& key) const;
     
+    /**
+     * @brief Resolves a typed handle for a key
+     *
+     * Resolve handles once (at startup or construction) and keep them; hot
+     * paths then read configuration without any string work or locking.
+     *
+     * @tparam T Type of the value
+     * @param key Configuration key in dot notation
+     * @param defaultValue Value returned while the key is unset
+     * @return Handle bound to this manager
+     */
+    template<typename T>
+    ConfigHandle<T> getHandle(const std::string& key, const T& defaultValue = T{});
+    
+    /**
+     * @brief Pins the currently published configuration snapshot
+     *
+     * The snapshot stays valid while the returned pin lives; keep pins short,
+     * since publishing a change waits for them.
+     */
+    PublishedConfig::Pin getSnapshot() const {
+        return snapshot_.pin();
+    }
+    
     /**
      * @brief Removes a configuration key
      * @param key Configuration key to remove
@@ -172,6 +375,20 @@ public:
     std::unordered_map<std::string, int> getKitchenPrepTimes() const;
     void setKitchenPrepTime(const std::string& category, int minutes);
     
+    /**
+     * @brief Stations that prepare each menu category ("main_course=grill")
+     *
+     * Empty sends whole orders to one kitchen queue, without station tickets.
+     */
+    std::vector<std::string> getKitchenStationRoutes() const;
+    void setKitchenStationRoutes(const std::vector<std::string>& routes);
+    
+    /**
+     * @brief Per-item station overrides of the category routes ("42=bar")
+     */
+    std::vector<std::string> getKitchenItemStations() const;
+    void setKitchenItemStations(const std::vector<std::string>& routes);
+    
     // =================================================================
     // UI Configuration
     // =================================================================
@@ -337,6 +554,48 @@ public:
      * @return True if reloaded successfully, false otherwise
      */
     bool reload();
+    
+    // =================================================================
+    // Hot Reload
+    // =================================================================
+    
+    /**
+     * @brief One changed key, with the values before and after
+     */
+    struct ConfigChange {
+        std::string key;
+        ConfigValue oldValue;   ///< Empty if the key was added
+        ConfigValue newValue;   ///< Empty if the key was removed
+    };
+    
+    /**
+     * @brief Listener receiving the diff of a reload
+     *
+     * Runs on the thread that applied the change; for hot reloads that is the
+     * file watcher thread, so UI code must hop onto its session first.
+     */
+    using ChangeListener = std::function<void(const std::vector<ConfigChange>& changes)>;
+    using ListenerId = std::size_t;
+    
+    ListenerId addChangeListener(ChangeListener listener);
+    void removeChangeListener(ListenerId id);
+    
+    /**
+     * @brief Watches the last loaded file and reloads it when it changes
+     *
+     * Parsing and validation run on the watcher thread; a valid file is
+     * swapped in as a new snapshot and the diff goes to the change listeners.
+     *
+     * @return True if the file is being watched
+     */
+    bool enableHotReload();
+    void disableHotReload();
+    bool isHotReloadEnabled() const;
+    
+    /**
+     * @brief Formats a configuration value for logs and diffs
+     */
+    static std::string valueToString(const ConfigValue& value);
 
 protected:
     /**
@@ -353,24 +612,86 @@ protected:
      */
     ConfigSection* getSection(const std::string& sectionName);
     
-    /**
-     * @brief Gets a configuration section (const version)
-     * @param sectionName Name of the section
-     * @return Pointer to section, or nullptr if not found
-     */
-    const ConfigSection* getSection(const std::string& sectionName) const;
-    
     /**
      * @brief Creates a section if it doesn't exist
      * @param sectionName Name of the section to create
      * @return Reference to the section
      */
     ConfigSection& getOrCreateSection(const std::string& sectionName);
+    
+    /**
+     * @brief Publishes the working configuration as a new snapshot
+     *
+     * Must be called with writeMutex_ held after changing the sections
+     * returned by getSection() / getOrCreateSection().
+     */
+    void publishSnapshot();
 
 private:
-    // Configuration data
+    /**
+     * @brief Handles behind the typed getters, resolved in the constructor
+     */
+    struct ResolvedHandles {
+        ConfigHandle<std::string> restaurantName;
+        ConfigHandle<std::string> restaurantAddress;
+        ConfigHandle<std::string> restaurantPhone;
+        ConfigHandle<double> taxRate;
+        ConfigHandle<int> serverPort;
+        ConfigHandle<std::string> serverAddress;
+        ConfigHandle<int> sessionTimeout;
+        ConfigHandle<int> startingOrderId;
+        ConfigHandle<int> orderTimeout;
+        ConfigHandle<int> maxItemsPerOrder;
+        ConfigHandle<int> kitchenRefreshRate;
+        ConfigHandle<int> kitchenBusyThreshold;
+        ConfigHandle<std::vector<std::string>> kitchenStationRoutes;
+        ConfigHandle<std::vector<std::string>> kitchenItemStations;
+        ConfigHandle<std::string> defaultTheme;
+        ConfigHandle<int> uiUpdateInterval;
+        ConfigHandle<bool> groupMenuByCategory;
+        ConfigHandle<bool> inventoryEnabled;
+        ConfigHandle<bool> staffManagementEnabled;
+        ConfigHandle<bool> customerManagementEnabled;
+        ConfigHandle<bool> reportingEnabled;
+        ConfigHandle<bool> loyaltyProgramEnabled;
+        ConfigHandle<bool> llmEnabled;
+        ConfigHandle<std::string> llmProvider;
+        ConfigHandle<std::string> llmApiKey;
+        ConfigHandle<std::string> llmModel;
+        ConfigHandle<std::string> llmBaseUrl;
+        ConfigHandle<int> llmTimeout;
+        ConfigHandle<int> llmMaxTokens;
+        ConfigHandle<bool> llmDebugMode;
+        ConfigHandle<double> llmDefaultRadius;
+        ConfigHandle<double> llmMaxRadius;
+        ConfigHandle<std::vector<std::string>> enabledPaymentMethods;
+        ConfigHandle<std::vector<double>> tipSuggestions;
+    };
+    
+    // Working configuration (writer side, guarded by writeMutex_)
     std::unordered_map<std::string, ConfigSection> config_;
     
+    // Published snapshot; a superseded one is freed once no reader pins it
+    mutable std::mutex writeMutex_;
+    PublishedConfig snapshot_;
+    std::uint64_t snapshotVersion_;
+    
+    // Handle slots: key -> index into ConfigSnapshot slot table
+    std::unordered_map<std::string, std::size_t> slotIndex_;
+    std::vector<std::pair<std::string, std::string>> slotKeys_;
+    
+    ResolvedHandles handles_;
+    
+    // Reload layers: defaults, then file, then runtime setValue() calls
+    std::unordered_map<std::string, ConfigSection> defaults_;
+    std::unordered_map<std::string, ConfigValue> overrides_;
+    
+    // Hot reload
+    std::mutex listenerMutex_;
+    std::map<ListenerId, ChangeListener> listeners_;
+    ListenerId nextListenerId_;
+    std::size_t watchId_;
+    
     // File management
     std::string lastLoadedFile_;
     
@@ -384,10 +705,20 @@ private:
     void setDefaultPaymentConfig();
     void setDefaultAPIConfig();  // ADDED: API configuration method
     void setDefaultLLMConfig();  // LLM configuration defaults
+    void resolveHandles();
+    
+    bool applyProperties(const std::map<std::string, std::string>& properties, const std::string& source);
+    void notifyListeners(const std::vector<ConfigChange>& changes);
+    static bool convertText(const ConfigValue& prototype, const std::string& text, ConfigValue& out);
+    static bool validateValue(const std::string& key, const ConfigValue& value, std::string& error);
+    
+    template<typename T>
+    ConfigHandle<T> makeHandle(const std::string& key, const T& defaultValue, bool& slotAdded);
     
     // Type conversion helpers
     template<typename T>
     T convertValue(const ConfigValue& value, const T& defaultValue) const;
+    void reportConversionError(const ConfigValue& value) const;
     
     bool isValidKey(const std::string& key) const;
 };
@@ -397,24 +728,56 @@ template<typename T>
 T ConfigurationManager::getValue(const std::string& key, const T& defaultValue) const {
     auto [sectionName, keyName] = parseKey(key);
     
-    const auto* section = getSection(sectionName);
-    if (!section) {
-        return defaultValue;
-    }
-    
-    auto it = section->find(keyName);
-    if (it == section->end()) {
+    auto snapshot = getSnapshot();
+    const ConfigValue* value = snapshot->find(sectionName, keyName);
+    if (!value) {
         return defaultValue;
     }
     
-    return convertValue<T>(it->second, defaultValue);
+    return convertValue<T>(*value, defaultValue);
 }
 
 template<typename T>
 void ConfigurationManager::setValue(const std::string& key, const T& value) {
     auto [sectionName, keyName] = parseKey(key);
+    
+    std::lock_guard<std::mutex> lock(writeMutex_);
     auto& section = getOrCreateSection(sectionName);
     section[keyName] = value;
+    overrides_[key] = value;
+    publishSnapshot();
+}
+
+template<typename T>
+ConfigHandle<T> ConfigurationManager::getHandle(const std::string& key, const T& defaultValue) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    
+    bool slotAdded = false;
+    ConfigHandle<T> handle = makeHandle<T>(key, defaultValue, slotAdded);
+    if (slotAdded) {
+        publishSnapshot(); // Give the new slot its value
+    }
+    return handle;
+}
+
+template<typename T>
+ConfigHandle<T> ConfigurationManager::makeHandle(const std::string& key, const T& defaultValue, bool& slotAdded) {
+    auto it = slotIndex_.find(key);
+    if (it == slotIndex_.end()) {
+        it = slotIndex_.emplace(key, slotKeys_.size()).first;
+        slotKeys_.push_back(parseKey(key));
+        slotAdded = true;
+    }
+    return ConfigHandle<T>(&snapshot_, it->second, key, defaultValue);
+}
+
+template<typename T>
+T ConfigurationManager::convertValue(const ConfigValue& value, const T& defaultValue) const {
+    if (const T* typed = std::any_cast<T>(&value)) {
+        return *typed;
+    }
+    reportConversionError(value);
+    return defaultValue;
 }
 
 #endif // CONFIGURATIONMANAGER_H
@@ -268,6 +268,24 @@ private:
      */
     void onPeriodicUpdate();
     
+    /**
+     * @brief Subscribes this session to configuration hot reloads
+     * 
+     * Reloads are detected on the watcher thread; the listener posts them
+     * into this session so they are applied under the session lock.
+     */
+    void setupConfigurationReload();
+    
+    /**
+     * @brief Applies reloaded configuration values to the running session
+     * @param changes Keys whose effective values changed
+     * 
+     * Adjusts the refresh timer, rebuilds the LLM service when an llm.*
+     * key changed and publishes CONFIGURATION_CHANGED so services can pick
+     * up the new values (POSService applies the tax rate and kitchen keys).
+     */
+    void onConfigurationChanged(const std::vector<ConfigurationManager::ConfigChange>& changes);
+    
     /**
      * @brief Handles mode change events
      * @param newMode The new operating mode that was switched to
@@ -299,6 +317,14 @@ private:
      */
     void logApplicationStart();
     
+    /**
+     * @brief Logs the cold-start timing breakdown
+     * 
+     * Called at the end of construction; only the first session of the
+     * process logs it.
+     */
+    void reportStartupProfile();
+    
     /**
      * @brief Logs mode switch operations
      * @param mode The mode that was switched to
@@ -328,7 +354,7 @@ private:
     // =================================================================
     
     // Core Services
-    Logger& logger_;                                           ///< Reference to application logger
+    LogComponent& logger_;                                     ///< Reference to application logger
     std::shared_ptr<EventManager> eventManager_;              ///< Event management system
     std::shared_ptr<ConfigurationManager> configManager_;     ///< Configuration management
     std::shared_ptr<POSService> posService_;                  ///< POS service (may be enhanced)
@@ -357,6 +383,9 @@ private:
     
     // Real-time Updates
     std::unique_ptr<Wt::WTimer> updateTimer_;                 ///< Timer for periodic updates
+    
+    // Configuration Reload
+    ConfigurationManager::ListenerId configListenerId_;       ///< Hot reload listener (0 if none)
 
 };
 
@@ -148,7 +148,7 @@ private:
     SubscriptionHandle nextHandle_;
     
     // Logging integration
-    Logger& logger_;
+    LogComponent& logger_;
     
     // Statistics tracking
     mutable size_t totalEventsPublished_;
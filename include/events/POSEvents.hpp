@@ -4,11 +4,13 @@
 #include "../Order.hpp"
 #include "../KitchenInterface.hpp"
 #include "../PaymentProcessor.hpp"
+#include "../core/ConfigurationManager.hpp"
 #include "../utils/Logging.hpp"
 #include "../utils/LoggingUtils.hpp"
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <chrono>
 #include <Wt/Json/Object.h>
 #include <Wt/Json/Array.h>
@@ -45,6 +47,7 @@ namespace POSEvents {
     extern const std::string ORDER_CANCELLED;
     extern const std::string ORDER_STATUS_CHANGED;
     extern const std::string CURRENT_ORDER_CHANGED;      // ADDED: For when current order is set/cleared
+    extern const std::string ORDER_SYNC_CONFLICT;        // A queued order write was rejected by the API
     
     // Menu Events
     extern const std::string MENU_UPDATED;               // ADDED: For when menu items change
@@ -201,6 +204,30 @@ namespace POSEvents {
             : errorMessage(msg), errorCode(code), component(comp), isCritical(critical) {}
     };
     
+    /**
+     * @struct ConfigurationEventData
+     * @brief Data structure for configuration change events
+     */
+    struct ConfigurationEventData {
+        std::vector<ConfigurationManager::ConfigChange> changes;
+        std::string source; // File the change came from
+        
+        ConfigurationEventData(const std::vector<ConfigurationManager::ConfigChange>& chg,
+                               const std::string& src = "")
+            : changes(chg), source(src) {}
+        
+        /**
+         * @brief Finds the change for a key
+         * @return Pointer to the change, or nullptr if the key did not change
+         */
+        const ConfigurationManager::ConfigChange* find(const std::string& key) const {
+            for (const auto& change : changes) {
+                if (change.key == key) return &change;
+            }
+            return nullptr;
+        }
+    };
+    
     // =================================================================
     // Event Logging Utilities
     // =================================================================
@@ -488,6 +515,31 @@ namespace POSEvents {
         return ErrorEventData(message, code, component, critical);
     }
     
+    /**
+     * @brief Creates a configuration changed event data with optional logging
+     * @param changes Keys that changed, with old and new values
+     * @param source File the change came from
+     * @param enableLogging Whether to log this event creation (default: true)
+     * @return ConfigurationEventData for the event
+     */
+    inline ConfigurationEventData createConfigurationChangedData(const std::vector<ConfigurationManager::ConfigChange>& changes,
+                                                                 const std::string& source = "",
+                                                                 bool enableLogging = true) {
+        if (enableLogging) {
+            for (const auto& change : changes) {
+                // Never write credentials to the log
+                bool secret = change.key.find("key") != std::string::npos ||
+                              change.key.find("token") != std::string::npos ||
+                              change.key.find("password") != std::string::npos;
+                std::string context = change.key + (secret ? " changed" :
+                    ": '" + ConfigurationManager::valueToString(change.oldValue) +
+                    "' -> '" + ConfigurationManager::valueToString(change.newValue) + "'");
+                EventLogger::logUIEvent(CONFIGURATION_CHANGED, context, LogLevel::INFO);
+            }
+        }
+        return ConfigurationEventData(changes, source);
+    }
+    
     // =================================================================
     // Original JSON Event Creation Functions (unchanged for compatibility)
     // =================================================================
@@ -21,6 +21,7 @@
 
 // API Components
 #include "../api/APIClient.hpp"
+#include "../api/MutationOutbox.hpp"
 #include "../api/repositories/OrderRepository.hpp"
 #include "../api/repositories/MenuItemRepository.hpp"
 #include "../api/repositories/EmployeeRepository.hpp"
@@ -51,16 +52,46 @@ public:
         std::string apiBaseUrl;
         std::string authToken;
         int apiTimeout;
+        int maxRetries;
+        int retryDelayMs;
+        int coalesceWindowMs;
         bool enableCaching;
         bool debugMode;
+        bool enableOutbox;          ///< Write orders behind through the MutationOutbox
+        std::string outboxPath;
+        int outboxBatchSize;
+        int outboxRetryMs;
+        bool enableAtomicOperations; ///< Send write batches as one JSON:API atomic request
+        bool enableCompression;     ///< Ask for gzip/deflate responses
+        int compressRequestsAbove;  ///< Gzip request bodies larger than this (0: never)
+        bool enableSparseFieldsets; ///< List views ask only for the attributes they show
+        bool enableDeltaSync;       ///< Refresh active orders with only what changed
+        int orderFullSyncSeconds;
+        bool enableIdentityMap;     ///< One shared object per order/menu item/employee id
+        int identityMapTtlSeconds;
         
         // Default constructor with default values
         ServiceConfig() 
             : apiBaseUrl("http://localhost:5656/api")
             , authToken("")
             , apiTimeout(30)
+            , maxRetries(APIConfiguration::Defaults::MAX_RETRIES)
+            , retryDelayMs(APIConfiguration::Defaults::RETRY_DELAY_MS)
+            , coalesceWindowMs(APIConfiguration::Defaults::COALESCE_WINDOW_MS)
             , enableCaching(true)
-            , debugMode(false) {}
+            , debugMode(false)
+            , enableOutbox(APIConfiguration::Defaults::ENABLE_OUTBOX)
+            , outboxPath(APIConfiguration::Defaults::DEFAULT_OUTBOX_PATH)
+            , outboxBatchSize(APIConfiguration::Defaults::OUTBOX_BATCH_SIZE)
+            , outboxRetryMs(APIConfiguration::Defaults::OUTBOX_RETRY_MS)
+            , enableAtomicOperations(APIConfiguration::Defaults::ENABLE_ATOMIC_OPERATIONS)
+            , enableCompression(APIConfiguration::Defaults::ENABLE_COMPRESSION)
+            , compressRequestsAbove(APIConfiguration::Defaults::COMPRESS_REQUESTS_ABOVE)
+            , enableSparseFieldsets(APIConfiguration::Defaults::ENABLE_SPARSE_FIELDSETS)
+            , enableDeltaSync(APIConfiguration::Defaults::ENABLE_DELTA_SYNC)
+            , orderFullSyncSeconds(APIConfiguration::Defaults::ORDER_FULL_SYNC_SECONDS)
+            , enableIdentityMap(APIConfiguration::Defaults::ENABLE_IDENTITY_MAP)
+            , identityMapTtlSeconds(APIConfiguration::Defaults::IDENTITY_MAP_TTL_SECONDS) {}
     };
     
     /**
@@ -74,7 +105,7 @@ public:
     /**
      * @brief Virtual destructor
      */
-    virtual ~EnhancedPOSService() = default;
+    virtual ~EnhancedPOSService();
     
     /**
      * @brief Initializes the service and API connections
@@ -141,6 +172,16 @@ public:
      */
     void getActiveOrdersAsync(std::function<void(std::vector<std::shared_ptr<Order>>, bool)> callback = nullptr);
     
+    /**
+     * @brief Gets a summary of each active order from API - Async version
+     *
+     * For order lists: with sparse fieldsets on, the middleware sends only
+     * the attributes a summary holds, not the items.
+     *
+     * @param callback Callback with summary list
+     */
+    void getActiveOrderSummariesAsync(std::function<void(std::vector<OrderSummary>, bool)> callback = nullptr);
+    
     /**
      * @brief Gets order by ID from API
      * @param orderId Order ID to retrieve
@@ -282,6 +323,21 @@ public:
      */
     void getActiveEmployeesAsync(std::function<void(std::vector<Employee>, bool)> callback = nullptr);
     
+    // =================================================================
+    // Session Start
+    // =================================================================
+    
+    /**
+     * @brief Loads the menu, the staff and the active orders at once
+     *
+     * The three reads run concurrently. The menu fills the menu cache, so
+     * getMenuItems() serves it. Orders and staff fill the repositories, so
+     * the first order refresh can be a delta.
+     *
+     * @param callback Called with true once all three loaded
+     */
+    void preloadAsync(std::function<void(bool)> callback = nullptr);
+    
     // =================================================================
     // Kitchen Interface (Enhanced with API Integration)
     // =================================================================
@@ -344,9 +400,9 @@ public:
     
     /**
      * @brief Checks if service is connected to API
-     * @return True if connected
+     * @return True if connected and no API circuit is open
      */
-    bool isConnected() const { return initialized_; }
+    bool isConnected() const { return initialized_ && apiClient_ && apiClient_->isAvailable(); }
     
     /**
      * @brief Gets API client for advanced operations
@@ -377,12 +433,60 @@ protected:
      */
     void handleAPIError(const std::string& operation, const std::string& error);
     
+    /**
+     * @brief Checks whether the middleware circuit for an endpoint is open
+     *
+     * While it is, API calls would fail at once, so read operations serve
+     * local POSService data instead.
+     *
+     * @param endpoint API endpoint (e.g. "/Order")
+     * @param operation Operation name for logging
+     * @return True if local data should be used
+     */
+    bool isAPIDown(const std::string& endpoint, const std::string& operation) const;
+    
     /**
      * @brief Publishes event to event manager
      * @param eventType Event type
      * @param eventData Event data
      */
     void publishEvent(const std::string& eventType, const Wt::Json::Object& eventData);
+    
+    /**
+     * @brief Writes an order through the outbox, or to the API if it is off
+     *
+     * With the outbox open the write is queued and callback runs at once;
+     * the API receives it in the background, after earlier writes of the
+     * same order.
+     *
+     * @param method "POST" to create, "PUT" to replace
+     * @param order Order to write
+     * @param callback Called with true once the write is queued or accepted
+     */
+    void writeOrder(const std::string& method, std::shared_ptr<Order> order,
+                    std::function<void(bool)> callback);
+    
+    /**
+     * @brief Gets an order written by this service whose writes are still queued
+     * @param orderId Order ID
+     * @return The local order, or nullptr if the API copy is current
+     */
+    std::shared_ptr<Order> findWriteBehindOrder(int orderId);
+    
+    /**
+     * @brief getOrderByIdAsync() as an AsyncResult
+     */
+    AsyncResult<std::shared_ptr<Order>> fetchOrder(int orderId);
+    
+    /**
+     * @brief writeOrder() as an AsyncResult, settled with the order
+     */
+    AsyncResult<std::shared_ptr<Order>> writeOrderAsync(const std::string& method, std::shared_ptr<Order> order);
+    
+    /**
+     * @brief Drops repository identity map entries that local events outdate
+     */
+    void subscribeToInvalidations();
 
 private:
     // Enhanced service configuration
@@ -398,6 +502,16 @@ private:
     // Local current order tracking (enhances base class)
     std::shared_ptr<Order> currentOrder_;
     
+    // Orders with writes in the outbox, newer than the API's copies
+    std::map<int, std::shared_ptr<Order>> writeBehindOrders_;
+    int outboxListenerId_;
+    
+    // ORDER_MODIFIED / MENU_UPDATED subscriptions that invalidate identity maps
+    std::vector<EventManager::SubscriptionHandle> invalidationSubscriptions_;
+    
+    // Expires with the service; AsyncResult continuations are guarded by it
+    std::shared_ptr<const void> lifetime_;
+    
     // Caches
     std::vector<std::shared_ptr<MenuItem>> menuItemsCache_;
     std::map<int, std::shared_ptr<MenuItem>> menuItemByIdCache_;
@@ -416,7 +416,7 @@ protected:
 
 private:
     // Logger reference
-    Logger& logger_;
+    LogComponent& logger_;
 
     // Event manager for notifications
     std::shared_ptr<EventManager> eventManager_;
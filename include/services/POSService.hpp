@@ -46,9 +46,9 @@ public:
     explicit POSService(std::shared_ptr<EventManager> eventManager);
     
     /**
-     * @brief Virtual destructor
+     * @brief Virtual destructor; drops the configuration subscription
      */
-    virtual ~POSService() = default;
+    virtual ~POSService();
     
     // =====================================================================
     // Order Management Methods (Delegate to OrderManager)
@@ -155,6 +155,12 @@ public:
      */
     bool sendCurrentOrderToKitchen();
     
+    /**
+     * @brief Sets the tax rate used for order totals from now on
+     * @param rate Tax rate as a fraction (restaurant.tax_rate)
+     */
+    void setTaxRate(double rate);
+    
     // =====================================================================
     // Kitchen Interface Methods
     // =====================================================================
@@ -165,6 +171,18 @@ public:
      */
     std::vector<KitchenInterface::KitchenTicket> getKitchenTickets() const;
     
+    /**
+     * @brief Gets kitchen tickets without copying them, oldest first
+     * @return View of the kitchen tickets (empty without a kitchen interface)
+     */
+    KitchenInterface::TicketView getKitchenTicketView() const;
+    
+    /**
+     * @brief Gets the number of kitchen tickets
+     * @return Kitchen queue length
+     */
+    size_t getKitchenQueueLength() const;
+    
     /**
      * @brief Gets estimated wait time
      * @return Wait time in minutes
@@ -177,6 +195,49 @@ public:
      */
     Wt::Json::Object getKitchenQueueStatus() const;
     
+    /**
+     * @brief Sets the queue length above which the kitchen counts as busy
+     * @param threshold Maximum queue length (kitchen.busy_threshold)
+     */
+    void setKitchenBusyThreshold(size_t threshold);
+    
+    /**
+     * @brief Gets the queue length above which the kitchen counts as busy
+     * @return Maximum queue length (0 without a kitchen interface)
+     */
+    size_t getKitchenBusyThreshold() const;
+    
+    /**
+     * @brief Sets which kitchen station prepares each item
+     * @param categoryRoutes "<category>=<station>" entries (kitchen.station_routes)
+     * @param itemRoutes "<menu item id>=<station>" entries (kitchen.item_stations)
+     */
+    void setKitchenStationRouting(const std::vector<std::string>& categoryRoutes,
+                                  const std::vector<std::string>& itemRoutes);
+    
+    /**
+     * @brief Gets the names of the kitchen stations
+     * @return Station names, sorted
+     */
+    std::vector<std::string> getKitchenStationNames() const;
+    
+    /**
+     * @brief Gets one station's tickets without copying them, oldest first
+     * @param station Station name
+     * @return View of the station's tickets (empty for an unknown station)
+     */
+    KitchenInterface::TicketView getKitchenStationTicketView(const std::string& station) const;
+    
+    /**
+     * @brief Updates the status of an order's ticket at one station
+     * @param station Station name
+     * @param orderId Order ID
+     * @param status New status of the station's part of the order
+     * @return True if the station held a ticket for the order
+     */
+    bool updateKitchenStationStatus(const std::string& station, int orderId,
+                                    KitchenInterface::KitchenStatus status);
+    
     // =====================================================================
     // Menu Management Methods (ENHANCED)
     // =====================================================================
@@ -272,13 +333,13 @@ protected:
     
     /**
      * @brief Gets the logger (for derived classes)
-     * @return Reference to logger
+     * @return Reference to the "services.POSService" log component
      */
-    Logger& getLogger() const { return logger_; }
+    LogComponent& getLogger() const { return logger_; }
 
 private:
-    // LOGGING: Logger reference member
-    Logger& logger_;
+    // LOGGING: Logger component member
+    LogComponent& logger_;
     
     // Core subsystem components
     std::shared_ptr<EventManager> eventManager_;
@@ -292,12 +353,20 @@ private:
     // Menu items storage
     std::vector<std::shared_ptr<MenuItem>> menuItems_;
     
+    // Subscription to CONFIGURATION_CHANGED (tax rate, kitchen threshold and station routes)
+    EventManager::SubscriptionHandle configSubscription_;
+    
+    // Current kitchen.station_routes and kitchen.item_stations; a change to one keeps the other
+    std::vector<std::string> stationRoutes_;
+    std::vector<std::string> itemStations_;
+    
     // UI callback functions
     std::function<void(std::shared_ptr<Order>)> orderCreatedCallback_;
     std::function<void(std::shared_ptr<Order>)> orderModifiedCallback_;
     
     // Helper methods
     void initializeMenuItems();
+    void handleConfigurationChanged(const std::any& eventData);
     void initializeSubsystems();
     std::vector<std::string> convertOrderItemsToStringList(const std::vector<OrderItem>& items) const;
 };
@@ -20,6 +20,7 @@
 #include <Wt/WMessageBox.h>
 #include <Wt/WTimer.h>
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -125,9 +126,9 @@ protected:
     
     /**
      * @brief Displays orders received from API
-     * @param orders Vector of orders from API
+     * @param orders Summaries of the orders from API
      */
-    void displayAPIOrders(const std::vector<std::shared_ptr<Order>>& orders);
+    void displayAPIOrders(const std::vector<OrderSummary>& orders);
     
     /**
      * @brief Displays orders from local service (fallback)
@@ -139,7 +140,7 @@ protected:
      * @param orders Input orders to filter
      * @return Filtered orders
      */
-    std::vector<std::shared_ptr<Order>> filterOrders(const std::vector<std::shared_ptr<Order>>& orders) const;
+    std::vector<OrderSummary> filterOrders(const std::vector<OrderSummary>& orders) const;
     
     /**
      * @brief Shows loading state while fetching from API
@@ -164,10 +165,10 @@ protected:
     
     /**
      * @brief Adds a row for an order to the table
-     * @param order Order to add
+     * @param order Summary of the order to add
      * @param row Row number in the table
      */
-    void addOrderRow(std::shared_ptr<Order> order, int row);
+    void addOrderRow(const OrderSummary& order, int row);
     
     /**
      * @brief Applies consistent styling to a table row
@@ -212,7 +213,7 @@ private:
     std::vector<std::shared_ptr<Order>> getDisplayOrders() const;
     std::string formatOrderId(int orderId) const;
     std::string formatOrderStatus(Order::Status status) const;
-    std::string formatOrderTime(const std::shared_ptr<Order>& order) const;
+    std::string formatOrderTime(std::chrono::system_clock::time_point orderTime) const;
     std::string formatCurrency(double amount) const;
     
     /**
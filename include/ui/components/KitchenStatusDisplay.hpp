@@ -148,8 +148,7 @@ private:
     int getAveragePreparationTime() const;
     
     // Constants
-    static constexpr int BUSY_THRESHOLD = 5;
-    static constexpr int OVERLOADED_THRESHOLD = 10;
+    static constexpr int OVERLOAD_FACTOR = 2;      // Overloaded past this many times the busy threshold
     static constexpr int MAX_REASONABLE_WAIT = 45; // minutes
 };
 
@@ -183,6 +183,7 @@ private:
     // Event handlers
     void handleOrderCreated(const std::any& eventData);
     void handleCurrentOrderChanged(const std::any& eventData);
+    void handleOrderSyncConflict(const std::any& eventData);
     
     // Helper methods
     bool hasOrderWithItems() const;
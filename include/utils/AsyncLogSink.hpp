@@ -0,0 +1,195 @@
+#ifndef ASYNCLOGSINK_HPP
+#define ASYNCLOGSINK_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @file AsyncLogSink.hpp
+ * @brief Asynchronous log backend built on a lock-free MPSC ring buffer
+ *
+ * Producers (Wt request threads) push preformatted log records into a
+ * bounded ring buffer without taking a lock. A single background writer
+ * thread drains the ring, concatenates the records into one batch and hands
+ * the batch to a writer callback, which performs a single buffered write().
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class AsyncLogSink
+ * @brief Bounded multi-producer / single-consumer queue with a writer thread
+ *
+ * The ring is a sequence-numbered slot array (Vyukov style): producers claim a
+ * slot with a single CAS on the enqueue cursor and publish it by bumping the
+ * slot sequence; the consumer never contends with producers.
+ *
+ * When the ring is full the configured OverflowPolicy decides whether the
+ * record is dropped (and counted) or the producer waits for space.
+ */
+class AsyncLogSink {
+public:
+    /**
+     * @brief Behaviour when a producer finds the ring full
+     */
+    enum class OverflowPolicy {
+        DROP,   ///< Discard the record and increment the dropped counter
+        BLOCK   ///< Wait until the writer thread frees a slot
+    };
+
+    /**
+     * @brief Callback receiving a contiguous batch of formatted records
+     */
+    using BatchWriter = std::function<void(const char* data, std::size_t size)>;
+
+    /**
+     * @brief Callback producing the record that reports dropped records
+     *
+     * Lets the owner write the notice in its own record format.
+     */
+    using DropReporter = std::function<std::string(std::uint64_t droppedRecords)>;
+
+    /**
+     * @brief Constructs the sink and starts the writer thread
+     * @param capacity Ring capacity in records (rounded up to a power of two)
+     * @param policy Overflow policy
+     * @param writer Callback invoked on the writer thread for every batch
+     * @param dropReporter Optional formatter for "records dropped" notices
+     */
+    AsyncLogSink(std::size_t capacity, OverflowPolicy policy, BatchWriter writer,
+                 DropReporter dropReporter = nullptr);
+
+    /**
+     * @brief Flushes pending records and stops the writer thread
+     */
+    ~AsyncLogSink();
+
+    // Prevent copying
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    /**
+     * @brief Queues a preformatted record (including trailing newline)
+     * @param record Record to queue; moved from on success
+     * @return true if queued, false if dropped because the ring was full
+     */
+    bool enqueue(std::string&& record);
+
+    /**
+     * @brief Queues a record under an explicit overflow policy
+     *
+     * Lets records that must not be lost (binary format descriptors) wait
+     * for space in a sink configured to drop. Must not be called from the
+     * writer thread with OverflowPolicy::BLOCK.
+     *
+     * @param record Record to queue; moved from on success only
+     * @param policy Overflow policy for this record
+     * @return true if queued; false if dropped, or if the sink is stopped
+     */
+    bool enqueue(std::string&& record, OverflowPolicy policy);
+
+    /**
+     * @brief Blocks until every record queued before the call is written
+     */
+    void flush();
+
+    /**
+     * @brief Drains and writes pending records, then joins the writer thread
+     */
+    void stop();
+
+    /**
+     * @brief Best-effort drain used from fatal signal handlers
+     *
+     * Skips the writer thread and the writer callback: every published record
+     * is written from its slot with write(2), so nothing is allocated and no
+     * lock is taken. Gives up if the writer thread holds the consumer side
+     * for too long.
+     *
+     * @param fd Descriptor receiving the records
+     */
+    void emergencyDrain(int fd);
+
+    /**
+     * @brief Installs handlers for SIGSEGV, SIGABRT, SIGBUS, SIGFPE and SIGILL
+     *
+     * Installed with sigaction(); the handlers call emergencyDrain(fd) on this
+     * sink, put back the action that was installed before and re-raise the
+     * signal, so an earlier handler (or the default action) still runs.
+     *
+     * @param fd Descriptor to drain into; it must stay open (the logger keeps
+     *           its descriptor number across rotations)
+     */
+    void installCrashHandlers(int fd);
+
+    /**
+     * @brief Gets the number of records discarded under OverflowPolicy::DROP
+     */
+    std::uint64_t getDroppedCount() const;
+
+    /**
+     * @brief Gets the ring capacity in records
+     */
+    std::size_t getCapacity() const { return capacity_; }
+
+    OverflowPolicy getOverflowPolicy() const { return policy_; }
+
+    /**
+     * @brief Parses "drop" / "block" (case-insensitive), defaulting to DROP
+     */
+    static OverflowPolicy stringToPolicy(const std::string& policyStr);
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        std::string record;
+    };
+
+    bool tryEnqueue(std::string& record);
+    bool tryDequeue(std::string& out);
+    std::size_t drainBatch();
+    void writerLoop();
+
+    bool acquireConsumer(bool bounded);
+    void releaseConsumer();
+
+    static void crashSignalHandler(int signal);
+
+    // Ring buffer
+    std::size_t capacity_;
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::size_t> enqueuePos_;
+    alignas(64) std::size_t dequeuePos_;
+
+    OverflowPolicy policy_;
+    BatchWriter writer_;
+    DropReporter dropReporter_;
+    std::string batch_;
+
+    // Consumer ownership shared between writer thread and crash path
+    std::atomic_flag consumerBusy_ = ATOMIC_FLAG_INIT;
+
+    // Writer thread coordination
+    std::thread writerThread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    std::condition_variable flushedCondition_;
+    std::atomic<bool> writerSleeping_;
+    std::atomic<bool> running_;
+    std::atomic<std::size_t> writtenPos_;
+    std::atomic<std::uint64_t> droppedCount_;
+
+    static std::atomic<AsyncLogSink*> crashSink_;
+    static std::atomic<int> crashFd_;
+};
+
+#endif // ASYNCLOGSINK_HPP
@@ -0,0 +1,229 @@
+#ifndef BINARYLOGFORMAT_HPP
+#define BINARYLOGFORMAT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @file BinaryLogFormat.hpp
+ * @brief On-disk layout and encoders for structured binary logging
+ *
+ * In binary mode the logger writes no text. Each call site registers its
+ * format string once and receives a descriptor id; afterwards every log call
+ * writes only the id, a raw nanosecond timestamp and the raw argument bytes.
+ * The offline pos-logcat tool turns the file back into the text log format.
+ *
+ * File layout (host byte order, identified by the endian marker):
+ *   header:     "POSBLOG\0" | u32 version | u32 endian marker
+ *   record:     u8 type | u32 payload length | payload
+ *   DESCRIPTOR: u32 id | u8 level | u16 format length | format bytes
+ *   EVENT:      u32 id | i64 timestamp (ns since epoch) | arguments
+ *   argument:   u8 tag | value ('i' i64, 'u' u64, 'd' f64, 'b' u8,
+ *               's' u32 length + bytes)
+ *
+ * Placeholders in the format string are written as "{}".
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class BinaryLogFormat
+ * @brief Static helpers shared by the Logger and the pos-logcat decoder
+ */
+class BinaryLogFormat {
+public:
+    static constexpr char MAGIC[8] = {'P', 'O', 'S', 'B', 'L', 'O', 'G', '\0'};
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t ENDIAN_MARKER = 0x01020304;
+    static constexpr std::size_t HEADER_SIZE = sizeof(MAGIC) + 2 * sizeof(std::uint32_t);
+    static constexpr std::size_t RECORD_PREFIX_SIZE = 1 + sizeof(std::uint32_t);
+
+    enum RecordType : std::uint8_t {
+        RECORD_DESCRIPTOR = 1,
+        RECORD_EVENT = 2
+    };
+
+    enum ArgTag : std::uint8_t {
+        ARG_INT = 'i',
+        ARG_UINT = 'u',
+        ARG_DOUBLE = 'd',
+        ARG_BOOL = 'b',
+        ARG_STRING = 's'
+    };
+
+    /**
+     * @brief Appends the file header to a buffer
+     */
+    static void appendHeader(std::string& out) {
+        out.append(MAGIC, sizeof(MAGIC));
+        appendRaw(out, VERSION);
+        appendRaw(out, ENDIAN_MARKER);
+    }
+
+    /**
+     * @brief Appends a DESCRIPTOR record to a buffer
+     * @param out Destination buffer
+     * @param id Descriptor id
+     * @param level Numeric LogLevel of the call site
+     * @param format Format string with "{}" placeholders
+     */
+    static void appendDescriptor(std::string& out, std::uint32_t id, std::uint8_t level,
+                                 std::string_view format) {
+        auto formatLength = static_cast<std::uint16_t>(std::min<std::size_t>(format.size(), 0xFFFF));
+        std::size_t start = beginRecord(out, RECORD_DESCRIPTOR);
+        appendRaw(out, id);
+        appendRaw(out, level);
+        appendRaw(out, formatLength);
+        out.append(format.data(), formatLength);
+        endRecord(out, start);
+    }
+
+    /**
+     * @brief Appends an EVENT record to a buffer
+     * @param out Destination buffer
+     * @param id Descriptor id returned at registration
+     * @param args Raw argument values
+     */
+    template<typename... Args>
+    static void appendEvent(std::string& out, std::uint32_t id, const Args&... args) {
+        std::int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        std::size_t start = beginRecord(out, RECORD_EVENT);
+        appendRaw(out, id);
+        appendRaw(out, timestamp);
+        (appendArg(out, args), ...);
+        endRecord(out, start);
+    }
+
+    /**
+     * @brief Renders a format string with typed arguments as text
+     *
+     * Used when binary mode is off so LOG_STRUCTURED call sites still produce
+     * the same text the decoder would.
+     */
+    template<typename... Args>
+    static std::string formatText(std::string_view format, const Args&... args) {
+        std::ostringstream oss;
+        std::size_t pos = 0;
+        (appendTextArg(oss, format, pos, args), ...);
+        oss << format.substr(pos);
+        return oss.str();
+    }
+
+    /**
+     * @brief Writes one placeholder substitution; shared with the decoder
+     */
+    static void appendLiteralUntilPlaceholder(std::ostringstream& oss, std::string_view format,
+                                              std::size_t& pos) {
+        std::size_t next = format.find("{}", pos);
+        if (next == std::string_view::npos) {
+            oss << format.substr(pos);
+            pos = format.size();
+            oss << ' ';
+            return;
+        }
+        oss << format.substr(pos, next - pos);
+        pos = next + 2;
+    }
+
+    /**
+     * @brief Renders a boolean the way the text logger does
+     */
+    static const char* boolText(bool value) {
+        return value ? "true" : "false";
+    }
+
+    /**
+     * @brief Level label matching Logger's text output (padded to 5 chars)
+     */
+    static const char* levelLabel(std::uint8_t level) {
+        switch (level) {
+            case 4: return "DEBUG";
+            case 3: return "INFO ";
+            case 2: return "WARN ";
+            case 1: return "ERROR";
+            case 0: return "NONE ";
+            default: return "UNKNOWN";
+        }
+    }
+
+private:
+    template<typename T>
+    static void appendRaw(std::string& out, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "raw values must be trivially copyable");
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static std::size_t beginRecord(std::string& out, RecordType type) {
+        std::size_t start = out.size();
+        out.push_back(static_cast<char>(type));
+        appendRaw(out, std::uint32_t{0}); // Patched by endRecord
+        return start;
+    }
+
+    static void endRecord(std::string& out, std::size_t start) {
+        auto length = static_cast<std::uint32_t>(out.size() - start - RECORD_PREFIX_SIZE);
+        std::memcpy(&out[start + 1], &length, sizeof(length));
+    }
+
+    static void appendString(std::string& out, std::string_view value) {
+        out.push_back(static_cast<char>(ARG_STRING));
+        appendRaw(out, static_cast<std::uint32_t>(value.size()));
+        out.append(value.data(), value.size());
+    }
+
+    template<typename T>
+    static void appendArg(std::string& out, const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            out.push_back(static_cast<char>(ARG_BOOL));
+            appendRaw(out, static_cast<std::uint8_t>(value ? 1 : 0));
+        } else if constexpr (std::is_enum_v<U>) {
+            appendArg(out, static_cast<std::underlying_type_t<U>>(value));
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            out.push_back(static_cast<char>(ARG_INT));
+            appendRaw(out, static_cast<std::int64_t>(value));
+        } else if constexpr (std::is_integral_v<U>) {
+            out.push_back(static_cast<char>(ARG_UINT));
+            appendRaw(out, static_cast<std::uint64_t>(value));
+        } else if constexpr (std::is_floating_point_v<U>) {
+            out.push_back(static_cast<char>(ARG_DOUBLE));
+            appendRaw(out, static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+            appendString(out, std::string_view(value));
+        } else {
+            static_assert(std::is_convertible_v<const U&, std::string_view>,
+                          "unsupported binary log argument type");
+        }
+    }
+
+    template<typename T>
+    static void appendTextArg(std::ostringstream& oss, std::string_view format,
+                              std::size_t& pos, const T& value) {
+        using U = std::decay_t<T>;
+        appendLiteralUntilPlaceholder(oss, format, pos);
+        if constexpr (std::is_same_v<U, bool>) {
+            oss << boolText(value);
+        } else if constexpr (std::is_enum_v<U>) {
+            oss << static_cast<std::underlying_type_t<U>>(value);
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            oss << static_cast<std::int64_t>(value);
+        } else if constexpr (std::is_integral_v<U>) {
+            oss << static_cast<std::uint64_t>(value);
+        } else if constexpr (std::is_floating_point_v<U>) {
+            oss << static_cast<double>(value);
+        } else {
+            oss << std::string_view(value);
+        }
+    }
+};
+
+#endif // BINARYLOGFORMAT_HPP
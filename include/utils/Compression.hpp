@@ -0,0 +1,54 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @file Compression.hpp
+ * @brief In-memory gzip and deflate for HTTP bodies
+ *
+ * Used by HttpTransport for Content-Encoding and by the mock middleware.
+ * Without zlib (POS_HAVE_ZLIB undefined) every function fails and
+ * isAvailable() returns false, so callers send and accept identity bodies.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @namespace Compression
+ * @brief Content-Encoding helpers
+ */
+namespace Compression {
+
+    /**
+     * @brief Whether the build has zlib
+     */
+    bool isAvailable();
+
+    /**
+     * @brief Gzips a body
+     * @param input Body to compress
+     * @param output Receives the gzip stream
+     * @return False if zlib is missing or compression failed
+     */
+    bool gzip(const std::string& input, std::string& output);
+
+    /**
+     * @brief Decodes a body sent with Content-Encoding gzip or deflate
+     *
+     * "deflate" is accepted both as a zlib stream (RFC 9110) and as raw
+     * deflate data, which some servers send instead.
+     *
+     * @param encoding Content-Encoding value, in lower case
+     * @param input Encoded body
+     * @param output Receives the decoded body
+     * @param maxBytes Fails rather than decode more than this
+     * @return False for an unknown encoding, corrupt data or too large a body
+     */
+    bool decode(const std::string& encoding, const std::string& input, std::string& output,
+                std::size_t maxBytes);
+}
+
+#endif // COMPRESSION_H
@@ -0,0 +1,79 @@
+#ifndef LOGARCHIVER_HPP
+#define LOGARCHIVER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * @file LogArchiver.hpp
+ * @brief Background compression and retention of rotated log files
+ *
+ * The Logger hands every rotated file to the archiver and returns
+ * immediately. A single low-priority thread gzips the file (when built with
+ * zlib) and prunes old archives, so rotating a 1 GB log never stalls a
+ * request thread or the log writer.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class LogArchiver
+ * @brief Low-priority worker that compresses rotated logs and applies retention
+ */
+class LogArchiver {
+public:
+    /**
+     * @brief Starts the archiver thread
+     * @param directory Log directory to prune
+     * @param baseFileName Base name of log files owned by the logger
+     * @param compress Whether to gzip rotated files
+     * @param maxRotatedFiles Rotated files to keep (0 keeps everything)
+     */
+    LogArchiver(const std::string& directory, const std::string& baseFileName,
+                bool compress, std::size_t maxRotatedFiles);
+
+    /**
+     * @brief Finishes queued work and joins the thread
+     */
+    ~LogArchiver();
+
+    // Prevent copying
+    LogArchiver(const LogArchiver&) = delete;
+    LogArchiver& operator=(const LogArchiver&) = delete;
+
+    /**
+     * @brief Queues a closed log file for compression and retention
+     * @param path Path of the rotated file
+     * @param activePath Path the logger writes to now (never pruned)
+     */
+    void archive(const std::string& path, const std::string& activePath);
+
+    /**
+     * @brief Whether gzip support was compiled in
+     */
+    static bool isCompressionAvailable();
+
+private:
+    void workerLoop();
+    bool compressFile(const std::string& path);
+    void applyRetention(const std::string& activePath);
+
+    std::string directory_;
+    std::string baseFileName_;
+    bool compress_;
+    std::size_t maxRotatedFiles_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    std::deque<std::pair<std::string, std::string>> pending_;
+    bool stopping_;
+    std::thread worker_;
+};
+
+#endif // LOGARCHIVER_HPP
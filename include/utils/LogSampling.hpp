@@ -0,0 +1,154 @@
+#ifndef LOGSAMPLING_HPP
+#define LOGSAMPLING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file LogSampling.hpp
+ * @brief Per-call-site rate limiting and sampling for high-frequency log messages
+ *
+ * Each LOG_RATE_LIMITED / LOG_SAMPLED call site owns one static instance of
+ * the classes below. Both are lock-free: the rate limiter is a GCRA token
+ * bucket updated with a single CAS, the sampler is one atomic counter.
+ *
+ * Messages that are held back are counted, and the count is reported either
+ * on the next message that gets through or, if the site keeps being
+ * suppressed, as a summary line once per report interval.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class LogRateLimiter
+ * @brief Token bucket (GCRA form) allowing perSecond messages with a burst
+ */
+class LogRateLimiter {
+public:
+    /**
+     * @brief Outcome of one call
+     */
+    enum class Decision {
+        LOG,        ///< Log the message (annotated with suppressed count, if any)
+        REPORT,     ///< Message suppressed, but a suppression summary is due
+        SUPPRESS    ///< Drop the message silently (it is counted)
+    };
+
+    /**
+     * @brief Constructs a limiter
+     * @param perSecond Sustained messages per second
+     * @param burst Messages allowed back to back before limiting starts
+     * @param reportIntervalSeconds Minimum seconds between suppression summaries
+     */
+    LogRateLimiter(double perSecond, double burst, int reportIntervalSeconds = 60)
+        : intervalNs_(static_cast<std::int64_t>(1e9 / (perSecond > 0 ? perSecond : 1.0)))
+        , toleranceNs_(static_cast<std::int64_t>(intervalNs_ * ((burst > 1 ? burst : 1.0) - 1.0)))
+        , reportIntervalNs_(static_cast<std::int64_t>(reportIntervalSeconds) * 1000000000)
+        , theoreticalArrivalNs_(0)
+        , lastReportNs_(nowNs())
+        , suppressed_(0) {}
+
+    /**
+     * @brief Decides whether the current message may be logged
+     * @param suppressedOut Set to the messages suppressed since the last
+     *        report when the decision is LOG or REPORT
+     */
+    Decision acquire(std::uint64_t& suppressedOut) {
+        const std::int64_t now = nowNs();
+        std::int64_t tat = theoreticalArrivalNs_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            if (now < tat - toleranceNs_) {
+                return suppress(now, suppressedOut);
+            }
+            std::int64_t next = (tat > now ? tat : now) + intervalNs_;
+            if (theoreticalArrivalNs_.compare_exchange_weak(tat, next, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        suppressedOut = suppressed_.exchange(0, std::memory_order_relaxed);
+        if (suppressedOut > 0) {
+            lastReportNs_.store(now, std::memory_order_relaxed);
+        }
+        return Decision::LOG;
+    }
+
+    static std::string annotate(std::string message, std::uint64_t suppressed) {
+        if (suppressed > 0) {
+            message += " (" + std::to_string(suppressed) + " similar messages suppressed)";
+        }
+        return message;
+    }
+
+    static std::string summary(const char* file, int line, std::uint64_t suppressed) {
+        return "Rate limit: " + std::to_string(suppressed) + " messages suppressed at "
+             + file + ":" + std::to_string(line);
+    }
+
+private:
+    Decision suppress(std::int64_t now, std::uint64_t& suppressedOut) {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+
+        // Only one thread wins the right to write the periodic summary
+        std::int64_t last = lastReportNs_.load(std::memory_order_relaxed);
+        if (now - last >= reportIntervalNs_ &&
+            lastReportNs_.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            suppressedOut = suppressed_.exchange(0, std::memory_order_relaxed);
+            if (suppressedOut > 0) {
+                return Decision::REPORT;
+            }
+        }
+        return Decision::SUPPRESS;
+    }
+
+    static std::int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const std::int64_t intervalNs_;
+    const std::int64_t toleranceNs_;
+    const std::int64_t reportIntervalNs_;
+    std::atomic<std::int64_t> theoreticalArrivalNs_;
+    std::atomic<std::int64_t> lastReportNs_;
+    std::atomic<std::uint64_t> suppressed_;
+};
+
+/**
+ * @class LogSampler
+ * @brief Lets through one message in every N
+ */
+class LogSampler {
+public:
+    explicit LogSampler(std::uint64_t everyN)
+        : everyN_(everyN > 0 ? everyN : 1), counter_(0) {}
+
+    /**
+     * @brief Returns true for the 1st, (N+1)th, (2N+1)th ... call
+     */
+    bool sample() {
+        return counter_.fetch_add(1, std::memory_order_relaxed) % everyN_ == 0;
+    }
+
+    std::uint64_t getEveryN() const { return everyN_; }
+
+    /**
+     * @brief Marks a sampled message so readers can scale what they see
+     */
+    static std::string annotate(std::string message, std::uint64_t everyN) {
+        if (everyN > 1) {
+            message += " [sampled 1/" + std::to_string(everyN) + "]";
+        }
+        return message;
+    }
+
+private:
+    const std::uint64_t everyN_;
+    std::atomic<std::uint64_t> counter_;
+};
+
+#endif // LOGSAMPLING_HPP
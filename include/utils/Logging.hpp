@@ -1,10 +1,19 @@
 #ifndef LOGGING_HPP
 #define LOGGING_HPP
 
+#include "BinaryLogFormat.hpp"
+
 #include <string>
 #include <mutex>
-#include <fstream>
+#include <atomic>
+#include <memory>
 #include <map>
+#include <vector>
+#include <cstdint>
+
+class AsyncLogSink;
+class LogArchiver;
+class LogComponent;
 
 // ============================================================================
 // Logging Framework Header
@@ -25,6 +34,15 @@ public:
     void setLogLevel(LogLevel level);
     void setLogLevel(const std::string& levelStr);
     LogLevel getLogLevel() const;
+    
+    /**
+     * @brief Cheap check used by the LOG_* macros before formatting a message
+     * @param level Level of the message about to be logged
+     * @return true if a message at this level would be written
+     */
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) <= static_cast<int>(currentLevel_.load(std::memory_order_relaxed));
+    }
     std::string getCurrentLevelString() const;
     
     void log(LogLevel level, const std::string& message);
@@ -33,6 +51,66 @@ public:
     void warn(const std::string& message);
     void error(const std::string& message);
     
+    /**
+     * @brief Registers a structured call-site format (see LOG_STRUCTURED)
+     * @param level Level of the call site
+     * @param format Format string with "{}" placeholders
+     * @return Descriptor id to pass to logStructured()
+     */
+    std::uint32_t registerFormat(LogLevel level, const char* format);
+    
+    /**
+     * @brief Logs a registered format with raw arguments
+     *
+     * In binary mode only the descriptor id, a raw timestamp and the argument
+     * bytes are written; otherwise the format is rendered to text.
+     */
+    template<typename... Args>
+    void logStructured(std::uint32_t formatId, LogLevel level, const char* format, const Args&... args) {
+        // The level was checked by the caller (LOG_STRUCTURED)
+        if (!binaryMode_) {
+            write(level, BinaryLogFormat::formatText(format, args...));
+            return;
+        }
+        std::string record;
+        record.reserve(64);
+        BinaryLogFormat::appendEvent(record, formatId, args...);
+        writeRecord(std::move(record));
+    }
+    
+    bool isBinaryMode() const { return binaryMode_; }
+    
+    /**
+     * @brief Gets the handle for a named component, creating it on first use
+     *
+     * Names are dot-separated ("api.APIClient"). A component's level is the
+     * most specific override among its name and its parents ("api"), falling
+     * back to the global level. The returned reference stays valid for the
+     * life of the process, so callers resolve it once and keep it.
+     */
+    LogComponent& getComponent(const std::string& name);
+    
+    /**
+     * @brief Overrides the level of a component and its children at runtime
+     */
+    void setComponentLevel(const std::string& name, LogLevel level);
+    void setComponentLevel(const std::string& name, const std::string& levelStr);
+    
+    /**
+     * @brief Removes an override so the component inherits again
+     */
+    void clearComponentLevel(const std::string& name);
+    
+    /**
+     * @brief Gets all configured component overrides
+     */
+    std::map<std::string, LogLevel> getComponentLevels() const;
+    
+    /**
+     * @brief Blocks until every queued log record has reached the log file
+     */
+    void flush();
+    
     void initializeFromConfiguration();
     
 private:
@@ -43,12 +121,23 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
     
-    void writeToFile(const std::string& logEntry);
+    friend class LogComponent;
+    
+    void write(LogLevel level, const std::string& message);
+    void refreshComponentLevels();
+    LogLevel resolveComponentLevel(const std::string& name) const;
+    std::string formatEntry(LogLevel level, const std::string& message);
+    void writeRecord(std::string&& record);
+    void writeToFile(const char* data, std::size_t size);
+    bool openLogFile();
+    void writeBinaryPreamble();
     void rotateLogFile();
     std::string getCurrentTimestamp();
+    void appendTimestamp(std::string& out);
     std::string levelToString(LogLevel level) const;
     LogLevel stringToLevel(const std::string& levelStr);
     std::string getCurrentLogFileName();
+    std::string getNextLogFileName();
     
     // Configuration methods
     std::string readConfigProperty(const std::string& propertyName, const std::string& defaultValue = "");
@@ -56,17 +145,96 @@ private:
     void loadConfigurationFromEnvironment();
     
     // Member variables
-    LogLevel currentLevel_;
+    std::atomic<LogLevel> currentLevel_;
     std::string logDirectory_;
     std::string baseFileName_;
     std::size_t maxFileSize_;
     mutable std::mutex logMutex_;
-    std::ofstream logFile_;
+    int logFd_;
+    std::size_t currentFileSize_;
     std::string currentFileName_;
     bool enableConsole_;
     
+    // Asynchronous backend (null when logging.async is disabled)
+    bool asyncEnabled_;
+    std::size_t asyncQueueSize_;
+    std::string asyncOverflowPolicy_;
+    std::unique_ptr<AsyncLogSink> asyncSink_;
+    
+    // Rotated file compression and retention (off the writer path)
+    bool compressRotated_;
+    std::size_t maxRotatedFiles_;
+    std::unique_ptr<LogArchiver> archiver_;
+    std::string rotationStem_;
+    int rotationSuffix_ = 0;
+    
+    // Structured binary logging (logging.binary)
+    struct FormatDescriptor {
+        LogLevel level;
+        std::string format;
+    };
+    bool binaryMode_;
+    std::mutex formatMutex_;
+    std::vector<FormatDescriptor> formats_;
+    std::uint32_t messageFormatIds_[5];
+    
+    // Per-component levels (logging.level.<component>)
+    mutable std::mutex componentMutex_;
+    std::map<std::string, std::unique_ptr<LogComponent>> components_;
+    std::map<std::string, LogLevel> componentOverrides_;
+    
     // Configuration cache
     std::map<std::string, std::string> configProperties_;
 };
 
+/**
+ * @class LogComponent
+ * @brief Named logging handle with its own effective level
+ *
+ * Offers the same logging calls as Logger, so it can replace a Logger&
+ * member and be passed to every LOG_* macro. The effective level is kept in
+ * an atomic and refreshed by Logger when global or component levels change.
+ */
+class LogComponent {
+public:
+    const std::string& getName() const { return name_; }
+    
+    bool isEnabled(LogLevel level) const {
+        return static_cast<int>(level) <= effectiveLevel_.load(std::memory_order_relaxed);
+    }
+    
+    LogLevel getLogLevel() const {
+        return static_cast<LogLevel>(effectiveLevel_.load(std::memory_order_relaxed));
+    }
+    
+    void log(LogLevel level, const std::string& message) {
+        if (level != LogLevel::NONE && isEnabled(level)) {
+            logger_.write(level, message);
+        }
+    }
+    void debug(const std::string& message) { log(LogLevel::DEBUG, message); }
+    void info(const std::string& message)  { log(LogLevel::INFO, message); }
+    void warn(const std::string& message)  { log(LogLevel::WARN, message); }
+    void error(const std::string& message) { log(LogLevel::ERROR, message); }
+    
+    std::uint32_t registerFormat(LogLevel level, const char* format) {
+        return logger_.registerFormat(level, format);
+    }
+    
+    template<typename... Args>
+    void logStructured(std::uint32_t formatId, LogLevel level, const char* format, const Args&... args) {
+        logger_.logStructured(formatId, level, format, args...);
+    }
+    
+    LogComponent(Logger& logger, const std::string& name, LogLevel level)
+        : logger_(logger), name_(name), effectiveLevel_(static_cast<int>(level)) {}
+    
+private:
+    friend class Logger;
+    
+    Logger& logger_;
+    std::string name_;
+    std::atomic<int> effectiveLevel_;
+};
+
 #endif // LOGGING_HPP
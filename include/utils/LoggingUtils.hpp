@@ -1,6 +1,9 @@
 #ifndef LOGGINGUTILS_HPP
 #define LOGGINGUTILS_HPP
 
+#include "Logging.hpp"
+#include "LogSampling.hpp"
+
 #include <string>
 #include <sstream>
 
@@ -120,9 +123,135 @@ private:
     }
 };
 
+// ============================================================================
+// Level Gating
+// ============================================================================
+
+/**
+ * @brief Most verbose level compiled into the binary
+ *
+ * Calls above this level are compiled out entirely by the LOG_* macros below.
+ * Release builds define it as 3 (INFO) to strip DEBUG calls; the default keeps
+ * every level and leaves the decision to Logger's runtime level.
+ */
+#ifndef POS_LOG_COMPILED_LEVEL
+#define POS_LOG_COMPILED_LEVEL 4
+#endif
+
+// Map a Logger method name (debug, info, warn, error) to its LogLevel
+#define POS_LOG_LEVEL_debug LogLevel::DEBUG
+#define POS_LOG_LEVEL_info  LogLevel::INFO
+#define POS_LOG_LEVEL_warn  LogLevel::WARN
+#define POS_LOG_LEVEL_error LogLevel::ERROR
+
+/**
+ * @brief true if a level is compiled in and currently enabled on the logger
+ *
+ * The first operand is a constant expression, so disabled levels fold away.
+ */
+#define POS_LOG_ENABLED(logger_ref, level) \
+    (static_cast<int>(level) <= POS_LOG_COMPILED_LEVEL && (logger_ref).isEnabled(level))
+
+/**
+ * @brief Log a message, evaluating the message expression only when enabled
+ * @param logger_ref Logger instance
+ * @param level LogLevel of the message
+ * @param message_expr Expression producing the message string
+ */
+#define LOG_AT_LEVEL(logger_ref, level, message_expr) \
+    do { \
+        auto& pos_log_ref_ = (logger_ref); \
+        if (POS_LOG_ENABLED(pos_log_ref_, level)) { \
+            pos_log_ref_.log(level, message_expr); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(logger_ref, message_expr) LOG_AT_LEVEL(logger_ref, LogLevel::DEBUG, message_expr)
+#define LOG_INFO(logger_ref, message_expr)  LOG_AT_LEVEL(logger_ref, LogLevel::INFO, message_expr)
+#define LOG_WARN(logger_ref, message_expr)  LOG_AT_LEVEL(logger_ref, LogLevel::WARN, message_expr)
+#define LOG_ERROR(logger_ref, message_expr) LOG_AT_LEVEL(logger_ref, LogLevel::ERROR, message_expr)
+
+/**
+ * @brief Log a stream expression, building the ostringstream only when enabled
+ *
+ * Example: LOG_STREAM(logger_, LogLevel::DEBUG, "handle: " << handle);
+ */
+#define LOG_STREAM(logger_ref, level, stream_expr) \
+    do { \
+        auto& pos_log_ref_ = (logger_ref); \
+        if (POS_LOG_ENABLED(pos_log_ref_, level)) { \
+            std::ostringstream pos_log_oss_; \
+            pos_log_oss_ << stream_expr; \
+            pos_log_ref_.log(level, pos_log_oss_.str()); \
+        } \
+    } while (0)
+
+/**
+ * @brief Log through a static per-call-site format descriptor
+ *
+ * The format is registered once; in binary mode each call then writes only
+ * the descriptor id, a timestamp and the raw arguments. Decode with pos-logcat.
+ *
+ * Example: LOG_STRUCTURED(logger_, LogLevel::DEBUG, "[PUBLISH] {} -> {}", publisher, eventType);
+ */
+#define LOG_STRUCTURED(logger_ref, level, format, ...) \
+    do { \
+        auto& pos_log_ref_ = (logger_ref); \
+        if (POS_LOG_ENABLED(pos_log_ref_, level)) { \
+            static const std::uint32_t pos_log_format_id_ = pos_log_ref_.registerFormat(level, format); \
+            pos_log_ref_.logStructured(pos_log_format_id_, level, format, __VA_ARGS__); \
+        } \
+    } while (0)
+
+/**
+ * @brief Log at most perSecond messages (with a burst) from this call site
+ *
+ * Suppressed messages are counted; the count is appended to the next message
+ * that gets through, or logged as a summary once a minute while the site
+ * stays suppressed.
+ *
+ * Example: LOG_RATE_LIMITED(logger_, LogLevel::WARN, 5, 20, "Retrying " + url);
+ */
+#define LOG_RATE_LIMITED(logger_ref, level, perSecond, burst, message_expr) \
+    do { \
+        auto& pos_log_ref_ = (logger_ref); \
+        if (POS_LOG_ENABLED(pos_log_ref_, level)) { \
+            static LogRateLimiter pos_log_limiter_(perSecond, burst); \
+            std::uint64_t pos_log_suppressed_ = 0; \
+            switch (pos_log_limiter_.acquire(pos_log_suppressed_)) { \
+                case LogRateLimiter::Decision::LOG: \
+                    pos_log_ref_.log(level, LogRateLimiter::annotate(message_expr, pos_log_suppressed_)); \
+                    break; \
+                case LogRateLimiter::Decision::REPORT: \
+                    pos_log_ref_.log(level, LogRateLimiter::summary(__FILE__, __LINE__, pos_log_suppressed_)); \
+                    break; \
+                case LogRateLimiter::Decision::SUPPRESS: \
+                    break; \
+            } \
+        } \
+    } while (0)
+
+/**
+ * @brief Log one in every everyN messages from this call site
+ *
+ * Example: LOG_SAMPLED(logger_, LogLevel::DEBUG, 100, "Polled " + endpoint);
+ */
+#define LOG_SAMPLED(logger_ref, level, everyN, message_expr) \
+    do { \
+        auto& pos_log_ref_ = (logger_ref); \
+        if (POS_LOG_ENABLED(pos_log_ref_, level)) { \
+            static LogSampler pos_log_sampler_(everyN); \
+            if (pos_log_sampler_.sample()) { \
+                pos_log_ref_.log(level, LogSampler::annotate(message_expr, pos_log_sampler_.getEveryN())); \
+            } \
+        } \
+    } while (0)
+
 // ============================================================================
 // Convenient Macros for Common Logging Patterns
 // ============================================================================
+//
+// All of these check the level before building any strings.
 
 /**
  * @brief Log a key-value pair with the logger
@@ -132,7 +261,7 @@ private:
  * @param key_value Value to log
  */
 #define LOG_KEY_VALUE(logger_ref, level_method, key_name, key_value) \
-    logger_ref.level_method(LoggingUtils::formatKeyValue(key_name, key_value))
+    LOG_AT_LEVEL(logger_ref, POS_LOG_LEVEL_##level_method, LoggingUtils::formatKeyValue(key_name, key_value))
 
 /**
  * @brief Log a boolean configuration value
@@ -142,7 +271,7 @@ private:
  * @param config_value Boolean value
  */
 #define LOG_CONFIG_BOOL(logger_ref, level_method, config_key, config_value) \
-    logger_ref.level_method("  - " + LoggingUtils::formatKeyValue(config_key, config_value))
+    LOG_AT_LEVEL(logger_ref, POS_LOG_LEVEL_##level_method, "  - " + LoggingUtils::formatKeyValue(config_key, config_value))
 
 /**
  * @brief Log a string configuration value
@@ -152,7 +281,7 @@ private:
  * @param config_value String value
  */
 #define LOG_CONFIG_STRING(logger_ref, level_method, config_key, config_value) \
-    logger_ref.level_method("  - " + LoggingUtils::formatKeyValue(config_key, config_value))
+    LOG_AT_LEVEL(logger_ref, POS_LOG_LEVEL_##level_method, "  - " + LoggingUtils::formatKeyValue(config_key, config_value))
 
 /**
  * @brief Log an operation status
@@ -161,7 +290,7 @@ private:
  * @param is_success Whether operation succeeded
  */
 #define LOG_OPERATION_STATUS(logger_ref, operation_name, is_success) \
-    logger_ref.info(LoggingUtils::formatStatus(operation_name, is_success ? "SUCCESS" : "FAILED"))
+    LOG_INFO(logger_ref, LoggingUtils::formatStatus(operation_name, is_success ? "SUCCESS" : "FAILED"))
 
 /**
  * @brief Log an error with component context
@@ -171,6 +300,6 @@ private:
  * @param error_msg Error message
  */
 #define LOG_COMPONENT_ERROR(logger_ref, component_name, operation_name, error_msg) \
-    logger_ref.error(LoggingUtils::formatError(component_name, operation_name, error_msg))
+    LOG_ERROR(logger_ref, LoggingUtils::formatError(component_name, operation_name, error_msg))
 
 #endif // LOGGINGUTILS_HPP
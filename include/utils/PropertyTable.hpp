@@ -0,0 +1,78 @@
+#ifndef PROPERTYTABLE_HPP
+#define PROPERTYTABLE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @file PropertyTable.hpp
+ * @brief Shared, parse-once table of <property> values from wt_config.xml
+ *
+ * The Logger and every session's ConfigurationManager read their settings
+ * from the same file. PropertyTable parses it in a single streaming pass and
+ * hands out the same immutable table to all of them; the file is parsed
+ * again only when its size or modification time changes (hot reload).
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class PropertyTable
+ * @brief Process-wide cache of parsed property files
+ */
+class PropertyTable {
+public:
+    using Properties = std::map<std::string, std::string>;
+
+    /**
+     * @brief Gets the process-wide table
+     */
+    static PropertyTable& getInstance();
+
+    // Prevent copying
+    PropertyTable(const PropertyTable&) = delete;
+    PropertyTable& operator=(const PropertyTable&) = delete;
+
+    /**
+     * @brief Gets the properties of a file, parsing it only if needed
+     * @param filePath Configuration file
+     * @return Shared immutable properties, or nullptr if the file cannot be read
+     */
+    std::shared_ptr<const Properties> load(const std::string& filePath);
+
+    /**
+     * @brief Extracts <property name="...">value</property> entries in one pass
+     *
+     * Comments are skipped, values are trimmed and the predefined XML
+     * entities are decoded. Other elements are ignored.
+     *
+     * @param in Stream positioned at the start of the document
+     * @param out Receives the properties (later duplicates win)
+     */
+    static void parse(std::istream& in, Properties& out);
+
+    std::uint64_t getParseCount() const;
+    std::uint64_t getCacheHitCount() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<const Properties> properties;
+        std::filesystem::file_time_type modified;
+        std::uintmax_t size;
+    };
+
+    PropertyTable();
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> files_;
+    std::uint64_t parseCount_;
+    std::uint64_t cacheHitCount_;
+};
+
+#endif // PROPERTYTABLE_HPP
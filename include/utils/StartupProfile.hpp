@@ -0,0 +1,84 @@
+#ifndef STARTUPPROFILE_HPP
+#define STARTUPPROFILE_HPP
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file StartupProfile.hpp
+ * @brief Cold-start timing breakdown
+ *
+ * Startup code wraps its expensive steps in StartupProfile::Phase. When the
+ * first session has finished building, the application calls complete() and
+ * logs the breakdown once; phases that run after that are not recorded.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+/**
+ * @class StartupProfile
+ * @brief Process-wide recorder of named startup phases
+ */
+class StartupProfile {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @class Phase
+     * @brief Times its own lifetime as one startup phase
+     */
+    class Phase {
+    public:
+        explicit Phase(std::string name);
+        ~Phase();
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        std::string name_;
+        Clock::time_point start_;
+    };
+
+    /**
+     * @brief Gets the process-wide profile (its first use is time zero)
+     */
+    static StartupProfile& getInstance();
+
+    // Prevent copying
+    StartupProfile(const StartupProfile&) = delete;
+    StartupProfile& operator=(const StartupProfile&) = delete;
+
+    /**
+     * @brief Records a phase (ignored once startup is complete)
+     */
+    void record(const std::string& name, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * @brief Marks startup as complete
+     * @param report Receives the breakdown, one line per phase
+     * @return True only for the first call
+     */
+    bool complete(std::vector<std::string>& report);
+
+    bool isComplete() const;
+
+private:
+    struct Record {
+        std::string name;
+        Clock::time_point start;
+        Clock::duration elapsed;
+    };
+
+    StartupProfile();
+
+    mutable std::mutex mutex_;
+    Clock::time_point origin_;
+    std::vector<Record> records_;
+    bool complete_;
+};
+
+#endif // STARTUPPROFILE_HPP
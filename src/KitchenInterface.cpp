@@ -3,7 +3,25 @@
 #include <iomanip>
 #include <sstream>
 
-KitchenInterface::KitchenInterface() : wasKitchenBusy_(false) {}
+KitchenInterface::KitchenInterface() : waitingPrepTime_(0), wasKitchenBusy_(false), busyThreshold_(5) {}
+
+void KitchenInterface::setBusyThreshold(size_t threshold) {
+    busyThreshold_ = threshold;
+    
+    // Re-evaluate the busy state against the new threshold
+    bool isBusy = isKitchenBusy();
+    if (isBusy && !wasKitchenBusy_) {
+        wasKitchenBusy_ = true;
+        onKitchenBusy(tickets_.size());
+    } else if (!isBusy && wasKitchenBusy_) {
+        wasKitchenBusy_ = false;
+        onKitchenFree(tickets_.size());
+    }
+    
+    for (auto& [name, station] : stations_) {
+        updateStationBusy(name, *station);
+    }
+}
 
 bool KitchenInterface::sendOrderToKitchen(std::shared_ptr<Order> order) {
     if (!order) return false;
@@ -11,17 +29,30 @@ bool KitchenInterface::sendOrderToKitchen(std::shared_ptr<Order> order) {
     // Create kitchen ticket
     KitchenTicket ticket = createKitchenTicket(order);
     
+    // Add to active tickets; an order sent again replaces its earlier ticket
+    eraseTicket(tickets_, waitingPrepTime_, ticket.orderId);
+    insertTicket(tickets_, waitingPrepTime_, ticket);
+    
+    // Queue its items at the stations that prepare them
+    removeStationTickets(ticket.orderId);
+    Wt::Json::Array stationNames;
+    if (!routing_.empty()) {
+        for (const auto& [name, stationTicket] : createStationTickets(order)) {
+            Station& station = stationFor(name);
+            insertTicket(station.tickets, station.waitingPrepTime, stationTicket);
+            updateStationBusy(name, station);
+            stationNames.push_back(Wt::Json::Value(name));
+        }
+    }
+    
     // Update order status
     order->setStatus(Order::SENT_TO_KITCHEN);
     
-    // Add to active tickets
-    activeTickets_.push_back(ticket);
-    
     // Check for busy state change
     bool isBusy = isKitchenBusy();
     if (isBusy && !wasKitchenBusy_) {
         wasKitchenBusy_ = true;
-        onKitchenBusy(activeTickets_.size());
+        onKitchenBusy(tickets_.size());
     }
     
     // Call extension point
@@ -33,17 +64,24 @@ bool KitchenInterface::sendOrderToKitchen(std::shared_ptr<Order> order) {
     message["orderId"] = Wt::Json::Value(order->getOrderId());
     message["tableNumber"] = Wt::Json::Value(order->getTableNumber());
     message["items"] = Wt::Json::Value(static_cast<int>(order->getItems().size()));
+    message["stations"] = Wt::Json::Value(std::move(stationNames));
     message["timestamp"] = Wt::Json::Value(getCurrentTimestamp());
     
     return broadcastToKitchen(message);
 }
 
 bool KitchenInterface::updateKitchenStatus(int orderId, KitchenStatus status) {
-    int ticketIndex = findTicketIndex(orderId);
-    if (ticketIndex == -1) return false;
+    KitchenStatus oldStatus;
+    if (!setTicketStatus(tickets_, waitingPrepTime_, orderId, status, oldStatus)) return false;
     
-    KitchenStatus oldStatus = activeTickets_[ticketIndex].status;
-    activeTickets_[ticketIndex].status = status;
+    // Station tickets stay until the order is served, so station screens
+    // show their part as ready; an order ready as a whole is ready at
+    // every station
+    if (status == SERVED) {
+        removeStationTickets(orderId);
+    } else if (!isWaiting(status)) {
+        markStationTicketsReady(orderId);
+    }
     
     // Update order status based on kitchen status
     // Note: In a real system, we'd need access to OrderManager here
@@ -55,7 +93,7 @@ bool KitchenInterface::updateKitchenStatus(int orderId, KitchenStatus status) {
     bool isBusy = isKitchenBusy();
     if (!isBusy && wasKitchenBusy_) {
         wasKitchenBusy_ = false;
-        onKitchenFree(activeTickets_.size());
+        onKitchenFree(tickets_.size());
     }
     
     // Broadcast status update
@@ -71,65 +109,72 @@ bool KitchenInterface::updateKitchenStatus(int orderId, KitchenStatus status) {
 
 Wt::Json::Object KitchenInterface::getKitchenQueueStatus() {
     Wt::Json::Object status;
-    status["queueLength"] = Wt::Json::Value(static_cast<int>(activeTickets_.size()));
+    status["queueLength"] = Wt::Json::Value(static_cast<int>(tickets_.size()));
     status["estimatedWaitTime"] = Wt::Json::Value(getEstimatedWaitTime());
     status["isKitchenBusy"] = Wt::Json::Value(isKitchenBusy());
     
     // Add status breakdown
-    std::map<KitchenStatus, int> statusCounts;
-    for (const auto& ticket : activeTickets_) {
-        statusCounts[ticket.status]++;
-    }
-    
     Wt::Json::Object statusBreakdown;
-    statusBreakdown["received"] = Wt::Json::Value(statusCounts[ORDER_RECEIVED]);
-    statusBreakdown["preparing"] = Wt::Json::Value(statusCounts[PREP_STARTED]);
-    statusBreakdown["ready"] = Wt::Json::Value(statusCounts[READY_FOR_PICKUP]);
+    statusBreakdown["received"] = Wt::Json::Value(static_cast<int>(tickets_.count(ORDER_RECEIVED)));
+    statusBreakdown["preparing"] = Wt::Json::Value(static_cast<int>(tickets_.count(PREP_STARTED)));
+    statusBreakdown["ready"] = Wt::Json::Value(static_cast<int>(tickets_.count(READY_FOR_PICKUP)));
     
     status["statusBreakdown"] = statusBreakdown;
+    
+    Wt::Json::Object stations;
+    for (const auto& [name, station] : stations_) {
+        Wt::Json::Object stationStatus;
+        stationStatus["queueLength"] = Wt::Json::Value(static_cast<int>(station->tickets.size()));
+        stationStatus["estimatedWaitTime"] = Wt::Json::Value(
+            estimateWait(station->tickets.size(), station->waitingPrepTime));
+        stationStatus["isBusy"] = Wt::Json::Value(station->tickets.size() > busyThreshold_);
+        stations[name] = Wt::Json::Value(std::move(stationStatus));
+    }
+    status["stations"] = Wt::Json::Value(std::move(stations));
     status["lastUpdated"] = Wt::Json::Value(getCurrentTimestamp());
     
     return status;
 }
 
 std::vector<KitchenInterface::KitchenTicket> KitchenInterface::getActiveTickets() {
-    return activeTickets_;
+    const TicketView tickets = tickets_.queue();
+    return std::vector<KitchenTicket>(tickets.begin(), tickets.end());
 }
 
-const KitchenInterface::KitchenTicket* KitchenInterface::getTicketByOrderId(int orderId) {
-    int index = findTicketIndex(orderId);
-    return (index != -1) ? &activeTickets_[index] : nullptr;
+const KitchenInterface::KitchenTicket* KitchenInterface::getTicketByOrderId(int orderId) const {
+    return tickets_.find(orderId);
 }
 
 bool KitchenInterface::removeTicket(int orderId) {
-    int index = findTicketIndex(orderId);
-    if (index != -1) {
-        activeTickets_.erase(activeTickets_.begin() + index);
-        
-        // Check for busy state change
-        bool isBusy = isKitchenBusy();
-        if (!isBusy && wasKitchenBusy_) {
-            wasKitchenBusy_ = false;
-            onKitchenFree(activeTickets_.size());
-        }
-        
-        return true;
+    if (!eraseTicket(tickets_, waitingPrepTime_, orderId)) {
+        return false;
+    }
+    removeStationTickets(orderId);
+    
+    // Check for busy state change
+    bool isBusy = isKitchenBusy();
+    if (!isBusy && wasKitchenBusy_) {
+        wasKitchenBusy_ = false;
+        onKitchenFree(tickets_.size());
     }
-    return false;
+    
+    return true;
 }
 
 int KitchenInterface::getEstimatedWaitTime() {
-    if (activeTickets_.empty()) return 0;
+    if (tickets_.empty()) return 0;
     
-    int totalTime = 0;
-    for (const auto& ticket : activeTickets_) {
-        if (ticket.status == ORDER_RECEIVED || ticket.status == PREP_STARTED) {
-            totalTime += ticket.estimatedPrepTime;
-        }
-    }
+    return estimateWait(tickets_.size(), waitingPrepTime_);
+}
+
+int KitchenInterface::estimateWait(size_t queueLength, int waitingPrepTime) {
+    if (queueLength == 0) return 0;
+    
+    // Only tickets still waiting or in preparation add to the wait
+    int totalTime = waitingPrepTime;
     
     // Add base wait time based on queue length
-    int baseWaitTime = std::min(static_cast<int>(activeTickets_.size()) * 2, 15);
+    int baseWaitTime = std::min(static_cast<int>(queueLength) * 2, 15);
     
     return std::max(totalTime / 2, baseWaitTime); // Average estimate
 }
@@ -163,21 +208,54 @@ KitchenInterface::KitchenTicket KitchenInterface::createKitchenTicket(std::share
     
     // Extract item names and special instructions
     for (const auto& item : order->getItems()) {
-        for (int i = 0; i < item.getQuantity(); ++i) {
-            ticket.items.push_back(item.getMenuItem().getName());
-        }
-        
-        if (!item.getSpecialInstructions().empty()) {
-            if (!ticket.specialInstructions.empty()) {
-                ticket.specialInstructions += "; ";
-            }
-            ticket.specialInstructions += item.getSpecialInstructions();
-        }
+        addItemToTicket(ticket, item);
     }
     
     return ticket;
 }
 
+std::map<std::string, KitchenInterface::KitchenTicket> KitchenInterface::createStationTickets(
+    std::shared_ptr<Order> order) {
+    std::map<std::string, KitchenTicket> tickets;
+    std::map<std::string, int> lines;
+    const auto now = std::chrono::system_clock::now();
+    const int tableNumber = order->getTableNumber();  // Parsed from the identifier on each call
+    
+    for (const auto& item : order->getItems()) {
+        const std::string station = routeItem(item.getMenuItem());
+        auto [it, created] = tickets.try_emplace(station);
+        KitchenTicket& ticket = it->second;
+        if (created) {
+            ticket.orderId = order->getOrderId();
+            ticket.tableNumber = tableNumber;
+            ticket.timestamp = now;
+            ticket.status = ORDER_RECEIVED;
+            ticket.station = station;
+        }
+        addItemToTicket(ticket, item);
+        ++lines[station];
+    }
+    
+    // Same estimate as a whole order, over the station's lines only
+    for (auto& [station, ticket] : tickets) {
+        ticket.estimatedPrepTime = std::min(5 + lines[station] * 3, 30);
+    }
+    return tickets;
+}
+
+void KitchenInterface::addItemToTicket(KitchenTicket& ticket, const OrderItem& item) {
+    for (int i = 0; i < item.getQuantity(); ++i) {
+        ticket.items.push_back(item.getMenuItem().getName());
+    }
+    
+    if (!item.getSpecialInstructions().empty()) {
+        if (!ticket.specialInstructions.empty()) {
+            ticket.specialInstructions += "; ";
+        }
+        ticket.specialInstructions += item.getSpecialInstructions();
+    }
+}
+
 bool KitchenInterface::broadcastToKitchen(const Wt::Json::Object& message) {
     // In a real implementation, this would send to kitchen display systems
     // For demo purposes, we'll just return true
@@ -201,9 +279,241 @@ std::string KitchenInterface::getCurrentTimestamp() {
     return ss.str();
 }
 
-int KitchenInterface::findTicketIndex(int orderId) {
-    auto it = std::find_if(activeTickets_.begin(), activeTickets_.end(),
-        [orderId](const KitchenTicket& ticket) { return ticket.orderId == orderId; });
+// =================================================================
+// Station routing
+// =================================================================
+
+KitchenInterface::StationRouting KitchenInterface::StationRouting::parse(
+    const std::vector<std::string>& categoryRoutes, const std::vector<std::string>& itemRoutes,
+    std::vector<std::string>* rejected) {
+    static const std::map<std::string, MenuItem::Category> categories = {
+        {"appetizer", MenuItem::APPETIZER},
+        {"main_course", MenuItem::MAIN_COURSE},
+        {"dessert", MenuItem::DESSERT},
+        {"beverage", MenuItem::BEVERAGE},
+        {"special", MenuItem::SPECIAL}
+    };
+    
+    auto reject = [rejected](const std::string& route) {
+        if (rejected) rejected->push_back(route);
+    };
+    
+    StationRouting routing;
+    for (const auto& route : categoryRoutes) {
+        const size_t equals = route.find('=');
+        auto category = categories.find(route.substr(0, equals));
+        if (equals == std::string::npos || equals + 1 == route.size() || category == categories.end()) {
+            reject(route);
+            continue;
+        }
+        routing.byCategory[category->second] = route.substr(equals + 1);
+    }
+    
+    for (const auto& route : itemRoutes) {
+        const size_t equals = route.find('=');
+        if (equals == 0 || equals == std::string::npos || equals + 1 == route.size()) {
+            reject(route);
+            continue;
+        }
+        try {
+            size_t used = 0;
+            const int itemId = std::stoi(route.substr(0, equals), &used);
+            if (used != equals) {
+                reject(route);
+                continue;
+            }
+            routing.byItemId[itemId] = route.substr(equals + 1);
+        } catch (const std::exception&) {
+            reject(route);
+        }
+    }
+    return routing;
+}
+
+void KitchenInterface::setStationRouting(StationRouting routing) {
+    routing_ = std::move(routing);
     
-    return (it != activeTickets_.end()) ? std::distance(activeTickets_.begin(), it) : -1;
+    for (const auto& [category, name] : routing_.byCategory) {
+        stationFor(name);
+    }
+    for (const auto& [itemId, name] : routing_.byItemId) {
+        stationFor(name);
+    }
+    dropUnroutedStations();
+}
+
+std::string KitchenInterface::routeItem(const MenuItem& item) const {
+    auto byId = routing_.byItemId.find(item.getId());
+    if (byId != routing_.byItemId.end()) {
+        return byId->second;
+    }
+    auto byCategory = routing_.byCategory.find(item.getCategory());
+    return byCategory != routing_.byCategory.end() ? byCategory->second : routing_.defaultStation;
+}
+
+std::vector<std::string> KitchenInterface::getStationNames() const {
+    std::vector<std::string> names;
+    names.reserve(stations_.size());
+    for (const auto& [name, station] : stations_) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+KitchenInterface::TicketView KitchenInterface::getStationTickets(const std::string& station) const {
+    const Station* found = findStation(station);
+    return found ? found->tickets.queue() : TicketView();
+}
+
+const KitchenInterface::KitchenTicket* KitchenInterface::getStationTicket(const std::string& station,
+                                                                          int orderId) const {
+    const Station* found = findStation(station);
+    return found ? found->tickets.find(orderId) : nullptr;
+}
+
+bool KitchenInterface::updateStationStatus(const std::string& stationName, int orderId, KitchenStatus status) {
+    auto it = stations_.find(stationName);
+    if (it == stations_.end()) return false;
+    Station& station = *it->second;
+    
+    KitchenStatus oldStatus;
+    if (!setTicketStatus(station.tickets, station.waitingPrepTime, orderId, status, oldStatus)) return false;
+    updateStationBusy(stationName, station);
+    
+    Wt::Json::Object message;
+    message["type"] = Wt::Json::Value("station_status_update");
+    message["station"] = Wt::Json::Value(stationName);
+    message["orderId"] = Wt::Json::Value(orderId);
+    message["status"] = Wt::Json::Value(static_cast<int>(status));
+    message["statusName"] = Wt::Json::Value(kitchenStatusToString(status));
+    message["timestamp"] = Wt::Json::Value(getCurrentTimestamp());
+    bool sent = broadcastToKitchen(message);
+    
+    // Recombine: the order follows its least advanced station
+    bool allReady = true;
+    bool anyStarted = false;
+    for (const auto& [name, other] : stations_) {
+        if (const KitchenTicket* ticket = other->tickets.find(orderId)) {
+            allReady = allReady && !isWaiting(ticket->status);
+            anyStarted = anyStarted || ticket->status != ORDER_RECEIVED;
+        }
+    }
+    
+    const KitchenTicket* whole = tickets_.find(orderId);
+    if (allReady) {
+        if (whole && isWaiting(whole->status)) {
+            sent = updateKitchenStatus(orderId, READY_FOR_PICKUP) && sent;
+            onOrderRecombined(orderId);
+        }
+    } else if (anyStarted && whole && whole->status == ORDER_RECEIVED) {
+        sent = updateKitchenStatus(orderId, PREP_STARTED) && sent;
+    }
+    
+    return sent;
+}
+
+size_t KitchenInterface::getStationQueueLength(const std::string& station) const {
+    const Station* found = findStation(station);
+    return found ? found->tickets.size() : 0;
+}
+
+int KitchenInterface::getStationWaitTime(const std::string& station) const {
+    const Station* found = findStation(station);
+    return found ? estimateWait(found->tickets.size(), found->waitingPrepTime) : 0;
+}
+
+bool KitchenInterface::isStationBusy(const std::string& station) const {
+    return getStationQueueLength(station) > busyThreshold_;
+}
+
+void KitchenInterface::insertTicket(TicketStore& store, int& waitingPrepTime, const KitchenTicket& ticket) {
+    if (store.insert(ticket) && isWaiting(ticket.status)) {
+        waitingPrepTime += ticket.estimatedPrepTime;
+    }
+}
+
+bool KitchenInterface::eraseTicket(TicketStore& store, int& waitingPrepTime, int orderId) {
+    const KitchenTicket* ticket = store.find(orderId);
+    if (!ticket) {
+        return false;
+    }
+    if (isWaiting(ticket->status)) {
+        waitingPrepTime -= ticket->estimatedPrepTime;
+    }
+    return store.erase(orderId);
+}
+
+bool KitchenInterface::setTicketStatus(TicketStore& store, int& waitingPrepTime, int orderId,
+                                       KitchenStatus status, KitchenStatus& oldStatus) {
+    if (!store.setStatus(orderId, status, &oldStatus)) {
+        return false;
+    }
+    if (isWaiting(oldStatus) != isWaiting(status)) {
+        const int prepTime = store.find(orderId)->estimatedPrepTime;
+        waitingPrepTime += isWaiting(status) ? prepTime : -prepTime;
+    }
+    return true;
+}
+
+const KitchenInterface::Station* KitchenInterface::findStation(const std::string& name) const {
+    auto it = stations_.find(name);
+    return it != stations_.end() ? it->second.get() : nullptr;
+}
+
+KitchenInterface::Station& KitchenInterface::stationFor(const std::string& name) {
+    auto& station = stations_[name];
+    if (!station) {
+        station = std::make_unique<Station>();
+    }
+    return *station;
+}
+
+void KitchenInterface::updateStationBusy(const std::string& name, Station& station) {
+    const bool isBusy = station.tickets.size() > busyThreshold_;
+    if (isBusy && !station.wasBusy) {
+        station.wasBusy = true;
+        onStationBusy(name, station.tickets.size());
+    } else if (!isBusy && station.wasBusy) {
+        station.wasBusy = false;
+        onStationFree(name, station.tickets.size());
+    }
+}
+
+void KitchenInterface::removeStationTickets(int orderId) {
+    for (auto& [name, station] : stations_) {
+        if (eraseTicket(station->tickets, station->waitingPrepTime, orderId)) {
+            updateStationBusy(name, *station);
+        }
+    }
+    dropUnroutedStations();
+}
+
+void KitchenInterface::markStationTicketsReady(int orderId) {
+    for (auto& entry : stations_) {
+        Station* station = entry.second.get();
+        const KitchenTicket* ticket = station->tickets.find(orderId);
+        KitchenStatus oldStatus;
+        if (ticket && isWaiting(ticket->status)) {
+            setTicketStatus(station->tickets, station->waitingPrepTime, orderId, READY_FOR_PICKUP, oldStatus);
+        }
+    }
+}
+
+void KitchenInterface::dropUnroutedStations() {
+    // Keeps every routed station, and any station still holding tickets
+    for (auto it = stations_.begin(); it != stations_.end();) {
+        const std::string& name = it->first;
+        bool routed = false;
+        for (const auto& [category, station] : routing_.byCategory) {
+            routed = routed || station == name;
+        }
+        for (const auto& [itemId, station] : routing_.byItemId) {
+            routed = routed || station == name;
+        }
+        if (!routed && it->second->tickets.empty()) {
+            it = stations_.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
@@ -145,6 +145,16 @@ bool Order::isValidTableIdentifier(const std::string& identifier) {
     return false;
 }
 
+std::atomic<double> Order::taxRate_{0.08};
+
+void Order::setTaxRate(double rate) {
+    taxRate_.store(rate, std::memory_order_relaxed);
+}
+
+double Order::getTaxRate() {
+    return taxRate_.load(std::memory_order_relaxed);
+}
+
 std::vector<std::string> Order::getTableIdentifierOptions() {
     std::vector<std::string> options;
     
@@ -168,16 +178,30 @@ void Order::calculateTotals() {
         subtotal_ += item.getTotalPrice();
     }
     
-    tax_ = subtotal_ * TAX_RATE;
+    tax_ = subtotal_ * getTaxRate();
     total_ = subtotal_ + tax_;
 }
 
+OrderSummary::OrderSummary(const Order& order)
+    : orderId(order.getOrderId())
+    , tableIdentifier(order.getTableIdentifier())
+    , tableNumber(order.getTableNumber())
+    , status(order.getStatus())
+    , itemCount(static_cast<int>(order.getItems().size()))
+    , total(order.getTotal())
+    , createdAt(order.getTimestamp()) {
+}
+
 int Order::extractTableNumber() const {
+    return tableNumberOf(tableIdentifier_);
+}
+
+int Order::tableNumberOf(const std::string& identifier) {
     // Extract numeric table number for legacy compatibility
-    if (isDineIn()) {
+    if (identifier.find("table") == 0) {
         std::regex tablePattern(R"(^table (\d+)$)");
         std::smatch match;
-        if (std::regex_match(tableIdentifier_, match, tablePattern)) {
+        if (std::regex_match(identifier, match, tablePattern)) {
             return std::stoi(match[1].str());
         }
     }
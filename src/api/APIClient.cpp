@@ -4,15 +4,284 @@
 
 #include "../../include/api/APIClient.hpp"
 #include "../../include/api/APIConfiguration.hpp"
+#include "../../include/api/APIMetrics.hpp"
+#include "../../include/api/RequestCoalescer.hpp"
+#include "../../include/utils/LoggingUtils.hpp"
+
+#include <Wt/Json/Serializer.h>
+#include <Wt/WApplication.h>
+#include <Wt/WServer.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
+#include <random>
 #include <sstream>
 
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    bool isIdempotent(const HttpTransport::Request& request) {
+        if (request.method == "GET" || request.method == "PUT" || request.method == "DELETE") {
+            return true;
+        }
+        // The middleware applies a keyed write once, however often it arrives
+        return std::any_of(request.headers.begin(), request.headers.end(), [](const auto& header) {
+            return header.first == APIConfiguration::Headers::IDEMPOTENCY_KEY;
+        });
+    }
+    
+    // No answer at all, or the middleware (or a proxy in front of it) failing
+    bool isOutage(const HttpTransport::Response& response) {
+        return response.statusCode == 0 || APIConfiguration::isServerError(response.statusCode);
+    }
+    
+    bool isRetryable(const HttpTransport::Response& response) {
+        switch (response.statusCode) {
+            case 0:
+            case APIConfiguration::StatusCodes::TOO_MANY_REQUESTS:
+            case APIConfiguration::StatusCodes::BAD_GATEWAY:
+            case APIConfiguration::StatusCodes::SERVICE_UNAVAILABLE:
+            case APIConfiguration::StatusCodes::GATEWAY_TIMEOUT:
+                return true;
+            default:
+                return false;
+        }
+    }
+    
+    // Exponential backoff with "equal jitter": half of the delay is fixed and
+    // half random, so sessions that failed together do not retry together
+    std::chrono::milliseconds backoff(int retry, int baseDelayMs) {
+        long long delay = std::max(baseDelayMs, 1);
+        for (int i = 1; i < retry && delay < APIConfiguration::Defaults::MAX_RETRY_DELAY_MS; ++i) {
+            delay *= 2;
+        }
+        delay = std::min<long long>(delay, APIConfiguration::Defaults::MAX_RETRY_DELAY_MS);
+        
+        thread_local std::mt19937 random{std::random_device{}()};
+        std::uniform_int_distribution<long long> jitter(0, delay / 2);
+        return std::chrono::milliseconds(delay - delay / 2 + jitter(random));
+    }
+    
+    // ========================================================================
+    // Atomic operations (https://jsonapi.org/ext/atomic)
+    // ========================================================================
+    
+    const char* const ATOMIC_OPERATIONS = "atomic:operations";
+    const char* const ATOMIC_RESULTS = "atomic:results";
+    
+    std::string jsonString(const std::string& text) {
+        std::string quoted = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+    
+    // "/Order/1001?include=items" -> {"Order", "1001"}
+    std::pair<std::string, std::string> typeAndId(const std::string& endpoint) {
+        std::string path = endpoint.substr(0, endpoint.find('?'));
+        path.erase(0, path.find_first_not_of('/'));
+        while (!path.empty() && path.back() == '/') {
+            path.pop_back();
+        }
+        const std::size_t slash = path.find('/');
+        if (slash == std::string::npos) {
+            return {path, std::string()};
+        }
+        return {path.substr(0, slash), path.substr(slash + 1)};
+    }
+    
+    /**
+     * One entry of "atomic:operations". The body is a serialized resource
+     * object and is spliced in as it is, not parsed again
+     */
+    std::string atomicOperation(const APIClient::Operation& operation) {
+        const auto [type, id] = typeAndId(operation.endpoint);
+        std::string entry = "{\"op\":";
+        if (operation.method == "POST") {
+            entry += "\"add\"";
+        } else if (operation.method == "DELETE") {
+            entry += "\"remove\"";
+        } else {
+            entry += "\"update\"";  // PUT bodies carry every attribute, so a merge replaces them all
+        }
+        if (!id.empty()) {
+            entry += ",\"ref\":{\"type\":" + jsonString(type) + ",\"id\":" + jsonString(id) + "}";
+        }
+        if (operation.method != "DELETE" && !operation.body.empty()) {
+            entry += ",\"data\":" + operation.body;
+        }
+        return entry + "}";
+    }
+    
+    // Resource a write changes, for ordering writes to it; empty if unknown
+    std::string writeTarget(const APIClient::Operation& operation) {
+        auto [type, id] = typeAndId(operation.endpoint);
+        if (id.empty() && operation.method == "POST") {
+            Wt::Json::Object resource;
+            Wt::Json::ParseError error;
+            if (Wt::Json::parse(operation.body, resource, error) &&
+                resource.get("id").type() == Wt::Json::Type::String) {
+                id = static_cast<std::string>(resource.get("id"));
+            }
+        }
+        return id.empty() ? std::string() : type + "/" + id;
+    }
+    
+    // Same writes, same key: a resent batch is applied at most once (FNV-1a)
+    std::string batchKey(const std::vector<APIClient::Operation>& operations) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (const auto& operation : operations) {
+            for (char c : operation.idempotencyKey + "\n") {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+            }
+        }
+        std::ostringstream key;
+        key << "batch-" << std::hex << hash;
+        return key.str();
+    }
+    
+    /**
+     * The operation a rejected atomic request names in its errors
+     * ("source": {"pointer": "/atomic:operations/3"})
+     */
+    struct RejectedOperation {
+        long index = -1;
+        int statusCode = 0;
+        std::string message;
+    };
+    
+    RejectedOperation rejectedOperation(const HttpTransport::Response& response) {
+        RejectedOperation rejected;
+        Wt::Json::Object document;
+        Wt::Json::ParseError error;
+        if (response.statusCode < 400 || response.body.empty() ||
+            !Wt::Json::parse(response.body, document, error) ||
+            document.get("errors").type() != Wt::Json::Type::Array) {
+            return rejected;
+        }
+        
+        const std::string prefix = std::string("/") + ATOMIC_OPERATIONS + "/";
+        for (const auto& item : static_cast<const Wt::Json::Array&>(document.get("errors"))) {
+            if (item.type() != Wt::Json::Type::Object) {
+                continue;
+            }
+            const Wt::Json::Object& problem = item;
+            const Wt::Json::Value& source = problem.get("source");
+            if (source.type() != Wt::Json::Type::Object) {
+                continue;
+            }
+            const Wt::Json::Value& pointer = static_cast<const Wt::Json::Object&>(source).get("pointer");
+            if (pointer.type() != Wt::Json::Type::String ||
+                static_cast<std::string>(pointer).compare(0, prefix.size(), prefix) != 0) {
+                continue;
+            }
+            
+            const std::string path = static_cast<std::string>(pointer).substr(prefix.size());
+            rejected.index = std::strtol(path.c_str(), nullptr, 10);
+            rejected.statusCode = response.statusCode;
+            const Wt::Json::Value& status = problem.get("status");
+            if (status.type() == Wt::Json::Type::String) {
+                rejected.statusCode = std::atoi(static_cast<std::string>(status).c_str());
+            }
+            const Wt::Json::Value& detail = problem.get("detail");
+            const Wt::Json::Value& title = problem.get("title");
+            rejected.message = detail.type() == Wt::Json::Type::String ? static_cast<std::string>(detail)
+                             : title.type() == Wt::Json::Type::String ? static_cast<std::string>(title)
+                             : response.body;
+            break;
+        }
+        return rejected;
+    }
+    
+    // Answers of a middleware without the extension (no pointer to an operation)
+    bool lacksAtomicOperations(int statusCode) {
+        switch (statusCode) {
+            case APIConfiguration::StatusCodes::NOT_FOUND:
+            case APIConfiguration::StatusCodes::METHOD_NOT_ALLOWED:
+            case APIConfiguration::StatusCodes::UNSUPPORTED_MEDIA_TYPE:
+            case APIConfiguration::StatusCodes::NOT_IMPLEMENTED:
+                return true;
+            default:
+                return false;
+        }
+    }
+    
+    APIClient::APIResponse notApplied(const std::string& reason) {
+        APIClient::APIResponse response;
+        response.statusCode = APIConfiguration::StatusCodes::FAILED_DEPENDENCY;
+        response.errorMessage = reason;
+        return response;
+    }
+    
+    // Retry-After in seconds; the HTTP-date form is not used by the middleware
+    std::chrono::milliseconds retryAfter(const HttpTransport::Response& response) {
+        const std::string value = response.header("retry-after");
+        if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+            return std::chrono::milliseconds(0);
+        }
+        try {
+            return std::chrono::seconds(std::stoi(value));
+        } catch (const std::exception&) {
+            return std::chrono::milliseconds(0);
+        }
+    }
+}
+
+/**
+ * One logical request across its attempts
+ */
+struct APIClient::Call {
+    HttpTransport::Request request;
+    std::string circuit;
+    Clock::time_point deadline;
+    APIMetrics::Series* metrics = nullptr;
+    Clock::time_point sentAt;
+    int attempts = 0;
+    int maxRetries = 0;
+    int retryDelayMs = 0;
+    LogComponent* logger = nullptr;
+    HttpTransport::Completion done;
+};
+
+/**
+ * The writes of a batch, sent as individual requests
+ */
+struct APIClient::Pipeline {
+    std::vector<std::shared_ptr<Call>> calls;   // Taken out when sent
+    std::vector<std::string> staleResources;    // Resource each write changes
+    std::vector<std::size_t> next;              // Next write to the same resource, or npos
+    std::vector<bool> waits;                    // Follows an earlier write to its resource
+    
+    std::mutex mutex;
+    std::shared_ptr<BatchResponse> response;
+    std::size_t remaining = 0;
+    BatchDelivery deliver;
+};
+
 APIClient::APIClient(const std::string& baseUrl) 
     : baseUrl_(baseUrl), timeoutSeconds_(APIConfiguration::Defaults::API_TIMEOUT), 
-      debugMode_(false) {
+      maxRetries_(APIConfiguration::Defaults::MAX_RETRIES),
+      retryDelayMs_(APIConfiguration::Defaults::RETRY_DELAY_MS),
+      debugMode_(false),
+      hadLevelBeforeDebug_(false),
+      levelBeforeDebug_(LogLevel::INFO),
+      acceptCompressed_(APIConfiguration::Defaults::ENABLE_COMPRESSION),
+      compressRequestsAbove_(APIConfiguration::Defaults::COMPRESS_REQUESTS_ABOVE),
+      operationsEndpoint_(APIConfiguration::Defaults::ENABLE_ATOMIC_OPERATIONS
+                          ? APIConfiguration::Defaults::DEFAULT_OPERATIONS_ENDPOINT : ""),
+      atomicSupport_(std::make_shared<std::atomic<AtomicSupport>>(AtomicSupport::Unknown)),
+      logger_(Logger::getInstance().getComponent("api.APIClient")) {
     
     initializeDefaults();
-    httpClient_ = std::make_unique<Wt::Http::Client>();
     
     std::cout << "[APIClient] Initialized with base URL: " << baseUrl_ << std::endl;
 }
@@ -20,53 +289,34 @@ APIClient::APIClient(const std::string& baseUrl)
 void APIClient::get(const std::string& endpoint, 
                    const std::map<std::string, std::string>& params,
                    ResponseCallback callback) {
+    sendGet(endpoint, params, bindToSession(std::move(callback)));
+}
+
+void APIClient::sendGet(const std::string& endpoint,
+                        const std::map<std::string, std::string>& params,
+                        Delivery deliverToCaller) {
     
     std::string url = buildUrl(endpoint, params);
     debugLog("GET request to: " + url);
     
-    if (!httpClient_) {
-        APIResponse response;
-        response.success = false;
-        response.errorMessage = "HTTP client not initialized";
-        if (callback) callback(response);
+    // Identical reads already on their way are joined, not repeated. The
+    // query parameters come from a std::map, so equal queries build equal URLs
+    const std::string key = ResponseCache::makeKey(url, authScope());
+    auto flight = RequestCoalescer::getInstance().join(key, std::move(deliverToCaller));
+    if (!flight) {
+        debugLog("Joined GET in flight: " + url);
         return;
     }
+    Delivery deliver = [key, flight](std::shared_ptr<const APIResponse> response) {
+        RequestCoalescer::getInstance().complete(key, flight, std::move(response));
+    };
     
-    try {
-        // Create HTTP message
-        Wt::Http::Message message;
-        addAuthHeaders(message);
-        
-        // For now, we'll implement a simplified version
-        // In a real implementation, you'd use Wt::Http::Client::get()
-        
-        // Simulate API response for demo
-        APIResponse response;
-        response.success = true;
-        response.statusCode = 200;
-        
-        // Create sample JSON:API response
-        Wt::Json::Object sampleData;
-        sampleData["type"] = Wt::Json::Value("Order");
-        sampleData["id"] = Wt::Json::Value("1");
-        
-        Wt::Json::Object attributes;
-        attributes["order_id"] = Wt::Json::Value(1);
-        attributes["table_identifier"] = Wt::Json::Value("table 1");
-        attributes["status"] = Wt::Json::Value("pending");
-        sampleData["attributes"] = attributes;
-        
-        response.data = sampleData;
-        
-        if (callback) callback(response);
-        
-    } catch (const std::exception& e) {
-        // FIXED: Use handleError instead of handleAPIError, and handle return value
-        APIResponse errorResponse = handleError(500, std::string("Exception: ") + e.what());
-        if (callback) {
-            callback(errorResponse);
-        }
+    auto cached = cachedResources_.find(resourceFor(endpoint));
+    if (cached != cachedResources_.end()) {
+        sendCachedGet(endpoint, url, cached->second, std::move(deliver));
+        return;
     }
+    sendRequest("GET", endpoint, url, "", std::move(deliver));
 }
 
 void APIClient::post(const std::string& endpoint,
@@ -75,16 +325,7 @@ void APIClient::post(const std::string& endpoint,
     
     std::string url = buildUrl(endpoint);
     debugLog("POST request to: " + url);
-    
-    // Similar implementation to GET but with request body
-    // For demo, we'll simulate success
-    
-    APIResponse response;
-    response.success = true;
-    response.statusCode = 201;
-    response.data = data; // Echo back the data
-    
-    if (callback) callback(response);
+    sendRequest("POST", endpoint, url, Wt::Json::serialize(data, 0), bindToSession(std::move(callback)));
 }
 
 void APIClient::put(const std::string& endpoint,
@@ -93,14 +334,7 @@ void APIClient::put(const std::string& endpoint,
     
     std::string url = buildUrl(endpoint);
     debugLog("PUT request to: " + url);
-    
-    // Simulate API response for demo
-    APIResponse response;
-    response.success = true;
-    response.statusCode = 200;
-    response.data = data;
-    
-    if (callback) callback(response);
+    sendRequest("PUT", endpoint, url, Wt::Json::serialize(data, 0), bindToSession(std::move(callback)));
 }
 
 void APIClient::patch(const std::string& endpoint,
@@ -109,14 +343,7 @@ void APIClient::patch(const std::string& endpoint,
     
     std::string url = buildUrl(endpoint);
     debugLog("PATCH request to: " + url);
-    
-    // Simulate API response for demo
-    APIResponse response;
-    response.success = true;
-    response.statusCode = 200;
-    response.data = data;
-    
-    if (callback) callback(response);
+    sendRequest("PATCH", endpoint, url, Wt::Json::serialize(data, 0), bindToSession(std::move(callback)));
 }
 
 void APIClient::delete_(const std::string& endpoint,
@@ -124,13 +351,175 @@ void APIClient::delete_(const std::string& endpoint,
     
     std::string url = buildUrl(endpoint);
     debugLog("DELETE request to: " + url);
+    sendRequest("DELETE", endpoint, url, "", bindToSession(std::move(callback)));
+}
+
+AsyncResult<APIClient::SharedResponse> APIClient::getAsync(const std::string& endpoint,
+                                                           const std::map<std::string, std::string>& params) {
+    AsyncResult<SharedResponse> result;
+    sendGet(endpoint, params, settleInSession(result));
+    return result;
+}
+
+AsyncResult<APIClient::SharedResponse> APIClient::postAsync(const std::string& endpoint,
+                                                            const Wt::Json::Object& data) {
+    AsyncResult<SharedResponse> result;
+    std::string url = buildUrl(endpoint);
+    debugLog("POST request to: " + url);
+    sendRequest("POST", endpoint, url, Wt::Json::serialize(data, 0), settleInSession(result));
+    return result;
+}
+
+AsyncResult<APIClient::SharedResponse> APIClient::putAsync(const std::string& endpoint,
+                                                           const Wt::Json::Object& data) {
+    AsyncResult<SharedResponse> result;
+    std::string url = buildUrl(endpoint);
+    debugLog("PUT request to: " + url);
+    sendRequest("PUT", endpoint, url, Wt::Json::serialize(data, 0), settleInSession(result));
+    return result;
+}
+
+AsyncResult<APIClient::SharedResponse> APIClient::patchAsync(const std::string& endpoint,
+                                                             const Wt::Json::Object& data) {
+    AsyncResult<SharedResponse> result;
+    std::string url = buildUrl(endpoint);
+    debugLog("PATCH request to: " + url);
+    sendRequest("PATCH", endpoint, url, Wt::Json::serialize(data, 0), settleInSession(result));
+    return result;
+}
+
+AsyncResult<APIClient::SharedResponse> APIClient::deleteAsync(const std::string& endpoint) {
+    AsyncResult<SharedResponse> result;
+    std::string url = buildUrl(endpoint);
+    debugLog("DELETE request to: " + url);
+    sendRequest("DELETE", endpoint, url, "", settleInSession(result));
+    return result;
+}
+
+AsyncResult<std::shared_ptr<const APIClient::BatchResponse>> APIClient::batchAsync(std::vector<Operation> operations) {
+    AsyncResult<std::shared_ptr<const BatchResponse>> result;
+    auto settle = result.resolver();
+    sendBatch(std::move(operations), postToSession<BatchResponse>(
+        [settle](std::shared_ptr<const BatchResponse> response) {
+            const bool success = response->success();
+            settle(std::move(response), success);
+        }));
+    return result;
+}
+
+void APIClient::sendIdempotent(const std::string& method,
+                               const std::string& endpoint,
+                               const std::string& body,
+                               const std::string& idempotencyKey,
+                               ResponseCallback callback) {
     
-    // Simulate API response for demo
-    APIResponse response;
-    response.success = true;
-    response.statusCode = 204; // No Content
+    std::string url = buildUrl(endpoint);
+    debugLog(method + " request to: " + url + " (key " + idempotencyKey + ")");
+    sendRequest(method, endpoint, url, body, bindToSession(std::move(callback)), idempotencyKey);
+}
+
+void APIClient::batch(std::vector<Operation> operations, BatchCallback callback) {
+    sendBatch(std::move(operations), bindToSession(std::move(callback)));
+}
+
+void APIClient::sendBatch(std::vector<Operation> operations, BatchDelivery deliver) {
+    std::shared_ptr<Pipeline> pipeline = makePipeline(operations);
+    
+    // One write gains nothing from the extension
+    if (operations.size() < 2 || operationsEndpoint_.empty() ||
+        atomicSupport_->load() == AtomicSupport::Unsupported) {
+        debugLog("Batch of " + std::to_string(operations.size()) + " writes sent individually");
+        startPipeline(std::move(pipeline), std::move(deliver));
+        return;
+    }
     
-    if (callback) callback(response);
+    std::string document = std::string("{\"") + ATOMIC_OPERATIONS + "\":[";
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        if (i > 0) {
+            document += ',';
+        }
+        document += atomicOperation(operations[i]);
+    }
+    document += "]}";
+    
+    const std::string url = buildUrl(operationsEndpoint_);
+    HttpTransport::Request request = makeRequest("POST", url, std::move(document));
+    for (auto& [name, value] : request.headers) {
+        if (name == APIConfiguration::Headers::CONTENT_TYPE || name == APIConfiguration::Headers::ACCEPT) {
+            value = APIConfiguration::ContentTypes::JSON_API_ATOMIC;
+        }
+    }
+    const bool keyed = std::all_of(operations.begin(), operations.end(),
+                                   [](const Operation& operation) { return !operation.idempotencyKey.empty(); });
+    if (keyed) {
+        request.headers.emplace_back(APIConfiguration::Headers::IDEMPOTENCY_KEY, batchKey(operations));
+    }
+    debugLog("Batch of " + std::to_string(operations.size()) + " writes to: " + url);
+    
+    // Runs on the transport thread, possibly after this client is gone
+    LogComponent& logger = logger_;
+    auto support = atomicSupport_;
+    const std::size_t count = operations.size();
+    execute(operationsEndpoint_, std::move(request),
+        [&logger, support, pipeline, deliver, count, url](HttpTransport::Response raw) {
+            const RejectedOperation rejected = rejectedOperation(raw);
+            if (rejected.index < 0 && lacksAtomicOperations(raw.statusCode)) {
+                if (support->exchange(AtomicSupport::Unsupported) != AtomicSupport::Unsupported) {
+                    logger.info("[APIClient] " + url + " answered " + std::to_string(raw.statusCode) +
+                                ", sending write batches as individual requests");
+                }
+                startPipeline(pipeline, deliver);
+                return;
+            }
+            
+            APIResponse outcome = parseResponse(raw);
+            auto response = std::make_shared<BatchResponse>();
+            response->atomic = true;
+            
+            if (outcome.success) {
+                support->store(AtomicSupport::Supported);
+                response->results.resize(count);
+                const Wt::Json::Value& results = outcome.data.get(ATOMIC_RESULTS);
+                const Wt::Json::Array* answers = results.type() == Wt::Json::Type::Array
+                    ? &static_cast<const Wt::Json::Array&>(results) : nullptr;
+                for (std::size_t i = 0; i < count; ++i) {
+                    APIResponse& result = response->results[i];
+                    result.success = true;
+                    result.statusCode = outcome.statusCode;
+                    if (answers && i < answers->size() && (*answers)[i].type() == Wt::Json::Type::Object) {
+                        const Wt::Json::Value& data = static_cast<const Wt::Json::Object&>((*answers)[i]).get("data");
+                        if (data.type() == Wt::Json::Type::Object) {
+                            result.data = static_cast<const Wt::Json::Object&>(data);
+                        }
+                    }
+                }
+                for (const std::string& resource : pipeline->staleResources) {
+                    ResponseCache::getInstance().invalidate(resource);
+                    RequestCoalescer::getInstance().invalidate(resource);
+                }
+            } else if (rejected.index >= 0 && static_cast<std::size_t>(rejected.index) < count) {
+                response->results.assign(count, notApplied("Not applied: write " + std::to_string(rejected.index) +
+                                                           " of the batch was rejected"));
+                APIResponse& result = response->results[static_cast<std::size_t>(rejected.index)];
+                result.statusCode = rejected.statusCode;
+                result.errorMessage = rejected.message;
+            } else if (APIConfiguration::isClientError(outcome.statusCode) &&
+                       outcome.statusCode != APIConfiguration::StatusCodes::REQUEST_TIMEOUT &&
+                       outcome.statusCode != APIConfiguration::StatusCodes::TOO_MANY_REQUESTS) {
+                // Rejected without naming a write; nothing was applied, so the
+                // writes can be tried one by one to learn which one it was
+                LOG_DEBUG(logger, "[APIClient] Batch rejected [" + std::to_string(outcome.statusCode) +
+                          "], sending its writes individually");
+                startPipeline(pipeline, deliver);
+                return;
+            } else {
+                response->results.assign(count, outcome);
+            }
+            
+            if (deliver) {
+                deliver(std::move(response));
+            }
+        });
 }
 
 APIClient::APIResponse APIClient::getSync(const std::string& endpoint,
@@ -138,18 +527,7 @@ APIClient::APIResponse APIClient::getSync(const std::string& endpoint,
     
     std::string url = buildUrl(endpoint, params);
     debugLog("Synchronous GET request to: " + url);
-    
-    // For demo, return sample data
-    APIResponse response;
-    response.success = true;
-    response.statusCode = 200;
-    
-    Wt::Json::Object sampleData;
-    sampleData["type"] = Wt::Json::Value("Order");
-    sampleData["id"] = Wt::Json::Value("1");
-    
-    response.data = sampleData;
-    return response;
+    return sendSync("GET", endpoint, url, "");
 }
 
 APIClient::APIResponse APIClient::postSync(const std::string& endpoint,
@@ -157,16 +535,375 @@ APIClient::APIResponse APIClient::postSync(const std::string& endpoint,
     
     std::string url = buildUrl(endpoint);
     debugLog("Synchronous POST request to: " + url);
+    return sendSync("POST", endpoint, url, Wt::Json::serialize(data, 0));
+}
+
+void APIClient::sendRequest(const std::string& method, const std::string& endpoint, const std::string& url,
+                            std::string body, Delivery deliver, const std::string& idempotencyKey) {
     
-    // For demo, return success
-    APIResponse response;
-    response.success = true;
-    response.statusCode = 201;
-    response.data = data;
+    // A successful write makes cached and shared reads of the resource outdated
+    std::string staleResource = (method == "GET") ? std::string() : resourceFor(endpoint);
+    
+    HttpTransport::Request request = makeRequest(method, url, std::move(body));
+    if (!idempotencyKey.empty()) {
+        request.headers.emplace_back(APIConfiguration::Headers::IDEMPOTENCY_KEY, idempotencyKey);
+    }
     
+    // Runs on the transport thread, possibly after this client is gone:
+    // parse there without touching members, deliver in the session
+    LogComponent& logger = logger_;
+    execute(endpoint, std::move(request),
+        [&logger, method, url, staleResource, deliver](HttpTransport::Response raw) {
+            APIResponse response = parseResponse(raw);
+            if (!response.success) {
+                LOG_DEBUG(logger, "[APIClient] " + method + " " + url + " failed [" +
+                          std::to_string(response.statusCode) + "]: " + response.errorMessage);
+            } else if (!staleResource.empty()) {
+                ResponseCache::getInstance().invalidate(staleResource);
+                RequestCoalescer::getInstance().invalidate(staleResource);
+            }
+            if (deliver) {
+                deliver(std::make_shared<const APIResponse>(std::move(response)));
+            }
+        });
+}
+
+APIClient::APIResponse APIClient::sendSync(const std::string& method, const std::string& endpoint,
+                                          const std::string& url, std::string body) {
+    auto promise = std::make_shared<std::promise<HttpTransport::Response>>();
+    std::future<HttpTransport::Response> result = promise->get_future();
+    
+    execute(endpoint, makeRequest(method, url, std::move(body)),
+        [promise](HttpTransport::Response raw) {
+            promise->set_value(std::move(raw));
+        });
+    
+    // The request's timeout (retries included) bounds this wait
+    APIResponse response = parseResponse(result.get());
+    if (response.success && method != "GET") {
+        ResponseCache::getInstance().invalidate(resourceFor(endpoint));
+        RequestCoalescer::getInstance().invalidate(resourceFor(endpoint));
+    }
     return response;
 }
 
+void APIClient::sendCachedGet(const std::string& endpoint, const std::string& url,
+                              std::chrono::seconds staleWhileRevalidate, Delivery deliver) {
+    
+    const std::string key = ResponseCache::makeKey(url, authScope());
+    ResponseCache::Lookup cached = ResponseCache::getInstance().lookup(key, staleWhileRevalidate);
+    
+    HttpTransport::Request request = makeRequest("GET", url, "");
+    if (cached.found) {
+        if (!cached.etag.empty()) {
+            request.headers.emplace_back("If-None-Match", cached.etag);
+        }
+        if (!cached.lastModified.empty()) {
+            request.headers.emplace_back("If-Modified-Since", cached.lastModified);
+        }
+    }
+    
+    LogComponent& logger = logger_;
+    if (cached.servable) {
+        debugLog("Cache hit: " + url);
+        if (deliver) {
+            deliver(decodeCached(key, cached));
+        }
+        if (cached.revalidate) {
+            // Nobody waits for this one; the next GET sees its result
+            execute(endpoint, std::move(request), [&logger, key, url](HttpTransport::Response raw) {
+                const std::string outcome = raw.error.empty() ? std::to_string(raw.statusCode) : raw.error;
+                applyToCache(key, std::move(raw));
+                LOG_DEBUG(logger, "[APIClient] Revalidated " + url + ": " + outcome);
+            });
+        }
+        return;
+    }
+    
+    execute(endpoint, std::move(request),
+        [&logger, key, url, deliver, cached = std::move(cached)](HttpTransport::Response raw) {
+            std::shared_ptr<const APIResponse> response;
+            if (cached.found && isOutage(raw)) {
+                // An old copy serves callers better than an error during an outage
+                LOG_DEBUG(logger, "[APIClient] GET " + url + " failed (" + raw.error +
+                          "), serving cached copy");
+                ResponseCache::getInstance().revalidationFailed(key);
+                response = decodeCached(key, cached);
+            } else {
+                response = applyToCache(key, std::move(raw));
+            }
+            if (deliver) {
+                deliver(std::move(response));
+            }
+        });
+}
+
+std::shared_ptr<const APIClient::APIResponse> APIClient::applyToCache(const std::string& key,
+                                                                      HttpTransport::Response response) {
+    // A 304 becomes the cached response, a 200 is stored, anything else
+    // ends the revalidation
+    ResponseCache& cache = ResponseCache::getInstance();
+    if (response.statusCode == 304) {
+        ResponseCache::Lookup cached;
+        if (cache.refresh(key, response, cached)) {
+            return decodeCached(key, cached);
+        }
+    } else if (response.statusCode == 200 && response.error.empty()) {
+        auto decoded = std::make_shared<const APIResponse>(parseResponse(response));
+        cache.store(key, response, decoded);
+        return decoded;
+    }
+    cache.revalidationFailed(key);
+    return std::make_shared<const APIResponse>(parseResponse(response));
+}
+
+std::shared_ptr<const APIClient::APIResponse> APIClient::decodeCached(const std::string& key,
+                                                                      const ResponseCache::Lookup& cached) {
+    if (cached.decoded) {
+        return std::static_pointer_cast<const APIResponse>(cached.decoded);
+    }
+    auto decoded = std::make_shared<const APIResponse>(parseResponse(cached.response));
+    ResponseCache::getInstance().attachDecoded(key, cached.version, decoded);
+    return decoded;
+}
+
+void APIClient::execute(const std::string& endpoint, HttpTransport::Request request,
+                        HttpTransport::Completion done) const {
+    std::shared_ptr<Call> call = makeCall(endpoint, std::move(request));
+    call->done = std::move(done);
+    dispatch(std::move(call));
+}
+
+std::shared_ptr<APIClient::Call> APIClient::makeCall(const std::string& endpoint,
+                                                     HttpTransport::Request request) const {
+    auto call = std::make_shared<Call>();
+    call->request = std::move(request);
+    call->circuit = resourceFor(endpoint);
+    call->metrics = &APIMetrics::getInstance().series(call->request.method, endpoint);
+    call->deadline = Clock::now() + call->request.timeout;
+    call->maxRetries = maxRetries_;
+    call->retryDelayMs = retryDelayMs_;
+    call->logger = &logger_;
+    return call;
+}
+
+void APIClient::dispatch(std::shared_ptr<Call> call) {
+    if (!CircuitBreaker::getInstance().tryAcquire(call->circuit)) {
+        HttpTransport::Response response;
+        response.error = "Circuit open for " + call->circuit + ", request not sent";
+        if (call->attempts == 0) {
+            call->metrics->reject();
+        } else {
+            call->metrics->finish(Clock::now() - call->sentAt, true);
+        }
+        call->done(std::move(response));
+        return;
+    }
+    
+    // Metrics see one request however many attempts it takes
+    if (call->attempts == 0) {
+        call->sentAt = Clock::now();
+        call->metrics->start();
+    }
+    
+    // Every attempt gets what is left of the caller's timeout
+    ++call->attempts;
+    call->request.timeout = std::max(std::chrono::milliseconds(1),
+        std::chrono::duration_cast<std::chrono::milliseconds>(call->deadline - Clock::now()));
+    
+    // Resent attempts keep their X-Request-ID so the middleware can spot duplicates
+    HttpTransport::getInstance().send(call->request, [call](HttpTransport::Response response) {
+        CircuitBreaker& breaker = CircuitBreaker::getInstance();
+        breaker.recordResult(call->circuit, !isOutage(response));
+        
+        const bool safeToRepeat = isIdempotent(call->request) || !response.requestSent;
+        if (call->attempts <= call->maxRetries && isRetryable(response) && safeToRepeat &&
+            !breaker.isOpen(call->circuit)) {
+            
+            auto delay = std::max(backoff(call->attempts, call->retryDelayMs), retryAfter(response));
+            if (Clock::now() + delay < call->deadline) {
+                LOG_DEBUG(*call->logger, "[APIClient] " + call->request.method + " " + call->request.url +
+                          " attempt " + std::to_string(call->attempts) + " failed (" +
+                          (response.error.empty() ? std::to_string(response.statusCode) : response.error) +
+                          "), retrying in " + std::to_string(delay.count()) + " ms");
+                HttpTransport::getInstance().schedule(delay, [call]() { dispatch(call); });
+                return;
+            }
+        }
+        
+        call->metrics->finish(Clock::now() - call->sentAt, !response.error.empty() || response.statusCode >= 400);
+        call->done(std::move(response));
+    });
+}
+
+std::shared_ptr<APIClient::Pipeline> APIClient::makePipeline(const std::vector<Operation>& operations) {
+    // Built up front: the atomic request may fall back to it after this
+    // client is gone
+    auto pipeline = std::make_shared<Pipeline>();
+    pipeline->next.assign(operations.size(), std::string::npos);
+    pipeline->waits.assign(operations.size(), false);
+    
+    std::map<std::string, std::size_t> lastWrite;  // Resource -> its latest write so far
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        const Operation& operation = operations[i];
+        HttpTransport::Request request = makeRequest(operation.method, buildUrl(operation.endpoint), operation.body);
+        if (!operation.idempotencyKey.empty()) {
+            request.headers.emplace_back(APIConfiguration::Headers::IDEMPOTENCY_KEY, operation.idempotencyKey);
+        }
+        pipeline->calls.push_back(makeCall(operation.endpoint, std::move(request)));
+        pipeline->staleResources.push_back(resourceFor(operation.endpoint));
+        
+        const std::string target = writeTarget(operation);
+        if (target.empty()) {
+            continue;
+        }
+        auto previous = lastWrite.find(target);
+        if (previous != lastWrite.end()) {
+            pipeline->next[previous->second] = i;
+            pipeline->waits[i] = true;
+        }
+        lastWrite[target] = i;
+    }
+    return pipeline;
+}
+
+void APIClient::startPipeline(std::shared_ptr<Pipeline> pipeline, BatchDelivery deliver) {
+    const std::size_t count = pipeline->calls.size();
+    pipeline->deliver = std::move(deliver);
+    pipeline->response = std::make_shared<BatchResponse>();
+    pipeline->response->results.resize(count);
+    pipeline->remaining = count;
+    
+    if (count == 0) {
+        if (pipeline->deliver) {
+            pipeline->deliver(pipeline->response);
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!pipeline->waits[i]) {
+            runPipelined(pipeline, i);
+        }
+    }
+}
+
+void APIClient::runPipelined(std::shared_ptr<Pipeline> pipeline, std::size_t index) {
+    // Taken out of the pipeline, so the completion does not keep itself alive
+    std::shared_ptr<Call> call = std::move(pipeline->calls[index]);
+    call->done = [pipeline, index](HttpTransport::Response raw) {
+        APIResponse result = parseResponse(raw);
+        const bool succeeded = result.success;
+        if (succeeded) {
+            ResponseCache::getInstance().invalidate(pipeline->staleResources[index]);
+            RequestCoalescer::getInstance().invalidate(pipeline->staleResources[index]);
+        }
+        
+        const std::size_t next = pipeline->next[index];
+        bool finished = false;
+        {
+            std::lock_guard<std::mutex> lock(pipeline->mutex);
+            pipeline->response->results[index] = std::move(result);
+            --pipeline->remaining;
+            
+            // Later writes to the resource would apply out of order or to
+            // something that is not there
+            for (std::size_t skipped = succeeded ? std::string::npos : next; skipped != std::string::npos;
+                 skipped = pipeline->next[skipped]) {
+                pipeline->response->results[skipped] =
+                    notApplied("Not sent: an earlier write to the same resource failed");
+                --pipeline->remaining;
+            }
+            finished = pipeline->remaining == 0;
+        }
+        
+        if (succeeded && next != std::string::npos) {
+            runPipelined(pipeline, next);
+        }
+        if (finished && pipeline->deliver) {
+            pipeline->deliver(pipeline->response);
+        }
+    };
+    dispatch(std::move(call));
+}
+
+HttpTransport::Request APIClient::makeRequest(const std::string& method, const std::string& url,
+                                              std::string body) const {
+    HttpTransport::Request request;
+    request.method = method;
+    request.url = url;
+    request.headers = buildHeaders();
+    request.body = std::move(body);
+    request.timeout = std::chrono::seconds(timeoutSeconds_);
+    request.acceptCompressed = acceptCompressed_;
+    request.compressBodyAbove = compressRequestsAbove_;
+    return request;
+}
+
+std::string APIClient::resourceFor(const std::string& endpoint) const {
+    // One circuit per resource: "/Order/17?include=items" -> "<base>/Order"
+    std::size_t start = endpoint.find_first_not_of('/');
+    std::string resource = (start == std::string::npos)
+        ? std::string()
+        : endpoint.substr(start, endpoint.find_first_of("/?", start) - start);
+    
+    std::string base = baseUrl_;
+    while (!base.empty() && base.back() == '/') {
+        base.pop_back();
+    }
+    return base + "/" + resource;
+}
+
+std::string APIClient::authScope() const {
+    // Responses are shared between clients using the same token only; the
+    // token itself is not kept in cache keys
+    if (authToken_.empty()) {
+        return "anonymous";
+    }
+    std::ostringstream scope;
+    scope << std::hex << std::hash<std::string>{}(authToken_);
+    return scope.str();
+}
+
+template<typename Response>
+std::function<void(std::shared_ptr<const Response>)>
+APIClient::postToSession(std::function<void(std::shared_ptr<const Response>)> deliver) {
+    Wt::WApplication* app = Wt::WApplication::instance();
+    Wt::WServer* server = Wt::WServer::instance();
+    if (!app || !server) {
+        return deliver;
+    }
+    
+    // Wt drops the posted function if the session has ended meanwhile. The
+    // response is shared so that posting (which copies the function) does
+    // not copy the parsed document
+    std::string sessionId = app->sessionId();
+    return [server, sessionId, deliver](std::shared_ptr<const Response> response) {
+        server->post(sessionId, [deliver, response]() { deliver(response); });
+    };
+}
+
+APIClient::Delivery APIClient::settleInSession(const AsyncResult<SharedResponse>& result) {
+    auto settle = result.resolver();
+    return postToSession<APIResponse>([settle](SharedResponse response) {
+        const bool success = response->success;
+        settle(std::move(response), success);
+    });
+}
+
+APIClient::Delivery APIClient::bindToSession(ResponseCallback callback) {
+    if (!callback) {
+        return nullptr;
+    }
+    return postToSession<APIResponse>([callback](std::shared_ptr<const APIResponse> response) { callback(*response); });
+}
+
+APIClient::BatchDelivery APIClient::bindToSession(BatchCallback callback) {
+    if (!callback) {
+        return nullptr;
+    }
+    return postToSession<BatchResponse>([callback](std::shared_ptr<const BatchResponse> response) { callback(*response); });
+}
+
 std::string APIClient::buildUrl(const std::string& endpoint,
                                const std::map<std::string, std::string>& params) {
     
@@ -185,68 +922,87 @@ std::string APIClient::buildUrl(const std::string& endpoint,
     return url;
 }
 
-void APIClient::addAuthHeaders(Wt::Http::Message& message) {
+std::vector<std::pair<std::string, std::string>> APIClient::buildHeaders() const {
     // FIXED: Use APIConfiguration static methods
-    auto defaultHeaders = APIConfiguration::getDefaultHeaders();
-    for (const auto& [key, value] : defaultHeaders) {
-        message.addHeader(key, value);
-    }
+    std::vector<std::pair<std::string, std::string>> headers(defaultHeaders_.begin(), defaultHeaders_.end());
     
-    // Add custom headers
-    for (const auto& [key, value] : defaultHeaders_) {
-        message.addHeader(key, value);
+    // Every request gets its own id (the defaults carry the one from construction)
+    for (auto& [key, value] : headers) {
+        if (key == APIConfiguration::Headers::X_REQUEST_ID) {
+            value = APIConfiguration::generateRequestId();
+        }
     }
     
     // Add authentication header if token is set
     if (!authToken_.empty()) {
-        message.addHeader(APIConfiguration::Headers::AUTHORIZATION,
-                         APIConfiguration::buildAuthHeader(authToken_));
+        headers.emplace_back(APIConfiguration::Headers::AUTHORIZATION,
+                             APIConfiguration::buildAuthHeader(authToken_));
     }
+    
+    return headers;
 }
 
-APIClient::APIResponse APIClient::parseResponse(const Wt::Http::Message& response) {
+APIClient::APIResponse APIClient::parseResponse(const HttpTransport::Response& response) {
     APIResponse result;
     
-    // Get status code (this would need to be implemented based on Wt::Http::Message API)
-    // result.statusCode = response.status();
+    if (!response.error.empty()) {
+        result.errorMessage = response.error;
+        return result;
+    }
+    
+    result.statusCode = response.statusCode;
+    if (!APIConfiguration::isSuccessStatus(response.statusCode)) {
+        return handleError(response.statusCode, response.body);
+    }
     
     // Parse JSON response body
-    std::string body = response.body();
+    const std::string& body = response.body;
     
-    if (isValidJson(body)) {
-        try {
-            Wt::Json::Object jsonResponse;
-            Wt::Json::parse(body, jsonResponse);
-            
-            // Parse JSON:API format
-            if (jsonResponse.contains("data")) {
-                auto dataValue = jsonResponse.get("data");
-                if (dataValue.type() == Wt::Json::Type::Object) {
-                    result.data = static_cast<Wt::Json::Object>(dataValue);
-                } else if (dataValue.type() == Wt::Json::Type::Array) {
-                    result.dataArray = static_cast<Wt::Json::Array>(dataValue);
-                }
-            }
-            
-            if (jsonResponse.contains("meta")) {
-                result.meta = static_cast<Wt::Json::Object>(jsonResponse.get("meta"));
-            }
-            
-            if (jsonResponse.contains("included")) {
-                result.included = static_cast<Wt::Json::Array>(jsonResponse.get("included"));
-            }
-            
-            result.success = true;
-            
-        } catch (const std::exception& e) {
-            result.success = false;
-            result.errorMessage = "JSON parsing error: " + std::string(e.what());
-        }
-    } else {
-        result.success = false;
-        result.errorMessage = "Invalid JSON response";
+    if (body.empty()) {
+        // 204 No Content and friends
+        result.success = true;
+        return result;
+    }
+    
+    // One parse; the members of the document are then moved, not copied
+    Wt::Json::Object document;
+    Wt::Json::ParseError error;
+    if (!Wt::Json::parse(body, document, error)) {
+        result.errorMessage = "Invalid JSON response: " + std::string(error.what());
+        return result;
+    }
+    
+    // Parse JSON:API format
+    auto data = document.find("data");
+    if (data == document.end()) {
+        // Plain JSON (e.g. LLM provider APIs): the document is the data
+        result.data = std::move(document);
+        result.success = true;
+        return result;
+    }
+    
+    if (data->second.type() == Wt::Json::Type::Object) {
+        result.data = std::move(static_cast<Wt::Json::Object&>(data->second));
+    } else if (data->second.type() == Wt::Json::Type::Array) {
+        result.dataArray = std::move(static_cast<Wt::Json::Array&>(data->second));
+    }
+    
+    auto meta = document.find("meta");
+    if (meta != document.end() && meta->second.type() == Wt::Json::Type::Object) {
+        result.meta = std::move(static_cast<Wt::Json::Object&>(meta->second));
     }
     
+    auto links = document.find("links");
+    if (links != document.end() && links->second.type() == Wt::Json::Type::Object) {
+        result.links = std::move(static_cast<Wt::Json::Object&>(links->second));
+    }
+    
+    auto included = document.find("included");
+    if (included != document.end() && included->second.type() == Wt::Json::Type::Array) {
+        result.included = std::move(static_cast<Wt::Json::Array&>(included->second));
+    }
+    
+    result.success = true;
     return result;
 }
 
@@ -256,8 +1012,6 @@ APIClient::APIResponse APIClient::handleError(int statusCode, const std::string&
     response.statusCode = statusCode;
     response.errorMessage = body;
     
-    debugLog("API Error [" + std::to_string(statusCode) + "]: " + body);
-    
     return response;
 }
 
@@ -271,22 +1025,75 @@ void APIClient::setTimeout(int seconds) {
     debugLog("Timeout set to " + std::to_string(seconds) + " seconds");
 }
 
+void APIClient::setAtomicOperations(bool enabled, const std::string& endpoint) {
+    operationsEndpoint_ = enabled ? endpoint : std::string();
+    // A new endpoint may well support the extension
+    atomicSupport_ = std::make_shared<std::atomic<AtomicSupport>>(AtomicSupport::Unknown);
+    debugLog(enabled ? "Atomic operations enabled at " + endpoint : std::string("Atomic operations disabled"));
+}
+
+void APIClient::setCompression(bool acceptCompressed, std::size_t compressRequestsAbove) {
+    acceptCompressed_ = acceptCompressed;
+    compressRequestsAbove_ = compressRequestsAbove;
+    if ((acceptCompressed || compressRequestsAbove > 0) && !HttpTransport::isCompressionAvailable()) {
+        debugLog("Compression requested, but this build has no zlib; bodies stay uncompressed");
+    }
+}
+
+void APIClient::enableResponseCache(const std::string& endpoint, std::chrono::seconds staleWhileRevalidate) {
+    cachedResources_[resourceFor(endpoint)] = staleWhileRevalidate;
+    debugLog("Response cache enabled for " + endpoint);
+}
+
+void APIClient::expireCachedResponses(const std::string& endpoint) {
+    ResponseCache::getInstance().markStale(resourceFor(endpoint));
+}
+
+void APIClient::setRetryPolicy(int maxRetries, int retryDelayMs) {
+    maxRetries_ = std::max(maxRetries, 0);
+    retryDelayMs_ = std::max(retryDelayMs, 1);
+    debugLog("Retry policy set to " + std::to_string(maxRetries_) + " retries, " +
+             std::to_string(retryDelayMs_) + " ms initial delay");
+}
+
+bool APIClient::isAvailable(const std::string& endpoint) const {
+    CircuitBreaker& breaker = CircuitBreaker::getInstance();
+    if (endpoint.empty()) {
+        return !breaker.isAnyOpen(resourceFor("/"));
+    }
+    return !breaker.isOpen(resourceFor(endpoint));
+}
+
 void APIClient::setHeaders(const std::map<std::string, std::string>& headers) {
     defaultHeaders_ = headers;
     debugLog("Custom headers updated");
 }
 
 void APIClient::setDebugMode(bool enabled) {
+    if (enabled == debugMode_) {
+        return;
+    }
     debugMode_ = enabled;
+
+    Logger& logger = Logger::getInstance();
     if (enabled) {
-        std::cout << "[APIClient] Debug mode enabled" << std::endl;
+        const auto levels = logger.getComponentLevels();
+        const auto it = levels.find(logger_.getName());
+        hadLevelBeforeDebug_ = it != levels.end();
+        if (hadLevelBeforeDebug_) {
+            levelBeforeDebug_ = it->second;
+        }
+        logger.setComponentLevel(logger_.getName(), LogLevel::DEBUG);
+        logger_.info("[APIClient] Debug mode enabled");
+    } else if (hadLevelBeforeDebug_) {
+        logger.setComponentLevel(logger_.getName(), levelBeforeDebug_);
+    } else {
+        logger.clearComponentLevel(logger_.getName());
     }
 }
 
 void APIClient::debugLog(const std::string& message) {
-    if (debugMode_) {
-        std::cout << "[APIClient DEBUG] " << message << std::endl;
-    }
+    LOG_DEBUG(logger_, "[APIClient] " + message);
 }
 
 void APIClient::initializeDefaults() {
@@ -308,12 +1115,3 @@ std::string APIClient::encodeQueryParams(const std::map<std::string, std::string
     return oss.str();
 }
 
-bool APIClient::isValidJson(const std::string& json) {
-    try {
-        Wt::Json::Value value;
-        Wt::Json::parse(json, value);
-        return true;
-    } catch (const std::exception&) {
-        return false;
-    }
-}
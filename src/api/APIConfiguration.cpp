@@ -16,6 +16,8 @@
 const char* APIConfiguration::Defaults::DEFAULT_BASE_URL = "http://localhost:5656/api";
 const char* APIConfiguration::Defaults::DEFAULT_AUTH_ENDPOINT = "/auth/login";
 const char* APIConfiguration::Defaults::DEFAULT_VERSION = "v1";
+const char* APIConfiguration::Defaults::DEFAULT_OUTBOX_PATH = "data/api_outbox.jsonl";
+const char* APIConfiguration::Defaults::DEFAULT_OPERATIONS_ENDPOINT = "/operations";
 
 const char* APIConfiguration::Headers::CONTENT_TYPE = "Content-Type";
 const char* APIConfiguration::Headers::ACCEPT = "Accept";
@@ -24,9 +26,12 @@ const char* APIConfiguration::Headers::USER_AGENT = "User-Agent";
 const char* APIConfiguration::Headers::X_API_KEY = "X-API-Key";
 const char* APIConfiguration::Headers::X_REQUEST_ID = "X-Request-ID";
 const char* APIConfiguration::Headers::X_CLIENT_VERSION = "X-Client-Version";
+const char* APIConfiguration::Headers::IDEMPOTENCY_KEY = "Idempotency-Key";
 
 const char* APIConfiguration::ContentTypes::JSON = "application/json";
 const char* APIConfiguration::ContentTypes::JSON_API = "application/vnd.api+json";
+const char* APIConfiguration::ContentTypes::JSON_API_ATOMIC =
+    "application/vnd.api+json; ext=\"https://jsonapi.org/ext/atomic\"";
 const char* APIConfiguration::ContentTypes::FORM_URLENCODED = "application/x-www-form-urlencoded";
 const char* APIConfiguration::ContentTypes::MULTIPART_FORM = "multipart/form-data";
 
@@ -114,11 +119,17 @@ std::string APIConfiguration::getStatusDescription(int statusCode) {
         case StatusCodes::UNAUTHORIZED:          return "Unauthorized";
         case StatusCodes::FORBIDDEN:             return "Forbidden";
         case StatusCodes::NOT_FOUND:             return "Not Found";
+        case StatusCodes::METHOD_NOT_ALLOWED:    return "Method Not Allowed";
         case StatusCodes::CONFLICT:              return "Conflict";
+        case StatusCodes::UNSUPPORTED_MEDIA_TYPE: return "Unsupported Media Type";
         case StatusCodes::UNPROCESSABLE_ENTITY:  return "Unprocessable Entity";
+        case StatusCodes::FAILED_DEPENDENCY:     return "Failed Dependency";
+        case StatusCodes::TOO_MANY_REQUESTS:     return "Too Many Requests";
         case StatusCodes::INTERNAL_SERVER_ERROR: return "Internal Server Error";
+        case StatusCodes::NOT_IMPLEMENTED:       return "Not Implemented";
         case StatusCodes::BAD_GATEWAY:           return "Bad Gateway";
         case StatusCodes::SERVICE_UNAVAILABLE:   return "Service Unavailable";
+        case StatusCodes::GATEWAY_TIMEOUT:       return "Gateway Timeout";
         default:
             if (isSuccessStatus(statusCode))      return "Success";
             if (isClientError(statusCode))        return "Client Error";
@@ -170,7 +181,7 @@ std::string APIConfiguration::urlEncode(const std::string& value) {
         if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
             encoded << c;
         } else {
-            encoded << '%' << std::setw(2) << static_cast<unsigned char>(c);
+            encoded << '%' << std::setw(2) << static_cast<int>(static_cast<unsigned char>(c));
         }
     }
     
@@ -0,0 +1,197 @@
+//============================================================================
+// src/api/APIMetrics.cpp - Implementation of APIMetrics
+//============================================================================
+
+#include "../../include/api/APIMetrics.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <iomanip>
+#include <vector>
+
+const std::array<double, APIMetrics::BUCKETS> APIMetrics::BUCKET_BOUNDS = {
+    0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+
+namespace {
+    std::size_t hashOf(const std::string& method, const std::string& route) {
+        return std::hash<std::string>{}(route) * 31 + std::hash<std::string>{}(method);
+    }
+
+    // Label values are quoted; backslash, quote and newline must be escaped
+    std::string escapeLabel(const std::string& value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c : value) {
+            if (c == '\\' || c == '"') {
+                escaped += '\\';
+                escaped += c;
+            } else if (c == '\n') {
+                escaped += "\\n";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    std::string labels(const APIMetrics::Series& series) {
+        return "route=\"" + escapeLabel(series.getRoute()) + "\",method=\"" + escapeLabel(series.getMethod()) + "\"";
+    }
+
+    void family(std::ostream& out, const char* name, const char* type, const char* help) {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << ' ' << type << '\n';
+    }
+}
+
+APIMetrics::Series::Series(std::string method, std::string route)
+    : method_(std::move(method)), route_(std::move(route)), hash_(hashOf(method_, route_)) {
+}
+
+void APIMetrics::Series::start() {
+    inFlight_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void APIMetrics::Series::finish(std::chrono::steady_clock::duration elapsed, bool failed) {
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    const double seconds = static_cast<double>(micros) / 1e6;
+    const std::size_t bucket = static_cast<std::size_t>(
+        std::lower_bound(BUCKET_BOUNDS.begin(), BUCKET_BOUNDS.end(), seconds) - BUCKET_BOUNDS.begin());
+
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    latencyMicros_.fetch_add(static_cast<std::uint64_t>(std::max<std::int64_t>(micros, 0)), std::memory_order_relaxed);
+    requests_.fetch_add(1, std::memory_order_relaxed);
+    if (failed) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    inFlight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void APIMetrics::Series::reject() {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+}
+
+APIMetrics::APIMetrics() : overflow_("other", "other") {
+}
+
+APIMetrics& APIMetrics::getInstance() {
+    static APIMetrics instance;
+    return instance;
+}
+
+APIMetrics::Series& APIMetrics::series(const std::string& method, const std::string& endpoint) {
+    const std::string route = routeFor(endpoint);
+    const std::size_t hash = hashOf(method, route);
+    if (Series* known = find(hash, method, route)) {
+        return *known;
+    }
+
+    std::lock_guard<std::mutex> lock(registerMutex_);
+    if (Series* known = find(hash, method, route)) {
+        return *known;  // Registered while we waited
+    }
+    const std::size_t count = count_.load(std::memory_order_relaxed);
+    if (count == MAX_SERIES) {
+        return overflow_;
+    }
+    series_[count] = std::make_unique<Series>(method, route);
+    count_.store(count + 1, std::memory_order_release);
+    return *series_[count];
+}
+
+APIMetrics::Series* APIMetrics::find(std::size_t hash, const std::string& method, const std::string& route) const {
+    const std::size_t count = count_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; ++i) {
+        Series* candidate = series_[i].get();
+        if (candidate->hash_ == hash && candidate->route_ == route && candidate->method_ == method) {
+            return candidate;
+        }
+    }
+    return nullptr;
+}
+
+std::string APIMetrics::routeFor(const std::string& endpoint) {
+    const std::string path = endpoint.substr(0, endpoint.find('?'));
+
+    std::string route;
+    std::size_t start = 0;
+    while (start < path.size()) {
+        std::size_t end = path.find('/', start);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        if (end > start) {
+            const bool isId = std::all_of(path.begin() + start, path.begin() + end,
+                                          [](unsigned char c) { return std::isdigit(c); });
+            route += '/';
+            route += isId ? std::string("{id}") : path.substr(start, end - start);
+        }
+        start = end + 1;
+    }
+    return route.empty() ? "/" : route;
+}
+
+void APIMetrics::render(std::ostream& out) const {
+    // Series registered after this load are left for the next scrape
+    const std::size_t count = count_.load(std::memory_order_acquire);
+    std::vector<const Series*> all;
+    all.reserve(count + 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        all.push_back(series_[i].get());
+    }
+    if (overflow_.requests_.load(std::memory_order_relaxed) > 0 ||
+        overflow_.rejected_.load(std::memory_order_relaxed) > 0 ||
+        overflow_.inFlight_.load(std::memory_order_relaxed) > 0) {
+        all.push_back(&overflow_);
+    }
+
+    family(out, "pos_api_requests_total", "counter", "Requests sent to the middleware, retries not counted");
+    for (const Series* series : all) {
+        out << "pos_api_requests_total{" << labels(*series) << "} "
+            << series->requests_.load(std::memory_order_relaxed) << '\n';
+    }
+
+    family(out, "pos_api_errors_total", "counter", "Requests that got no answer or a status of 400 or more");
+    for (const Series* series : all) {
+        out << "pos_api_errors_total{" << labels(*series) << "} "
+            << series->errors_.load(std::memory_order_relaxed) << '\n';
+    }
+
+    family(out, "pos_api_rejected_total", "counter", "Requests not sent because the circuit was open");
+    for (const Series* series : all) {
+        out << "pos_api_rejected_total{" << labels(*series) << "} "
+            << series->rejected_.load(std::memory_order_relaxed) << '\n';
+    }
+
+    family(out, "pos_api_requests_in_flight", "gauge", "Requests sent and not answered yet");
+    for (const Series* series : all) {
+        out << "pos_api_requests_in_flight{" << labels(*series) << "} "
+            << series->inFlight_.load(std::memory_order_relaxed) << '\n';
+    }
+
+    family(out, "pos_api_request_duration_seconds", "histogram",
+           "Time from sending a request to its answer, retries included");
+    for (const Series* series : all) {
+        const std::string seriesLabels = labels(*series);
+
+        // Buckets are summed from one read of each, so _count matches +Inf
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i <= BUCKETS; ++i) {
+            cumulative += series->buckets_[i].load(std::memory_order_relaxed);
+            out << "pos_api_request_duration_seconds_bucket{" << seriesLabels << ",le=\"";
+            if (i < BUCKETS) {
+                out << BUCKET_BOUNDS[i];
+            } else {
+                out << "+Inf";
+            }
+            out << "\"} " << cumulative << '\n';
+        }
+        const std::uint64_t micros = series->latencyMicros_.load(std::memory_order_relaxed);
+        out << "pos_api_request_duration_seconds_sum{" << seriesLabels << "} "
+            << micros / 1000000 << '.' << std::setw(6) << std::setfill('0') << micros % 1000000
+            << std::setfill(' ') << '\n'
+            << "pos_api_request_duration_seconds_count{" << seriesLabels << "} " << cumulative << '\n';
+    }
+}
@@ -0,0 +1,140 @@
+//============================================================================
+// src/api/CircuitBreaker.cpp - Implementation of CircuitBreaker
+//============================================================================
+
+#include "../../include/api/CircuitBreaker.hpp"
+#include "../../include/api/APIConfiguration.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+CircuitBreaker::Settings::Settings()
+    : failureThreshold(APIConfiguration::Defaults::CIRCUIT_FAILURE_THRESHOLD)
+    , openDuration(std::chrono::seconds(APIConfiguration::Defaults::CIRCUIT_OPEN_SECONDS)) {}
+
+CircuitBreaker& CircuitBreaker::getInstance() {
+    static CircuitBreaker instance;
+    return instance;
+}
+
+CircuitBreaker::CircuitBreaker()
+    : logger_(Logger::getInstance().getComponent("api.CircuitBreaker")) {}
+
+bool CircuitBreaker::failsFast(const Circuit& circuit, Clock::time_point now) const {
+    switch (circuit.state) {
+        case State::OPEN:
+            return now - circuit.openedAt < settings_.openDuration;
+        case State::HALF_OPEN:
+            return circuit.probeInFlight;
+        default:
+            return false;
+    }
+}
+
+bool CircuitBreaker::tryAcquire(const std::string& circuit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = circuits_.find(circuit);
+    if (it == circuits_.end()) {
+        return true;
+    }
+
+    Circuit& state = it->second;
+    if (failsFast(state, Clock::now())) {
+        return false;
+    }
+    if (state.state != State::CLOSED) {
+        // Open period over: this request is the probe
+        state.state = State::HALF_OPEN;
+        state.probeInFlight = true;
+    }
+    return true;
+}
+
+void CircuitBreaker::recordResult(const std::string& circuit, bool success) {
+    std::string transition;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = circuits_.find(circuit);
+        if (success && it == circuits_.end()) {
+            return;
+        }
+
+        Circuit& state = (it != circuits_.end()) ? it->second : circuits_[circuit];
+        if (success) {
+            if (state.state != State::CLOSED) {
+                transition = "closed, middleware is answering again";
+            }
+            circuits_.erase(it);
+        } else if (state.state == State::HALF_OPEN) {
+            state.state = State::OPEN;
+            state.probeInFlight = false;
+            state.openedAt = Clock::now();
+            transition = "still failing, open again";
+        } else if (state.state == State::CLOSED &&
+                   ++state.consecutiveFailures >= settings_.failureThreshold) {
+            state.state = State::OPEN;
+            state.openedAt = Clock::now();
+            transition = "opened after " + std::to_string(state.consecutiveFailures) +
+                         " consecutive failures, failing fast for " +
+                         std::to_string(settings_.openDuration.count()) + " ms";
+        }
+        // Failures reported while already open (requests sent before it
+        // opened) do not extend the open period
+    }
+
+    if (!transition.empty()) {
+        logger_.warn("[CircuitBreaker] " + circuit + " " + transition);
+    }
+}
+
+bool CircuitBreaker::isOpen(const std::string& circuit) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = circuits_.find(circuit);
+    return it != circuits_.end() && failsFast(it->second, Clock::now());
+}
+
+bool CircuitBreaker::isAnyOpen(const std::string& prefix) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto now = Clock::now();
+    for (auto it = circuits_.lower_bound(prefix); it != circuits_.end(); ++it) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        if (failsFast(it->second, now)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CircuitBreaker::State CircuitBreaker::getState(const std::string& circuit) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = circuits_.find(circuit);
+    return it != circuits_.end() ? it->second.state : State::CLOSED;
+}
+
+void CircuitBreaker::setSettings(const Settings& settings) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    settings_ = settings;
+    if (settings_.failureThreshold < 1) {
+        settings_.failureThreshold = 1;
+    }
+}
+
+CircuitBreaker::Settings CircuitBreaker::getSettings() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return settings_;
+}
+
+void CircuitBreaker::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    circuits_.clear();
+}
+
+std::string CircuitBreaker::stateToString(State state) {
+    switch (state) {
+        case State::CLOSED:    return "CLOSED";
+        case State::OPEN:      return "OPEN";
+        case State::HALF_OPEN: return "HALF_OPEN";
+        default:               return "UNKNOWN";
+    }
+}
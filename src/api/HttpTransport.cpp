@@ -0,0 +1,838 @@
+//============================================================================
+// src/api/HttpTransport.cpp - Implementation of HttpTransport
+//============================================================================
+
+#include "../../include/api/HttpTransport.hpp"
+#include "../../include/utils/Compression.hpp"
+
+#include <boost/asio.hpp>
+#ifdef POS_HAVE_OPENSSL
+#include <boost/asio/ssl.hpp>
+#include <boost/version.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <deque>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <poll.h>
+
+namespace asio = boost::asio;
+using tcp = asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+using ErrorCode = boost::system::error_code;
+
+namespace {
+    // Refuse bodies larger than this rather than buffering without bound
+    constexpr std::size_t MAX_BODY_BYTES = 64 * 1024 * 1024;
+
+    struct Target {
+        bool tls = false;
+        std::string host;
+        std::string port;
+        std::string path;
+
+        std::string key() const { return (tls ? "https://" : "http://") + host + ":" + port; }
+    };
+
+    std::string toLower(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    std::string trim(const std::string& text) {
+        const char* whitespace = " \t\r\n";
+        std::size_t first = text.find_first_not_of(whitespace);
+        if (first == std::string::npos) {
+            return "";
+        }
+        return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+    }
+
+    bool parseUrl(const std::string& url, Target& target, std::string& error) {
+        std::size_t hostStart;
+        if (url.compare(0, 7, "http://") == 0) {
+            hostStart = 7;
+        } else if (url.compare(0, 8, "https://") == 0) {
+            hostStart = 8;
+            target.tls = true;
+        } else {
+            error = "Unsupported URL scheme: " + url;
+            return false;
+        }
+
+        std::size_t pathStart = url.find_first_of("/?", hostStart);
+        std::string authority = url.substr(hostStart, pathStart - hostStart);
+        target.path = (pathStart == std::string::npos) ? "/" : url.substr(pathStart);
+        if (target.path[0] == '?') {
+            target.path.insert(0, "/");
+        }
+
+        std::size_t colon = authority.rfind(':');
+        if (colon != std::string::npos && authority.find(']', colon) == std::string::npos) {
+            target.host = authority.substr(0, colon);
+            target.port = authority.substr(colon + 1);
+        } else {
+            target.host = authority;
+            target.port = target.tls ? "443" : "80";
+        }
+        if (target.host.size() > 2 && target.host.front() == '[' && target.host.back() == ']') {
+            target.host = target.host.substr(1, target.host.size() - 2);
+        }
+
+        if (target.host.empty()) {
+            error = "Missing host in URL: " + url;
+            return false;
+        }
+        return true;
+    }
+
+    bool isIdempotent(const std::string& method) {
+        return method == "GET" || method == "HEAD" || method == "PUT" ||
+               method == "DELETE" || method == "OPTIONS";
+    }
+
+    /**
+     * One TCP (optionally TLS) connection and its read buffer. Bytes left in
+     * the buffer after a response mean the connection is out of sync and it
+     * is not reused.
+     */
+    class Connection {
+    public:
+        Connection(asio::io_context& io, std::string key)
+            : socket(io), key(std::move(key)) {}
+
+        ~Connection() { close(); }
+
+        template<typename Handler>
+        void write(const std::string& data, Handler&& handler) {
+#ifdef POS_HAVE_OPENSSL
+            if (tls) {
+                asio::async_write(*tls, asio::buffer(data), std::forward<Handler>(handler));
+                return;
+            }
+#endif
+            asio::async_write(socket, asio::buffer(data), std::forward<Handler>(handler));
+        }
+
+        template<typename Handler>
+        void readUntil(const char* delimiter, Handler&& handler) {
+#ifdef POS_HAVE_OPENSSL
+            if (tls) {
+                asio::async_read_until(*tls, buffer, delimiter, std::forward<Handler>(handler));
+                return;
+            }
+#endif
+            asio::async_read_until(socket, buffer, delimiter, std::forward<Handler>(handler));
+        }
+
+        template<typename Handler>
+        void readAtLeast(std::size_t bytes, Handler&& handler) {
+#ifdef POS_HAVE_OPENSSL
+            if (tls) {
+                asio::async_read(*tls, buffer, asio::transfer_at_least(bytes), std::forward<Handler>(handler));
+                return;
+            }
+#endif
+            asio::async_read(socket, buffer, asio::transfer_at_least(bytes), std::forward<Handler>(handler));
+        }
+
+        /**
+         * An idle connection the server has closed (or written to) polls
+         * readable; such a connection must not carry the next request.
+         */
+        bool isStale() const {
+            if (!socket.is_open() || buffer.size() > 0) {
+                return true;
+            }
+            pollfd fd{const_cast<tcp::socket&>(socket).native_handle(), POLLIN, 0};
+            return ::poll(&fd, 1, 0) != 0;
+        }
+
+        void close() {
+            ErrorCode ec;
+            socket.shutdown(tcp::socket::shutdown_both, ec);
+            socket.close(ec);
+        }
+
+        tcp::socket socket;
+#ifdef POS_HAVE_OPENSSL
+        std::unique_ptr<asio::ssl::stream<tcp::socket&>> tls;
+#endif
+        asio::streambuf buffer;
+        std::string key;
+        Clock::time_point idleSince;
+    };
+}
+
+// ============================================================================
+// Transport state (touched only on the transport thread, except counters)
+// ============================================================================
+
+struct HttpTransport::Impl {
+    Impl()
+        : work(asio::make_work_guard(io))
+#ifdef POS_HAVE_OPENSSL
+        , tlsContext(asio::ssl::context::tls_client)
+#endif
+        , sweepTimer(io)
+        , sweepScheduled(false)
+        , running(0) {
+#ifdef POS_HAVE_OPENSSL
+        tlsContext.set_default_verify_paths();
+#endif
+    }
+
+    std::shared_ptr<Connection> takeIdle(const std::string& key);
+    void putIdle(std::shared_ptr<Connection> connection);
+    void scheduleSweep();
+    void pump();
+
+    asio::io_context io;
+    asio::executor_work_guard<asio::io_context::executor_type> work;
+#ifdef POS_HAVE_OPENSSL
+    asio::ssl::context tlsContext;
+#endif
+    std::thread thread;
+
+    Limits limits;
+    std::map<std::string, std::deque<std::shared_ptr<Connection>>> idle;
+    std::deque<std::shared_ptr<Exchange>> queue;
+    asio::steady_timer sweepTimer;
+    bool sweepScheduled;
+    std::size_t running;
+
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> connectionsOpened{0};
+    std::atomic<std::uint64_t> connectionsReused{0};
+    std::atomic<std::uint64_t> timeouts{0};
+    std::atomic<std::size_t> inFlight{0};
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::uint64_t> bodyBytesReceived{0};
+    std::atomic<std::uint64_t> bodyBytesDecoded{0};
+};
+
+// ============================================================================
+// Exchange: one request from queueing to completion
+// ============================================================================
+
+class HttpTransport::Exchange : public std::enable_shared_from_this<HttpTransport::Exchange> {
+public:
+    Exchange(Impl& impl, Request request, Completion completion)
+        : impl_(impl)
+        , request_(std::move(request))
+        , completion_(std::move(completion))
+        , deadline_(impl.io)
+        , resolver_(impl.io) {}
+
+    /**
+     * @brief Validates the request and arms the deadline
+     * @return False if the exchange already completed with an error
+     */
+    bool prepare() {
+        std::string error;
+        if (!parseUrl(request_.url, target_, error)) {
+            complete(error);
+            return false;
+        }
+#ifndef POS_HAVE_OPENSSL
+        if (target_.tls) {
+            complete("https is not available (built without OpenSSL): " + request_.url);
+            return false;
+        }
+#endif
+        buildRequestText();
+
+        auto self = shared_from_this();
+        deadline_.expires_after(request_.timeout);
+        deadline_.async_wait([self](const ErrorCode& ec) {
+            if (!ec) {
+                self->onTimeout();
+            }
+        });
+        return true;
+    }
+
+    void start() {
+        started_ = true;
+        connection_ = impl_.takeIdle(target_.key());
+        if (connection_) {
+            reusedConnection_ = true;
+            impl_.connectionsReused.fetch_add(1, std::memory_order_relaxed);
+            writeRequest();
+        } else {
+            connect();
+        }
+    }
+
+    bool isDone() const { return done_; }
+
+private:
+    void buildRequestText() {
+        std::ostringstream out;
+        out << request_.method << ' ' << target_.path << " HTTP/1.1\r\n";
+
+        const bool defaultPort = target_.port == (target_.tls ? "443" : "80");
+        out << "Host: " << target_.host << (defaultPort ? "" : ":" + target_.port) << "\r\n";
+        out << "Connection: keep-alive\r\n";
+        if (request_.acceptCompressed && Compression::isAvailable()) {
+            out << "Accept-Encoding: gzip, deflate\r\n";
+        }
+
+        std::string compressed;
+        const bool compressBody = request_.compressBodyAbove > 0 && request_.body.size() > request_.compressBodyAbove &&
+                                  Compression::gzip(request_.body, compressed);
+        const std::string& body = compressBody ? compressed : request_.body;
+        if (compressBody) {
+            out << "Content-Encoding: gzip\r\n";
+        }
+        if (!body.empty() || request_.method == "POST" ||
+            request_.method == "PUT" || request_.method == "PATCH") {
+            out << "Content-Length: " << body.size() << "\r\n";
+        }
+
+        for (const auto& [name, value] : request_.headers) {
+            const std::string lower = toLower(name);
+            if (lower == "host" || lower == "connection" || lower == "content-length" || value.empty() ||
+                (lower == "accept-encoding" && request_.acceptCompressed) ||
+                (lower == "content-encoding" && compressBody)) {
+                continue;
+            }
+            out << name << ": " << value << "\r\n";
+        }
+        out << "\r\n" << body;
+        requestText_ = out.str();
+    }
+
+    void connect() {
+        connection_ = std::make_shared<Connection>(impl_.io, target_.key());
+        impl_.connectionsOpened.fetch_add(1, std::memory_order_relaxed);
+
+        auto self = shared_from_this();
+        resolver_.async_resolve(target_.host, target_.port,
+            [self](const ErrorCode& ec, tcp::resolver::results_type endpoints) {
+                if (ec) {
+                    self->fail("Cannot resolve " + self->target_.host, ec);
+                    return;
+                }
+                asio::async_connect(self->connection_->socket, endpoints,
+                    [self](const ErrorCode& ec, const tcp::endpoint&) {
+                        if (ec) {
+                            self->fail("Cannot connect to " + self->target_.key(), ec);
+                            return;
+                        }
+                        ErrorCode ignored;
+                        self->connection_->socket.set_option(tcp::no_delay(true), ignored);
+                        self->handshake();
+                    });
+            });
+    }
+
+    void handshake() {
+#ifdef POS_HAVE_OPENSSL
+        if (target_.tls) {
+            auto& tls = connection_->tls;
+            tls = std::make_unique<asio::ssl::stream<tcp::socket&>>(connection_->socket, impl_.tlsContext);
+            SSL_set_tlsext_host_name(tls->native_handle(), target_.host.c_str());
+            tls->set_verify_mode(asio::ssl::verify_peer);
+#if BOOST_VERSION >= 107300
+            tls->set_verify_callback(asio::ssl::host_name_verification(target_.host));
+#else
+            tls->set_verify_callback(asio::ssl::rfc2818_verification(target_.host));
+#endif
+            auto self = shared_from_this();
+            tls->async_handshake(asio::ssl::stream_base::client, [self](const ErrorCode& ec) {
+                if (ec) {
+                    self->fail("TLS handshake with " + self->target_.host + " failed", ec);
+                    return;
+                }
+                self->writeRequest();
+            });
+            return;
+        }
+#endif
+        writeRequest();
+    }
+
+    void writeRequest() {
+        // From here on the server may act on the request even if it fails
+        response_.requestSent = true;
+        auto self = shared_from_this();
+        connection_->write(requestText_, [self](const ErrorCode& ec, std::size_t) {
+            if (ec) {
+                self->fail("Write failed", ec);
+                return;
+            }
+            self->readHeaders();
+        });
+    }
+
+    void readHeaders() {
+        auto self = shared_from_this();
+        connection_->readUntil("\r\n\r\n", [self](const ErrorCode& ec, std::size_t length) {
+            if (ec) {
+                self->fail("No response", ec);
+                return;
+            }
+            self->responseStarted_ = true;
+            self->parseHeaders(self->take(length));
+        });
+    }
+
+    void parseHeaders(const std::string& block) {
+        std::istringstream lines(block);
+        std::string line;
+
+        std::getline(lines, line);
+        std::istringstream statusLine(line);
+        std::string version;
+        statusLine >> version >> response_.statusCode;
+        if (version.compare(0, 5, "HTTP/") != 0 || response_.statusCode < 100) {
+            fail("Malformed status line: " + trim(line), ErrorCode());
+            return;
+        }
+
+        while (std::getline(lines, line)) {
+            std::size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            std::string name = toLower(trim(line.substr(0, colon)));
+            std::string value = trim(line.substr(colon + 1));
+            auto& slot = response_.headers[name];
+            slot = slot.empty() ? value : slot + ", " + value;
+        }
+
+        // Interim responses (100 Continue) are followed by the real one
+        if (response_.statusCode < 200) {
+            response_.headers.clear();
+            readHeaders();
+            return;
+        }
+
+        const std::string connectionHeader = toLower(response_.header("connection"));
+        keepAlive_ = (version == "HTTP/1.1") ? connectionHeader.find("close") == std::string::npos
+                                             : connectionHeader.find("keep-alive") != std::string::npos;
+
+        if (request_.method == "HEAD" || response_.statusCode == 204 || response_.statusCode == 304) {
+            complete("");
+        } else if (toLower(response_.header("transfer-encoding")).find("chunked") != std::string::npos) {
+            readChunkSize();
+        } else if (!response_.header("content-length").empty()) {
+            std::size_t length = 0;
+            try {
+                length = static_cast<std::size_t>(std::stoull(response_.header("content-length")));
+            } catch (const std::exception&) {
+                fail("Invalid Content-Length", ErrorCode());
+                return;
+            }
+            if (length > MAX_BODY_BYTES) {
+                fail("Response body too large", ErrorCode());
+                return;
+            }
+            readBody(length, [self = shared_from_this()]() { self->complete(""); });
+        } else {
+            keepAlive_ = false;
+            readToEnd();
+        }
+    }
+
+    template<typename Next>
+    void readBody(std::size_t length, Next next) {
+        if (connection_->buffer.size() >= length) {
+            response_.body += take(length);
+            next();
+            return;
+        }
+        auto self = shared_from_this();
+        connection_->readAtLeast(length - connection_->buffer.size(),
+            [self, length, next](const ErrorCode& ec, std::size_t) {
+                if (ec) {
+                    self->fail("Response body truncated", ec);
+                    return;
+                }
+                self->response_.body += self->take(length);
+                next();
+            });
+    }
+
+    void readChunkSize() {
+        auto self = shared_from_this();
+        connection_->readUntil("\r\n", [self](const ErrorCode& ec, std::size_t length) {
+            if (ec) {
+                self->fail("Chunked body truncated", ec);
+                return;
+            }
+            std::string line = self->take(length);
+            std::size_t size = 0;
+            try {
+                size = static_cast<std::size_t>(std::stoull(line.substr(0, line.find(';')), nullptr, 16));
+            } catch (const std::exception&) {
+                self->fail("Invalid chunk size", ErrorCode());
+                return;
+            }
+
+            if (size == 0) {
+                self->readTrailers();
+            } else if (self->response_.body.size() + size > MAX_BODY_BYTES) {
+                self->fail("Response body too large", ErrorCode());
+            } else {
+                // Chunk data is followed by CRLF
+                self->readBody(size, [self]() {
+                    self->readBody(2, [self]() {
+                        self->response_.body.resize(self->response_.body.size() - 2);
+                        self->readChunkSize();
+                    });
+                });
+            }
+        });
+    }
+
+    void readTrailers() {
+        auto self = shared_from_this();
+        connection_->readUntil("\r\n", [self](const ErrorCode& ec, std::size_t length) {
+            if (ec) {
+                self->fail("Chunked body truncated", ec);
+                return;
+            }
+            if (self->take(length) == "\r\n") {
+                self->complete("");
+            } else {
+                self->readTrailers();
+            }
+        });
+    }
+
+    void readToEnd() {
+        auto self = shared_from_this();
+        connection_->readAtLeast(1, [self](const ErrorCode& ec, std::size_t) {
+            if (self->connection_->buffer.size() > MAX_BODY_BYTES) {
+                self->fail("Response body too large", ErrorCode());
+                return;
+            }
+            if (!ec) {
+                self->readToEnd();
+                return;
+            }
+            if (ec == asio::error::eof
+#ifdef POS_HAVE_OPENSSL
+                || ec == asio::ssl::error::stream_truncated
+#endif
+                ) {
+                self->response_.body += self->take(self->connection_->buffer.size());
+                self->complete("");
+                return;
+            }
+            self->fail("Response body truncated", ec);
+        });
+    }
+
+    std::string take(std::size_t length) {
+        auto data = connection_->buffer.data();
+        std::string text(asio::buffers_begin(data), asio::buffers_begin(data) + static_cast<std::ptrdiff_t>(length));
+        connection_->buffer.consume(length);
+        return text;
+    }
+
+    void onTimeout() {
+        if (done_) {
+            return;
+        }
+        timedOut_ = true;
+        impl_.timeouts.fetch_add(1, std::memory_order_relaxed);
+
+        if (!started_) {
+            // Still waiting for a slot; pump() skips finished exchanges
+            complete("Request timed out after " + std::to_string(request_.timeout.count()) +
+                     " ms waiting for a connection slot");
+            return;
+        }
+
+        // Aborts the pending operation; its handler reports the timeout
+        resolver_.cancel();
+        if (connection_) {
+            connection_->close();
+        }
+    }
+
+    void fail(const std::string& what, const ErrorCode& ec) {
+        if (done_) {
+            return;
+        }
+        if (timedOut_) {
+            complete("Request timed out after " + std::to_string(request_.timeout.count()) + " ms");
+            return;
+        }
+
+        // A pooled connection closed by the server just before reuse: the
+        // request never got an answer, so an idempotent one is sent again
+        if (reusedConnection_ && !responseStarted_ && !retried_ && isIdempotent(request_.method)) {
+            retried_ = true;
+            reusedConnection_ = false;
+            connection_->close();
+            connect();
+            return;
+        }
+
+        complete(ec ? what + ": " + ec.message() : what);
+    }
+
+    void complete(const std::string& error) {
+        if (done_) {
+            return;
+        }
+        done_ = true;
+        deadline_.cancel();
+
+        if (connection_) {
+            bool reusable = error.empty() && keepAlive_ && connection_->buffer.size() == 0;
+            if (reusable) {
+                impl_.putIdle(std::move(connection_));
+            } else {
+                connection_->close();
+            }
+            connection_.reset();
+        }
+
+        if (started_) {
+            --impl_.running;
+            impl_.inFlight.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        response_.error = error.empty() ? decodeBody() : error;
+        if (!response_.error.empty()) {
+            response_.statusCode = 0;
+        }
+
+        try {
+            if (completion_) {
+                completion_(std::move(response_));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[HttpTransport] Completion for " << request_.url << " threw: " << e.what() << std::endl;
+        }
+        completion_ = nullptr;
+
+        if (started_) {
+            impl_.pump();
+        }
+    }
+
+    /**
+     * @brief Undoes the response's Content-Encoding
+     * @return Error message, empty on success
+     */
+    std::string decodeBody() {
+        impl_.bodyBytesReceived.fetch_add(response_.body.size(), std::memory_order_relaxed);
+
+        auto encoding = response_.headers.find("content-encoding");
+        if (encoding != response_.headers.end() && !response_.body.empty()) {
+            const std::string name = toLower(trim(encoding->second));
+            if (name != "identity") {
+                std::string decoded;
+                if (!Compression::decode(name, response_.body, decoded, MAX_BODY_BYTES)) {
+                    return "Cannot decode " + name + " response body";
+                }
+                response_.body = std::move(decoded);
+            }
+            // The body no longer matches what these described
+            response_.headers.erase(encoding);
+            response_.headers.erase("content-length");
+        }
+
+        impl_.bodyBytesDecoded.fetch_add(response_.body.size(), std::memory_order_relaxed);
+        return "";
+    }
+
+    Impl& impl_;
+    Request request_;
+    Completion completion_;
+    Target target_;
+    std::string requestText_;
+    asio::steady_timer deadline_;
+    tcp::resolver resolver_;
+    std::shared_ptr<Connection> connection_;
+    Response response_;
+
+    bool started_ = false;
+    bool done_ = false;
+    bool timedOut_ = false;
+    bool reusedConnection_ = false;
+    bool responseStarted_ = false;
+    bool retried_ = false;
+    bool keepAlive_ = false;
+};
+
+// ============================================================================
+// Pool management
+// ============================================================================
+
+std::shared_ptr<Connection> HttpTransport::Impl::takeIdle(const std::string& key) {
+    auto it = idle.find(key);
+    if (it == idle.end()) {
+        return nullptr;
+    }
+
+    // Most recently used first: it is the least likely to have been closed
+    auto& connections = it->second;
+    const auto now = Clock::now();
+    while (!connections.empty()) {
+        auto connection = std::move(connections.back());
+        connections.pop_back();
+        if (now - connection->idleSince < limits.idleTimeout && !connection->isStale()) {
+            return connection;
+        }
+        connection->close();
+    }
+    return nullptr;
+}
+
+void HttpTransport::Impl::putIdle(std::shared_ptr<Connection> connection) {
+    auto& connections = idle[connection->key];
+    connection->idleSince = Clock::now();
+    connections.push_back(std::move(connection));
+    while (connections.size() > limits.maxIdlePerHost) {
+        connections.front()->close();
+        connections.pop_front();
+    }
+    scheduleSweep();
+}
+
+void HttpTransport::Impl::scheduleSweep() {
+    if (sweepScheduled) {
+        return;
+    }
+    sweepScheduled = true;
+
+    // Close idle connections the server is about to drop anyway, so they
+    // do not linger in CLOSE_WAIT
+    sweepTimer.expires_after(limits.idleTimeout);
+    sweepTimer.async_wait([this](const ErrorCode& ec) {
+        sweepScheduled = false;
+        if (ec) {
+            return;
+        }
+        const auto now = Clock::now();
+        bool remaining = false;
+        for (auto& [key, connections] : idle) {
+            while (!connections.empty() && now - connections.front()->idleSince >= limits.idleTimeout) {
+                connections.front()->close();
+                connections.pop_front();
+            }
+            remaining = remaining || !connections.empty();
+        }
+        if (remaining) {
+            scheduleSweep();
+        }
+    });
+}
+
+void HttpTransport::Impl::pump() {
+    while (running < limits.maxInFlight && !queue.empty()) {
+        auto exchange = std::move(queue.front());
+        queue.pop_front();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        if (exchange->isDone()) {
+            continue; // Timed out while waiting
+        }
+        ++running;
+        inFlight.fetch_add(1, std::memory_order_relaxed);
+        exchange->start();
+    }
+}
+
+// ============================================================================
+// HttpTransport
+// ============================================================================
+
+std::string HttpTransport::Response::header(const std::string& lowerCaseName) const {
+    auto it = headers.find(lowerCaseName);
+    return it != headers.end() ? it->second : std::string();
+}
+
+HttpTransport& HttpTransport::getInstance() {
+    static HttpTransport instance;
+    return instance;
+}
+
+HttpTransport::HttpTransport()
+    : impl_(std::make_unique<Impl>()) {
+    impl_->thread = std::thread([this]() { impl_->io.run(); });
+}
+
+HttpTransport::~HttpTransport() {
+    impl_->work.reset();
+    impl_->io.stop();
+    if (impl_->thread.joinable()) {
+        impl_->thread.join();
+    }
+}
+
+void HttpTransport::send(Request request, Completion completion) {
+    impl_->requests.fetch_add(1, std::memory_order_relaxed);
+    impl_->queued.fetch_add(1, std::memory_order_relaxed);
+
+    Impl* impl = impl_.get();
+    asio::post(impl->io, [impl, request = std::move(request), completion = std::move(completion)]() mutable {
+        auto exchange = std::make_shared<Exchange>(*impl, std::move(request), std::move(completion));
+        if (!exchange->prepare()) {
+            impl->queued.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+        impl->queue.push_back(std::move(exchange));
+        impl->pump();
+    });
+}
+
+void HttpTransport::schedule(std::chrono::milliseconds delay, std::function<void()> task) {
+    Impl* impl = impl_.get();
+    asio::post(impl->io, [impl, delay, task = std::move(task)]() mutable {
+        auto timer = std::make_shared<asio::steady_timer>(impl->io, delay);
+        timer->async_wait([timer, task = std::move(task)](const ErrorCode& ec) {
+            if (!ec) {
+                task();
+            }
+        });
+    });
+}
+
+void HttpTransport::setLimits(const Limits& limits) {
+    Impl* impl = impl_.get();
+    asio::post(impl->io, [impl, limits]() {
+        impl->limits = limits;
+        if (impl->limits.maxInFlight == 0) {
+            impl->limits.maxInFlight = 1;
+        }
+        impl->pump();
+    });
+}
+
+HttpTransport::Stats HttpTransport::getStats() const {
+    Stats stats;
+    stats.requests = impl_->requests.load(std::memory_order_relaxed);
+    stats.connectionsOpened = impl_->connectionsOpened.load(std::memory_order_relaxed);
+    stats.connectionsReused = impl_->connectionsReused.load(std::memory_order_relaxed);
+    stats.timeouts = impl_->timeouts.load(std::memory_order_relaxed);
+    stats.inFlight = impl_->inFlight.load(std::memory_order_relaxed);
+    stats.queued = impl_->queued.load(std::memory_order_relaxed);
+    stats.bodyBytesReceived = impl_->bodyBytesReceived.load(std::memory_order_relaxed);
+    stats.bodyBytesDecoded = impl_->bodyBytesDecoded.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool HttpTransport::isTlsAvailable() {
+#ifdef POS_HAVE_OPENSSL
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool HttpTransport::isCompressionAvailable() {
+    return Compression::isAvailable();
+}
@@ -0,0 +1,100 @@
+//============================================================================
+// src/api/MetricsResource.cpp - Implementation of MetricsResource
+//============================================================================
+
+#include "../../include/api/MetricsResource.hpp"
+#include "../../include/api/APIMetrics.hpp"
+#include "../../include/api/HttpTransport.hpp"
+#include "../../include/api/MutationOutbox.hpp"
+#include "../../include/api/RequestCoalescer.hpp"
+#include "../../include/api/ResponseCache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+
+#include <unistd.h>
+
+namespace {
+    // Taken during static initialization, close enough to the process start
+    const std::chrono::system_clock::time_point PROCESS_START = std::chrono::system_clock::now();
+
+    template<typename Value>
+    void metric(std::ostream& out, const char* name, const char* type, const char* help, Value value) {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << ' ' << type << '\n'
+            << name << ' ' << value << '\n';
+    }
+
+    // Resident set size from /proc (Linux only); 0 elsewhere
+    std::uint64_t residentBytes() {
+        std::ifstream statm("/proc/self/statm");
+        std::uint64_t totalPages = 0;
+        std::uint64_t residentPages = 0;
+        if (!(statm >> totalPages >> residentPages)) {
+            return 0;
+        }
+        return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+}
+
+MetricsResource::MetricsResource() = default;
+
+MetricsResource::~MetricsResource() {
+    beingDeleted();
+}
+
+void MetricsResource::handleRequest(const Wt::Http::Request&, Wt::Http::Response& response) {
+    response.setMimeType("text/plain; version=0.0.4; charset=utf-8");
+    response.addHeader("Cache-Control", "no-store");
+    render(response.out());
+}
+
+void MetricsResource::render(std::ostream& out) {
+    APIMetrics::getInstance().render(out);
+
+    const HttpTransport::Stats transport = HttpTransport::getInstance().getStats();
+    metric(out, "pos_http_transport_requests_total", "counter", "Attempts put on the wire", transport.requests);
+    metric(out, "pos_http_transport_connections_opened_total", "counter", "Connections opened",
+           transport.connectionsOpened);
+    metric(out, "pos_http_transport_connections_reused_total", "counter", "Requests sent on a kept-alive connection",
+           transport.connectionsReused);
+    metric(out, "pos_http_transport_timeouts_total", "counter", "Attempts that timed out", transport.timeouts);
+    metric(out, "pos_http_transport_in_flight", "gauge", "Attempts on the wire", transport.inFlight);
+    metric(out, "pos_http_transport_queued", "gauge", "Attempts waiting for a free slot", transport.queued);
+    metric(out, "pos_http_transport_body_bytes_received_total", "counter", "Response body bytes as received",
+           transport.bodyBytesReceived);
+    metric(out, "pos_http_transport_body_bytes_decoded_total", "counter",
+           "Response body bytes after Content-Encoding was decoded", transport.bodyBytesDecoded);
+
+    const ResponseCache::Stats cache = ResponseCache::getInstance().getStats();
+    metric(out, "pos_response_cache_hits_total", "counter", "GETs served without waiting for the network", cache.hits);
+    metric(out, "pos_response_cache_not_modified_total", "counter", "304 answers to revalidations", cache.notModified);
+    metric(out, "pos_response_cache_misses_total", "counter", "GETs not found in the cache", cache.misses);
+    metric(out, "pos_response_cache_stores_total", "counter", "Responses stored", cache.stores);
+    metric(out, "pos_response_cache_entries", "gauge", "Responses held", cache.entries);
+
+    const RequestCoalescer::Stats coalescer = RequestCoalescer::getInstance().getStats();
+    metric(out, "pos_request_coalescer_upstream_total", "counter", "GETs sent upstream", coalescer.upstream);
+    metric(out, "pos_request_coalescer_joined_total", "counter", "GETs answered by a request in flight",
+           coalescer.joined);
+    metric(out, "pos_request_coalescer_window_hits_total", "counter", "GETs answered within the coalescing window",
+           coalescer.windowHits);
+    metric(out, "pos_request_coalescer_in_flight", "gauge", "Upstream GETs in flight", coalescer.inFlight);
+
+    const MutationOutbox::Stats outbox = MutationOutbox::getInstance().getStats();
+    metric(out, "pos_outbox_enqueued_total", "counter", "Writes queued", outbox.enqueued);
+    metric(out, "pos_outbox_delivered_total", "counter", "Writes accepted by the middleware", outbox.delivered);
+    metric(out, "pos_outbox_superseded_total", "counter", "Writes replaced by a later PUT before sending",
+           outbox.superseded);
+    metric(out, "pos_outbox_conflicts_total", "counter", "Writes rejected and dropped", outbox.conflicts);
+    metric(out, "pos_outbox_deferred_total", "counter", "Batches stopped by an outage", outbox.deferred);
+    metric(out, "pos_outbox_pending", "gauge", "Writes waiting to be sent", outbox.pending);
+
+    metric(out, "process_start_time_seconds", "gauge", "Start time of the process since the Unix epoch",
+           std::chrono::duration_cast<std::chrono::seconds>(PROCESS_START.time_since_epoch()).count());
+    metric(out, "process_cpu_seconds_total", "counter", "User and system CPU time spent",
+           static_cast<double>(std::clock()) / CLOCKS_PER_SEC);
+    metric(out, "process_resident_memory_bytes", "gauge", "Resident memory size", residentBytes());
+}
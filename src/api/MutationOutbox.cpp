@@ -0,0 +1,630 @@
+//============================================================================
+// src/api/MutationOutbox.cpp - Implementation of MutationOutbox
+//============================================================================
+
+#include "../../include/api/MutationOutbox.hpp"
+#include "../../include/api/APIConfiguration.hpp"
+#include "../../include/api/HttpTransport.hpp"
+#include "../../include/utils/LoggingUtils.hpp"
+
+#include <Wt/Json/Parser.h>
+#include <Wt/Json/Serializer.h>
+#include <Wt/Json/Value.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+// Journal format
+// ============================================================================
+// One JSON object per line, appended in order:
+//   {"op":"queue","seq":7,"key":"...","method":"PUT","endpoint":"/Order/1001",
+//    "group":"Order/1001","body":"{...}","cred":"..."}
+//   {"op":"done","seq":7,"status":200}
+// A write is pending while it has a "queue" record and no "done" record.
+// The journal is rewritten with only pending writes when it is opened, and
+// truncated whenever the queue drains.
+// Auth tokens stay in memory: "cred" only names one, and a name from an
+// earlier run is sent with Settings::authToken. The files are created 0600.
+
+namespace {
+    const char* const OP_QUEUE = "queue";
+    const char* const OP_DONE = "done";
+
+    std::string text(const Wt::Json::Object& record, const std::string& name) {
+        const Wt::Json::Value& value = record.get(name);
+        return value.type() == Wt::Json::Type::String ? static_cast<std::string>(value) : std::string();
+    }
+
+    std::uint64_t sequenceOf(const Wt::Json::Object& record) {
+        const Wt::Json::Value& value = record.get("seq");
+        return value.type() == Wt::Json::Type::Number
+            ? static_cast<std::uint64_t>(static_cast<long long>(value))
+            : 0;
+    }
+
+    // fopen() would leave the journal readable by every local user
+    std::FILE* openPrivate(const std::string& path, bool truncate) {
+        const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND);
+        const int fd = ::open(path.c_str(), flags, 0600);
+        if (fd < 0) {
+            return nullptr;
+        }
+        ::fchmod(fd, 0600);  // Also a file left by an older version
+        std::FILE* file = ::fdopen(fd, truncate ? "w" : "a");
+        if (!file) {
+            ::close(fd);
+        }
+        return file;
+    }
+}
+
+MutationOutbox::Settings::Settings()
+    : journalPath(APIConfiguration::Defaults::DEFAULT_OUTBOX_PATH)
+    , baseUrl(APIConfiguration::Defaults::DEFAULT_BASE_URL)
+    , timeoutSeconds(APIConfiguration::Defaults::API_TIMEOUT)
+    , batchSize(APIConfiguration::Defaults::OUTBOX_BATCH_SIZE)
+    , retryInterval(std::chrono::milliseconds(APIConfiguration::Defaults::OUTBOX_RETRY_MS))
+    , atomicOperations(APIConfiguration::Defaults::ENABLE_ATOMIC_OPERATIONS)
+    , compressRequestsAbove(APIConfiguration::Defaults::COMPRESS_REQUESTS_ABOVE) {}
+
+MutationOutbox& MutationOutbox::getInstance() {
+    static MutationOutbox instance;
+    return instance;
+}
+
+MutationOutbox::MutationOutbox()
+    : logger_(Logger::getInstance().getComponent("api.MutationOutbox")) {
+    // Constructed first, the transport is destroyed after the outbox, so the
+    // worker's last batch can still complete at exit
+    HttpTransport::getInstance();
+}
+
+MutationOutbox::~MutationOutbox() {
+    close();
+}
+
+bool MutationOutbox::open(const Settings& settings) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        if (settings.journalPath != settings_.journalPath || settings.baseUrl != settings_.baseUrl) {
+            logger_.warn("[MutationOutbox] Already open with " + settings_.journalPath + " for " +
+                         settings_.baseUrl + "; ignoring " + settings.journalPath + " for " + settings.baseUrl);
+        }
+        return true;
+    }
+
+    settings_ = settings;
+    settings_.batchSize = std::max<std::size_t>(settings_.batchSize, 1);
+    if (!loadJournal(settings_.journalPath) || !rewriteJournal()) {
+        queue_.clear();
+        return false;
+    }
+
+    client_ = std::make_shared<APIClient>(settings_.baseUrl);
+    client_->setTimeout(settings_.timeoutSeconds);
+    client_->setAtomicOperations(settings_.atomicOperations);
+    client_->setCompression(APIConfiguration::Defaults::ENABLE_COMPRESSION, settings_.compressRequestsAbove);
+    retryAt_ = Clock::now();
+    pending_.store(queue_.size(), std::memory_order_relaxed);
+
+    open_ = true;
+    stopping_ = false;
+    worker_ = std::thread(&MutationOutbox::run, this);
+
+    logger_.info("[MutationOutbox] Opened " + settings_.journalPath + " with " +
+                 std::to_string(queue_.size()) + " queued writes");
+    return true;
+}
+
+void MutationOutbox::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wakeUp_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (journal_) {
+        syncJournal();
+        std::fclose(journal_);
+        journal_ = nullptr;
+    }
+    queue_.clear();
+    credentials_.clear();
+    client_.reset();
+    open_ = false;
+}
+
+bool MutationOutbox::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+std::uint64_t MutationOutbox::enqueue(const std::string& method, const std::string& endpoint,
+                                      const std::string& group, const Wt::Json::Object& body,
+                                      const std::string& authToken) {
+    Mutation mutation;
+    mutation.idempotencyKey = APIConfiguration::generateRequestId();
+    mutation.method = method;
+    mutation.endpoint = endpoint;
+    mutation.group = group;
+    if (method != "DELETE") {
+        mutation.body = Wt::Json::serialize(body, 0);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return 0;
+        }
+
+        mutation.sequence = lastSequence_ + 1;
+        mutation.credential = credentialFor(authToken);
+        if (!appendRecord(toRecord(mutation))) {
+            logger_.error("[MutationOutbox] Could not journal " + method + " " + endpoint);
+            return 0;
+        }
+        lastSequence_ = mutation.sequence;
+        queue_.push_back(mutation);
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        pending_.store(queue_.size(), std::memory_order_relaxed);
+    }
+
+    wakeUp_.notify_one();
+    return mutation.sequence;
+}
+
+void MutationOutbox::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retryAt_ = Clock::now();
+    }
+    wakeUp_.notify_one();
+}
+
+std::size_t MutationOutbox::pendingCount(const std::string& group) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (group.empty()) {
+        return queue_.size();
+    }
+    return static_cast<std::size_t>(std::count_if(queue_.begin(), queue_.end(),
+        [&group](const Mutation& mutation) { return mutation.group == group; }));
+}
+
+std::size_t MutationOutbox::replaceAuthToken(const std::string& previous, const std::string& token) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_ || previous == token) {
+        return 0;
+    }
+
+    std::string from;  // Writes queued without a token send Settings::authToken
+    if (previous != settings_.authToken) {
+        auto it = std::find_if(credentials_.begin(), credentials_.end(),
+            [&previous](const auto& entry) { return entry.second == previous; });
+        if (it == credentials_.end()) {
+            return 0;
+        }
+        from = it->first;
+    }
+    const std::string to = credentialFor(token);
+
+    // The journal only names credentials, so it needs no rewrite; a write in
+    // flight is settled by sequence and does not mind the change
+    std::size_t moved = 0;
+    for (Mutation& mutation : queue_) {
+        if (mutation.credential == from) {
+            mutation.credential = to;
+            ++moved;
+        }
+    }
+    if (!from.empty()) {
+        credentials_.erase(from);
+    }
+    return moved;
+}
+
+int MutationOutbox::addConflictListener(ConflictListener listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int id = nextListenerId_++;
+    listeners_[id] = std::move(listener);
+    return id;
+}
+
+void MutationOutbox::removeConflictListener(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_.erase(id);
+}
+
+MutationOutbox::Stats MutationOutbox::getStats() const {
+    Stats stats;
+    stats.enqueued = enqueued_.load(std::memory_order_relaxed);
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.superseded = superseded_.load(std::memory_order_relaxed);
+    stats.conflicts = conflicts_.load(std::memory_order_relaxed);
+    stats.deferred = deferred_.load(std::memory_order_relaxed);
+    stats.pending = pending_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ============================================================================
+// Journal
+// ============================================================================
+
+bool MutationOutbox::loadJournal(const std::string& path) {
+    queue_.clear();
+    lastSequence_ = 0;
+
+    std::ifstream in(path);
+    if (!in) {
+        return true;  // Nothing queued yet
+    }
+
+    std::map<std::uint64_t, Mutation> pending;
+    std::string line;
+    std::size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (line.empty()) {
+            continue;
+        }
+
+        // A crash can leave the last line incomplete: it was never queued
+        Wt::Json::Object record;
+        Wt::Json::ParseError error;
+        if (!Wt::Json::parse(line, record, error)) {
+            logger_.warn("[MutationOutbox] Skipping unreadable journal line " + std::to_string(lineNumber));
+            continue;
+        }
+
+        const std::string op = text(record, "op");
+        const std::uint64_t sequence = sequenceOf(record);
+        if (sequence == 0) {
+            continue;
+        }
+        lastSequence_ = std::max(lastSequence_, sequence);
+
+        if (op == OP_QUEUE) {
+            Mutation& mutation = pending[sequence];
+            mutation.sequence = sequence;
+            mutation.idempotencyKey = text(record, "key");
+            mutation.method = text(record, "method");
+            mutation.endpoint = text(record, "endpoint");
+            mutation.group = text(record, "group");
+            mutation.body = text(record, "body");
+            // Older journals hold the token itself (or none): keep it for
+            // this run only, open() rewrites the journal without it
+            mutation.credential = record.contains("token") ? credentialFor(text(record, "token"))
+                                                           : text(record, "cred");
+        } else if (op == OP_DONE) {
+            pending.erase(sequence);
+        }
+    }
+
+    for (auto& entry : pending) {
+        queue_.push_back(std::move(entry.second));
+    }
+    return true;
+}
+
+bool MutationOutbox::rewriteJournal() {
+    if (journal_) {
+        std::fclose(journal_);
+        journal_ = nullptr;
+    }
+
+    const std::filesystem::path path(settings_.journalPath);
+    std::error_code ec;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    // Write the pending records beside the journal, then swap them in, so a
+    // crash leaves either the old journal or the new one
+    const std::string tempPath = settings_.journalPath + ".tmp";
+    std::FILE* temp = openPrivate(tempPath, true);
+    if (!temp) {
+        logger_.error("[MutationOutbox] Cannot write " + tempPath);
+        return false;
+    }
+    bool written = true;
+    for (const Mutation& mutation : queue_) {
+        const std::string line = Wt::Json::serialize(toRecord(mutation), 0) + "\n";
+        written = written && std::fwrite(line.data(), 1, line.size(), temp) == line.size();
+    }
+    written = written && std::fflush(temp) == 0 && ::fsync(::fileno(temp)) == 0;
+    std::fclose(temp);
+
+    if (written) {
+        std::filesystem::rename(tempPath, path, ec);
+        written = !ec;
+    }
+    if (!written) {
+        std::filesystem::remove(tempPath, ec);
+        logger_.error("[MutationOutbox] Cannot rewrite " + settings_.journalPath);
+        return false;
+    }
+
+    journal_ = openPrivate(settings_.journalPath, false);
+    if (!journal_) {
+        logger_.error("[MutationOutbox] Cannot open " + settings_.journalPath);
+        return false;
+    }
+    return true;
+}
+
+bool MutationOutbox::appendRecord(const Wt::Json::Object& record) {
+    if (!journal_) {
+        return false;
+    }
+    const std::string line = Wt::Json::serialize(record, 0) + "\n";
+    return std::fwrite(line.data(), 1, line.size(), journal_) == line.size() &&
+           std::fflush(journal_) == 0;
+}
+
+void MutationOutbox::syncJournal() {
+    if (journal_) {
+        std::fflush(journal_);
+        ::fsync(::fileno(journal_));
+    }
+}
+
+Wt::Json::Object MutationOutbox::toRecord(const Mutation& mutation) {
+    Wt::Json::Object record;
+    record["op"] = Wt::Json::Value(OP_QUEUE);
+    record["seq"] = Wt::Json::Value(static_cast<long long>(mutation.sequence));
+    record["key"] = Wt::Json::Value(mutation.idempotencyKey);
+    record["method"] = Wt::Json::Value(mutation.method);
+    record["endpoint"] = Wt::Json::Value(mutation.endpoint);
+    record["group"] = Wt::Json::Value(mutation.group);
+    record["body"] = Wt::Json::Value(mutation.body);
+    if (!mutation.credential.empty()) {
+        record["cred"] = Wt::Json::Value(mutation.credential);
+    }
+    return record;
+}
+
+std::string MutationOutbox::credentialFor(const std::string& token) {
+    if (token.empty() || token == settings_.authToken) {
+        return std::string();
+    }
+    for (const auto& entry : credentials_) {
+        if (entry.second == token) {
+            return entry.first;
+        }
+    }
+    // Random, so a name left in the journal by an earlier run never matches
+    const std::string credential = APIConfiguration::generateRequestId();
+    credentials_[credential] = token;
+    return credential;
+}
+
+std::string MutationOutbox::tokenFor(const std::string& credential) const {
+    auto it = credentials_.find(credential);
+    return it != credentials_.end() ? it->second : settings_.authToken;
+}
+
+// ============================================================================
+// Draining
+// ============================================================================
+
+bool MutationOutbox::isRejection(int statusCode) {
+    // Auth failures and throttling are worth retrying once the cause is fixed
+    switch (statusCode) {
+        case APIConfiguration::StatusCodes::UNAUTHORIZED:
+        case APIConfiguration::StatusCodes::FORBIDDEN:
+        case APIConfiguration::StatusCodes::REQUEST_TIMEOUT:
+        case APIConfiguration::StatusCodes::TOO_MANY_REQUESTS:
+        case APIConfiguration::StatusCodes::FAILED_DEPENDENCY:
+            return false;
+        default:
+            return APIConfiguration::isClientError(statusCode);
+    }
+}
+
+std::vector<MutationOutbox::Send> MutationOutbox::nextBatch() const {
+    // Only the oldest write of each group may go: a later one could
+    // otherwise overtake it
+    std::vector<Send> batch;
+    std::map<std::string, std::size_t> heads;  // Group -> its entry in batch
+    std::set<std::string> blocked;             // Groups with a write that must wait
+    for (const Mutation& mutation : queue_) {
+        // One request carries one token: writes with another wait for a
+        // later batch, and so does the rest of their group
+        if (!batch.empty() && mutation.credential != batch.front().mutation.credential) {
+            if (!mutation.group.empty()) {
+                blocked.insert(mutation.group);
+            }
+            continue;
+        }
+        if (mutation.group.empty()) {
+            if (batch.size() < settings_.batchSize) {
+                batch.push_back(Send{mutation, {mutation.sequence}});
+            }
+            continue;
+        }
+        if (blocked.count(mutation.group)) {
+            continue;
+        }
+
+        auto head = heads.find(mutation.group);
+        if (head == heads.end()) {
+            if (batch.size() < settings_.batchSize) {
+                heads[mutation.group] = batch.size();
+                batch.push_back(Send{mutation, {mutation.sequence}});
+            } else {
+                blocked.insert(mutation.group);
+            }
+            continue;
+        }
+
+        // A PUT replaces the whole resource: the newer one carries both
+        Send& pending = batch[head->second];
+        if (mutation.method == "PUT" && pending.mutation.method == "PUT" &&
+            mutation.endpoint == pending.mutation.endpoint) {
+            pending.mutation = mutation;
+            pending.settles.push_back(mutation.sequence);
+        } else {
+            blocked.insert(mutation.group);
+        }
+    }
+    return batch;
+}
+
+std::vector<MutationOutbox::Outcome> MutationOutbox::send(const std::vector<Send>& batch) {
+    struct Pending {
+        std::mutex mutex;
+        std::condition_variable answered;
+        std::vector<Outcome> outcomes;
+        bool done = false;
+    };
+    auto pending = std::make_shared<Pending>();
+
+    // Groups are independent, but one atomic request is still one round trip
+    // instead of one per group
+    std::vector<APIClient::Operation> operations;
+    operations.reserve(batch.size());
+    for (const Send& send : batch) {
+        const Mutation& mutation = send.mutation;
+        operations.push_back(APIClient::Operation{mutation.method, mutation.endpoint, mutation.body,
+                                                  mutation.idempotencyKey});
+    }
+
+    client_->batch(std::move(operations), [pending](const APIClient::BatchResponse& response) {
+        std::vector<Outcome> outcomes;
+        outcomes.reserve(response.results.size());
+        for (const APIClient::APIResponse& result : response.results) {
+            Outcome outcome;
+            outcome.delivered = result.success;
+            outcome.rejected = !result.success && isRejection(result.statusCode);
+            outcome.statusCode = result.statusCode;
+            outcome.message = result.errorMessage;
+            outcomes.push_back(std::move(outcome));
+        }
+
+        std::lock_guard<std::mutex> lock(pending->mutex);
+        pending->outcomes = std::move(outcomes);
+        pending->done = true;
+        pending->answered.notify_one();
+    });
+
+    // Every request ends by its timeout, so this wait is bounded
+    std::unique_lock<std::mutex> lock(pending->mutex);
+    pending->answered.wait(lock, [&pending]() { return pending->done; });
+    return std::move(pending->outcomes);
+}
+
+void MutationOutbox::settle(const std::vector<Send>& batch, const std::vector<Outcome>& outcomes,
+                            std::vector<Conflict>& conflicts) {
+    bool deferred = false;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const Mutation& mutation = batch[i].mutation;
+        const std::vector<std::uint64_t>& settles = batch[i].settles;
+        const Outcome& outcome = outcomes[i];
+
+        if (!outcome.delivered && !outcome.rejected) {
+            // Held back by another write's rejection: the next batch sends it
+            if (outcome.statusCode != APIConfiguration::StatusCodes::FAILED_DEPENDENCY) {
+                deferred = true;
+            }
+            continue;
+        }
+
+        for (std::uint64_t sequence : settles) {
+            Wt::Json::Object record;
+            record["op"] = Wt::Json::Value(OP_DONE);
+            record["seq"] = Wt::Json::Value(static_cast<long long>(sequence));
+            record["status"] = Wt::Json::Value(outcome.statusCode);
+            appendRecord(record);
+        }
+
+        // Settled writes are the oldest of their group, but other groups'
+        // writes may sit between them
+        queue_.erase(std::remove_if(queue_.begin(), queue_.end(),
+            [&settles](const Mutation& queued) {
+                return std::find(settles.begin(), settles.end(), queued.sequence) != settles.end();
+            }),
+            queue_.end());
+        superseded_.fetch_add(settles.size() - 1, std::memory_order_relaxed);
+
+        if (outcome.delivered) {
+            delivered_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            conflicts_.fetch_add(1, std::memory_order_relaxed);
+            logger_.warn("[MutationOutbox] " + mutation.method + " " + mutation.endpoint + " rejected [" +
+                         std::to_string(outcome.statusCode) + "]: " + outcome.message);
+            conflicts.push_back(Conflict{mutation, outcome.statusCode, outcome.message});
+        }
+    }
+
+    if (deferred) {
+        deferred_.fetch_add(1, std::memory_order_relaxed);
+        retryAt_ = Clock::now() + settings_.retryInterval;
+        LOG_RATE_LIMITED(logger_, LogLevel::WARN, 5, 60,
+                         "[MutationOutbox] Middleware unreachable, " + std::to_string(queue_.size()) +
+                         " writes kept for retry");
+    }
+
+    // Drained: start the journal over instead of letting it grow
+    if (queue_.empty() && journal_) {
+        std::fclose(journal_);
+        std::FILE* truncated = openPrivate(settings_.journalPath, true);
+        journal_ = truncated ? truncated : openPrivate(settings_.journalPath, false);
+        credentials_.clear();
+    }
+    pending_.store(queue_.size(), std::memory_order_relaxed);
+}
+
+void MutationOutbox::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (queue_.empty()) {
+            wakeUp_.wait(lock);
+            continue;
+        }
+        if (Clock::now() < retryAt_) {
+            wakeUp_.wait_until(lock, retryAt_);
+            continue;
+        }
+
+        // Writes about to be sent must not be lost to a power failure
+        syncJournal();
+        const std::vector<Send> batch = nextBatch();
+        client_->setAuthToken(tokenFor(batch.front().mutation.credential));
+
+        lock.unlock();
+        const std::vector<Outcome> outcomes = send(batch);
+        lock.lock();
+
+        std::vector<Conflict> conflicts;
+        settle(batch, outcomes, conflicts);
+        if (conflicts.empty()) {
+            continue;
+        }
+
+        // Listeners may call back into the outbox
+        std::vector<ConflictListener> listeners;
+        for (const auto& entry : listeners_) {
+            listeners.push_back(entry.second);
+        }
+        lock.unlock();
+        for (const Conflict& conflict : conflicts) {
+            for (const auto& listener : listeners) {
+                listener(conflict);
+            }
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,120 @@
+//============================================================================
+// src/api/RequestCoalescer.cpp - Implementation of RequestCoalescer
+//============================================================================
+
+#include "../../include/api/RequestCoalescer.hpp"
+#include "../../include/api/ResponseCache.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+RequestCoalescer& RequestCoalescer::getInstance() {
+    static RequestCoalescer instance;
+    return instance;
+}
+
+std::shared_ptr<RequestCoalescer::Flight> RequestCoalescer::join(const std::string& key, Waiter waiter) {
+    Result answer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto flight = flights_.find(key);
+        if (flight != flights_.end()) {
+            flight->second->waiters.push_back(std::move(waiter));
+            joined_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto recent = recent_.find(key);
+        if (recent != recent_.end()) {
+            if (Clock::now() - recent->second.completedAt < window_) {
+                answer = recent->second.result;
+                windowHits_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                recent_.erase(recent);
+            }
+        }
+
+        if (!answer) {
+            auto created = std::make_shared<Flight>();
+            created->waiters.push_back(std::move(waiter));
+            flights_[key] = created;
+            upstream_.fetch_add(1, std::memory_order_relaxed);
+            inFlight_.store(flights_.size(), std::memory_order_relaxed);
+            return created;
+        }
+    }
+
+    // Outside the lock: the waiter may start another request
+    if (waiter) {
+        waiter(std::move(answer));
+    }
+    return nullptr;
+}
+
+void RequestCoalescer::complete(const std::string& key, const std::shared_ptr<Flight>& flight, Result result) {
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // An invalidate() may have detached this flight; its waiters still
+        // get the answer, but later GETs do not
+        auto current = flights_.find(key);
+        const bool attached = current != flights_.end() && current->second == flight;
+        if (attached) {
+            flights_.erase(current);
+            inFlight_.store(flights_.size(), std::memory_order_relaxed);
+            if (window_.count() > 0 && result && result->success) {
+                const auto now = Clock::now();
+                for (auto it = recent_.begin(); it != recent_.end();) {
+                    it = (now - it->second.completedAt >= window_) ? recent_.erase(it) : std::next(it);
+                }
+                recent_[key] = Recent{result, now};
+            }
+        }
+        waiters.swap(flight->waiters);
+    }
+
+    for (auto& waiter : waiters) {
+        if (waiter) {
+            waiter(result);
+        }
+    }
+}
+
+void RequestCoalescer::invalidate(const std::string& urlPrefix) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto flight = flights_.lower_bound(urlPrefix);
+    while (flight != flights_.end() && flight->first.compare(0, urlPrefix.size(), urlPrefix) == 0) {
+        flight = ResponseCache::isUnderPrefix(flight->first, urlPrefix) ? flights_.erase(flight) : std::next(flight);
+    }
+    inFlight_.store(flights_.size(), std::memory_order_relaxed);
+
+    auto recent = recent_.lower_bound(urlPrefix);
+    while (recent != recent_.end() && recent->first.compare(0, urlPrefix.size(), urlPrefix) == 0) {
+        recent = ResponseCache::isUnderPrefix(recent->first, urlPrefix) ? recent_.erase(recent) : std::next(recent);
+    }
+}
+
+void RequestCoalescer::setWindow(std::chrono::milliseconds window) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    window_ = std::max(window, std::chrono::milliseconds(0));
+    if (window_.count() == 0) {
+        recent_.clear();
+    }
+}
+
+std::chrono::milliseconds RequestCoalescer::getWindow() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return window_;
+}
+
+RequestCoalescer::Stats RequestCoalescer::getStats() const {
+    Stats stats;
+    stats.upstream = upstream_.load(std::memory_order_relaxed);
+    stats.joined = joined_.load(std::memory_order_relaxed);
+    stats.windowHits = windowHits_.load(std::memory_order_relaxed);
+    stats.inFlight = inFlight_.load(std::memory_order_relaxed);
+    return stats;
+}
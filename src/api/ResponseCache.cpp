@@ -0,0 +1,251 @@
+//============================================================================
+// src/api/ResponseCache.cpp - Implementation of ResponseCache
+//============================================================================
+
+#include "../../include/api/ResponseCache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace {
+    constexpr std::size_t DEFAULT_MAX_ENTRIES = 256;
+
+    // A revalidation that never reported back no longer blocks new ones
+    constexpr std::chrono::minutes REVALIDATION_GIVE_UP{2};
+
+    std::string toLower(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    // Value of "name=seconds" in a Cache-Control header, -1 if absent
+    long long directiveSeconds(const std::string& cacheControl, const std::string& name) {
+        std::size_t pos = cacheControl.find(name + "=");
+        while (pos != std::string::npos) {
+            if (pos == 0 || cacheControl[pos - 1] == ',' || cacheControl[pos - 1] == ' ') {
+                try {
+                    return std::stoll(cacheControl.substr(pos + name.size() + 1));
+                } catch (const std::exception&) {
+                    return -1;
+                }
+            }
+            pos = cacheControl.find(name + "=", pos + 1);
+        }
+        return -1;
+    }
+}
+
+ResponseCache& ResponseCache::getInstance() {
+    static ResponseCache instance;
+    return instance;
+}
+
+ResponseCache::ResponseCache()
+    : maxEntries_(DEFAULT_MAX_ENTRIES)
+    , nextVersion_(0) {}
+
+std::string ResponseCache::makeKey(const std::string& url, const std::string& authScope) {
+    // URL first, so invalidate()/markStale() can match on URL prefixes
+    return url + '\n' + authScope;
+}
+
+bool ResponseCache::isUnderPrefix(const std::string& key, const std::string& urlPrefix) {
+    if (key.compare(0, urlPrefix.size(), urlPrefix) != 0) {
+        return false;
+    }
+    if (urlPrefix.empty() || urlPrefix.back() == '/' || key.size() == urlPrefix.size()) {
+        return true;
+    }
+    // '\n' ends the URL part of a makeKey() key
+    const char next = key[urlPrefix.size()];
+    return next == '/' || next == '?' || next == '\n';
+}
+
+ResponseCache::Lookup ResponseCache::lookup(const std::string& key, std::chrono::seconds staleWhileRevalidate) {
+    Lookup result;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    Entry& entry = it->second;
+    const auto now = Clock::now();
+    const auto age = now - entry.storedAt;
+    const bool usable = !entry.noCache && !entry.mustRevalidate;
+    const bool fresh = usable && age < entry.maxAge;
+
+    result.found = true;
+    result.servable = usable && age < entry.maxAge + std::max(entry.staleWhileRevalidate, staleWhileRevalidate);
+    if (entry.decoded) {
+        result.decoded = entry.decoded;
+    } else {
+        result.response = entry.response;
+    }
+    result.version = entry.version;
+    result.etag = entry.etag;
+    result.lastModified = entry.lastModified;
+
+    if (result.servable) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        const bool revalidationRunning = entry.revalidating && now - entry.revalidationStarted < REVALIDATION_GIVE_UP;
+        if (!fresh && !revalidationRunning) {
+            entry.revalidating = true;
+            entry.revalidationStarted = now;
+            result.revalidate = true;
+        }
+    } else {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+bool ResponseCache::store(const std::string& key, const HttpTransport::Response& response,
+                          std::shared_ptr<const void> decoded) {
+    if (response.statusCode != 200 || !response.error.empty()) {
+        return false;
+    }
+
+    Entry entry;
+    entry.response = response;
+    entry.decoded = std::move(decoded);
+    entry.etag = response.header("etag");
+    entry.lastModified = response.header("last-modified");
+    entry.storedAt = Clock::now();
+
+    applyCacheControl(response, entry);
+
+    // Without validators or a max-age it could neither be served fresh nor
+    // revalidated cheaply
+    const bool cacheable =
+        toLower(response.header("cache-control")).find("no-store") == std::string::npos &&
+        (!entry.etag.empty() || !entry.lastModified.empty() || entry.maxAge.count() > 0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!cacheable) {
+        entries_.erase(key);
+        entryCount_.store(entries_.size(), std::memory_order_relaxed);
+        return false;
+    }
+    entry.version = ++nextVersion_;
+    entries_[key] = std::move(entry);
+    stores_.fetch_add(1, std::memory_order_relaxed);
+    evictIfFull();
+    return true;
+}
+
+bool ResponseCache::refresh(const std::string& key, const HttpTransport::Response& notModified, Lookup& cached) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return false;
+    }
+
+    Entry& entry = it->second;
+    if (!notModified.header("etag").empty()) {
+        entry.etag = notModified.header("etag");
+    }
+    if (!notModified.header("last-modified").empty()) {
+        entry.lastModified = notModified.header("last-modified");
+    }
+    if (!notModified.header("cache-control").empty()) {
+        entry.response.headers["cache-control"] = notModified.header("cache-control");
+        applyCacheControl(entry.response, entry);
+    }
+    entry.storedAt = Clock::now();
+    entry.mustRevalidate = false;
+    entry.revalidating = false;
+    notModified_.fetch_add(1, std::memory_order_relaxed);
+
+    cached.found = true;
+    cached.servable = true;
+    if (entry.decoded) {
+        cached.decoded = entry.decoded;
+    } else {
+        cached.response = entry.response;
+    }
+    cached.version = entry.version;
+    cached.etag = entry.etag;
+    cached.lastModified = entry.lastModified;
+    return true;
+}
+
+void ResponseCache::attachDecoded(const std::string& key, std::uint64_t version,
+                                  std::shared_ptr<const void> decoded) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.version == version) {
+        it->second.decoded = std::move(decoded);
+    }
+}
+
+void ResponseCache::revalidationFailed(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        it->second.revalidating = false;
+    }
+}
+
+void ResponseCache::markStale(const std::string& urlPrefix) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.lower_bound(urlPrefix);
+         it != entries_.end() && it->first.compare(0, urlPrefix.size(), urlPrefix) == 0; ++it) {
+        if (isUnderPrefix(it->first, urlPrefix)) {
+            it->second.mustRevalidate = true;
+        }
+    }
+}
+
+void ResponseCache::invalidate(const std::string& urlPrefix) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.lower_bound(urlPrefix);
+    while (it != entries_.end() && it->first.compare(0, urlPrefix.size(), urlPrefix) == 0) {
+        it = isUnderPrefix(it->first, urlPrefix) ? entries_.erase(it) : std::next(it);
+    }
+    entryCount_.store(entries_.size(), std::memory_order_relaxed);
+}
+
+void ResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    entryCount_.store(0, std::memory_order_relaxed);
+}
+
+ResponseCache::Stats ResponseCache::getStats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.notModified = notModified_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.stores = stores_.load(std::memory_order_relaxed);
+    stats.entries = entryCount_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ResponseCache::setMaxEntries(std::size_t maxEntries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxEntries_ = std::max<std::size_t>(maxEntries, 1);
+    evictIfFull();
+}
+
+void ResponseCache::applyCacheControl(const HttpTransport::Response& response, Entry& entry) {
+    const std::string cacheControl = toLower(response.header("cache-control"));
+    entry.noCache = cacheControl.find("no-cache") != std::string::npos;
+    entry.maxAge = std::chrono::seconds(std::max(directiveSeconds(cacheControl, "max-age"), 0LL));
+    entry.staleWhileRevalidate =
+        std::chrono::seconds(std::max(directiveSeconds(cacheControl, "stale-while-revalidate"), 0LL));
+}
+
+void ResponseCache::evictIfFull() {
+    // Oldest first; the cache is small enough for a linear scan
+    while (entries_.size() > maxEntries_) {
+        auto oldest = std::min_element(entries_.begin(), entries_.end(),
+            [](const auto& a, const auto& b) { return a.second.storedAt < b.second.storedAt; });
+        entries_.erase(oldest);
+    }
+    entryCount_.store(entries_.size(), std::memory_order_relaxed);
+}
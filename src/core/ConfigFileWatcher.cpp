@@ -0,0 +1,195 @@
+#include "../../include/core/ConfigFileWatcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// ============================================================================
+// ConfigFileWatcher Implementation
+// ============================================================================
+
+namespace {
+    // Editors often produce several events per save; wait for them to settle
+    constexpr auto DEBOUNCE_DELAY = std::chrono::milliseconds(250);
+
+    constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+}
+
+ConfigFileWatcher& ConfigFileWatcher::getInstance() {
+    static ConfigFileWatcher instance;
+    return instance;
+}
+
+ConfigFileWatcher::ConfigFileWatcher()
+    : nextId_(1)
+    , inotifyFd_(-1)
+    , wakeFd_{-1, -1} {}
+
+ConfigFileWatcher::~ConfigFileWatcher() {
+    if (thread_.joinable()) {
+        char stop = 1;
+        ssize_t written = ::write(wakeFd_[1], &stop, 1);
+        (void)written;
+        thread_.join();
+    }
+    for (int fd : {inotifyFd_, wakeFd_[0], wakeFd_[1]}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+ConfigFileWatcher::WatchId ConfigFileWatcher::watch(const std::string& path, ChangeCallback callback) {
+    std::filesystem::path absolute = std::filesystem::absolute(path).lexically_normal();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!startLocked()) {
+        return 0;
+    }
+
+    Watch watch;
+    watch.directory = absolute.parent_path().string();
+    watch.fileName = absolute.filename().string();
+    watch.callback = std::move(callback);
+
+    if (addDirectoryLocked(watch.directory) < 0) {
+        std::cerr << "[ConfigFileWatcher] Cannot watch " << watch.directory << std::endl;
+        return 0;
+    }
+
+    WatchId id = nextId_++;
+    watches_.emplace(id, std::move(watch));
+    return id;
+}
+
+void ConfigFileWatcher::unwatch(WatchId id) {
+    // Callbacks run with mutex_ held, so this also waits for a running one
+    std::lock_guard<std::mutex> lock(mutex_);
+    watches_.erase(id);
+}
+
+bool ConfigFileWatcher::startLocked() {
+    if (thread_.joinable()) {
+        return true;
+    }
+
+    inotifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        std::cerr << "[ConfigFileWatcher] inotify unavailable, hot reload disabled" << std::endl;
+        return false;
+    }
+    if (::pipe2(wakeFd_, O_CLOEXEC) < 0) {
+        ::close(inotifyFd_);
+        inotifyFd_ = -1;
+        return false;
+    }
+
+    thread_ = std::thread(&ConfigFileWatcher::watchLoop, this);
+    return true;
+}
+
+int ConfigFileWatcher::addDirectoryLocked(const std::string& directory) {
+    for (const auto& [wd, watchedDirectory] : directories_) {
+        if (watchedDirectory == directory) {
+            return wd;
+        }
+    }
+
+    int wd = ::inotify_add_watch(inotifyFd_, directory.c_str(), WATCH_MASK);
+    if (wd >= 0) {
+        directories_[wd] = directory;
+    }
+    return wd;
+}
+
+bool ConfigFileWatcher::isWatchedLocked(const std::string& directory, const std::string& fileName) const {
+    for (const auto& [id, watch] : watches_) {
+        if (watch.directory == directory && watch.fileName == fileName) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ConfigFileWatcher::watchLoop() {
+    using Clock = std::chrono::steady_clock;
+
+    std::map<std::pair<std::string, std::string>, Clock::time_point> pending;
+    alignas(struct inotify_event) char buffer[4096];
+
+    for (;;) {
+        // Sleep until the next debounced change is due, or indefinitely
+        int timeoutMs = -1;
+        if (!pending.empty()) {
+            Clock::time_point next = Clock::time_point::max();
+            for (const auto& entry : pending) {
+                next = std::min(next, entry.second);
+            }
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(next - Clock::now());
+            timeoutMs = std::max<int>(0, static_cast<int>(remaining.count()));
+        }
+
+        struct pollfd fds[2] = {
+            {inotifyFd_, POLLIN, 0},
+            {wakeFd_[0], POLLIN, 0}
+        };
+        int ready = ::poll(fds, 2, timeoutMs);
+        if (ready < 0 && errno != EINTR) {
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return; // Shutdown requested
+        }
+
+        if (fds[0].revents & POLLIN) {
+            ssize_t length;
+            while ((length = ::read(inotifyFd_, buffer, sizeof(buffer))) > 0) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (char* ptr = buffer; ptr < buffer + length; ) {
+                    auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+                    ptr += sizeof(struct inotify_event) + event->len;
+
+                    auto dir = directories_.find(event->wd);
+                    if (dir != directories_.end() && event->len > 0 && isWatchedLocked(dir->second, event->name)) {
+                        pending[{dir->second, event->name}] = Clock::now() + DEBOUNCE_DELAY;
+                    }
+                }
+            }
+        }
+
+        const auto now = Clock::now();
+        for (auto it = pending.begin(); it != pending.end(); ) {
+            if (it->second <= now) {
+                dispatch(it->first.first, it->first.second);
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void ConfigFileWatcher::dispatch(const std::string& directory, const std::string& fileName) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const std::string path = (std::filesystem::path(directory) / fileName).string();
+    for (const auto& [id, watch] : watches_) {
+        if (watch.directory != directory || watch.fileName != fileName) {
+            continue;
+        }
+        try {
+            watch.callback(path);
+        } catch (const std::exception& e) {
+            std::cerr << "[ConfigFileWatcher] Callback for " << path << " failed: " << e.what() << std::endl;
+        }
+    }
+}
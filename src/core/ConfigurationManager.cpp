@@ -1,23 +1,82 @@
 #include "../../include/core/ConfigurationManager.hpp"
+#include "../../include/core/ConfigFileWatcher.hpp"
+#include "../../include/utils/PropertyTable.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <cctype>
 #include <cstdlib>
+#include <thread>
+
+// =================================================================
+// ConfigSnapshot
+// =================================================================
+
+const ConfigSnapshot::ConfigValue* ConfigSnapshot::find(const std::string& sectionName,
+                                                        const std::string& keyName) const {
+    auto sectionIt = sections_.find(sectionName);
+    if (sectionIt == sections_.end()) {
+        return nullptr;
+    }
+    
+    auto it = sectionIt->second.find(keyName);
+    return (it != sectionIt->second.end()) ? &(it->second) : nullptr;
+}
+
+// =================================================================
+// PublishedConfig
+// =================================================================
+
+PublishedConfig::PublishedConfig()
+    : current_(new ConfigSnapshot())
+    , epoch_(0) {}
+
+PublishedConfig::~PublishedConfig() {
+    delete current_.load();
+}
+
+void PublishedConfig::publish(std::unique_ptr<const ConfigSnapshot> snapshot) {
+    const ConfigSnapshot* previous = current_.exchange(snapshot.release(), std::memory_order_seq_cst);
+    
+    // A reader that saw the previous pointer registered on one of the two
+    // counters before the exchange. Flip new readers to the other counter and
+    // drain the old one, twice, so both counters have been empty once since
+    for (int phase = 0; phase < 2; ++phase) {
+        const unsigned draining = epoch_.fetch_add(1, std::memory_order_seq_cst) & 1u;
+        while (readers_[draining].count.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+    delete previous;
+}
+
+// =================================================================
+// ConfigurationManager
+// =================================================================
 
 ConfigurationManager::ConfigurationManager()
-    : lastLoadedFile_("") {
+    : snapshotVersion_(0)
+    , nextListenerId_(1)
+    , watchId_(0)
+    , lastLoadedFile_("") {
     
     // Initialize with default values
     loadDefaults();
+    resolveHandles();
+}
+
+ConfigurationManager::~ConfigurationManager() {
+    disableHotReload();
 }
 
 void ConfigurationManager::initialize() {
     std::cout << "[ConfigurationManager] Initializing with default configuration" << std::endl;
     
     // Load defaults if not already loaded
-    if (config_.empty()) {
+    if (getSnapshot()->getSections().empty()) {
         loadDefaults();
     }
     
@@ -25,6 +84,8 @@ void ConfigurationManager::initialize() {
 }
 
 void ConfigurationManager::loadDefaults() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    
     // Restaurant configuration
     setDefaultRestaurantConfig();
     
@@ -52,6 +113,9 @@ void ConfigurationManager::loadDefaults() {
     // LLM configuration
     setDefaultLLMConfig();
 
+    defaults_ = config_;
+    publishSnapshot();
+
     std::cout << "[ConfigurationManager] Default configuration loaded with API and LLM settings" << std::endl;
 }
 
@@ -73,6 +137,27 @@ void ConfigurationManager::setDefaultAPIConfig() {
     
     // Cache settings
     api["cache_timeout_minutes"] = 5;
+    api["coalesce_window_ms"] = 0;  // Share identical GETs only while in flight
+    
+    // Write-behind outbox for order writes
+    api["outbox_enabled"] = true;
+    api["outbox_path"] = std::string("data/api_outbox.jsonl");
+    api["outbox_batch_size"] = 16;
+    api["outbox_retry_ms"] = 5000;
+    api["atomic_operations"] = true;  // Falls back to single requests if unsupported
+    
+    // Payload size: compressed responses, and list views ask for fewer attributes
+    api["compression"] = true;
+    api["compress_requests_above"] = 0;  // Bytes; the middleware must accept Content-Encoding
+    api["sparse_fieldsets"] = true;
+    
+    // Active order refreshes fetch only orders changed since the last one
+    api["delta_sync"] = true;
+    api["order_full_sync_seconds"] = 300;
+    
+    // Repositories share one object per entity id; reads within the TTL stay local
+    api["identity_map"] = true;
+    api["identity_map_ttl_seconds"] = 30;
     
     std::cout << "[ConfigurationManager] API configuration defaults set" << std::endl;
 }
@@ -102,7 +187,13 @@ void ConfigurationManager::setDefaultOrderConfig() {
 void ConfigurationManager::setDefaultKitchenConfig() {
     auto& kitchen = getOrCreateSection("kitchen");
     kitchen["refresh_rate"] = 5; // seconds
-    kitchen["busy_threshold"] = 10;
+    kitchen["busy_threshold"] = 5; // tickets before the kitchen counts as busy
+    
+    // Station of each menu category ("main_course=grill"), and per-item
+    // overrides ("<menu item id>=<station>"); none by default, so orders
+    // are not split into station tickets until routes are configured
+    kitchen["station_routes"] = std::vector<std::string>();
+    kitchen["item_stations"] = std::vector<std::string>();
     
     // Default prep times (in minutes)
     std::unordered_map<std::string, int> prepTimes;
@@ -117,7 +208,7 @@ void ConfigurationManager::setDefaultKitchenConfig() {
 void ConfigurationManager::setDefaultUIConfig() {
     auto& ui = getOrCreateSection("ui");
     ui["default_theme"] = std::string("light");
-    ui["update_interval"] = 10; // seconds
+    ui["update_interval"] = 5; // seconds
     ui["group_menu_by_category"] = true;
     ui["show_descriptions"] = true;
     ui["max_themes"] = 10;
@@ -159,29 +250,87 @@ ConfigurationManager::ConfigSection* ConfigurationManager::getSection(const std:
     return (it != config_.end()) ? &(it->second) : nullptr;
 }
 
-const ConfigurationManager::ConfigSection* ConfigurationManager::getSection(const std::string& sectionName) const {
-    auto it = config_.find(sectionName);
-    return (it != config_.end()) ? &(it->second) : nullptr;
-}
-
 ConfigurationManager::ConfigSection& ConfigurationManager::getOrCreateSection(const std::string& sectionName) {
     return config_[sectionName];
 }
 
-bool ConfigurationManager::hasKey(const std::string& key) const {
-    auto [sectionName, keyName] = parseKey(key);
+void ConfigurationManager::publishSnapshot() {
+    auto snapshot = std::make_unique<ConfigSnapshot>();
+    snapshot->sections_ = config_;
+    snapshot->version_ = ++snapshotVersion_;
     
-    const auto* section = getSection(sectionName);
-    if (!section) {
-        return false;
+    // Resolve handle slots against the new snapshot's own storage
+    snapshot->slots_.reserve(slotKeys_.size());
+    for (const auto& [sectionName, keyName] : slotKeys_) {
+        snapshot->slots_.push_back(snapshot->find(sectionName, keyName));
     }
     
-    return section->find(keyName) != section->end();
+    snapshot_.publish(std::move(snapshot));
+}
+
+void ConfigurationManager::resolveHandles() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    bool added = false;
+    
+    handles_.restaurantName = makeHandle<std::string>("restaurant.name", "Sample Restaurant", added);
+    handles_.restaurantAddress = makeHandle<std::string>("restaurant.address", "", added);
+    handles_.restaurantPhone = makeHandle<std::string>("restaurant.phone", "", added);
+    handles_.taxRate = makeHandle<double>("restaurant.tax_rate", 0.08, added);
+    
+    handles_.serverPort = makeHandle<int>("server.port", 9090, added);
+    handles_.serverAddress = makeHandle<std::string>("server.address", "0.0.0.0", added);
+    handles_.sessionTimeout = makeHandle<int>("server.session_timeout", 3600, added);
+    
+    handles_.startingOrderId = makeHandle<int>("order.starting_id", 1000, added);
+    handles_.orderTimeout = makeHandle<int>("order.timeout", 30, added);
+    handles_.maxItemsPerOrder = makeHandle<int>("order.max_items", 50, added);
+    
+    handles_.kitchenRefreshRate = makeHandle<int>("kitchen.refresh_rate", 5, added);
+    handles_.kitchenBusyThreshold = makeHandle<int>("kitchen.busy_threshold", 5, added);
+    handles_.kitchenStationRoutes = makeHandle<std::vector<std::string>>("kitchen.station_routes", {}, added);
+    handles_.kitchenItemStations = makeHandle<std::vector<std::string>>("kitchen.item_stations", {}, added);
+    
+    handles_.defaultTheme = makeHandle<std::string>("ui.default_theme", "light", added);
+    handles_.uiUpdateInterval = makeHandle<int>("ui.update_interval", 5, added);
+    handles_.groupMenuByCategory = makeHandle<bool>("ui.group_menu_by_category", true, added);
+    
+    handles_.inventoryEnabled = makeHandle<bool>("features.inventory", false, added);
+    handles_.staffManagementEnabled = makeHandle<bool>("features.staff_management", false, added);
+    handles_.customerManagementEnabled = makeHandle<bool>("features.customer_management", false, added);
+    handles_.reportingEnabled = makeHandle<bool>("features.reporting", false, added);
+    handles_.loyaltyProgramEnabled = makeHandle<bool>("features.loyalty_program", false, added);
+    
+    handles_.llmEnabled = makeHandle<bool>("llm.enabled", false, added);
+    handles_.llmProvider = makeHandle<std::string>("llm.provider", "anthropic", added);
+    handles_.llmApiKey = makeHandle<std::string>("llm.api_key", "", added);
+    handles_.llmModel = makeHandle<std::string>("llm.model", "claude-3-sonnet-20240229", added);
+    handles_.llmBaseUrl = makeHandle<std::string>("llm.base_url", "", added);
+    handles_.llmTimeout = makeHandle<int>("llm.timeout", 60, added);
+    handles_.llmMaxTokens = makeHandle<int>("llm.max_tokens", 4096, added);
+    handles_.llmDebugMode = makeHandle<bool>("llm.debug_mode", false, added);
+    handles_.llmDefaultRadius = makeHandle<double>("llm.default_radius_km", 5.0, added);
+    handles_.llmMaxRadius = makeHandle<double>("llm.max_radius_km", 50.0, added);
+    
+    handles_.enabledPaymentMethods = makeHandle<std::vector<std::string>>("payment.enabled_methods",
+        {"cash", "credit_card", "debit_card", "mobile_pay"}, added);
+    handles_.tipSuggestions = makeHandle<std::vector<double>>("payment.tip_suggestions",
+        {0.15, 0.18, 0.20, 0.25}, added);
+    
+    // One publish for all new slots
+    if (added) {
+        publishSnapshot();
+    }
+}
+
+bool ConfigurationManager::hasKey(const std::string& key) const {
+    auto [sectionName, keyName] = parseKey(key);
+    return getSnapshot()->find(sectionName, keyName) != nullptr;
 }
 
 bool ConfigurationManager::removeKey(const std::string& key) {
     auto [sectionName, keyName] = parseKey(key);
     
+    std::lock_guard<std::mutex> lock(writeMutex_);
     auto* section = getSection(sectionName);
     if (!section) {
         return false;
@@ -190,6 +339,8 @@ bool ConfigurationManager::removeKey(const std::string& key) {
     auto it = section->find(keyName);
     if (it != section->end()) {
         section->erase(it);
+        overrides_.erase(key);
+        publishSnapshot();
         return true;
     }
     
@@ -199,9 +350,11 @@ bool ConfigurationManager::removeKey(const std::string& key) {
 std::vector<std::string> ConfigurationManager::getSectionKeys(const std::string& sectionName) const {
     std::vector<std::string> keys;
     
-    const auto* section = getSection(sectionName);
-    if (section) {
-        for (const auto& pair : *section) {
+    auto snapshot = getSnapshot();
+    const auto& sections = snapshot->getSections();
+    auto section = sections.find(sectionName);
+    if (section != sections.end()) {
+        for (const auto& pair : section->second) {
             keys.push_back(pair.first);
         }
     }
@@ -210,22 +363,14 @@ std::vector<std::string> ConfigurationManager::getSectionKeys(const std::string&
 }
 
 // Type conversion helper
-template<typename T>
-T ConfigurationManager::convertValue(const ConfigValue& value, const T& defaultValue) const {
-    try {
-        return std::any_cast<T>(value);
-    } catch (const std::bad_any_cast& e) {
-        std::cerr << "[ConfigurationManager] Type conversion error: " << e.what() << std::endl;
-        return defaultValue;
-    }
+void ConfigurationManager::reportConversionError(const ConfigValue& value) const {
+    std::cerr << "[ConfigurationManager] Type conversion error: stored value is "
+              << value.type().name() << std::endl;
 }
 
-// Explicit template instantiations for common types
-template int ConfigurationManager::convertValue<int>(const ConfigValue& value, const int& defaultValue) const;
-
 // Restaurant configuration getters
 std::string ConfigurationManager::getRestaurantName() const {
-    return getValue<std::string>("restaurant.name", "Sample Restaurant");
+    return handles_.restaurantName.get();
 }
 
 void ConfigurationManager::setRestaurantName(const std::string& name) {
@@ -233,7 +378,7 @@ void ConfigurationManager::setRestaurantName(const std::string& name) {
 }
 
 std::string ConfigurationManager::getRestaurantAddress() const {
-    return getValue<std::string>("restaurant.address", "");
+    return handles_.restaurantAddress.get();
 }
 
 void ConfigurationManager::setRestaurantAddress(const std::string& address) {
@@ -241,7 +386,7 @@ void ConfigurationManager::setRestaurantAddress(const std::string& address) {
 }
 
 std::string ConfigurationManager::getRestaurantPhone() const {
-    return getValue<std::string>("restaurant.phone", "");
+    return handles_.restaurantPhone.get();
 }
 
 void ConfigurationManager::setRestaurantPhone(const std::string& phone) {
@@ -249,7 +394,7 @@ void ConfigurationManager::setRestaurantPhone(const std::string& phone) {
 }
 
 double ConfigurationManager::getTaxRate() const {
-    return getValue<double>("restaurant.tax_rate", 0.08);
+    return handles_.taxRate.get();
 }
 
 void ConfigurationManager::setTaxRate(double rate) {
@@ -258,7 +403,7 @@ void ConfigurationManager::setTaxRate(double rate) {
 
 // Server configuration
 int ConfigurationManager::getServerPort() const {
-    return getValue<int>("server.port", 9090);
+    return handles_.serverPort.get();
 }
 
 void ConfigurationManager::setServerPort(int port) {
@@ -266,7 +411,7 @@ void ConfigurationManager::setServerPort(int port) {
 }
 
 std::string ConfigurationManager::getServerAddress() const {
-    return getValue<std::string>("server.address", "0.0.0.0");
+    return handles_.serverAddress.get();
 }
 
 void ConfigurationManager::setServerAddress(const std::string& address) {
@@ -274,7 +419,7 @@ void ConfigurationManager::setServerAddress(const std::string& address) {
 }
 
 int ConfigurationManager::getSessionTimeout() const {
-    return getValue<int>("server.session_timeout", 3600);
+    return handles_.sessionTimeout.get();
 }
 
 void ConfigurationManager::setSessionTimeout(int timeoutSeconds) {
@@ -283,7 +428,7 @@ void ConfigurationManager::setSessionTimeout(int timeoutSeconds) {
 
 // Order configuration
 int ConfigurationManager::getStartingOrderId() const {
-    return getValue<int>("order.starting_id", 1000);
+    return handles_.startingOrderId.get();
 }
 
 void ConfigurationManager::setStartingOrderId(int startId) {
@@ -291,7 +436,7 @@ void ConfigurationManager::setStartingOrderId(int startId) {
 }
 
 int ConfigurationManager::getOrderTimeout() const {
-    return getValue<int>("order.timeout", 30);
+    return handles_.orderTimeout.get();
 }
 
 void ConfigurationManager::setOrderTimeout(int timeoutMinutes) {
@@ -299,7 +444,7 @@ void ConfigurationManager::setOrderTimeout(int timeoutMinutes) {
 }
 
 int ConfigurationManager::getMaxItemsPerOrder() const {
-    return getValue<int>("order.max_items", 50);
+    return handles_.maxItemsPerOrder.get();
 }
 
 void ConfigurationManager::setMaxItemsPerOrder(int maxItems) {
@@ -308,7 +453,7 @@ void ConfigurationManager::setMaxItemsPerOrder(int maxItems) {
 
 // Kitchen configuration
 int ConfigurationManager::getKitchenRefreshRate() const {
-    return getValue<int>("kitchen.refresh_rate", 5);
+    return handles_.kitchenRefreshRate.get();
 }
 
 void ConfigurationManager::setKitchenRefreshRate(int rateSeconds) {
@@ -316,16 +461,32 @@ void ConfigurationManager::setKitchenRefreshRate(int rateSeconds) {
 }
 
 int ConfigurationManager::getKitchenBusyThreshold() const {
-    return getValue<int>("kitchen.busy_threshold", 10);
+    return handles_.kitchenBusyThreshold.get();
 }
 
 void ConfigurationManager::setKitchenBusyThreshold(int threshold) {
     setValue<int>("kitchen.busy_threshold", threshold);
 }
 
+std::vector<std::string> ConfigurationManager::getKitchenStationRoutes() const {
+    return handles_.kitchenStationRoutes.get();
+}
+
+void ConfigurationManager::setKitchenStationRoutes(const std::vector<std::string>& routes) {
+    setValue<std::vector<std::string>>("kitchen.station_routes", routes);
+}
+
+std::vector<std::string> ConfigurationManager::getKitchenItemStations() const {
+    return handles_.kitchenItemStations.get();
+}
+
+void ConfigurationManager::setKitchenItemStations(const std::vector<std::string>& routes) {
+    setValue<std::vector<std::string>>("kitchen.item_stations", routes);
+}
+
 // UI configuration
 std::string ConfigurationManager::getDefaultTheme() const {
-    return getValue<std::string>("ui.default_theme", "light");
+    return handles_.defaultTheme.get();
 }
 
 void ConfigurationManager::setDefaultTheme(const std::string& themeId) {
@@ -333,7 +494,7 @@ void ConfigurationManager::setDefaultTheme(const std::string& themeId) {
 }
 
 int ConfigurationManager::getUIUpdateInterval() const {
-    return getValue<int>("ui.update_interval", 10);
+    return handles_.uiUpdateInterval.get();
 }
 
 void ConfigurationManager::setUIUpdateInterval(int intervalSeconds) {
@@ -341,7 +502,7 @@ void ConfigurationManager::setUIUpdateInterval(int intervalSeconds) {
 }
 
 bool ConfigurationManager::getGroupMenuByCategory() const {
-    return getValue<bool>("ui.group_menu_by_category", true);
+    return handles_.groupMenuByCategory.get();
 }
 
 void ConfigurationManager::setGroupMenuByCategory(bool group) {
@@ -358,29 +519,28 @@ void ConfigurationManager::setFeatureEnabled(const std::string& featureName, boo
 }
 
 bool ConfigurationManager::isInventoryEnabled() const {
-    return isFeatureEnabled("inventory");
+    return handles_.inventoryEnabled.get();
 }
 
 bool ConfigurationManager::isStaffManagementEnabled() const {
-    return isFeatureEnabled("staff_management");
+    return handles_.staffManagementEnabled.get();
 }
 
 bool ConfigurationManager::isCustomerManagementEnabled() const {
-    return isFeatureEnabled("customer_management");
+    return handles_.customerManagementEnabled.get();
 }
 
 bool ConfigurationManager::isReportingEnabled() const {
-    return isFeatureEnabled("reporting");
+    return handles_.reportingEnabled.get();
 }
 
 bool ConfigurationManager::isLoyaltyProgramEnabled() const {
-    return isFeatureEnabled("loyalty_program");
+    return handles_.loyaltyProgramEnabled.get();
 }
 
 // Payment configuration
 std::vector<std::string> ConfigurationManager::getEnabledPaymentMethods() const {
-    return getValue<std::vector<std::string>>("payment.enabled_methods", 
-        {"cash", "credit_card", "debit_card", "mobile_pay"});
+    return handles_.enabledPaymentMethods.get();
 }
 
 void ConfigurationManager::setPaymentMethodEnabled(const std::string& method, bool enabled) {
@@ -397,20 +557,281 @@ void ConfigurationManager::setPaymentMethodEnabled(const std::string& method, bo
 }
 
 std::vector<double> ConfigurationManager::getTipSuggestions() const {
-    return getValue<std::vector<double>>("payment.tip_suggestions", {0.15, 0.18, 0.20, 0.25});
+    return handles_.tipSuggestions.get();
 }
 
 void ConfigurationManager::setTipSuggestions(const std::vector<double>& suggestions) {
     setValue<std::vector<double>>("payment.tip_suggestions", suggestions);
 }
 
-// File operations (basic implementations)
+// File operations
 bool ConfigurationManager::loadFromFile(const std::string& filePath) {
-    std::cout << "[ConfigurationManager] File loading not implemented, using defaults" << std::endl;
+    // Parsed once per file version and shared with Logger and other sessions
+    auto properties = PropertyTable::getInstance().load(filePath);
+    if (!properties) {
+        std::cerr << "[ConfigurationManager] Could not read " << filePath << ", keeping current configuration" << std::endl;
+        return false;
+    }
+    
     lastLoadedFile_ = filePath;
+    return applyProperties(*properties, filePath);
+}
+
+bool ConfigurationManager::applyProperties(const std::map<std::string, std::string>& properties,
+                                           const std::string& source) {
+    std::vector<ConfigChange> changes;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        
+        // Build the candidate configuration without touching the live one
+        auto candidate = defaults_;
+        for (const auto& [key, text] : properties) {
+            auto [sectionName, keyName] = parseKey(key);
+            if (sectionName == "logging") {
+                continue; // Owned by Logger
+            }
+            
+            ConfigValue value;
+            auto& section = candidate[sectionName];
+            auto existing = section.find(keyName);
+            if (!convertText(existing != section.end() ? existing->second : ConfigValue(), text, value)) {
+                std::cerr << "[ConfigurationManager] " << source << ": invalid value '" << text
+                          << "' for " << key << ", configuration not applied" << std::endl;
+                return false;
+            }
+            
+            std::string error;
+            if (!validateValue(key, value, error)) {
+                std::cerr << "[ConfigurationManager] " << source << ": " << key << " " << error
+                          << ", configuration not applied" << std::endl;
+                return false;
+            }
+            section[keyName] = std::move(value);
+        }
+        
+        for (const auto& [key, value] : overrides_) {
+            auto [sectionName, keyName] = parseKey(key);
+            candidate[sectionName][keyName] = value;
+        }
+        
+        // Diff against the live configuration
+        for (const auto& [sectionName, section] : candidate) {
+            auto oldSection = config_.find(sectionName);
+            for (const auto& [keyName, value] : section) {
+                ConfigValue oldValue;
+                if (oldSection != config_.end()) {
+                    auto it = oldSection->second.find(keyName);
+                    if (it != oldSection->second.end()) {
+                        oldValue = it->second;
+                    }
+                }
+                if (!oldValue.has_value() || valueToString(oldValue) != valueToString(value)) {
+                    changes.push_back({sectionName + "." + keyName, oldValue, value});
+                }
+            }
+        }
+        for (const auto& [sectionName, section] : config_) {
+            auto newSection = candidate.find(sectionName);
+            for (const auto& [keyName, value] : section) {
+                if (newSection == candidate.end() || newSection->second.count(keyName) == 0) {
+                    changes.push_back({sectionName + "." + keyName, value, ConfigValue()});
+                }
+            }
+        }
+        
+        if (changes.empty()) {
+            return true;
+        }
+        
+        config_ = std::move(candidate);
+        publishSnapshot();
+    }
+    
+    std::cout << "[ConfigurationManager] Applied " << changes.size() << " change(s) from " << source << std::endl;
+    notifyListeners(changes);
+    return true;
+}
+
+bool ConfigurationManager::convertText(const ConfigValue& prototype, const std::string& text, ConfigValue& out) {
+    auto split = [&text]() {
+        std::vector<std::string> parts;
+        std::stringstream ss(text);
+        std::string part;
+        while (std::getline(ss, part, ',')) {
+            part.erase(0, part.find_first_not_of(" \t"));
+            part.erase(part.find_last_not_of(" \t") + 1);
+            if (!part.empty()) {
+                parts.push_back(part);
+            }
+        }
+        return parts;
+    };
+    
+    try {
+        std::size_t used = 0;
+        if (!prototype.has_value() || prototype.type() == typeid(std::string)) {
+            out = text;
+        } else if (prototype.type() == typeid(int)) {
+            int value = std::stoi(text, &used);
+            if (used != text.size()) return false;
+            out = value;
+        } else if (prototype.type() == typeid(double)) {
+            double value = std::stod(text, &used);
+            if (used != text.size()) return false;
+            out = value;
+        } else if (prototype.type() == typeid(bool)) {
+            std::string lower = text;
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+            if (lower == "true" || lower == "1" || lower == "yes") out = true;
+            else if (lower == "false" || lower == "0" || lower == "no") out = false;
+            else return false;
+        } else if (prototype.type() == typeid(std::vector<std::string>)) {
+            out = split();
+        } else if (prototype.type() == typeid(std::vector<double>)) {
+            std::vector<double> values;
+            for (const auto& part : split()) {
+                values.push_back(std::stod(part));
+            }
+            out = values;
+        } else {
+            return false; // Structured values cannot be set from a property
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+bool ConfigurationManager::validateValue(const std::string& key, const ConfigValue& value, std::string& error) {
+    if (const double* rate = std::any_cast<double>(&value)) {
+        if (key == "restaurant.tax_rate" && (*rate < 0.0 || *rate > 1.0)) {
+            error = "must be between 0 and 1";
+            return false;
+        }
+    }
+    
+    if (const int* number = std::any_cast<int>(&value)) {
+        static const std::vector<std::string> positiveKeys = {
+            "server.session_timeout", "order.timeout", "order.max_items", "kitchen.refresh_rate",
+            "ui.update_interval", "api.timeout", "llm.timeout", "llm.max_tokens"
+        };
+        if (std::find(positiveKeys.begin(), positiveKeys.end(), key) != positiveKeys.end() && *number <= 0) {
+            error = "must be positive";
+            return false;
+        }
+        if (key == "kitchen.busy_threshold" && *number < 0) {
+            error = "must not be negative";
+            return false;
+        }
+        if (key == "server.port" && (*number <= 0 || *number > 65535)) {
+            error = "must be a valid port";
+            return false;
+        }
+    }
+    
+    if (const auto* routes = std::any_cast<std::vector<std::string>>(&value)) {
+        if (key == "kitchen.station_routes" || key == "kitchen.item_stations") {
+            for (const auto& route : *routes) {
+                const std::size_t equals = route.find('=');
+                if (equals == 0 || equals == std::string::npos || equals + 1 == route.size()) {
+                    error = "entry '" + route + "' is not <key>=<station>";
+                    return false;
+                }
+            }
+        }
+    }
+    
     return true;
 }
 
+std::string ConfigurationManager::valueToString(const ConfigValue& value) {
+    std::ostringstream oss;
+    
+    if (!value.has_value()) {
+        return "";
+    } else if (const auto* text = std::any_cast<std::string>(&value)) {
+        return *text;
+    } else if (const auto* number = std::any_cast<int>(&value)) {
+        oss << *number;
+    } else if (const auto* real = std::any_cast<double>(&value)) {
+        oss << *real;
+    } else if (const auto* flag = std::any_cast<bool>(&value)) {
+        oss << (*flag ? "true" : "false");
+    } else if (const auto* texts = std::any_cast<std::vector<std::string>>(&value)) {
+        for (std::size_t i = 0; i < texts->size(); ++i) {
+            oss << (i ? "," : "") << (*texts)[i];
+        }
+    } else if (const auto* reals = std::any_cast<std::vector<double>>(&value)) {
+        for (std::size_t i = 0; i < reals->size(); ++i) {
+            oss << (i ? "," : "") << (*reals)[i];
+        }
+    } else if (const auto* map = std::any_cast<std::unordered_map<std::string, int>>(&value)) {
+        std::map<std::string, int> sorted(map->begin(), map->end());
+        bool first = true;
+        for (const auto& [name, number] : sorted) {
+            oss << (first ? "" : ",") << name << "=" << number;
+            first = false;
+        }
+    } else {
+        oss << "<" << value.type().name() << ">";
+    }
+    
+    return oss.str();
+}
+
+// Hot reload
+ConfigurationManager::ListenerId ConfigurationManager::addChangeListener(ChangeListener listener) {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    ListenerId id = nextListenerId_++;
+    listeners_.emplace(id, std::move(listener));
+    return id;
+}
+
+void ConfigurationManager::removeChangeListener(ListenerId id) {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    listeners_.erase(id);
+}
+
+void ConfigurationManager::notifyListeners(const std::vector<ConfigChange>& changes) {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    for (const auto& [id, listener] : listeners_) {
+        listener(changes);
+    }
+}
+
+bool ConfigurationManager::enableHotReload() {
+    if (watchId_ != 0) {
+        return true;
+    }
+    if (lastLoadedFile_.empty()) {
+        return false;
+    }
+    
+    // Runs on the watcher thread, off the request threads
+    watchId_ = ConfigFileWatcher::getInstance().watch(lastLoadedFile_, [this](const std::string& path) {
+        // The first session to get here re-parses; the rest share the result
+        if (auto properties = PropertyTable::getInstance().load(path)) {
+            applyProperties(*properties, path);
+        }
+    });
+    
+    if (watchId_ != 0) {
+        std::cout << "[ConfigurationManager] Watching " << lastLoadedFile_ << " for changes" << std::endl;
+    }
+    return watchId_ != 0;
+}
+
+void ConfigurationManager::disableHotReload() {
+    if (watchId_ != 0) {
+        ConfigFileWatcher::getInstance().unwatch(watchId_);
+        watchId_ = 0;
+    }
+}
+
+bool ConfigurationManager::isHotReloadEnabled() const {
+    return watchId_ != 0;
+}
+
 void ConfigurationManager::loadFromEnvironment(const std::string& prefix) {
     std::cout << "[ConfigurationManager] Environment loading not implemented" << std::endl;
 }
@@ -472,7 +893,7 @@ void ConfigurationManager::setDefaultLLMConfig() {
 }
 
 bool ConfigurationManager::isLLMEnabled() const {
-    return getValue<bool>("llm.enabled", false);
+    return handles_.llmEnabled.get();
 }
 
 void ConfigurationManager::setLLMEnabled(bool enabled) {
@@ -480,7 +901,7 @@ void ConfigurationManager::setLLMEnabled(bool enabled) {
 }
 
 std::string ConfigurationManager::getLLMProvider() const {
-    return getValue<std::string>("llm.provider", "anthropic");
+    return handles_.llmProvider.get();
 }
 
 void ConfigurationManager::setLLMProvider(const std::string& provider) {
@@ -488,7 +909,7 @@ void ConfigurationManager::setLLMProvider(const std::string& provider) {
 }
 
 std::string ConfigurationManager::getLLMApiKey() const {
-    std::string key = getValue<std::string>("llm.api_key", "");
+    const std::string& key = handles_.llmApiKey.get();
 
     // Check environment variable if config value is empty or a placeholder
     if (key.empty() || key.find("${") != std::string::npos) {
@@ -506,7 +927,7 @@ void ConfigurationManager::setLLMApiKey(const std::string& apiKey) {
 }
 
 std::string ConfigurationManager::getLLMModel() const {
-    return getValue<std::string>("llm.model", "claude-3-sonnet-20240229");
+    return handles_.llmModel.get();
 }
 
 void ConfigurationManager::setLLMModel(const std::string& model) {
@@ -514,7 +935,7 @@ void ConfigurationManager::setLLMModel(const std::string& model) {
 }
 
 std::string ConfigurationManager::getLLMBaseUrl() const {
-    return getValue<std::string>("llm.base_url", "");
+    return handles_.llmBaseUrl.get();
 }
 
 void ConfigurationManager::setLLMBaseUrl(const std::string& baseUrl) {
@@ -522,7 +943,7 @@ void ConfigurationManager::setLLMBaseUrl(const std::string& baseUrl) {
 }
 
 int ConfigurationManager::getLLMTimeout() const {
-    return getValue<int>("llm.timeout", 60);
+    return handles_.llmTimeout.get();
 }
 
 void ConfigurationManager::setLLMTimeout(int timeoutSeconds) {
@@ -530,7 +951,7 @@ void ConfigurationManager::setLLMTimeout(int timeoutSeconds) {
 }
 
 int ConfigurationManager::getLLMMaxTokens() const {
-    return getValue<int>("llm.max_tokens", 4096);
+    return handles_.llmMaxTokens.get();
 }
 
 void ConfigurationManager::setLLMMaxTokens(int maxTokens) {
@@ -538,7 +959,7 @@ void ConfigurationManager::setLLMMaxTokens(int maxTokens) {
 }
 
 bool ConfigurationManager::isLLMDebugMode() const {
-    return getValue<bool>("llm.debug_mode", false);
+    return handles_.llmDebugMode.get();
 }
 
 void ConfigurationManager::setLLMDebugMode(bool enabled) {
@@ -546,9 +967,9 @@ void ConfigurationManager::setLLMDebugMode(bool enabled) {
 }
 
 double ConfigurationManager::getLLMDefaultRadius() const {
-    return getValue<double>("llm.default_radius_km", 5.0);
+    return handles_.llmDefaultRadius.get();
 }
 
 double ConfigurationManager::getLLMMaxRadius() const {
-    return getValue<double>("llm.max_radius_km", 50.0);
+    return handles_.llmMaxRadius.get();
 }
@@ -3,15 +3,18 @@
 //============================================================================
 
 #include "../../include/core/RestaurantPOSApp.hpp"
+#include "../../include/utils/PropertyTable.hpp"
+#include "../../include/utils/StartupProfile.hpp"
 
 #include <Wt/WBootstrap5Theme.h>
 #include <Wt/WEnvironment.h>
+#include <Wt/WServer.h>
 #include <iostream>
 #include <sstream>
 
 RestaurantPOSApp::RestaurantPOSApp(const Wt::WEnvironment& env)
     : Wt::WApplication(env)
-    , logger_(Logger::getInstance())
+    , logger_(Logger::getInstance().getComponent("core.RestaurantPOSApp"))
     , isDestroying_(false)
     , currentMode_(POS_MODE)
     , mainContainer_(nullptr)
@@ -21,6 +24,7 @@ RestaurantPOSApp::RestaurantPOSApp(const Wt::WEnvironment& env)
     , modeContainer_(nullptr)
     , posModeContainer_(nullptr)
     , kitchenModeContainer_(nullptr)
+    , configListenerId_(0)
 {
     logApplicationStart();
     
@@ -30,6 +34,8 @@ RestaurantPOSApp::RestaurantPOSApp(const Wt::WEnvironment& env)
     // Initialize services
     initializeServices();
     
+    auto uiPhase = std::make_unique<StartupProfile::Phase>("session.ui");
+    
     // Initialize component factory
     initializeComponentFactory();
     
@@ -54,9 +60,15 @@ RestaurantPOSApp::RestaurantPOSApp(const Wt::WEnvironment& env)
     // Set up real-time updates
     setupRealTimeUpdates();
     
+    // Apply configuration file edits without a restart
+    setupConfigurationReload();
+    
     // ENHANCED: Ensure POS mode is loaded and visible by default
     ensurePOSModeDefault();
     
+    uiPhase.reset();
+    reportStartupProfile();
+    
     logger_.info("✓ RestaurantPOSApp initialized successfully in POS mode with styling");
     doJavaScript("setTimeout(function(){var s=document.createElement('style');s.innerHTML='body>*:not(.Wt-domRoot):not(.pos-app-container){display:none!important;position:absolute!important;left:-9999px!important;}';document.head.appendChild(s);Array.from(document.body.childNodes).forEach(function(n){if(n.nodeType===3&&n.textContent.trim().length>100&&(n.textContent.includes('CDATA')||n.textContent.includes('window.')||n.textContent.includes('function')))n.remove();});},50);");
     useStyleSheet(Wt::WLink("/assets/css/hide-cdata.css"));
@@ -247,14 +259,20 @@ void RestaurantPOSApp::onThemeChanged(ThemeService::Theme oldTheme, ThemeService
 // Rest of the methods remain the same but with enhanced logging...
 
 void RestaurantPOSApp::initializeServices() {
+    StartupProfile::Phase phase("session.services");
     logger_.info("[RestaurantPOSApp] Initializing services...");
     
     // Create event manager first (other services depend on it)
     eventManager_ = std::make_shared<EventManager>();
     
     // Create configuration manager and initialize with API settings
-    configManager_ = std::make_shared<ConfigurationManager>();
-    configManager_->initialize();
+    {
+        StartupProfile::Phase configPhase("session.config");
+        configManager_ = std::make_shared<ConfigurationManager>();
+        configManager_->initialize();
+        configManager_->loadFromFile(ConfigurationManager::DEFAULT_CONFIG_FILE);
+        configManager_->enableHotReload();
+    }
     
     // ENABLE API for testing
     configManager_->setValue<bool>("api.enabled", true);
@@ -283,10 +301,19 @@ void RestaurantPOSApp::initializeServices() {
     if (enhancedService) {
         LOG_CONFIG_BOOL(logger_, info, "EnhancedPOSService connected", enhancedService->isConnected());
         logger_.info("[RestaurantPOSApp] ✓ EnhancedPOSService created successfully");
+        
+        // Menu, staff and active orders load concurrently while the UI is built
+        enhancedService->preloadAsync();
     } else {
         logger_.info("[RestaurantPOSApp] ✓ Standard POSService created (local data)");
     }
     
+    posService_->setTaxRate(configManager_->getTaxRate());
+    posService_->setKitchenBusyThreshold(
+        static_cast<size_t>(configManager_->getKitchenBusyThreshold()));
+    posService_->setKitchenStationRouting(configManager_->getKitchenStationRoutes(),
+                                          configManager_->getKitchenItemStations());
+    
     // Initialize menu
     posService_->initializeMenu();
     
@@ -305,6 +332,7 @@ void RestaurantPOSApp::initializeLLMService() {
     // Check if LLM is enabled in configuration
     if (!configManager_->isLLMEnabled()) {
         logger_.info("[RestaurantPOSApp] LLM service is disabled in configuration");
+        llmQueryService_.reset();
         return;
     }
 
@@ -596,13 +624,60 @@ void RestaurantPOSApp::setupEventListeners() {
 }
 
 void RestaurantPOSApp::setupRealTimeUpdates() {
-    // Create timer for periodic updates - keep responsive 5-second interval
+    // Create timer for periodic updates - interval from ui.update_interval (default 5s)
+    int interval = configManager_->getUIUpdateInterval();
     updateTimer_ = std::make_unique<Wt::WTimer>();
-    updateTimer_->setInterval(std::chrono::seconds(5));
+    updateTimer_->setInterval(std::chrono::seconds(interval));
     updateTimer_->timeout().connect(this, &RestaurantPOSApp::onPeriodicUpdate);
     updateTimer_->start();
     
-    logger_.info("✓ Real-time updates enabled (5 second interval with smart refresh)");
+    logger_.info("✓ Real-time updates enabled (" + std::to_string(interval) +
+                 " second interval with smart refresh)");
+}
+
+void RestaurantPOSApp::setupConfigurationReload() {
+    // The listener runs on the config watcher thread; hand the changes to
+    // this session instead of touching widgets from there
+    const std::string sessionId = this->sessionId();
+    configListenerId_ = configManager_->addChangeListener(
+        [sessionId](const std::vector<ConfigurationManager::ConfigChange>& changes) {
+            Wt::WServer* server = Wt::WServer::instance();
+            if (!server) {
+                return;
+            }
+            server->post(sessionId, [changes]() {
+                auto* app = dynamic_cast<RestaurantPOSApp*>(Wt::WApplication::instance());
+                if (app) {
+                    app->onConfigurationChanged(changes);
+                }
+            });
+        });
+}
+
+void RestaurantPOSApp::onConfigurationChanged(const std::vector<ConfigurationManager::ConfigChange>& changes) {
+    if (isDestroying_) {
+        return;
+    }
+    
+    logger_.info("[RestaurantPOSApp] Configuration reloaded: " +
+                 std::to_string(changes.size()) + " value(s) changed");
+    
+    bool llmChanged = false;
+    for (const auto& change : changes) {
+        if (change.key == "ui.update_interval" && updateTimer_) {
+            updateTimer_->setInterval(std::chrono::seconds(configManager_->getUIUpdateInterval()));
+        }
+        llmChanged = llmChanged || change.key.rfind("llm.", 0) == 0;
+    }
+    
+    // The LLM service takes its settings at initialization, so rebuild it
+    if (llmChanged) {
+        initializeLLMService();
+    }
+    
+    auto configEventData = POSEvents::createConfigurationChangedData(
+        changes, ConfigurationManager::DEFAULT_CONFIG_FILE);
+    eventManager_->publish(POSEvents::CONFIGURATION_CHANGED, configEventData, "RestaurantPOSApp");
 }
 
 void RestaurantPOSApp::onPeriodicUpdate() {
@@ -631,6 +706,11 @@ RestaurantPOSApp::~RestaurantPOSApp() {
     isDestroying_ = true;
     
     try {
+        // Stop receiving configuration reloads for this session
+        if (configManager_ && configListenerId_ != 0) {
+            configManager_->removeChangeListener(configListenerId_);
+        }
+        
         // Stop the update timer first
         if (updateTimer_) {
             updateTimer_->stop();
@@ -654,6 +734,22 @@ RestaurantPOSApp::~RestaurantPOSApp() {
     }
 }
 
+void RestaurantPOSApp::reportStartupProfile() {
+    // Only the first session reports; later sessions start warm
+    std::vector<std::string> report;
+    if (!StartupProfile::getInstance().complete(report)) {
+        return;
+    }
+    
+    for (const auto& line : report) {
+        logger_.info(line);
+    }
+    
+    const auto& properties = PropertyTable::getInstance();
+    logger_.info("  Config files parsed: " + std::to_string(properties.getParseCount()) +
+                 ", shared loads: " + std::to_string(properties.getCacheHitCount()));
+}
+
 void RestaurantPOSApp::logApplicationStart() {
     logger_.info("\n" + std::string(60, '='));
     logger_.info("🍽️  RESTAURANT POS SYSTEM STARTING");
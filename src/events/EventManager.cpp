@@ -4,11 +4,12 @@
 #include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <cstdio>
 #include <sstream>
 
 EventManager::EventManager() 
     : nextHandle_(1)
-    , logger_(Logger::getInstance())
+    , logger_(Logger::getInstance().getComponent("events.EventManager"))
     , totalEventsPublished_(0)
     , totalEventHandlerInvocations_(0)
     , totalEventHandlerErrors_(0)
@@ -56,12 +57,11 @@ void EventManager::unsubscribe(SubscriptionHandle handle, const std::string& sub
             eventType = type;
             
             // Log subscription details before removal
-            std::ostringstream detailsMsg;
-            detailsMsg << "Subscription active for " 
-                      << std::chrono::duration_cast<std::chrono::seconds>(
-                         std::chrono::system_clock::now() - it->subscriptionTime).count()
-                      << " seconds, invoked " << it->invocationCount << " times";
-            logger_.debug(detailsMsg.str());
+            LOG_STREAM(logger_, LogLevel::DEBUG,
+                       "Subscription active for " 
+                       << std::chrono::duration_cast<std::chrono::seconds>(
+                          std::chrono::system_clock::now() - it->subscriptionTime).count()
+                       << " seconds, invoked " << it->invocationCount << " times");
             
             subscriptions.erase(it);
             found = true;
@@ -117,17 +117,14 @@ void EventManager::publish(const std::string& eventType,
     logPublishAction(eventType, subscriberCount, publisherName);
     
     if (failedInvocations > 0) {
-        std::ostringstream errorMsg;
-        errorMsg << "Event publication completed with errors: " << failedInvocations 
-                 << " failed, " << successfulInvocations << " succeeded";
-        logger_.warn(errorMsg.str());
+        LOG_STREAM(logger_, LogLevel::WARN,
+                   "Event publication completed with errors: " << failedInvocations 
+                   << " failed, " << successfulInvocations << " succeeded");
     }
     
     // Debug logging for subscriber details
-    if (logger_.getLogLevel() >= LogLevel::DEBUG) {
-        LOG_KEY_VALUE(logger_, debug, "Successful invocations", successfulInvocations);
-        LOG_KEY_VALUE(logger_, debug, "Failed invocations", failedInvocations);
-    }
+    LOG_KEY_VALUE(logger_, debug, "Successful invocations", successfulInvocations);
+    LOG_KEY_VALUE(logger_, debug, "Failed invocations", failedInvocations);
 }
 
 void EventManager::publish(const std::string& eventType, const std::string& publisherName) {
@@ -166,9 +163,9 @@ void EventManager::logSubscriptionStatistics() const {
     if (totalEventHandlerInvocations_ > 0) {
         double successRate = (double)(totalEventHandlerInvocations_ - totalEventHandlerErrors_) 
                            / totalEventHandlerInvocations_ * 100.0;
-        std::ostringstream rateMsg;
-        rateMsg << std::fixed << std::setprecision(2) << successRate << "%";
-        LOG_KEY_VALUE(logger_, info, "Handler success rate", rateMsg.str());
+        char rate[32];
+        std::snprintf(rate, sizeof(rate), "%.2f%%", successRate);
+        LOG_KEY_VALUE(logger_, info, "Handler success rate", std::string(rate));
     }
     
     logger_.info("==============================");
@@ -221,30 +218,25 @@ void EventManager::logSubscriptionAction(const std::string& action,
                                         const std::string& eventType, 
                                         SubscriptionHandle handle, 
                                         const std::string& subscriberName) const {
-    std::ostringstream actionMsg;
-    actionMsg << "[" << action << "] " << subscriberName 
-              << " -> " << eventType 
-              << " (handle: " << handle << ")";
-    logger_.info(actionMsg.str());
+    LOG_STREAM(logger_, LogLevel::INFO,
+               "[" << action << "] " << subscriberName 
+               << " -> " << eventType 
+               << " (handle: " << handle << ")");
     
     // Additional debug info
-    if (logger_.getLogLevel() >= LogLevel::DEBUG) {
-        LOG_KEY_VALUE(logger_, debug, "Subscribers for this event", getSubscriberCount(eventType));
-    }
+    LOG_KEY_VALUE(logger_, debug, "Subscribers for this event", getSubscriberCount(eventType));
 }
 
 void EventManager::logPublishAction(const std::string& eventType, 
                                    size_t subscriberCount, 
                                    const std::string& publisherName) const {
-    std::ostringstream publishMsg;
-    publishMsg << "[PUBLISH] " << publisherName 
-               << " -> " << eventType 
-               << " (" << subscriberCount << " subscribers)";
-    
+    // Runs for every event; structured so binary mode skips text formatting
     if (subscriberCount == 0) {
-        logger_.debug(publishMsg.str() + " - NO SUBSCRIBERS");
+        LOG_STRUCTURED(logger_, LogLevel::DEBUG, "[PUBLISH] {} -> {} ({} subscribers) - NO SUBSCRIBERS",
+                       publisherName, eventType, subscriberCount);
     } else {
-        logger_.debug(publishMsg.str());
+        LOG_STRUCTURED(logger_, LogLevel::DEBUG, "[PUBLISH] {} -> {} ({} subscribers)",
+                       publisherName, eventType, subscriberCount);
     }
 }
 
@@ -19,6 +19,7 @@ namespace POSEvents {
     const std::string ORDER_CANCELLED = "ORDER_CANCELLED";
     const std::string ORDER_STATUS_CHANGED = "ORDER_STATUS_CHANGED";
     const std::string CURRENT_ORDER_CHANGED = "CURRENT_ORDER_CHANGED";
+    const std::string ORDER_SYNC_CONFLICT = "ORDER_SYNC_CONFLICT";
     
     // Menu Events
     const std::string MENU_UPDATED = "MENU_UPDATED";
@@ -1,4 +1,5 @@
 #include "../include/core/RestaurantPOSApp.hpp"
+#include "../include/api/MetricsResource.hpp"
 #include <Wt/WServer.h>
 #include <iostream>
 #include <vector>
@@ -202,6 +203,10 @@ int main(int argc, char** argv) {
                            "/pos",
                            "/favicon.ico");
         
+        // Prometheus scrape endpoint; served outside any session
+        MetricsResource metricsResource;
+        server.addResource(&metricsResource, "/metrics");
+        
         std::cout << "🚀 Starting server..." << std::endl;
         
         // Start the server
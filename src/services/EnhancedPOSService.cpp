@@ -3,20 +3,43 @@
 //============================================================================
 
 #include "../../include/services/EnhancedPOSService.hpp"
+#include "../../include/api/RequestCoalescer.hpp"
+
+#include <Wt/WApplication.h>
+#include <Wt/WServer.h>
 
 #include <iostream>
 #include <algorithm>
+#include <any>
+#include <cstdlib>
 
 EnhancedPOSService::EnhancedPOSService(std::shared_ptr<EventManager> eventManager,
                                        const ServiceConfig& config)
     : POSService(eventManager),  // Call base class constructor (initializes logger)
-      config_(config), initialized_(false), menuCacheValid_(false) {
+      config_(config), initialized_(false), outboxListenerId_(0),
+      lifetime_(std::make_shared<char>()), menuCacheValid_(false) {
     
     getLogger().info("[EnhancedPOSService] Initializing with API integration...");
     LOG_CONFIG_STRING(getLogger(), info, "API Base URL", config_.apiBaseUrl);
     LOG_CONFIG_BOOL(getLogger(), info, "API Debug Mode", config_.debugMode);
     LOG_CONFIG_BOOL(getLogger(), info, "Caching Enabled", config_.enableCaching);
     LOG_CONFIG_STRING(getLogger(), info, "API Timeout", std::to_string(config_.apiTimeout) + "s");
+    LOG_CONFIG_STRING(getLogger(), info, "API Retries", std::to_string(config_.maxRetries) + " (from " +
+                      std::to_string(config_.retryDelayMs) + " ms)");
+    LOG_CONFIG_STRING(getLogger(), info, "API Coalescing Window", std::to_string(config_.coalesceWindowMs) + " ms");
+    LOG_CONFIG_STRING(getLogger(), info, "Order Write-Behind",
+                      config_.enableOutbox ? config_.outboxPath : std::string("disabled"));
+}
+
+EnhancedPOSService::~EnhancedPOSService() {
+    if (outboxListenerId_ != 0) {
+        MutationOutbox::getInstance().removeConflictListener(outboxListenerId_);
+    }
+    if (auto eventManager = getEventManager()) {
+        for (auto handle : invalidationSubscriptions_) {
+            eventManager->unsubscribe(handle, "EnhancedPOSService");
+        }
+    }
 }
 
 bool EnhancedPOSService::initialize() {
@@ -44,7 +67,14 @@ void EnhancedPOSService::initializeAPIComponents() {
         // Create API client
         apiClient_ = std::make_shared<APIClient>(config_.apiBaseUrl);
         apiClient_->setTimeout(config_.apiTimeout);
+        apiClient_->setRetryPolicy(config_.maxRetries, config_.retryDelayMs);
         apiClient_->setDebugMode(config_.debugMode);
+        apiClient_->setAtomicOperations(config_.enableAtomicOperations);
+        apiClient_->setCompression(config_.enableCompression,
+                                   static_cast<std::size_t>(std::max(config_.compressRequestsAbove, 0)));
+        
+        // Process-wide: identical reads from all sessions share responses
+        RequestCoalescer::getInstance().setWindow(std::chrono::milliseconds(config_.coalesceWindowMs));
         
         if (!config_.authToken.empty()) {
             apiClient_->setAuthToken(config_.authToken);
@@ -53,9 +83,79 @@ void EnhancedPOSService::initializeAPIComponents() {
         
         // Create repositories
         orderRepository_ = std::make_unique<OrderRepository>(apiClient_);
+        orderRepository_->setFullSyncInterval(std::chrono::seconds(config_.orderFullSyncSeconds));
         menuItemRepository_ = std::make_unique<MenuItemRepository>(apiClient_);
         employeeRepository_ = std::make_unique<EmployeeRepository>(apiClient_);
         
+        if (config_.enableIdentityMap) {
+            const std::chrono::seconds ttl(config_.identityMapTtlSeconds);
+            orderRepository_->setIdentityMap(true, ttl);
+            menuItemRepository_->setIdentityMap(true, ttl);
+            employeeRepository_->setIdentityMap(true, ttl);
+            subscribeToInvalidations();
+        }
+        
+        // Process-wide: the first session opens the journal with the
+        // server-wide settings, later ones share it; each write carries
+        // its own session's token
+        if (config_.enableOutbox) {
+            MutationOutbox::Settings outboxSettings;
+            outboxSettings.journalPath = config_.outboxPath;
+            outboxSettings.baseUrl = config_.apiBaseUrl;
+            outboxSettings.authToken = config_.authToken;
+            outboxSettings.timeoutSeconds = config_.apiTimeout;
+            outboxSettings.batchSize = static_cast<std::size_t>(std::max(config_.outboxBatchSize, 1));
+            outboxSettings.retryInterval = std::chrono::milliseconds(config_.outboxRetryMs);
+            outboxSettings.atomicOperations = config_.enableAtomicOperations;
+            outboxSettings.compressRequestsAbove = static_cast<std::size_t>(std::max(config_.compressRequestsAbove, 0));
+            
+            MutationOutbox& outbox = MutationOutbox::getInstance();
+            if (outbox.open(outboxSettings)) {
+                // Conflicts arrive on the outbox's thread: publish them in this session
+                std::weak_ptr<EventManager> events = getEventManager();
+                Wt::WApplication* app = Wt::WApplication::instance();
+                Wt::WServer* server = Wt::WServer::instance();
+                std::string sessionId = app ? app->sessionId() : std::string();
+                
+                outboxListenerId_ = outbox.addConflictListener(
+                    [events, server, sessionId](const MutationOutbox::Conflict& conflict) {
+                        const std::string prefix = "Order/";
+                        if (conflict.mutation.group.compare(0, prefix.size(), prefix) != 0) {
+                            return;
+                        }
+                        
+                        Wt::Json::Object eventData;
+                        eventData["orderId"] = Wt::Json::Value(std::atoi(conflict.mutation.group.c_str() + prefix.size()));
+                        eventData["method"] = Wt::Json::Value(conflict.mutation.method);
+                        eventData["statusCode"] = Wt::Json::Value(conflict.statusCode);
+                        eventData["message"] = Wt::Json::Value("Order change rejected by the server: " + conflict.message);
+                        
+                        auto publish = [events, eventData]() {
+                            if (auto eventManager = events.lock()) {
+                                eventManager->publish(POSEvents::ORDER_SYNC_CONFLICT, eventData, "EnhancedPOSService");
+                            }
+                        };
+                        if (server && !sessionId.empty()) {
+                            server->post(sessionId, publish);
+                        } else {
+                            publish();
+                        }
+                    });
+                getLogger().info("[EnhancedPOSService] Order writes go through the outbox (" +
+                                 std::to_string(outbox.pendingCount()) + " queued)");
+            } else {
+                getLogger().warn("[EnhancedPOSService] Outbox unavailable, order writes go straight to the API");
+            }
+        }
+        
+        // Menu and staff change rarely: serve them from the HTTP cache and
+        // revalidate in the background (an unchanged menu costs a 304)
+        if (config_.enableCaching) {
+            const std::chrono::minutes staleWindow(APIConfiguration::Defaults::CACHE_STALE_MINUTES);
+            apiClient_->enableResponseCache(menuItemRepository_->getEndpoint(), staleWindow);
+            apiClient_->enableResponseCache(employeeRepository_->getEndpoint(), staleWindow);
+        }
+        
         LOG_OPERATION_STATUS(getLogger(), "API components initialization", true);
         
     } catch (const std::exception& e) {
@@ -236,12 +336,9 @@ void EnhancedPOSService::createOrderAsync(const std::string& tableIdentifier,
         static int nextOrderId = 1000; // In real app, get from API
         auto order = std::make_shared<Order>(nextOrderId++, tableIdentifier);
         
-        // Save to API
-        orderRepository_->create(*order, [this, order, callback](std::unique_ptr<Order> createdOrder, bool success) {
-            if (success && createdOrder) {
-                // Update local order with API response data
-                // For now, we'll use the local order
-                
+        // Save to API (or queue it for the API)
+        writeOrder("POST", order, [this, order, callback](bool success) {
+            if (success) {
                 // Log the successful creation
                 POSEvents::EventLogger::logOrderEvent(
                     POSEvents::ORDER_CREATED,
@@ -288,28 +385,74 @@ void EnhancedPOSService::getActiveOrdersAsync(std::function<void(std::vector<std
         return;
     }
     
+    if (isAPIDown(orderRepository_->getEndpoint(), "getActiveOrdersAsync")) {
+        if (callback) callback(POSService::getActiveOrders(), true);
+        return;
+    }
+    
+    if (config_.enableDeltaSync) {
+        orderRepository_->syncActive([this, callback](std::vector<std::shared_ptr<Order>> orders, bool success) {
+            if (success) {
+                LOG_KEY_VALUE(getLogger(), info, "Active orders synced from API", orders.size());
+            } else {
+                LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "getActiveOrdersAsync", "Failed to sync from API");
+            }
+            
+            if (callback) callback(std::move(orders), success);
+        });
+        return;
+    }
+    
     // Filter for active orders (not served or cancelled)
     std::map<std::string, std::string> params;
     params["filter[status]"] = "0,1,2,3"; // PENDING,SENT_TO_KITCHEN,PREPARING,READY
     
-    orderRepository_->findAll(params, [this, callback](std::vector<Order> orders, bool success) {
-        std::vector<std::shared_ptr<Order>> sharedOrders;
-        
+    orderRepository_->findAllShared(params, [this, callback](std::vector<std::shared_ptr<Order>> sharedOrders, bool success) {
         if (success) {
-            sharedOrders.reserve(orders.size());
-            for (const auto& order : orders) {
-                sharedOrders.push_back(std::make_shared<Order>(order));
-            }
-            
             LOG_KEY_VALUE(getLogger(), info, "Active orders retrieved from API", sharedOrders.size());
         } else {
             LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "getActiveOrdersAsync", "Failed to retrieve from API");
         }
         
-        if (callback) callback(sharedOrders, success);
+        if (callback) callback(std::move(sharedOrders), success);
     });
 }
 
+void EnhancedPOSService::getActiveOrderSummariesAsync(std::function<void(std::vector<OrderSummary>, bool)> callback) {
+    if (!initialized_) {
+        LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "getActiveOrderSummariesAsync", "Service not initialized");
+        if (callback) callback({}, false);
+        return;
+    }
+    
+    if (isAPIDown(orderRepository_->getEndpoint(), "getActiveOrderSummariesAsync")) {
+        std::vector<OrderSummary> summaries;
+        for (const auto& order : POSService::getActiveOrders()) {
+            summaries.emplace_back(*order);
+        }
+        if (callback) callback(std::move(summaries), true);
+        return;
+    }
+    
+    auto onSummaries = [this, callback](std::vector<OrderSummary> summaries, bool success) {
+        if (success) {
+            LOG_KEY_VALUE(getLogger(), info, "Active order summaries retrieved from API", summaries.size());
+        } else {
+            LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "getActiveOrderSummariesAsync",
+                                "Failed to retrieve from API");
+        }
+        
+        if (callback) callback(std::move(summaries), success);
+    };
+    
+    const APIView view = config_.enableSparseFieldsets ? OrderRepository::summaryView() : APIView();
+    if (config_.enableDeltaSync) {
+        orderRepository_->syncActiveSummaries(onSummaries, view);
+    } else {
+        orderRepository_->findActiveSummaries(onSummaries, view);
+    }
+}
+
 // =================================================================
 // Menu Management Implementation
 // =================================================================
@@ -334,17 +477,21 @@ void EnhancedPOSService::getMenuItemsAsync(bool forceRefresh,
         return;
     }
     
+    if (isAPIDown(menuItemRepository_->getEndpoint(), "getMenuItemsAsync")) {
+        // A stale cache still beats the built-in menu
+        if (callback) callback(menuCacheValid_ ? menuItemsCache_ : POSService::getMenuItems(), true);
+        return;
+    }
+    
+    // A forced refresh must not be answered from the HTTP cache unchecked
+    if (forceRefresh) {
+        apiClient_->expireCachedResponses(menuItemRepository_->getEndpoint());
+    }
+    
     // Fetch from API
     getLogger().info("[EnhancedPOSService] Fetching menu items from API...");
-    menuItemRepository_->findAll({}, [this, callback](std::vector<MenuItem> items, bool success) {
-        std::vector<std::shared_ptr<MenuItem>> sharedItems;
-        
+    menuItemRepository_->findAllShared({}, [this, callback](std::vector<std::shared_ptr<MenuItem>> sharedItems, bool success) {
         if (success) {
-            sharedItems.reserve(items.size());
-            for (const auto& item : items) {
-                sharedItems.push_back(std::make_shared<MenuItem>(item));
-            }
-            
             // Update cache
             if (config_.enableCaching) {
                 updateMenuCache(sharedItems);
@@ -355,7 +502,7 @@ void EnhancedPOSService::getMenuItemsAsync(bool forceRefresh,
             handleAPIError("getMenuItemsAsync", "Failed to fetch menu items");
         }
         
-        if (callback) callback(sharedItems, success);
+        if (callback) callback(std::move(sharedItems), success);
     });
 }
 
@@ -377,7 +524,22 @@ void EnhancedPOSService::getMenuItemsByCategoryAsync(MenuItem::Category category
         }
         
         LOG_KEY_VALUE(getLogger(), debug, "Category items from cache", categoryItems.size());
-        if (callback) callback(categoryItems, true);
+        if (callback) callback(std::move(categoryItems), true);
+        return;
+    }
+    
+    if (isAPIDown(menuItemRepository_->getEndpoint(), "getMenuItemsByCategoryAsync")) {
+        std::vector<std::shared_ptr<MenuItem>> categoryItems;
+        if (menuCacheValid_) {
+            for (const auto& item : menuItemsCache_) {
+                if (item && item->getCategory() == category) {
+                    categoryItems.push_back(item);
+                }
+            }
+        } else {
+            categoryItems = POSService::getMenuItemsByCategory(category);
+        }
+        if (callback) callback(std::move(categoryItems), true);
         return;
     }
     
@@ -388,8 +550,8 @@ void EnhancedPOSService::getMenuItemsByCategoryAsync(MenuItem::Category category
         
         if (success) {
             sharedItems.reserve(items.size());
-            for (const auto& item : items) {
-                sharedItems.push_back(std::make_shared<MenuItem>(item));
+            for (auto& item : items) {
+                sharedItems.push_back(std::make_shared<MenuItem>(std::move(item)));
             }
             
             LOG_KEY_VALUE(getLogger(), info, "Category items loaded from API", sharedItems.size());
@@ -398,7 +560,7 @@ void EnhancedPOSService::getMenuItemsByCategoryAsync(MenuItem::Category category
                                "Failed to fetch category items");
         }
         
-        if (callback) callback(sharedItems, success);
+        if (callback) callback(std::move(sharedItems), success);
     });
 }
 
@@ -481,9 +643,8 @@ void EnhancedPOSService::saveCurrentOrderAsync(std::function<void(bool)> callbac
     
     int orderId = currentOrder_->getOrderId();
     
-    // Save to API
-    orderRepository_->update(orderId, *currentOrder_, 
-                           [this, orderId, callback](std::unique_ptr<Order> updatedOrder, bool success) {
+    // Save to API (or queue it for the API)
+    writeOrder("PUT", currentOrder_, [this, orderId, callback](bool success) {
         if (success) {
             LOG_OPERATION_STATUS(getLogger(), "Save current order to API", true);
         } else {
@@ -495,6 +656,34 @@ void EnhancedPOSService::saveCurrentOrderAsync(std::function<void(bool)> callbac
     });
 }
 
+void EnhancedPOSService::sendCurrentOrderToKitchenAsync(std::function<void(bool)> callback) {
+    getLogger().info("[EnhancedPOSService] Sending current order to kitchen asynchronously");
+    
+    std::shared_ptr<Order> order = currentOrder_;
+    if (!order) {
+        LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "sendCurrentOrderToKitchenAsync", "No current order to send");
+        if (callback) callback(false);
+        return;
+    }
+    
+    // Sets the status and clears the current order
+    if (!POSService::sendCurrentOrderToKitchen()) {
+        if (callback) callback(false);
+        return;
+    }
+    
+    // The lines and the new status go out as one write, not a save followed
+    // by a status update
+    int orderId = order->getOrderId();
+    writeOrder("PUT", order, [this, orderId, callback](bool success) {
+        if (!success) {
+            LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "sendCurrentOrderToKitchenAsync", 
+                               "Failed to save order " + std::to_string(orderId) + " to API");
+        }
+        if (callback) callback(success);
+    });
+}
+
 // =================================================================
 // Employee Management
 // =================================================================
@@ -515,7 +704,7 @@ void EnhancedPOSService::getEmployeesAsync(std::function<void(std::vector<Employ
             LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "getEmployeesAsync", "Failed to retrieve employees");
         }
         
-        if (callback) callback(employees, success);
+        if (callback) callback(std::move(employees), success);
     });
 }
 
@@ -537,7 +726,7 @@ void EnhancedPOSService::getEmployeesByRoleAsync(const std::string& role,
                                "Failed to retrieve employees with role: " + role);
         }
         
-        if (callback) callback(employees, success);
+        if (callback) callback(std::move(employees), success);
     });
 }
 
@@ -558,7 +747,50 @@ void EnhancedPOSService::getActiveEmployeesAsync(std::function<void(std::vector<
                                "Failed to retrieve active employees");
         }
         
-        if (callback) callback(employees, success);
+        if (callback) callback(std::move(employees), success);
+    });
+}
+
+// =================================================================
+// Session Start
+// =================================================================
+
+void EnhancedPOSService::preloadAsync(std::function<void(bool)> callback) {
+    getLogger().info("[EnhancedPOSService] Preloading menu, staff and active orders");
+    
+    if (!initialized_ || !apiClient_->isAvailable()) {
+        if (callback) callback(false);
+        return;
+    }
+    
+    // Independent reads: all three are in flight before any is awaited
+    std::map<std::string, std::string> activeFilter;
+    activeFilter["filter[status]"] = "0,1,2,3"; // PENDING,SENT_TO_KITCHEN,PREPARING,READY
+    auto menu = menuItemRepository_->findAllSharedAsync();
+    auto staff = employeeRepository_->findAllSharedAsync();
+    auto orders = config_.enableDeltaSync ? orderRepository_->syncActiveAsync()
+                                          : orderRepository_->findAllSharedAsync(activeFilter);
+    const auto started = std::chrono::steady_clock::now();
+    
+    whenAll(menu, staff, orders).then(lifetime_, [this, callback, started](auto loaded, bool success) {
+        auto& [menuItems, employees, activeOrders] = loaded;
+        
+        // Failed reads deliver nothing; keep whatever did arrive
+        if (config_.enableCaching && !menuItems.empty()) {
+            updateMenuCache(menuItems);
+        }
+        
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started);
+        getLogger().info("[EnhancedPOSService] Preloaded " + std::to_string(menuItems.size()) + " menu items, " +
+                         std::to_string(employees.size()) + " employees and " +
+                         std::to_string(activeOrders.size()) + " active orders in " +
+                         std::to_string(elapsed.count()) + " ms");
+        if (!success) {
+            LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "preloadAsync", "Not all data could be loaded");
+        }
+        
+        if (callback) callback(success);
     });
 }
 
@@ -569,6 +801,9 @@ void EnhancedPOSService::getActiveEmployeesAsync(std::function<void(std::vector<
 void EnhancedPOSService::setAuthToken(const std::string& token) {
     getLogger().info("[EnhancedPOSService] Updating API authentication token");
     
+    if (config_.enableOutbox) {
+        MutationOutbox::getInstance().replaceAuthToken(config_.authToken, token);
+    }
     config_.authToken = token;
     if (apiClient_) {
         apiClient_->setAuthToken(token);
@@ -588,6 +823,14 @@ void EnhancedPOSService::clearCaches() {
     menuItemByIdCache_.clear();
     menuCacheValid_ = false;
     
+    if (apiClient_) {
+        apiClient_->expireCachedResponses(menuItemRepository_->getEndpoint());
+        apiClient_->expireCachedResponses(employeeRepository_->getEndpoint());
+        orderRepository_->invalidateAll();
+        menuItemRepository_->invalidateAll();
+        employeeRepository_->invalidateAll();
+    }
+    
     LOG_KEY_VALUE(getLogger(), info, "Menu items cache cleared", menuItemsCleared);
     LOG_KEY_VALUE(getLogger(), info, "Menu by ID cache cleared", menuByIdCleared);
     LOG_OPERATION_STATUS(getLogger(), "Cache clearing", true);
@@ -615,6 +858,17 @@ void EnhancedPOSService::handleAPIError(const std::string& operation, const std:
     }
 }
 
+bool EnhancedPOSService::isAPIDown(const std::string& endpoint, const std::string& operation) const {
+    if (!apiClient_ || apiClient_->isAvailable(endpoint)) {
+        return false;
+    }
+    
+    LOG_RATE_LIMITED(getLogger(), LogLevel::WARN, 5, 20,
+                     "[EnhancedPOSService] " + operation + ": middleware unavailable (" + endpoint +
+                     " circuit open), using local data");
+    return true;
+}
+
 void EnhancedPOSService::publishEvent(const std::string& eventType, const Wt::Json::Object& eventData) {
     auto eventManager = getEventManager();
     if (eventManager) {
@@ -623,6 +877,86 @@ void EnhancedPOSService::publishEvent(const std::string& eventType, const Wt::Js
     }
 }
 
+void EnhancedPOSService::writeOrder(const std::string& method, std::shared_ptr<Order> order,
+                                    std::function<void(bool)> callback) {
+    const std::string id = std::to_string(order->getOrderId());
+    const std::string endpoint = (method == "POST")
+        ? orderRepository_->getEndpoint()
+        : orderRepository_->getEndpoint() + "/" + id;
+    
+    // One group per order: its writes reach the API in the order made here
+    MutationOutbox& outbox = MutationOutbox::getInstance();
+    if (config_.enableOutbox &&
+        outbox.enqueue(method, endpoint, "Order/" + id, orderRepository_->toResource(*order), config_.authToken) != 0) {
+        writeBehindOrders_[order->getOrderId()] = order;
+        orderRepository_->invalidate(id);
+        getLogger().debug("[EnhancedPOSService] Queued " + method + " " + endpoint + " (" +
+                          std::to_string(outbox.pendingCount()) + " writes pending)");
+        if (callback) callback(true);
+        return;
+    }
+    
+    auto done = [callback](std::unique_ptr<Order>, bool success) {
+        if (callback) callback(success);
+    };
+    if (method == "POST") {
+        orderRepository_->create(*order, done);
+    } else {
+        orderRepository_->update(id, *order, done);
+    }
+}
+
+AsyncResult<std::shared_ptr<Order>> EnhancedPOSService::writeOrderAsync(const std::string& method,
+                                                                       std::shared_ptr<Order> order) {
+    AsyncResult<std::shared_ptr<Order>> result;
+    auto settle = result.resolver();
+    writeOrder(method, order, [settle, order](bool success) { settle(order, success); });
+    return result;
+}
+
+AsyncResult<std::shared_ptr<Order>> EnhancedPOSService::fetchOrder(int orderId) {
+    return AsyncResult<std::shared_ptr<Order>>::from([this, orderId](auto settle) {
+        getOrderByIdAsync(orderId, settle);
+    });
+}
+
+std::shared_ptr<Order> EnhancedPOSService::findWriteBehindOrder(int orderId) {
+    auto it = writeBehindOrders_.find(orderId);
+    if (it == writeBehindOrders_.end()) {
+        return nullptr;
+    }
+    
+    if (MutationOutbox::getInstance().pendingCount("Order/" + std::to_string(orderId)) == 0) {
+        writeBehindOrders_.erase(it);  // Delivered (or rejected): the API copy is authoritative
+        orderRepository_->invalidate(orderId);
+        return nullptr;
+    }
+    return it->second;
+}
+
+void EnhancedPOSService::subscribeToInvalidations() {
+    auto eventManager = getEventManager();
+    if (!eventManager) {
+        return;
+    }
+    
+    // A modified order is re-read on next use; the map keeps the old object
+    // to compare with, so an unchanged order keeps its pointer
+    invalidationSubscriptions_.push_back(eventManager->subscribe(POSEvents::ORDER_MODIFIED,
+        [this](const std::any& data) {
+            const auto* eventData = std::any_cast<Wt::Json::Object>(&data);
+            const Wt::Json::Value& orderId = eventData ? eventData->get("orderId") : Wt::Json::Value::Null;
+            if (orderId.type() == Wt::Json::Type::Number) {
+                orderRepository_->invalidate(static_cast<int>(orderId));
+            } else {
+                orderRepository_->invalidateAll();
+            }
+        }, "EnhancedPOSService"));
+    
+    invalidationSubscriptions_.push_back(eventManager->subscribe(POSEvents::MENU_UPDATED,
+        [this](const std::any&) { menuItemRepository_->invalidateAll(); }, "EnhancedPOSService"));
+}
+
 bool EnhancedPOSService::isMenuCacheExpired() const {
     auto now = std::chrono::system_clock::now();
     auto cacheAge = std::chrono::duration_cast<std::chrono::minutes>(now - menuCacheTime_);
@@ -668,11 +1002,24 @@ void EnhancedPOSService::getOrderByIdAsync(int orderId,
         return;
     }
     
+    // Queued writes have not reached the API yet: its copy would be outdated
+    if (auto pendingOrder = findWriteBehindOrder(orderId)) {
+        if (callback) callback(pendingOrder, true);
+        return;
+    }
+    
+    if (isAPIDown(orderRepository_->getEndpoint(), "getOrderByIdAsync")) {
+        auto localOrder = POSService::getOrderById(orderId);
+        if (callback) callback(localOrder, localOrder != nullptr);
+        return;
+    }
+    
+    // A copy, even from the identity map: callers may change it
     orderRepository_->findById(orderId, [this, orderId, callback](std::unique_ptr<Order> order, bool success) {
         std::shared_ptr<Order> sharedOrder = nullptr;
         
         if (success && order) {
-            sharedOrder = std::make_shared<Order>(*order);
+            sharedOrder = std::shared_ptr<Order>(std::move(order));
             getLogger().info("[EnhancedPOSService] Order " + std::to_string(orderId) + " retrieved from API");
         } else {
             LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "getOrderByIdAsync", 
@@ -693,26 +1040,30 @@ void EnhancedPOSService::getOrdersByTableIdentifierAsync(const std::string& tabl
         return;
     }
     
+    if (isAPIDown(orderRepository_->getEndpoint(), "getOrdersByTableIdentifierAsync")) {
+        std::vector<std::shared_ptr<Order>> tableOrders;
+        for (const auto& order : POSService::getActiveOrders()) {
+            if (order && order->getTableIdentifier() == tableIdentifier) {
+                tableOrders.push_back(order);
+            }
+        }
+        if (callback) callback(std::move(tableOrders), true);
+        return;
+    }
+    
     // Use repository to find orders by table identifier
     std::map<std::string, std::string> params;
     params["filter[table_identifier]"] = tableIdentifier;
     
-    orderRepository_->findAll(params, [this, tableIdentifier, callback](std::vector<Order> orders, bool success) {
-        std::vector<std::shared_ptr<Order>> sharedOrders;
-        
+    orderRepository_->findAllShared(params, [this, tableIdentifier, callback](std::vector<std::shared_ptr<Order>> sharedOrders, bool success) {
         if (success) {
-            sharedOrders.reserve(orders.size());
-            for (const auto& order : orders) {
-                sharedOrders.push_back(std::make_shared<Order>(order));
-            }
-            
             LOG_KEY_VALUE(getLogger(), info, "Orders for table '" + tableIdentifier + "'", sharedOrders.size());
         } else {
             LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "getOrdersByTableIdentifierAsync", 
                                "Failed to retrieve orders for table: " + tableIdentifier);
         }
         
-        if (callback) callback(sharedOrders, success);
+        if (callback) callback(std::move(sharedOrders), success);
     });
 }
 
@@ -727,20 +1078,20 @@ void EnhancedPOSService::updateOrderStatusAsync(int orderId, Order::Status statu
         return;
     }
     
-    // First, get the current order
-    getOrderByIdAsync(orderId, [this, orderId, status, callback](std::shared_ptr<Order> order, bool success) {
-        if (!success || !order) {
-            LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "updateOrderStatusAsync", 
-                               "Could not retrieve order " + std::to_string(orderId) + " for status update");
-            if (callback) callback(false);
-            return;
-        }
-        
-        // Update the status locally
-        order->setStatus(status);
-        
-        // FIXED: Removed unused lambda capture 'status'
-        orderRepository_->update(orderId, *order, [this, orderId, callback](std::unique_ptr<Order> updatedOrder, bool updateSuccess) {
+    // Read the order, then write it back with the new status
+    fetchOrder(orderId)
+        .then(lifetime_, [this, orderId, status](std::shared_ptr<Order> order, bool success) {
+            if (!success || !order) {
+                LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "updateOrderStatusAsync", 
+                                   "Could not retrieve order " + std::to_string(orderId) + " for status update");
+                return AsyncResult<std::shared_ptr<Order>>::ready(nullptr, false);
+            }
+            
+            // Update the status locally
+            order->setStatus(status);
+            return writeOrderAsync("PUT", order);
+        })
+        .then(lifetime_, [this, orderId, callback](std::shared_ptr<Order> order, bool updateSuccess) {
             if (updateSuccess) {
                 getLogger().info("[EnhancedPOSService] Order " + std::to_string(orderId) + " status updated successfully");
                 
@@ -749,25 +1100,24 @@ void EnhancedPOSService::updateOrderStatusAsync(int orderId, Order::Status statu
                 if (eventManager) {
                     // FIXED: Create JSON event manually
                     Wt::Json::Object eventData;
-                    eventData["orderId"] = Wt::Json::Value(updatedOrder->getOrderId());
-                    eventData["tableIdentifier"] = Wt::Json::Value(updatedOrder->getTableIdentifier());
-                    eventData["status"] = Wt::Json::Value(static_cast<int>(updatedOrder->getStatus()));
+                    eventData["orderId"] = Wt::Json::Value(order->getOrderId());
+                    eventData["tableIdentifier"] = Wt::Json::Value(order->getTableIdentifier());
+                    eventData["status"] = Wt::Json::Value(static_cast<int>(order->getStatus()));
                     eventData["timestamp"] = Wt::Json::Value(static_cast<int64_t>(
                         std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())));
-                    eventData["message"] = Wt::Json::Value("Order " + std::to_string(updatedOrder->getOrderId()) + " modified");
+                    eventData["message"] = Wt::Json::Value("Order " + std::to_string(order->getOrderId()) + " modified");
                     
                     publishEvent(POSEvents::ORDER_STATUS_CHANGED, eventData);
                 }
                 
                 LOG_OPERATION_STATUS(getLogger(), "Order status update", true);
-            } else {
+            } else if (order) {
                 LOG_COMPONENT_ERROR(getLogger(), "EnhancedPOSService", "updateOrderStatusAsync", 
                                    "Failed to update order " + std::to_string(orderId) + " status");
             }
             
             if (callback) callback(updateSuccess);
         });
-    });
 }
 
 void EnhancedPOSService::cancelOrderAsync(int orderId,
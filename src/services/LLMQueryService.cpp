@@ -346,7 +346,7 @@ BusinessDemographics BusinessDemographics::fromJson(const Wt::Json::Object& json
 //============================================================================
 
 LLMQueryService::LLMQueryService(std::shared_ptr<EventManager> eventManager)
-    : logger_(Logger::getInstance())
+    : logger_(Logger::getInstance().getComponent("services.LLMQueryService"))
     , eventManager_(eventManager)
     , provider_(LLMProvider::ANTHROPIC)
     , timeoutSeconds_(60)
@@ -6,9 +6,10 @@
 #include <regex>
 
 POSService::POSService(std::shared_ptr<EventManager> eventManager)
-    : logger_(Logger::getInstance())  // ADDED: Initialize logger reference
+    : logger_(Logger::getInstance().getComponent("services.POSService"))
     , eventManager_(eventManager)
     , currentOrder_(nullptr)
+    , configSubscription_(0)
     , orderCreatedCallback_(nullptr)
     , orderModifiedCallback_(nullptr) {
     
@@ -17,9 +18,41 @@ POSService::POSService(std::shared_ptr<EventManager> eventManager)
     initializeSubsystems();
     initializeMenuItems();
     
+    if (eventManager_) {
+        configSubscription_ = eventManager_->subscribe(POSEvents::CONFIGURATION_CHANGED,
+            [this](const std::any& data) { handleConfigurationChanged(data); },
+            "POSService");
+    }
+    
     LOG_OPERATION_STATUS(logger_, "POSService initialization", true);
 }
 
+POSService::~POSService() {
+    if (eventManager_ && configSubscription_ != 0) {
+        eventManager_->unsubscribe(configSubscription_, "POSService");
+    }
+}
+
+void POSService::handleConfigurationChanged(const std::any& eventData) {
+    try {
+        const auto& data = std::any_cast<const POSEvents::ConfigurationEventData&>(eventData);
+        if (const auto* change = data.find("restaurant.tax_rate")) {
+            setTaxRate(std::any_cast<double>(change->newValue));
+        }
+        if (const auto* change = data.find("kitchen.busy_threshold")) {
+            setKitchenBusyThreshold(static_cast<size_t>(std::any_cast<int>(change->newValue)));
+        }
+        if (const auto* change = data.find("kitchen.station_routes")) {
+            setKitchenStationRouting(std::any_cast<std::vector<std::string>>(change->newValue), itemStations_);
+        }
+        if (const auto* change = data.find("kitchen.item_stations")) {
+            setKitchenStationRouting(stationRoutes_, std::any_cast<std::vector<std::string>>(change->newValue));
+        }
+    } catch (const std::bad_any_cast& e) {
+        LOG_COMPONENT_ERROR(logger_, "POSService", "handleConfigurationChanged", e.what());
+    }
+}
+
 void POSService::initializeSubsystems() {
     logger_.info("[POSService] Initializing subsystems...");
     
@@ -537,6 +570,11 @@ bool POSService::sendCurrentOrderToKitchen() {
     }
 }
 
+void POSService::setTaxRate(double rate) {
+    Order::setTaxRate(rate);
+    LOG_KEY_VALUE(logger_, info, "[POSService] Tax rate", rate);
+}
+
 // =====================================================================
 // Kitchen Interface Methods
 // =====================================================================
@@ -560,6 +598,18 @@ std::vector<KitchenInterface::KitchenTicket> POSService::getKitchenTickets() con
     }
 }
 
+KitchenInterface::TicketView POSService::getKitchenTicketView() const {
+    if (!kitchenInterface_) {
+        LOG_COMPONENT_ERROR(logger_, "POSService", "getKitchenTicketView", "Kitchen interface not available");
+        return {};
+    }
+    return kitchenInterface_->getTickets();
+}
+
+size_t POSService::getKitchenQueueLength() const {
+    return kitchenInterface_ ? kitchenInterface_->getQueueLength() : 0;
+}
+
 int POSService::getEstimatedWaitTime() const {
     logger_.debug("[POSService] Getting estimated wait time");
     
@@ -604,18 +654,68 @@ Wt::Json::Object POSService::getKitchenQueueStatus() const {
     }
 }
 
+void POSService::setKitchenBusyThreshold(size_t threshold) {
+    if (!kitchenInterface_) {
+        return;
+    }
+    kitchenInterface_->setBusyThreshold(threshold);
+    LOG_KEY_VALUE(logger_, info, "[POSService] Kitchen busy threshold", threshold);
+}
+
+size_t POSService::getKitchenBusyThreshold() const {
+    return kitchenInterface_ ? kitchenInterface_->getBusyThreshold() : 0;
+}
+
+void POSService::setKitchenStationRouting(const std::vector<std::string>& categoryRoutes,
+                                          const std::vector<std::string>& itemRoutes) {
+    stationRoutes_ = categoryRoutes;
+    itemStations_ = itemRoutes;
+    if (!kitchenInterface_) {
+        return;
+    }
+    
+    std::vector<std::string> rejected;
+    auto routing = KitchenInterface::StationRouting::parse(stationRoutes_, itemStations_, &rejected);
+    for (const auto& route : rejected) {
+        LOG_COMPONENT_ERROR(logger_, "POSService", "setKitchenStationRouting", "Ignoring route: " + route);
+    }
+    kitchenInterface_->setStationRouting(std::move(routing));
+    LOG_KEY_VALUE(logger_, info, "[POSService] Kitchen stations", kitchenInterface_->getStationNames().size());
+}
+
+std::vector<std::string> POSService::getKitchenStationNames() const {
+    return kitchenInterface_ ? kitchenInterface_->getStationNames() : std::vector<std::string>();
+}
+
+KitchenInterface::TicketView POSService::getKitchenStationTicketView(const std::string& station) const {
+    if (!kitchenInterface_) {
+        LOG_COMPONENT_ERROR(logger_, "POSService", "getKitchenStationTicketView", "Kitchen interface not available");
+        return {};
+    }
+    return kitchenInterface_->getStationTickets(station);
+}
+
+bool POSService::updateKitchenStationStatus(const std::string& station, int orderId,
+                                            KitchenInterface::KitchenStatus status) {
+    if (!kitchenInterface_) {
+        LOG_COMPONENT_ERROR(logger_, "POSService", "updateKitchenStationStatus", "Kitchen interface not available");
+        return false;
+    }
+    return kitchenInterface_->updateStationStatus(station, orderId, status);
+}
+
 // =====================================================================
 // Menu Management Methods (ENHANCED with event publishing)
 // =====================================================================
 
 std::vector<std::shared_ptr<MenuItem>> POSService::getMenuItems() const {
-    logger_.debug("[POSService] Retrieving all menu items");
+    LOG_DEBUG(logger_, "[POSService] Retrieving all menu items");
     LOG_KEY_VALUE(logger_, debug, "Total menu items available", menuItems_.size());
     return menuItems_;
 }
 
 std::vector<std::shared_ptr<MenuItem>> POSService::getMenuItemsByCategory(MenuItem::Category category) const {
-    logger_.debug("[POSService] Retrieving menu items by category");
+    LOG_DEBUG(logger_, "[POSService] Retrieving menu items by category");
     
     std::vector<std::shared_ptr<MenuItem>> categoryItems;
     
@@ -631,7 +731,7 @@ std::vector<std::shared_ptr<MenuItem>> POSService::getMenuItemsByCategory(MenuIt
 
 // ADDED: Method to find menu item by ID (useful for MenuDisplay)
 std::shared_ptr<MenuItem> POSService::getMenuItemById(int itemId) const {
-    logger_.debug("[POSService] Looking up menu item ID: " + std::to_string(itemId));
+    LOG_DEBUG(logger_, "[POSService] Looking up menu item ID: " + std::to_string(itemId));
     
     auto it = std::find_if(menuItems_.begin(), menuItems_.end(),
         [itemId](const std::shared_ptr<MenuItem>& item) {
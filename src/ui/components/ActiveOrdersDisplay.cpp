@@ -188,7 +188,7 @@ void ActiveOrdersDisplay::loadOrdersFromAPI() {
     if (enhancedService && enhancedService->isConnected()) {
         std::cout << "[ActiveOrdersDisplay] Loading orders from API..." << std::endl;
         
-        enhancedService->getActiveOrdersAsync([this](std::vector<std::shared_ptr<Order>> orders, bool success) {
+        enhancedService->getActiveOrderSummariesAsync([this](std::vector<OrderSummary> orders, bool success) {
             if (success) {
                 std::cout << "[ActiveOrdersDisplay] Loaded " << orders.size() << " orders from API" << std::endl;
                 displayAPIOrders(orders);
@@ -203,7 +203,7 @@ void ActiveOrdersDisplay::loadOrdersFromAPI() {
     }
 }
 
-void ActiveOrdersDisplay::displayAPIOrders(const std::vector<std::shared_ptr<Order>>& orders) {
+void ActiveOrdersDisplay::displayAPIOrders(const std::vector<OrderSummary>& orders) {
     clearLoadingState();
     
     while (ordersTable_->rowCount() > 1) {
@@ -248,21 +248,19 @@ void ActiveOrdersDisplay::displayLocalOrders() {
         if (maxOrdersToDisplay_ > 0 && i >= static_cast<size_t>(maxOrdersToDisplay_)) {
             break;
         }
-        addOrderRow(orders[i], static_cast<int>(i + 1));
+        addOrderRow(OrderSummary(*orders[i]), static_cast<int>(i + 1));
     }
     
     updateOrderCountDirect(static_cast<int>(orders.size()));
     std::cout << "[ActiveOrdersDisplay] Displayed " << orders.size() << " orders from local data" << std::endl;
 }
 
-std::vector<std::shared_ptr<Order>> ActiveOrdersDisplay::filterOrders(const std::vector<std::shared_ptr<Order>>& orders) const {
-    std::vector<std::shared_ptr<Order>> filteredOrders;
+std::vector<OrderSummary> ActiveOrdersDisplay::filterOrders(const std::vector<OrderSummary>& orders) const {
+    std::vector<OrderSummary> filteredOrders;
     
     for (const auto& order : orders) {
-        if (!order) continue;
-        
         if (!showCompletedOrders_) {
-            if (order->getStatus() == Order::SERVED || order->getStatus() == Order::CANCELLED) {
+            if (order.status == Order::SERVED || order.status == Order::CANCELLED) {
                 continue;
             }
         }
@@ -271,8 +269,8 @@ std::vector<std::shared_ptr<Order>> ActiveOrdersDisplay::filterOrders(const std:
     }
     
     std::sort(filteredOrders.begin(), filteredOrders.end(),
-        [](const std::shared_ptr<Order>& a, const std::shared_ptr<Order>& b) {
-            return a->getTimestamp() > b->getTimestamp();
+        [](const OrderSummary& a, const OrderSummary& b) {
+            return a.createdAt > b.createdAt;
         });
     
     return filteredOrders;
@@ -282,16 +280,16 @@ std::vector<std::shared_ptr<Order>> ActiveOrdersDisplay::filterOrders(const std:
 // DISPLAY METHODS
 // ============================================================================
 
-void ActiveOrdersDisplay::addOrderRow(std::shared_ptr<Order> order, int row) {
-    if (!order || !ordersTable_) {
+void ActiveOrdersDisplay::addOrderRow(const OrderSummary& order, int row) {
+    if (!ordersTable_) {
         return;
     }
     
     try {
         // Order ID
         std::string orderIdStr;
-        if (order->getOrderId() > 0) {
-            orderIdStr = formatOrderId(order->getOrderId());
+        if (order.orderId > 0) {
+            orderIdStr = formatOrderId(order.orderId);
         } else {
             orderIdStr = "#" + std::to_string(row);
         }
@@ -301,9 +299,9 @@ void ActiveOrdersDisplay::addOrderRow(std::shared_ptr<Order> order, int row) {
         ordersTable_->elementAt(row, 0)->addWidget(std::move(orderIdText));
         
         // Table/Location
-        std::string tableDisplay = order->getTableIdentifier();
+        std::string tableDisplay = order.tableIdentifier;
         if (tableDisplay.empty()) {
-            tableDisplay = "Table " + std::to_string(order->getTableNumber());
+            tableDisplay = "Table " + std::to_string(order.tableNumber);
         }
         
         auto tableText = std::make_unique<Wt::WText>(tableDisplay);
@@ -311,28 +309,22 @@ void ActiveOrdersDisplay::addOrderRow(std::shared_ptr<Order> order, int row) {
         ordersTable_->elementAt(row, 1)->addWidget(std::move(tableText));
         
         // Status badge
-        auto statusText = std::make_unique<Wt::WText>(formatOrderStatus(order->getStatus()));
-        UIStyleHelper::styleBadge(statusText.get(), getStatusBadgeVariant(order->getStatus()));
+        auto statusText = std::make_unique<Wt::WText>(formatOrderStatus(order.status));
+        UIStyleHelper::styleBadge(statusText.get(), getStatusBadgeVariant(order.status));
         ordersTable_->elementAt(row, 2)->addWidget(std::move(statusText));
         
         // Items count
-        size_t itemCount = order->getItems().size();
-        auto itemsText = std::make_unique<Wt::WText>(std::to_string(itemCount) + " items");
+        auto itemsText = std::make_unique<Wt::WText>(std::to_string(order.itemCount) + " items");
         itemsText->addStyleClass("text-muted small");
         ordersTable_->elementAt(row, 3)->addWidget(std::move(itemsText));
         
         // Total
-        double total = order->getTotal();
-        if (total <= 0.0 && !order->getItems().empty()) {
-            total = order->getSubtotal() + order->getTax();
-        }
-        
-        auto totalText = std::make_unique<Wt::WText>(formatCurrency(total));
+        auto totalText = std::make_unique<Wt::WText>(formatCurrency(order.total));
         totalText->addStyleClass("fw-bold text-success");
         ordersTable_->elementAt(row, 4)->addWidget(std::move(totalText));
         
         // Time
-        auto timeText = std::make_unique<Wt::WText>(formatOrderTime(order));
+        auto timeText = std::make_unique<Wt::WText>(formatOrderTime(order.createdAt));
         timeText->addStyleClass("text-muted small");
         ordersTable_->elementAt(row, 5)->addWidget(std::move(timeText));
         
@@ -343,25 +335,26 @@ void ActiveOrdersDisplay::addOrderRow(std::shared_ptr<Order> order, int row) {
         // View button
         auto viewButton = actionsContainer->addNew<Wt::WPushButton>("👁️ View");
         UIStyleHelper::styleButton(viewButton, "outline-primary", "sm");
-        viewButton->clicked().connect([this, order]() {
-            onViewOrderClicked(order->getOrderId());
+        const int orderId = order.orderId;
+        viewButton->clicked().connect([this, orderId]() {
+            onViewOrderClicked(orderId);
         });
         
         // Complete button (only for appropriate statuses)
-        if (order->getStatus() == Order::READY) {
+        if (order.status == Order::READY) {
             auto completeButton = actionsContainer->addNew<Wt::WPushButton>("✅ Complete");
             UIStyleHelper::styleButton(completeButton, "success", "sm");
-            completeButton->clicked().connect([this, order]() {
-                onCompleteOrderClicked(order->getOrderId());
+            completeButton->clicked().connect([this, orderId]() {
+                onCompleteOrderClicked(orderId);
             });
         }
         
         // Cancel button (only for pending orders)
-        if (order->getStatus() == Order::PENDING || order->getStatus() == Order::SENT_TO_KITCHEN) {
+        if (order.status == Order::PENDING || order.status == Order::SENT_TO_KITCHEN) {
             auto cancelButton = actionsContainer->addNew<Wt::WPushButton>("❌ Cancel");
             UIStyleHelper::styleButton(cancelButton, "outline-danger", "sm");
-            cancelButton->clicked().connect([this, order]() {
-                onCancelOrderClicked(order->getOrderId());
+            cancelButton->clicked().connect([this, orderId]() {
+                onCancelOrderClicked(orderId);
             });
         }
         
@@ -648,9 +641,8 @@ std::string ActiveOrdersDisplay::formatOrderStatus(Order::Status status) const {
     return Order::statusToString(status);
 }
 
-std::string ActiveOrdersDisplay::formatOrderTime(const std::shared_ptr<Order>& order) const {
+std::string ActiveOrdersDisplay::formatOrderTime(std::chrono::system_clock::time_point orderTime) const {
     auto now = std::chrono::system_clock::now();
-    auto orderTime = order->getTimestamp();
     auto duration = std::chrono::duration_cast<std::chrono::minutes>(now - orderTime);
     
     int minutes = static_cast<int>(duration.count());
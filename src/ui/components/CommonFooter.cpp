@@ -108,9 +108,8 @@ void CommonFooter::updateStatus() {
         }
         
         // Update kitchen queue count
-        auto kitchenTickets = posService_->getKitchenTickets();
         if (kitchenQueueText_) {
-            kitchenQueueText_->setText("👨‍🍳 Kitchen Queue: " + std::to_string(kitchenTickets.size()));
+            kitchenQueueText_->setText("👨‍🍳 Kitchen Queue: " + std::to_string(posService_->getKitchenQueueLength()));
         }
         
         // Update system status based on current load
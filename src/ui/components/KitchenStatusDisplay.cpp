@@ -223,8 +223,7 @@ void KitchenStatusDisplay::updateQueueStatus() {
     
     try {
         // Get current queue information
-        auto tickets = posService_->getKitchenTickets();
-        int queueSize = static_cast<int>(tickets.size());
+        int queueSize = static_cast<int>(posService_->getKitchenQueueLength());
         int waitTime = posService_->getEstimatedWaitTime();
         
         // Update queue size
@@ -301,11 +300,11 @@ int KitchenStatusDisplay::calculateKitchenLoad() const {
     }
     
     try {
-        auto tickets = posService_->getKitchenTickets();
-        int queueSize = static_cast<int>(tickets.size());
+        int queueSize = static_cast<int>(posService_->getKitchenQueueLength());
+        int busyThreshold = static_cast<int>(posService_->getKitchenBusyThreshold());
         
         // Calculate load as percentage of busy threshold
-        int loadPercentage = std::min(100, (queueSize * 100) / std::max(1, BUSY_THRESHOLD));
+        int loadPercentage = std::min(100, (queueSize * 100) / std::max(1, busyThreshold));
         return loadPercentage;
         
     } catch (const std::exception& e) {
@@ -331,8 +330,7 @@ std::string KitchenStatusDisplay::formatKitchenMetrics() const {
     }
     
     try {
-        auto tickets = posService_->getKitchenTickets();
-        int totalTickets = static_cast<int>(tickets.size());
+        int totalTickets = static_cast<int>(posService_->getKitchenQueueLength());
         int avgPrepTime = getAveragePreparationTime();
         
         std::string metrics = "Active Tickets: " + std::to_string(totalTickets) + " | ";
@@ -371,8 +369,8 @@ bool KitchenStatusDisplay::isKitchenBusy() const {
     }
     
     try {
-        auto tickets = posService_->getKitchenTickets();
-        return tickets.size() >= BUSY_THRESHOLD;
+        // Same rule as KitchenInterface::isKitchenBusy()
+        return posService_->getKitchenQueueLength() > posService_->getKitchenBusyThreshold();
     } catch (const std::exception& e) {
         return false;
     }
@@ -384,8 +382,7 @@ bool KitchenStatusDisplay::isKitchenOverloaded() const {
     }
     
     try {
-        auto tickets = posService_->getKitchenTickets();
-        return tickets.size() >= OVERLOADED_THRESHOLD;
+        return posService_->getKitchenQueueLength() > OVERLOAD_FACTOR * posService_->getKitchenBusyThreshold();
     } catch (const std::exception& e) {
         return false;
     }
@@ -397,7 +394,7 @@ int KitchenStatusDisplay::getAveragePreparationTime() const {
     }
     
     try {
-        auto tickets = posService_->getKitchenTickets();
+        auto tickets = posService_->getKitchenTicketView();
         if (tickets.empty()) {
             return 0;
         }
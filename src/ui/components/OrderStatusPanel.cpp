@@ -438,8 +438,7 @@ int OrderStatusPanel::getKitchenQueueSize() const {
     }
     
     try {
-        auto tickets = posService_->getKitchenTickets();
-        return static_cast<int>(tickets.size());
+        return static_cast<int>(posService_->getKitchenQueueLength());
     } catch (const std::exception& e) {
         std::cerr << "[OrderStatusPanel] Error getting kitchen queue size: " << e.what() << std::endl;
         return 0;
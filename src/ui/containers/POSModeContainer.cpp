@@ -5,6 +5,7 @@
 // ============================================================================
 
 #include "../../../include/ui/containers/POSModeContainer.hpp"
+#include "../../../include/services/EnhancedPOSService.hpp"
 
 #include <Wt/WVBoxLayout.h>
 #include <Wt/WHBoxLayout.h>
@@ -310,6 +311,15 @@ void POSModeContainer::setupEventListeners() {
             })
     );
     
+    // Listen for queued order writes the API rejected after they were accepted here
+    eventSubscriptions_.push_back(
+        eventManager_->subscribe(POSEvents::ORDER_SYNC_CONFLICT,
+            [this](const std::any& data) { 
+                if (isDestroying_) return;
+                handleOrderSyncConflict(data);
+            })
+    );
+    
     std::cout << "[POSModeContainer] Event listeners setup complete" << std::endl;
 }
 
@@ -569,6 +579,52 @@ void POSModeContainer::handleOrderCreated(const std::any& eventData) {
     }
 }
 
+void POSModeContainer::handleOrderSyncConflict(const std::any& eventData) {
+    const auto* conflict = std::any_cast<Wt::Json::Object>(&eventData);
+    if (!conflict) return;
+    
+    const Wt::Json::Value& orderIdValue = conflict->get("orderId");
+    const Wt::Json::Value& messageValue = conflict->get("message");
+    int orderId = orderIdValue.type() == Wt::Json::Type::Number ? static_cast<int>(orderIdValue) : -1;
+    std::string message = messageValue.type() == Wt::Json::Type::String
+        ? static_cast<std::string>(messageValue)
+        : std::string("Order change rejected by the server");
+    
+    std::cout << "[POSModeContainer] Order #" << orderId << " sync conflict: " << message << std::endl;
+    
+    // Staff were told the change was saved: say it was not, and for long enough to read
+    auto notification = POSEvents::createNotificationData(
+        "Order #" + std::to_string(orderId) + " was not saved. " + message +
+        ". Showing the server's copy; please re-enter the change.", "error", 10000);
+    eventManager_->publish(POSEvents::NOTIFICATION_REQUESTED, notification);
+    
+    if (activeOrdersDisplay_ && currentUIMode_ == UI_MODE_ORDER_ENTRY) {
+        activeOrdersDisplay_->refresh();
+    }
+    
+    // Replace the local copy of the order being edited with the server's
+    auto currentOrder = posService_->getCurrentOrder();
+    auto enhancedService = std::dynamic_pointer_cast<EnhancedPOSService>(posService_);
+    if (!enhancedService || !currentOrder || currentOrder->getOrderId() != orderId) {
+        return;
+    }
+    
+    enhancedService->getOrderByIdAsync(orderId, [this, orderId](std::shared_ptr<Order> order, bool success) {
+        if (isDestroying_) return;
+        
+        auto stillCurrent = posService_->getCurrentOrder();
+        if (!stillCurrent || stillCurrent->getOrderId() != orderId) return;
+        
+        if (success && order) {
+            posService_->setCurrentOrder(order);
+        } else {
+            // Rejected before the API ever stored it: nothing left to edit
+            std::cout << "[POSModeContainer] Order #" << orderId << " not on the server, closing it" << std::endl;
+            posService_->setCurrentOrder(nullptr);
+        }
+    });
+}
+
 // ============================================================================
 // SEND TO KITCHEN FUNCTIONALITY
 // ============================================================================
@@ -0,0 +1,325 @@
+#include "../../include/utils/AsyncLogSink.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <iterator>
+
+#include <signal.h>
+#include <unistd.h>
+
+// ============================================================================
+// AsyncLogSink Implementation
+// ============================================================================
+
+namespace {
+    // Upper bound on bytes handed to the writer in one call
+    constexpr std::size_t MAX_BATCH_BYTES = 64 * 1024;
+
+    // How long the writer sleeps when idle before re-checking the ring
+    constexpr auto IDLE_WAIT = std::chrono::milliseconds(100);
+
+    // Spins the crash path will wait for the writer thread to release the ring
+    constexpr int EMERGENCY_SPIN_LIMIT = 1000000;
+
+    constexpr int CRASH_SIGNALS[] = {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL};
+
+    // Actions replaced by installCrashHandlers(), restored before re-raising
+    struct sigaction previousCrashActions[std::size(CRASH_SIGNALS)];
+    std::atomic<bool> crashHandlersInstalled{false};
+
+    // Async-signal-safe: write(2) only
+    void writeAll(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t n = ::write(fd, data, size);
+            if (n <= 0) {
+                return;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+
+    std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+std::atomic<AsyncLogSink*> AsyncLogSink::crashSink_{nullptr};
+std::atomic<int> AsyncLogSink::crashFd_{-1};
+
+AsyncLogSink::AsyncLogSink(std::size_t capacity, OverflowPolicy policy, BatchWriter writer,
+                           DropReporter dropReporter)
+    : capacity_(roundUpToPowerOfTwo(capacity))
+    , mask_(capacity_ - 1)
+    , slots_(new Slot[capacity_])
+    , enqueuePos_(0)
+    , dequeuePos_(0)
+    , policy_(policy)
+    , writer_(std::move(writer))
+    , dropReporter_(std::move(dropReporter))
+    , writerSleeping_(false)
+    , running_(true)
+    , writtenPos_(0)
+    , droppedCount_(0)
+{
+    for (std::size_t i = 0; i < capacity_; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    batch_.reserve(MAX_BATCH_BYTES);
+
+    writerThread_ = std::thread(&AsyncLogSink::writerLoop, this);
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    stop();
+}
+
+bool AsyncLogSink::enqueue(std::string&& record) {
+    return enqueue(std::move(record), policy_);
+}
+
+bool AsyncLogSink::enqueue(std::string&& record, OverflowPolicy policy) {
+    while (!tryEnqueue(record)) {
+        if (policy == OverflowPolicy::DROP || !running_.load(std::memory_order_acquire)) {
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // BLOCK: make sure the writer is awake, then back off briefly
+        wakeCondition_.notify_one();
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    if (writerSleeping_.load(std::memory_order_relaxed)) {
+        wakeCondition_.notify_one();
+    }
+    return true;
+}
+
+bool AsyncLogSink::tryEnqueue(std::string& record) {
+    std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // Ring full
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = std::move(record);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncLogSink::tryDequeue(std::string& out) {
+    Slot& slot = slots_[dequeuePos_ & mask_];
+    std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+    if (seq != dequeuePos_ + 1) {
+        return false; // Empty, or producer has not published yet
+    }
+
+    out.append(slot.record);
+    slot.record.clear();
+    slot.sequence.store(dequeuePos_ + capacity_, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+}
+
+std::size_t AsyncLogSink::drainBatch() {
+    std::size_t drained = 0;
+    batch_.clear();
+
+    while (batch_.size() < MAX_BATCH_BYTES && tryDequeue(batch_)) {
+        ++drained;
+    }
+
+    if (!batch_.empty() && writer_) {
+        writer_(batch_.data(), batch_.size());
+    }
+
+    return drained;
+}
+
+void AsyncLogSink::writerLoop() {
+    std::uint64_t reportedDrops = 0;
+
+    while (running_.load(std::memory_order_acquire)) {
+        std::size_t drained = 0;
+        if (acquireConsumer(false)) {
+            drained = drainBatch();
+
+            std::uint64_t dropped = droppedCount_.load(std::memory_order_relaxed);
+            if (dropped != reportedDrops && writer_) {
+                std::string note = dropReporter_
+                    ? dropReporter_(dropped - reportedDrops)
+                    : "*** AsyncLogSink: " + std::to_string(dropped - reportedDrops)
+                      + " log records dropped (ring full) ***\n";
+                writer_(note.data(), note.size());
+                reportedDrops = dropped;
+            }
+
+            writtenPos_.store(dequeuePos_, std::memory_order_release);
+            releaseConsumer();
+        }
+
+        if (drained > 0) {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            flushedCondition_.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        flushedCondition_.notify_all();
+        writerSleeping_.store(true, std::memory_order_relaxed);
+        wakeCondition_.wait_for(lock, IDLE_WAIT);
+        writerSleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    // Final drain after stop() was requested
+    if (acquireConsumer(false)) {
+        while (drainBatch() > 0) {}
+        writtenPos_.store(dequeuePos_, std::memory_order_release);
+        releaseConsumer();
+    }
+
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    flushedCondition_.notify_all();
+}
+
+void AsyncLogSink::flush() {
+    const std::size_t target = enqueuePos_.load(std::memory_order_acquire);
+
+    if (!running_.load(std::memory_order_acquire)) {
+        if (acquireConsumer(false)) {
+            while (drainBatch() > 0) {}
+            writtenPos_.store(dequeuePos_, std::memory_order_release);
+            releaseConsumer();
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (writtenPos_.load(std::memory_order_acquire) < target &&
+           running_.load(std::memory_order_acquire)) {
+        wakeCondition_.notify_one();
+        flushedCondition_.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+void AsyncLogSink::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    AsyncLogSink* self = this;
+    crashSink_.compare_exchange_strong(self, nullptr);
+
+    wakeCondition_.notify_all();
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+}
+
+void AsyncLogSink::emergencyDrain(int fd) {
+    if (!acquireConsumer(true)) {
+        return;
+    }
+
+    // Unlike tryDequeue(), leaves the records in place: nothing is copied
+    for (;;) {
+        Slot& slot = slots_[dequeuePos_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+            break;
+        }
+        writeAll(fd, slot.record.data(), slot.record.size());
+        slot.sequence.store(dequeuePos_ + capacity_, std::memory_order_release);
+        ++dequeuePos_;
+    }
+    writtenPos_.store(dequeuePos_, std::memory_order_release);
+    releaseConsumer();
+}
+
+bool AsyncLogSink::acquireConsumer(bool bounded) {
+    int spins = 0;
+    while (consumerBusy_.test_and_set(std::memory_order_acquire)) {
+        if (bounded) {
+            // Signal context: plain spinning, no scheduler calls
+            if (++spins > EMERGENCY_SPIN_LIMIT) {
+                return false;
+            }
+            continue;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void AsyncLogSink::releaseConsumer() {
+    consumerBusy_.clear(std::memory_order_release);
+}
+
+void AsyncLogSink::installCrashHandlers(int fd) {
+    crashFd_.store(fd, std::memory_order_release);
+    crashSink_.store(this, std::memory_order_release);
+
+    // Later sinks only retarget the handlers; the saved actions stay the originals
+    if (crashHandlersInstalled.exchange(true)) {
+        return;
+    }
+
+    struct sigaction action {};
+    action.sa_handler = &AsyncLogSink::crashSignalHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = 0;
+
+    for (std::size_t i = 0; i < std::size(CRASH_SIGNALS); ++i) {
+        sigaction(CRASH_SIGNALS[i], &action, &previousCrashActions[i]);
+    }
+}
+
+void AsyncLogSink::crashSignalHandler(int signal) {
+    AsyncLogSink* sink = crashSink_.exchange(nullptr);
+    const int fd = crashFd_.load(std::memory_order_acquire);
+    if (sink != nullptr && fd >= 0) {
+        sink->emergencyDrain(fd);
+    }
+
+    // Chain: the signal stays blocked until this handler returns, then the
+    // previous action (often SIG_DFL) receives the re-raised signal
+    for (std::size_t i = 0; i < std::size(CRASH_SIGNALS); ++i) {
+        if (CRASH_SIGNALS[i] == signal) {
+            sigaction(signal, &previousCrashActions[i], nullptr);
+            break;
+        }
+    }
+    raise(signal);
+}
+
+std::uint64_t AsyncLogSink::getDroppedCount() const {
+    return droppedCount_.load(std::memory_order_relaxed);
+}
+
+AsyncLogSink::OverflowPolicy AsyncLogSink::stringToPolicy(const std::string& policyStr) {
+    std::string lower = policyStr;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    if (lower == "block") return OverflowPolicy::BLOCK;
+    return OverflowPolicy::DROP;
+}
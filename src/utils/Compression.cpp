@@ -0,0 +1,106 @@
+//============================================================================
+// src/utils/Compression.cpp - gzip and deflate via zlib
+//============================================================================
+
+#include "../../include/utils/Compression.hpp"
+
+#ifdef POS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+#ifdef POS_HAVE_ZLIB
+    constexpr std::size_t CHUNK_SIZE = 16 * 1024;
+
+    // windowBits for inflateInit2(): gzip or zlib header detected, or raw deflate
+    constexpr int AUTO_HEADER = 15 + 32;
+    constexpr int RAW_DEFLATE = -15;
+
+    bool inflateWith(int windowBits, const std::string& input, std::string& output, std::size_t maxBytes) {
+        z_stream stream{};
+        if (inflateInit2(&stream, windowBits) != Z_OK) {
+            return false;
+        }
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+
+        output.clear();
+        char chunk[CHUNK_SIZE];
+        int status = Z_OK;
+        while (status == Z_OK) {
+            stream.next_out = reinterpret_cast<Bytef*>(chunk);
+            stream.avail_out = sizeof(chunk);
+            status = inflate(&stream, Z_NO_FLUSH);
+            if (status != Z_OK && status != Z_STREAM_END) {
+                break;
+            }
+            output.append(chunk, sizeof(chunk) - stream.avail_out);
+            if (output.size() > maxBytes) {
+                status = Z_MEM_ERROR;
+                break;
+            }
+            if (status == Z_OK && stream.avail_in == 0 && stream.avail_out != 0) {
+                status = Z_DATA_ERROR;  // Truncated stream
+            }
+        }
+        inflateEnd(&stream);
+        return status == Z_STREAM_END;
+    }
+#endif
+}
+
+namespace Compression {
+
+    bool isAvailable() {
+#ifdef POS_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool gzip(const std::string& input, std::string& output) {
+#ifdef POS_HAVE_ZLIB
+        z_stream stream{};
+        // Level 6 is zlib's default; 15 + 16 asks for a gzip header
+        if (deflateInit2(&stream, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+
+        output.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+        stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+        stream.avail_out = static_cast<uInt>(output.size());
+
+        const int status = deflate(&stream, Z_FINISH);
+        output.resize(stream.total_out);
+        deflateEnd(&stream);
+        return status == Z_STREAM_END;
+#else
+        (void)input;
+        (void)output;
+        return false;
+#endif
+    }
+
+    bool decode(const std::string& encoding, const std::string& input, std::string& output,
+                std::size_t maxBytes) {
+#ifdef POS_HAVE_ZLIB
+        if (encoding == "gzip" || encoding == "x-gzip") {
+            return inflateWith(AUTO_HEADER, input, output, maxBytes);
+        }
+        if (encoding == "deflate") {
+            return inflateWith(AUTO_HEADER, input, output, maxBytes) ||
+                   inflateWith(RAW_DEFLATE, input, output, maxBytes);
+        }
+        return false;
+#else
+        (void)encoding;
+        (void)input;
+        (void)output;
+        (void)maxBytes;
+        return false;
+#endif
+    }
+}
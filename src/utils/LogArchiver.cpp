@@ -0,0 +1,177 @@
+#include "../../include/utils/LogArchiver.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef POS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+// ============================================================================
+// LogArchiver Implementation
+// ============================================================================
+
+namespace {
+    constexpr std::size_t COMPRESS_CHUNK_SIZE = 256 * 1024;
+
+    // Lowest CPU priority for the calling thread only (Linux: per-thread nice)
+    void lowerCurrentThreadPriority() {
+#ifdef SYS_gettid
+        pid_t tid = static_cast<pid_t>(::syscall(SYS_gettid));
+        ::setpriority(PRIO_PROCESS, static_cast<id_t>(tid), 19);
+#endif
+    }
+}
+
+LogArchiver::LogArchiver(const std::string& directory, const std::string& baseFileName,
+                         bool compress, std::size_t maxRotatedFiles)
+    : directory_(directory)
+    , baseFileName_(baseFileName)
+    , compress_(compress && isCompressionAvailable())
+    , maxRotatedFiles_(maxRotatedFiles)
+    , stopping_(false)
+{
+    worker_ = std::thread(&LogArchiver::workerLoop, this);
+}
+
+LogArchiver::~LogArchiver() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+    }
+    queueCondition_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void LogArchiver::archive(const std::string& path, const std::string& activePath) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        pending_.emplace_back(path, activePath);
+    }
+    queueCondition_.notify_one();
+}
+
+bool LogArchiver::isCompressionAvailable() {
+#ifdef POS_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LogArchiver::workerLoop() {
+    lowerCurrentThreadPriority();
+
+    for (;;) {
+        std::string path;
+        std::string activePath;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCondition_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return; // Stopping with nothing left to do
+            }
+            path = std::move(pending_.front().first);
+            activePath = std::move(pending_.front().second);
+            pending_.pop_front();
+        }
+
+        // A burst of rotations may have pruned this file already
+        if (compress_ && std::filesystem::exists(path) && !compressFile(path)) {
+            std::cerr << "LogArchiver: failed to compress " << path << std::endl;
+        }
+        applyRetention(activePath);
+    }
+}
+
+bool LogArchiver::compressFile(const std::string& path) {
+#ifdef POS_HAVE_ZLIB
+    const std::string archivePath = path + ".gz";
+    const std::string tempPath = archivePath + ".tmp";
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    gzFile out = gzopen(tempPath.c_str(), "wb6");
+    if (out == nullptr) {
+        return false;
+    }
+
+    std::vector<char> buffer(COMPRESS_CHUNK_SIZE);
+    bool ok = true;
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::streamsize count = in.gcount();
+        if (count > 0 && gzwrite(out, buffer.data(), static_cast<unsigned>(count)) != count) {
+            ok = false;
+            break;
+        }
+    }
+
+    if (gzclose(out) != Z_OK) {
+        ok = false;
+    }
+
+    std::error_code ec;
+    if (!ok) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    // Publish the archive atomically, then drop the uncompressed original
+    std::filesystem::rename(tempPath, archivePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    std::filesystem::remove(path, ec);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void LogArchiver::applyRetention(const std::string& activePath) {
+    if (maxRotatedFiles_ == 0) {
+        return;
+    }
+
+    // Rotated files are everything the logger wrote except the active file;
+    // names embed a sortable timestamp, so lexical order is age order.
+    const std::string prefix = baseFileName_ + "_";
+    const std::string activeName = std::filesystem::path(activePath).filename().string();
+    std::vector<std::filesystem::path> files;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+        const std::string name = entry.path().filename().string();
+        // Names sorting after the active one are newer files (this request is
+        // stale); the next request counts them against the real active file
+        if (entry.is_regular_file(ec) && name.rfind(prefix, 0) == 0 &&
+            name < activeName && name.find(".tmp") == std::string::npos) {
+            files.push_back(entry.path());
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+    if (files.size() <= maxRotatedFiles_) {
+        return;
+    }
+
+    std::size_t excess = files.size() - maxRotatedFiles_;
+    for (std::size_t i = 0; i < excess; ++i) {
+        std::filesystem::remove(files[i], ec);
+    }
+}
@@ -1,13 +1,22 @@
 #include "../../include/utils/Logging.hpp"
+#include "../../include/utils/AsyncLogSink.hpp"
+#include "../../include/utils/LogArchiver.hpp"
+#include "../../include/utils/PropertyTable.hpp"
+#include "../../include/utils/StartupProfile.hpp"
 
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <filesystem>
 #include <cstdlib>
 #include <chrono>
 #include <iomanip>
+#include <ctime>
+#include <cstring>
 #include <algorithm>
-#include <regex>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 // ============================================================================
 // Logger Implementation
@@ -18,26 +27,67 @@ Logger::Logger()
     , logDirectory_("logs")
     , baseFileName_("app")
     , maxFileSize_(1073741824) // 1GB in bytes
+    , logFd_(-1)
+    , currentFileSize_(0)
     , enableConsole_(true)
+    , asyncEnabled_(true)
+    , asyncQueueSize_(8192)
+    , asyncOverflowPolicy_("drop")
+    , compressRotated_(true)
+    , maxRotatedFiles_(10)
+    , binaryMode_(false)
+    , messageFormatIds_{}
 {
+    // Initialize from configuration sources
+    initializeFromConfiguration();
+    
     // Create logs directory if it doesn't exist
     std::filesystem::create_directories(logDirectory_);
     
-    // Initialize from configuration sources
-    initializeFromConfiguration();
+    archiver_ = std::make_unique<LogArchiver>(logDirectory_, baseFileName_,
+                                              compressRotated_, maxRotatedFiles_);
     
     // Open initial log file
     currentFileName_ = getCurrentLogFileName();
-    logFile_.open(currentFileName_, std::ios::app);
-    
-    if (!logFile_.is_open()) {
+    rotationStem_ = currentFileName_.substr(0, currentFileName_.rfind('.'));
+    if (!openLogFile()) {
         std::cerr << "Failed to open log file: " << currentFileName_ << std::endl;
     }
+    
+    // Start the background writer; from here on log() never touches the file
+    if (asyncEnabled_) {
+        asyncSink_ = std::make_unique<AsyncLogSink>(
+            asyncQueueSize_,
+            AsyncLogSink::stringToPolicy(asyncOverflowPolicy_),
+            [this](const char* data, std::size_t size) { writeToFile(data, size); },
+            [this](std::uint64_t dropped) {
+                std::string message = "AsyncLogSink: " + std::to_string(dropped)
+                                    + " log records dropped (ring full)";
+                if (!binaryMode_) {
+                    return formatEntry(LogLevel::WARN, message);
+                }
+                std::string record;
+                BinaryLogFormat::appendEvent(record, messageFormatIds_[static_cast<int>(LogLevel::WARN)], message);
+                return record;
+            });
+        asyncSink_->installCrashHandlers(logFd_);
+    }
+    
+    // Plain log() calls are carried as a "{}" descriptor per level in binary mode
+    for (LogLevel level : {LogLevel::ERROR, LogLevel::WARN, LogLevel::INFO, LogLevel::DEBUG}) {
+        messageFormatIds_[static_cast<int>(level)] = registerFormat(level, "{}");
+    }
 }
 
 Logger::~Logger() {
-    if (logFile_.is_open()) {
-        logFile_.close();
+    // Stopping the sink drains every queued record before the file closes;
+    // the archiver goes last because the final drain may still rotate
+    asyncSink_.reset();
+    archiver_.reset();
+    
+    if (logFd_ >= 0) {
+        ::close(logFd_);
+        logFd_ = -1;
     }
 }
 
@@ -47,8 +97,8 @@ Logger& Logger::getInstance() {
 }
 
 void Logger::setLogLevel(LogLevel level) {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    currentLevel_ = level;
+    currentLevel_.store(level, std::memory_order_relaxed);
+    refreshComponentLevels();
 }
 
 void Logger::setLogLevel(const std::string& levelStr) {
@@ -56,16 +106,16 @@ void Logger::setLogLevel(const std::string& levelStr) {
 }
 
 LogLevel Logger::getLogLevel() const {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    return currentLevel_;
+    return currentLevel_.load(std::memory_order_relaxed);
 }
 
 std::string Logger::getCurrentLevelString() const {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    return levelToString(currentLevel_);
+    return levelToString(getLogLevel());
 }
 
 void Logger::initializeFromConfiguration() {
+    StartupProfile::Phase phase("logger.configure");
+    
     // Load configuration from file first, then environment variables
     loadConfigurationFromFile();
     loadConfigurationFromEnvironment();
@@ -74,6 +124,14 @@ void Logger::initializeFromConfiguration() {
     std::string levelStr = readConfigProperty("logging.level", "INFO");
     setLogLevel(levelStr);
     
+    // Component overrides: logging.level.<component> (e.g. logging.level.api)
+    const std::string componentPrefix = "logging.level.";
+    for (const auto& [name, value] : configProperties_) {
+        if (name.size() > componentPrefix.size() && name.compare(0, componentPrefix.size(), componentPrefix) == 0) {
+            setComponentLevel(name.substr(componentPrefix.size()), value);
+        }
+    }
+    
     logDirectory_ = readConfigProperty("logging.directory", "logs");
     baseFileName_ = readConfigProperty("logging.base-filename", "app");
     
@@ -83,12 +141,39 @@ void Logger::initializeFromConfiguration() {
     std::string consoleStr = readConfigProperty("logging.enable-console", "true");
     enableConsole_ = (consoleStr == "true" || consoleStr == "1");
     
+    std::string asyncStr = readConfigProperty("logging.async", "true");
+    asyncEnabled_ = (asyncStr == "true" || asyncStr == "1");
+    asyncQueueSize_ = std::stoull(readConfigProperty("logging.async-queue-size", "8192"));
+    asyncOverflowPolicy_ = readConfigProperty("logging.async-overflow", "drop");
+    
+    std::string compressStr = readConfigProperty("logging.compress-rotated", "true");
+    compressRotated_ = (compressStr == "true" || compressStr == "1");
+    maxRotatedFiles_ = std::stoull(readConfigProperty("logging.max-rotated-files", "10"));
+    
+    std::string binaryStr = readConfigProperty("logging.binary", "false");
+    binaryMode_ = (binaryStr == "true" || binaryStr == "1");
+    if (binaryMode_) {
+        // Binary records are not readable on a terminal; decode with pos-logcat
+        enableConsole_ = false;
+    }
+    
     std::cout << "Logging configuration:" << std::endl;
     std::cout << "  Level: " << levelStr << std::endl;
+    for (const auto& [component, level] : getComponentLevels()) {
+        std::cout << "  Level [" << component << "]: " << levelToString(level) << std::endl;
+    }
     std::cout << "  Directory: " << logDirectory_ << std::endl;
     std::cout << "  Base filename: " << baseFileName_ << std::endl;
     std::cout << "  Max file size: " << maxFileSize_ << " bytes" << std::endl;
+    std::cout << "  Rotated files kept: " << maxRotatedFiles_
+              << (compressRotated_ && LogArchiver::isCompressionAvailable() ? " (gzip)" : "") << std::endl;
     std::cout << "  Console output: " << (enableConsole_ ? "enabled" : "disabled") << std::endl;
+    std::cout << "  Async writer: " << (asyncEnabled_ ? "enabled" : "disabled");
+    if (asyncEnabled_) {
+        std::cout << " (queue: " << asyncQueueSize_ << ", overflow: " << asyncOverflowPolicy_ << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "  Format: " << (binaryMode_ ? "binary (decode with pos-logcat)" : "text") << std::endl;
 }
 
 void Logger::loadConfigurationFromFile() {
@@ -99,31 +184,14 @@ void Logger::loadConfigurationFromFile() {
         return;
     }
     
-    std::ifstream file(configFile);
-    if (!file.is_open()) {
+    // Shared with ConfigurationManager, so the file is parsed only once
+    auto properties = PropertyTable::getInstance().load(configFile);
+    if (!properties) {
         std::cout << "Could not open configuration file: " << configFile << std::endl;
         return;
     }
     
-    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    file.close();
-    
-    // Simple XML property extraction using regex
-    std::regex propertyRegex("<property\\s+name\\s*=\\s*\"([^\"]+)\"\\s*>([^<]+)</property>");
-    std::smatch match;
-    
-    std::string::const_iterator start = content.cbegin();
-    while (std::regex_search(start, content.cend(), match, propertyRegex)) {
-        std::string name = match[1].str();
-        std::string value = match[2].str();
-        
-        // Trim whitespace
-        value.erase(0, value.find_first_not_of(" \t\n\r"));
-        value.erase(value.find_last_not_of(" \t\n\r") + 1);
-        
-        configProperties_[name] = value;
-        start = match.suffix().first;
-    }
+    configProperties_ = *properties;
     
     std::cout << "Loaded " << configProperties_.size() << " properties from " << configFile << std::endl;
 }
@@ -151,26 +219,120 @@ std::string Logger::readConfigProperty(const std::string& propertyName, const st
 }
 
 void Logger::log(LogLevel level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(logMutex_);
-    
     // Check if this level should be logged
-    if (currentLevel_ == LogLevel::NONE || level > currentLevel_) {
+    LogLevel current = currentLevel_.load(std::memory_order_relaxed);
+    if (current == LogLevel::NONE || level > current) {
         return;
     }
     
-    // Create log entry
-    std::stringstream logEntry;
-    logEntry << "[" << getCurrentTimestamp() << "] "
-             << "[" << levelToString(level) << "] "
-             << message << std::endl;
+    write(level, message);
+}
+
+void Logger::write(LogLevel level, const std::string& message) {
+    if (binaryMode_) {
+        logStructured(messageFormatIds_[static_cast<int>(level)], level, "{}", message);
+        return;
+    }
     
-    // Write to file
-    writeToFile(logEntry.str());
+    writeRecord(formatEntry(level, message));
+}
+
+LogComponent& Logger::getComponent(const std::string& name) {
+    std::lock_guard<std::mutex> lock(componentMutex_);
     
-    // Output to console if enabled
-    if (enableConsole_) {
-        std::cout << logEntry.str();
+    auto it = components_.find(name);
+    if (it == components_.end()) {
+        auto component = std::make_unique<LogComponent>(*this, name, resolveComponentLevel(name));
+        it = components_.emplace(name, std::move(component)).first;
     }
+    return *it->second;
+}
+
+void Logger::setComponentLevel(const std::string& name, LogLevel level) {
+    {
+        std::lock_guard<std::mutex> lock(componentMutex_);
+        componentOverrides_[name] = level;
+    }
+    refreshComponentLevels();
+}
+
+void Logger::setComponentLevel(const std::string& name, const std::string& levelStr) {
+    setComponentLevel(name, stringToLevel(levelStr));
+}
+
+void Logger::clearComponentLevel(const std::string& name) {
+    {
+        std::lock_guard<std::mutex> lock(componentMutex_);
+        componentOverrides_.erase(name);
+    }
+    refreshComponentLevels();
+}
+
+std::map<std::string, LogLevel> Logger::getComponentLevels() const {
+    std::lock_guard<std::mutex> lock(componentMutex_);
+    return componentOverrides_;
+}
+
+void Logger::refreshComponentLevels() {
+    std::lock_guard<std::mutex> lock(componentMutex_);
+    for (auto& [name, component] : components_) {
+        component->effectiveLevel_.store(static_cast<int>(resolveComponentLevel(name)),
+                                         std::memory_order_relaxed);
+    }
+}
+
+LogLevel Logger::resolveComponentLevel(const std::string& name) const {
+    // Most specific override wins: "api.APIClient", then "api", then global
+    std::string candidate = name;
+    for (;;) {
+        auto it = componentOverrides_.find(candidate);
+        if (it != componentOverrides_.end()) {
+            return it->second;
+        }
+        std::size_t dot = candidate.rfind('.');
+        if (dot == std::string::npos) {
+            break;
+        }
+        candidate.erase(dot);
+    }
+    return currentLevel_.load(std::memory_order_relaxed);
+}
+
+void Logger::writeRecord(std::string&& record) {
+    // Asynchronous path: hand the record to the writer thread and return
+    if (asyncSink_) {
+        asyncSink_->enqueue(std::move(record));
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(logMutex_);
+    writeToFile(record.data(), record.size());
+}
+
+std::uint32_t Logger::registerFormat(LogLevel level, const char* format) {
+    std::string descriptor;
+    std::uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(formatMutex_);
+        id = static_cast<std::uint32_t>(formats_.size());
+        formats_.push_back({level, format});
+        if (binaryMode_) {
+            BinaryLogFormat::appendDescriptor(descriptor, id, static_cast<std::uint8_t>(level), format);
+        }
+    }
+    
+    // Queued before the id is returned, so it precedes every event using it.
+    // A lost descriptor would leave its events undecodable until the next
+    // rotation, so it waits for space even under the "drop" policy
+    if (!descriptor.empty()) {
+        if (asyncSink_ && asyncSink_->enqueue(std::move(descriptor), AsyncLogSink::OverflowPolicy::BLOCK)) {
+            return id;
+        }
+        // Synchronous logging, or a sink already stopped and drained
+        std::lock_guard<std::mutex> lock(logMutex_);
+        writeToFile(descriptor.data(), descriptor.size());
+    }
+    return id;
 }
 
 void Logger::debug(const std::string& message) {
@@ -189,50 +351,165 @@ void Logger::error(const std::string& message) {
     log(LogLevel::ERROR, message);
 }
 
-void Logger::writeToFile(const std::string& logEntry) {
-    if (!logFile_.is_open()) {
-        return;
+void Logger::flush() {
+    if (asyncSink_) {
+        asyncSink_->flush();
     }
     
-    // Check if file size exceeds limit
-    logFile_.seekp(0, std::ios::end);
-    std::size_t currentSize = logFile_.tellp();
+    std::lock_guard<std::mutex> lock(logMutex_);
+    if (logFd_ >= 0) {
+        ::fsync(logFd_);
+    }
+}
+
+std::string Logger::formatEntry(LogLevel level, const std::string& message) {
+    std::string logEntry;
+    logEntry.reserve(message.size() + 36);
+    logEntry += '[';
+    appendTimestamp(logEntry);
+    logEntry += "] [";
+    logEntry += levelToString(level);
+    logEntry += "] ";
+    logEntry += message;
+    logEntry += '\n';
+    return logEntry;
+}
+
+void Logger::writeToFile(const char* data, std::size_t size) {
+    // Output to console if enabled
+    if (enableConsole_) {
+        std::size_t written = 0;
+        while (written < size) {
+            ssize_t n = ::write(STDOUT_FILENO, data + written, size - written);
+            if (n <= 0) break;
+            written += static_cast<std::size_t>(n);
+        }
+    }
     
-    if (currentSize >= maxFileSize_) {
+    if (logFd_ < 0) {
+        return;
+    }
+    
+    // Rotate before a write that would take the file past the limit, so it
+    // only grows beyond maxFileSize_ if one batch is larger than that
+    if (currentFileSize_ > 0 && currentFileSize_ + size > maxFileSize_) {
         rotateLogFile();
     }
     
-    // Write the log entry
-    logFile_ << logEntry;
-    logFile_.flush();
+    // Write the whole batch with as few syscalls as possible
+    std::size_t written = 0;
+    while (written < size) {
+        ssize_t n = ::write(logFd_, data + written, size - written);
+        if (n <= 0) break;
+        written += static_cast<std::size_t>(n);
+    }
+    currentFileSize_ += written;
+}
+
+bool Logger::openLogFile() {
+    logFd_ = ::open(currentFileName_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (logFd_ < 0) {
+        currentFileSize_ = 0;
+        return false;
+    }
+    
+    off_t size = ::lseek(logFd_, 0, SEEK_END);
+    currentFileSize_ = size > 0 ? static_cast<std::size_t>(size) : 0;
+    
+    if (binaryMode_ && currentFileSize_ == 0) {
+        writeBinaryPreamble();
+    }
+    return true;
+}
+
+void Logger::writeBinaryPreamble() {
+    // Every binary file is self-describing: header plus all known descriptors
+    std::string preamble;
+    BinaryLogFormat::appendHeader(preamble);
+    {
+        std::lock_guard<std::mutex> lock(formatMutex_);
+        for (std::size_t id = 0; id < formats_.size(); ++id) {
+            BinaryLogFormat::appendDescriptor(preamble, static_cast<std::uint32_t>(id),
+                                              static_cast<std::uint8_t>(formats_[id].level),
+                                              formats_[id].format);
+        }
+    }
+    
+    ssize_t n = ::write(logFd_, preamble.data(), preamble.size());
+    if (n > 0) {
+        currentFileSize_ += static_cast<std::size_t>(n);
+    }
 }
 
 void Logger::rotateLogFile() {
-    if (logFile_.is_open()) {
-        logFile_.close();
+    const std::string previousFileName = currentFileName_;
+    const std::string nextFileName = getNextLogFileName();
+    
+    int newFd = ::open(nextFileName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (newFd < 0) {
+        // Keep writing to the current file and retry after another maxFileSize_
+        currentFileSize_ = 0;
+        return;
     }
     
-    // Generate new filename with timestamp
-    currentFileName_ = getCurrentLogFileName();
+    // Swap the new file in under the same descriptor number, so the log
+    // descriptor is valid at every instant (crash handler included)
+    if (logFd_ >= 0) {
+        ::dup2(newFd, logFd_);
+        ::close(newFd);
+    } else {
+        logFd_ = newFd;
+    }
+    currentFileName_ = nextFileName;
+    currentFileSize_ = 0;
     
-    // Open new file
-    logFile_.open(currentFileName_, std::ios::app);
+    // Write the notice directly since the caller owns the writer
+    if (binaryMode_) {
+        writeBinaryPreamble();
+    } else {
+        std::string notice = formatEntry(LogLevel::INFO, "Log file rotated to: " + currentFileName_);
+        ssize_t n = ::write(logFd_, notice.data(), notice.size());
+        if (n > 0) {
+            currentFileSize_ += static_cast<std::size_t>(n);
+        }
+    }
     
-    if (logFile_.is_open()) {
-        info("Log file rotated to: " + currentFileName_);
+    // Compression and retention happen on the archiver's low-priority thread
+    if (archiver_) {
+        archiver_->archive(previousFileName, currentFileName_);
     }
 }
 
 std::string Logger::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+    std::string timestamp;
+    appendTimestamp(timestamp);
+    return timestamp;
+}
+
+void Logger::appendTimestamp(std::string& out) {
+    // "YYYY-mm-dd HH:MM:SS" is formatted once per second per thread; only the
+    // millisecond digits are patched for each line
+    constexpr std::size_t SECONDS_LENGTH = 19;
+    thread_local std::time_t cachedSecond = static_cast<std::time_t>(-1);
+    thread_local char cached[SECONDS_LENGTH + 5] = {};
     
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::time_t second = static_cast<std::time_t>(millis / 1000);
+    int ms = static_cast<int>(millis % 1000);
+    
+    if (second != cachedSecond) {
+        std::tm localTime;
+        localtime_r(&second, &localTime);
+        std::strftime(cached, sizeof(cached), "%Y-%m-%d %H:%M:%S", &localTime);
+        cached[SECONDS_LENGTH] = '.';
+        cachedSecond = second;
+    }
+    
+    cached[SECONDS_LENGTH + 1] = static_cast<char>('0' + ms / 100);
+    cached[SECONDS_LENGTH + 2] = static_cast<char>('0' + (ms / 10) % 10);
+    cached[SECONDS_LENGTH + 3] = static_cast<char>('0' + ms % 10);
+    out.append(cached, SECONDS_LENGTH + 4);
 }
 
 std::string Logger::levelToString(LogLevel level) const {
@@ -259,6 +536,35 @@ LogLevel Logger::stringToLevel(const std::string& levelStr) {
     return LogLevel::INFO; // Default fallback
 }
 
+std::string Logger::getNextLogFileName() {
+    // Several rotations can land in the same second. Names must keep rising
+    // even after older files were pruned, since retention relies on lexical
+    // order matching age order (hence the zero-padded suffix).
+    std::string fileName = getCurrentLogFileName();
+    const std::string extension = binaryMode_ ? ".binlog" : ".log";
+    const std::string stem = fileName.substr(0, fileName.size() - extension.size());
+    
+    if (stem == rotationStem_) {
+        ++rotationSuffix_;
+    } else {
+        rotationStem_ = stem;
+        rotationSuffix_ = 0;
+    }
+    
+    for (;;) {
+        if (rotationSuffix_ > 0) {
+            std::ostringstream suffixed;
+            suffixed << stem << '_' << std::setfill('0') << std::setw(3) << rotationSuffix_ << extension;
+            fileName = suffixed.str();
+        }
+        if (fileName != currentFileName_ && !std::filesystem::exists(fileName) &&
+            !std::filesystem::exists(fileName + ".gz")) {
+            return fileName;
+        }
+        ++rotationSuffix_;
+    }
+}
+
 std::string Logger::getCurrentLogFileName() {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
@@ -266,7 +572,7 @@ std::string Logger::getCurrentLogFileName() {
     std::stringstream ss;
     ss << logDirectory_ << "/" << baseFileName_ << "_"
        << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S")
-       << ".log";
+       << (binaryMode_ ? ".binlog" : ".log");
     
     return ss.str();
 }
@@ -0,0 +1,202 @@
+#include "../../include/utils/PropertyTable.hpp"
+#include "../../include/utils/StartupProfile.hpp"
+
+#include <cctype>
+#include <fstream>
+
+// ============================================================================
+// PropertyTable Implementation
+// ============================================================================
+
+namespace {
+    const char* const WHITESPACE = " \t\r\n";
+
+    std::string trim(const std::string& text) {
+        std::size_t first = text.find_first_not_of(WHITESPACE);
+        if (first == std::string::npos) {
+            return "";
+        }
+        return text.substr(first, text.find_last_not_of(WHITESPACE) - first + 1);
+    }
+
+    std::string decodeEntities(const std::string& text) {
+        if (text.find('&') == std::string::npos) {
+            return text;
+        }
+
+        static const std::pair<const char*, char> entities[] = {
+            {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}
+        };
+
+        std::string decoded;
+        decoded.reserve(text.size());
+        for (std::size_t i = 0; i < text.size(); ) {
+            bool replaced = false;
+            if (text[i] == '&') {
+                for (const auto& [entity, ch] : entities) {
+                    if (text.compare(i, std::char_traits<char>::length(entity), entity) == 0) {
+                        decoded += ch;
+                        i += std::char_traits<char>::length(entity);
+                        replaced = true;
+                        break;
+                    }
+                }
+            }
+            if (!replaced) {
+                decoded += text[i++];
+            }
+        }
+        return decoded;
+    }
+
+    // Consumes input up to and including the terminator (e.g. "-->")
+    void skipPast(std::streambuf* buf, const std::string& terminator, std::string* captured = nullptr) {
+        std::string tail;
+        int c;
+        while ((c = buf->sbumpc()) != std::char_traits<char>::eof()) {
+            tail += static_cast<char>(c);
+            if (tail.size() >= terminator.size() &&
+                tail.compare(tail.size() - terminator.size(), terminator.size(), terminator) == 0) {
+                if (captured) {
+                    captured->append(tail, 0, tail.size() - terminator.size());
+                }
+                return;
+            }
+            // Only the last few characters matter unless the content is kept
+            if (!captured && tail.size() > terminator.size()) {
+                tail.erase(0, 1);
+            }
+        }
+    }
+
+    // Value of the name="..." attribute inside a start tag, empty if absent
+    std::string nameAttribute(const std::string& tag) {
+        std::size_t pos = tag.find("name");
+        while (pos != std::string::npos) {
+            std::size_t eq = tag.find_first_not_of(WHITESPACE, pos + 4);
+            if (eq != std::string::npos && tag[eq] == '=') {
+                std::size_t quote = tag.find_first_not_of(WHITESPACE, eq + 1);
+                if (quote != std::string::npos && (tag[quote] == '"' || tag[quote] == '\'')) {
+                    std::size_t end = tag.find(tag[quote], quote + 1);
+                    if (end != std::string::npos) {
+                        return decodeEntities(tag.substr(quote + 1, end - quote - 1));
+                    }
+                }
+            }
+            pos = tag.find("name", pos + 4);
+        }
+        return "";
+    }
+}
+
+PropertyTable& PropertyTable::getInstance() {
+    static PropertyTable instance;
+    return instance;
+}
+
+PropertyTable::PropertyTable()
+    : parseCount_(0)
+    , cacheHitCount_(0) {}
+
+std::shared_ptr<const PropertyTable::Properties> PropertyTable::load(const std::string& filePath) {
+    std::error_code ec;
+    const auto modified = std::filesystem::last_write_time(filePath, ec);
+    const auto size = ec ? 0 : std::filesystem::file_size(filePath, ec);
+    if (ec) {
+        return nullptr;
+    }
+
+    // Parse under the lock so concurrent first loads share one parse
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto cached = files_.find(filePath);
+    if (cached != files_.end() && cached->second.modified == modified && cached->second.size == size) {
+        ++cacheHitCount_;
+        return cached->second.properties;
+    }
+
+    StartupProfile::Phase phase("config.parse " + filePath);
+
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+
+    auto properties = std::make_shared<Properties>();
+    parse(file, *properties);
+    ++parseCount_;
+
+    files_[filePath] = Entry{properties, modified, size};
+    return properties;
+}
+
+void PropertyTable::parse(std::istream& in, Properties& out) {
+    std::streambuf* buf = in.rdbuf();
+    const int eof = std::char_traits<char>::eof();
+
+    bool inProperty = false;
+    std::string name;
+    std::string text;   // Decoded value so far
+    std::string raw;    // Character data since the last markup
+    std::string tag;
+    int c;
+
+    while ((c = buf->sbumpc()) != eof) {
+        if (c != '<') {
+            if (inProperty) {
+                raw += static_cast<char>(c);
+            }
+            continue;
+        }
+        if (inProperty) {
+            text += decodeEntities(raw);
+            raw.clear();
+        }
+
+        // Read the tag up to '>', diverting to comments and CDATA early
+        tag.clear();
+        bool special = false;
+        while ((c = buf->sbumpc()) != eof && c != '>') {
+            tag += static_cast<char>(c);
+            if (tag == "!--") {
+                skipPast(buf, "-->");
+                special = true;
+                break;
+            }
+            if (tag == "![CDATA[") {
+                skipPast(buf, "]]>", inProperty ? &text : nullptr);
+                special = true;
+                break;
+            }
+        }
+        if (special) {
+            continue;
+        }
+
+        if (tag.compare(0, 8, "property") == 0 &&
+            (tag.size() == 8 || std::isspace(static_cast<unsigned char>(tag[8])) || tag[8] == '/')) {
+            name = nameAttribute(tag);
+            text.clear();
+            if (!tag.empty() && tag.back() == '/') {
+                if (!name.empty()) {
+                    out[name] = "";
+                }
+            } else {
+                inProperty = !name.empty();
+            }
+        } else if (inProperty && trim(tag) == "/property") {
+            out[name] = trim(text);
+            inProperty = false;
+        }
+    }
+}
+
+std::uint64_t PropertyTable::getParseCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return parseCount_;
+}
+
+std::uint64_t PropertyTable::getCacheHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cacheHitCount_;
+}
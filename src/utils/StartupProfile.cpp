@@ -0,0 +1,76 @@
+#include "../../include/utils/StartupProfile.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+// ============================================================================
+// StartupProfile Implementation
+// ============================================================================
+
+namespace {
+    double toMilliseconds(StartupProfile::Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+}
+
+StartupProfile::Phase::Phase(std::string name)
+    : name_(std::move(name)) {
+    // Make sure time zero is not later than the first phase
+    StartupProfile::getInstance();
+    start_ = Clock::now();
+}
+
+StartupProfile::Phase::~Phase() {
+    StartupProfile::getInstance().record(name_, start_, Clock::now());
+}
+
+StartupProfile& StartupProfile::getInstance() {
+    static StartupProfile instance;
+    return instance;
+}
+
+StartupProfile::StartupProfile()
+    : origin_(Clock::now())
+    , complete_(false) {}
+
+void StartupProfile::record(const std::string& name, Clock::time_point start, Clock::time_point end) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!complete_) {
+        records_.push_back(Record{name, start, end - start});
+    }
+}
+
+bool StartupProfile::complete(std::vector<std::string>& report) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (complete_) {
+        return false;
+    }
+    complete_ = true;
+
+    // Order by start time so nested phases follow the phase containing them
+    std::stable_sort(records_.begin(), records_.end(),
+                     [](const Record& a, const Record& b) { return a.start < b.start; });
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2);
+    line << "Startup breakdown: " << toMilliseconds(Clock::now() - origin_) << " ms since first phase";
+    report.push_back(line.str());
+
+    for (const auto& record : records_) {
+        line.str("");
+        line << "  +" << std::setw(9) << toMilliseconds(record.start - origin_) << " ms  "
+             << std::left << std::setw(40) << record.name << std::right
+             << std::setw(9) << toMilliseconds(record.elapsed) << " ms";
+        report.push_back(line.str());
+    }
+
+    records_.clear();
+    return true;
+}
+
+bool StartupProfile::isComplete() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return complete_;
+}
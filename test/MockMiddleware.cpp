@@ -0,0 +1,874 @@
+/**
+ * @file MockMiddleware.cpp
+ * @brief Implementation of the in-process JSON:API stand-in
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "MockMiddleware.hpp"
+#include "../include/utils/Compression.hpp"
+
+#include <Wt/Json/Array.h>
+#include <Wt/Json/Parser.h>
+#include <Wt/Json/Serializer.h>
+#include <Wt/Json/Value.h>
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
+#include <stdexcept>
+
+namespace asio = boost::asio;
+using asio::ip::tcp;
+
+namespace {
+    const char* const API_PREFIX = "/api/";
+    const char* const TYPES[] = {"Order", "MenuItem", "Employee"};
+
+    // Replies smaller than this are not worth a gzip header and a deflate
+    constexpr std::size_t COMPRESS_REPLIES_ABOVE = 1024;
+    constexpr std::size_t MAX_DECODED_BODY = 16 * 1024 * 1024;
+
+    std::string lower(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    std::string urlDecode(const std::string& text) {
+        std::string decoded;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '%' && i + 2 < text.size() &&
+                std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+                decoded += static_cast<char>(std::strtol(text.substr(i + 1, 2).c_str(), nullptr, 16));
+                i += 2;
+            } else {
+                decoded += (text[i] == '+') ? ' ' : text[i];
+            }
+        }
+        return decoded;
+    }
+
+    std::string urlEncode(const std::string& text) {
+        static const char* const HEX = "0123456789ABCDEF";
+        std::string encoded;
+        for (unsigned char c : text) {
+            if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == ',') {
+                encoded += static_cast<char>(c);
+            } else {
+                encoded += '%';
+                encoded += HEX[c >> 4];
+                encoded += HEX[c & 0x0F];
+            }
+        }
+        return encoded;
+    }
+
+    std::map<std::string, std::string> parseQuery(const std::string& query) {
+        std::map<std::string, std::string> params;
+        std::istringstream pairs(query);
+        std::string pair;
+        while (std::getline(pairs, pair, '&')) {
+            std::size_t equals = pair.find('=');
+            if (!pair.empty()) {
+                params[urlDecode(pair.substr(0, equals))] =
+                    equals == std::string::npos ? std::string() : urlDecode(pair.substr(equals + 1));
+            }
+        }
+        return params;
+    }
+
+    // Numeric ids sort as numbers ("2" before "10")
+    bool idLess(const std::string& a, const std::string& b) {
+        return a.size() != b.size() ? a.size() < b.size() : a < b;
+    }
+
+    // UTC with milliseconds; one fixed width, so timestamps order as text
+    std::string timestamp() {
+        const auto now = std::chrono::system_clock::now();
+        const std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+        const long long millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now.time_since_epoch()).count() % 1000;
+        std::tm utc{};
+        gmtime_r(&seconds, &utc);
+        char text[96];  // Room for any int fields, not just valid dates
+        std::snprintf(text, sizeof(text), "%04d-%02d-%02dT%02d:%02d:%02d.%03lldZ", utc.tm_year + 1900,
+                      utc.tm_mon + 1, utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec, millis);
+        return text;
+    }
+
+    std::string text(const Wt::Json::Value& object, const std::string& name) {
+        if (object.type() != Wt::Json::Type::Object) {
+            return std::string();
+        }
+        const Wt::Json::Value& value = static_cast<const Wt::Json::Object&>(object).get(name);
+        return value.type() == Wt::Json::Type::String ? static_cast<std::string>(value) : std::string();
+    }
+
+    std::string text(const Wt::Json::Object& object, const std::string& name) {
+        const Wt::Json::Value& value = object.get(name);
+        return value.type() == Wt::Json::Type::String ? static_cast<std::string>(value) : std::string();
+    }
+
+    std::string idOf(const Wt::Json::Value& value) {
+        if (value.type() == Wt::Json::Type::String) {
+            return static_cast<std::string>(value);
+        }
+        if (value.type() == Wt::Json::Type::Number) {
+            return std::to_string(static_cast<long long>(value));
+        }
+        return std::string();
+    }
+
+    const char* reason(int status) {
+        switch (status) {
+            case 200: return "OK";
+            case 201: return "Created";
+            case 204: return "No Content";
+            case 400: return "Bad Request";
+            case 404: return "Not Found";
+            case 409: return "Conflict";
+            case 415: return "Unsupported Media Type";
+            case 429: return "Too Many Requests";
+            case 500: return "Internal Server Error";
+            case 502: return "Bad Gateway";
+            case 503: return "Service Unavailable";
+            case 504: return "Gateway Timeout";
+            default: return "Unknown";
+        }
+    }
+}
+
+// ============================================================================
+// Network side
+// ============================================================================
+
+struct MockMiddleware::Server {
+    asio::io_context io;
+    tcp::acceptor acceptor{io};
+
+    void accept(MockMiddleware& owner);
+};
+
+/**
+ * One keep-alive client connection: read a request, answer it after the
+ * injected delay, repeat
+ */
+class MockMiddleware::Connection : public std::enable_shared_from_this<Connection> {
+public:
+    Connection(MockMiddleware& owner, tcp::socket socket)
+        : owner_(owner), socket_(std::move(socket)), timer_(socket_.get_executor()) {}
+
+    void readRequest() {
+        auto self = shared_from_this();
+        asio::async_read_until(socket_, buffer_, "\r\n\r\n",
+            [self](const boost::system::error_code& ec, std::size_t headerBytes) {
+                if (!ec) {
+                    self->onHeader(headerBytes);
+                }
+            });
+    }
+
+private:
+    void onHeader(std::size_t headerBytes) {
+        std::string header(asio::buffers_begin(buffer_.data()),
+                           asio::buffers_begin(buffer_.data()) + headerBytes);
+        buffer_.consume(headerBytes);
+
+        std::istringstream lines(header);
+        std::string line;
+        std::getline(lines, line);
+        std::istringstream requestLine(line);
+        std::string version;
+        requestLine >> method_ >> target_ >> version;
+
+        std::size_t contentLength = 0;
+        std::string connection;
+        idempotencyKey_.clear();
+        acceptsGzip_ = false;
+        contentEncoding_.clear();
+        while (std::getline(lines, line) && line != "\r") {
+            std::size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            const std::string name = lower(line.substr(0, colon));
+            std::string value = line.substr(colon + 1);
+            value.erase(0, value.find_first_not_of(' '));
+            value.erase(value.find_last_not_of("\r ") + 1);
+
+            if (name == "content-length") {
+                contentLength = static_cast<std::size_t>(std::strtoull(value.c_str(), nullptr, 10));
+            } else if (name == "connection") {
+                connection = lower(value);
+            } else if (name == "idempotency-key") {
+                idempotencyKey_ = value;
+            } else if (name == "accept-encoding") {
+                acceptsGzip_ = lower(value).find("gzip") != std::string::npos;
+            } else if (name == "content-encoding") {
+                contentEncoding_ = lower(value);
+            }
+        }
+        keepAlive_ = (version == "HTTP/1.1") ? connection != "close" : connection == "keep-alive";
+
+        if (buffer_.size() >= contentLength) {
+            onBody(contentLength);
+            return;
+        }
+        auto self = shared_from_this();
+        asio::async_read(socket_, buffer_, asio::transfer_exactly(contentLength - buffer_.size()),
+            [self, contentLength](const boost::system::error_code& ec, std::size_t) {
+                if (!ec) {
+                    self->onBody(contentLength);
+                }
+            });
+    }
+
+    void onBody(std::size_t contentLength) {
+        std::string body(asio::buffers_begin(buffer_.data()),
+                         asio::buffers_begin(buffer_.data()) + contentLength);
+        buffer_.consume(contentLength);
+
+        Reply reply;
+        std::string decoded;
+        if (!contentEncoding_.empty() && contentEncoding_ != "identity" &&
+            !Compression::decode(contentEncoding_, body, decoded, MAX_DECODED_BODY)) {
+            reply = error(415, "Cannot decode a " + contentEncoding_ + " body");
+        } else {
+            reply = owner_.handle(method_, target_, decoded.empty() ? body : decoded, idempotencyKey_);
+        }
+        const std::chrono::milliseconds delay = owner_.nextDelay();
+        if (delay.count() <= 0) {
+            writeReply(reply);
+            return;
+        }
+
+        // The delay is a timer, not a sleep: other connections keep going
+        auto self = shared_from_this();
+        timer_.expires_after(delay);
+        timer_.async_wait([self, reply](const boost::system::error_code& ec) {
+            if (!ec) {
+                self->writeReply(reply);
+            }
+        });
+    }
+
+    void writeReply(const Reply& reply) {
+        std::string body = (reply.status == 204) ? std::string() : reply.body;
+        std::string gzipped;
+        const bool compressed = acceptsGzip_ && body.size() >= COMPRESS_REPLIES_ABOVE &&
+                                Compression::gzip(body, gzipped);
+        if (compressed) {
+            body.swap(gzipped);
+            std::lock_guard<std::mutex> lock(owner_.mutex_);
+            ++owner_.stats_.compressedReplies;
+        }
+
+        std::ostringstream response;
+        response << "HTTP/1.1 " << reply.status << " " << reason(reply.status) << "\r\n"
+                 << "Content-Type: application/vnd.api+json\r\n"
+                 << (compressed ? "Content-Encoding: gzip\r\n" : "")
+                 << "Content-Length: " << body.size() << "\r\n"
+                 << "Connection: " << (keepAlive_ ? "keep-alive" : "close") << "\r\n\r\n"
+                 << body;
+        response_ = response.str();
+
+        auto self = shared_from_this();
+        asio::async_write(socket_, asio::buffer(response_),
+            [self](const boost::system::error_code& ec, std::size_t) {
+                if (!ec && self->keepAlive_) {
+                    self->readRequest();
+                } else {
+                    boost::system::error_code ignored;
+                    self->socket_.shutdown(tcp::socket::shutdown_both, ignored);
+                }
+            });
+    }
+
+    MockMiddleware& owner_;
+    tcp::socket socket_;
+    asio::steady_timer timer_;
+    asio::streambuf buffer_;
+    std::string method_;
+    std::string target_;
+    std::string idempotencyKey_;
+    std::string contentEncoding_;
+    std::string response_;
+    bool keepAlive_ = true;
+    bool acceptsGzip_ = false;
+};
+
+void MockMiddleware::Server::accept(MockMiddleware& owner) {
+    acceptor.async_accept([this, &owner](const boost::system::error_code& ec, tcp::socket socket) {
+        if (ec) {
+            return;  // Acceptor closed by stop()
+        }
+        {
+            std::lock_guard<std::mutex> lock(owner.mutex_);
+            ++owner.stats_.connections;
+        }
+        socket.set_option(tcp::no_delay(true));
+        std::make_shared<Connection>(owner, std::move(socket))->readRequest();
+        accept(owner);
+    });
+}
+
+// ============================================================================
+// MockMiddleware
+// ============================================================================
+
+MockMiddleware::MockMiddleware()
+    : MockMiddleware(Options()) {}
+
+MockMiddleware::MockMiddleware(const Options& options)
+    : options_(options), random_(options.seed ? options.seed : 1) {
+    seed();
+}
+
+MockMiddleware::~MockMiddleware() {
+    stop();
+}
+
+void MockMiddleware::start() {
+    if (server_) {
+        return;
+    }
+
+    auto server = std::make_unique<Server>();
+    const tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), options_.port);
+    boost::system::error_code ec;
+    server->acceptor.open(endpoint.protocol(), ec);
+    if (!ec) server->acceptor.set_option(tcp::acceptor::reuse_address(true), ec);
+    if (!ec) server->acceptor.bind(endpoint, ec);
+    if (!ec) server->acceptor.listen(asio::socket_base::max_listen_connections, ec);
+    if (ec) {
+        throw std::runtime_error("MockMiddleware: cannot listen on port " +
+                                 std::to_string(options_.port) + ": " + ec.message());
+    }
+    port_ = server->acceptor.local_endpoint().port();
+
+    server_ = std::move(server);
+    server_->accept(*this);
+    for (std::size_t i = 0; i < std::max<std::size_t>(options_.threads, 1); ++i) {
+        threads_.emplace_back([this]() { server_->io.run(); });
+    }
+}
+
+void MockMiddleware::stop() {
+    if (!server_) {
+        return;
+    }
+    server_->io.stop();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+    server_.reset();  // Closes the acceptor and every connection
+}
+
+unsigned short MockMiddleware::port() const {
+    return port_;
+}
+
+std::string MockMiddleware::baseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(port_) + "/api";
+}
+
+void MockMiddleware::setLatency(std::chrono::milliseconds latency, std::chrono::milliseconds jitter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_.latency = latency;
+    options_.jitter = jitter;
+}
+
+void MockMiddleware::setErrorRate(double errorRate, int errorStatus) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_.errorRate = errorRate;
+    options_.errorStatus = errorStatus;
+}
+
+std::size_t MockMiddleware::count(const std::string& type) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto resources = data_.resources.find(type);
+    return resources == data_.resources.end() ? 0 : resources->second.size();
+}
+
+Wt::Json::Object MockMiddleware::attributes(const std::string& type, const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto resources = data_.resources.find(type);
+    if (resources == data_.resources.end()) {
+        return Wt::Json::Object();
+    }
+    auto resource = resources->second.find(id);
+    return resource == resources->second.end() ? Wt::Json::Object() : resource->second;
+}
+
+MockMiddleware::Stats MockMiddleware::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void MockMiddleware::seed() {
+    static const char* const dishes[] = {"Soup", "Salad", "Burger", "Pasta", "Steak", "Cake", "Tea", "Special"};
+    static const char* const roles[] = {"server", "cook", "cashier", "manager", "host"};
+
+    for (const char* type : TYPES) {
+        data_.resources[type];
+    }
+
+    for (std::size_t i = 1; i <= options_.menuItems; ++i) {
+        Wt::Json::Object item;
+        item["name"] = Wt::Json::Value(std::string(dishes[i % 8]) + " " + std::to_string(i));
+        item["price"] = Wt::Json::Value(4.5 + static_cast<double>(i % 20));
+        item["category"] = Wt::Json::Value(static_cast<int>(i % 5));
+        item["available"] = Wt::Json::Value(i % 7 != 0);
+        data_.resources["MenuItem"][std::to_string(i)] = std::move(item);
+    }
+
+    for (std::size_t i = 1; i <= options_.orders; ++i) {
+        Wt::Json::Array items;
+        double total = 0.0;
+        for (std::size_t line = 0; line < 1 + i % 4; ++line) {
+            const std::size_t menuItemId = 1 + (i + line) % std::max<std::size_t>(options_.menuItems, 1);
+            const double price = 4.5 + static_cast<double>(menuItemId % 20);
+            Wt::Json::Object item;
+            item["menu_item_id"] = Wt::Json::Value(static_cast<int>(menuItemId));
+            item["name"] = Wt::Json::Value(std::string(dishes[menuItemId % 8]) + " " + std::to_string(menuItemId));
+            item["price"] = Wt::Json::Value(price);
+            item["quantity"] = Wt::Json::Value(static_cast<int>(1 + line % 2));
+            items.push_back(Wt::Json::Value(std::move(item)));
+            total += price * static_cast<double>(1 + line % 2);
+        }
+
+        Wt::Json::Object order;
+        order["table_identifier"] = Wt::Json::Value("table " + std::to_string(1 + i % 12));
+        order["status"] = Wt::Json::Value(static_cast<int>(i % 6));
+        order["items"] = Wt::Json::Value(std::move(items));
+        order["total"] = Wt::Json::Value(total);
+        char createdAt[32];
+        std::snprintf(createdAt, sizeof(createdAt), "2025-%02d-%02dT12:00:00.000Z",
+                      static_cast<int>(1 + (i / 28) % 12), static_cast<int>(1 + i % 28));
+        order["created_at"] = Wt::Json::Value(std::string(createdAt));
+        order["updated_at"] = Wt::Json::Value(std::string(createdAt));
+        data_.resources["Order"][std::to_string(i)] = std::move(order);
+    }
+
+    for (std::size_t i = 1; i <= options_.employees; ++i) {
+        const std::string number = std::to_string(1000 + i);
+        Wt::Json::Object employee;
+        employee["employee_number"] = Wt::Json::Value("E" + number);
+        employee["first_name"] = Wt::Json::Value("Staff");
+        employee["last_name"] = Wt::Json::Value("Member" + std::to_string(i));
+        employee["email"] = Wt::Json::Value("staff" + number + "@example.com");
+        employee["phone"] = Wt::Json::Value("555-010-" + number);
+        employee["role"] = Wt::Json::Value(roles[i % 5]);
+        employee["location_id"] = Wt::Json::Value("main");
+        employee["active"] = Wt::Json::Value(i % 9 != 0);
+        employee["hired_date"] = Wt::Json::Value("2024-01-15");
+        employee["hourly_rate"] = Wt::Json::Value(14.0 + static_cast<double>(i % 10));
+        data_.resources["Employee"][std::to_string(i)] = std::move(employee);
+    }
+
+    for (const char* type : TYPES) {
+        data_.nextIds[type] = static_cast<int>(data_.resources[type].size()) + 1;
+        for (auto& [id, attributes] : data_.resources[type]) {
+            if (!attributes.contains("updated_at")) {
+                attributes["updated_at"] = Wt::Json::Value("2025-01-01T00:00:00.000Z");
+            }
+        }
+    }
+}
+
+std::chrono::milliseconds MockMiddleware::nextDelay() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (options_.jitter.count() <= 0) {
+        return options_.latency;
+    }
+    random_ ^= random_ << 13;
+    random_ ^= random_ >> 7;
+    random_ ^= random_ << 17;
+    return options_.latency + std::chrono::milliseconds(random_ % (options_.jitter.count() + 1));
+}
+
+bool MockMiddleware::nextFails() {
+    // Called with mutex_ held
+    if (options_.errorRate <= 0.0) {
+        return false;
+    }
+    random_ ^= random_ << 13;
+    random_ ^= random_ >> 7;
+    random_ ^= random_ << 17;
+    return static_cast<double>(random_ % 1000000) / 1000000.0 < options_.errorRate;
+}
+
+MockMiddleware::Reply MockMiddleware::handle(const std::string& method, const std::string& target,
+                                             const std::string& body, const std::string& idempotencyKey) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.requests;
+        if (nextFails()) {
+            ++stats_.injectedErrors;
+            return error(options_.errorStatus, "Injected failure");
+        }
+        if (!idempotencyKey.empty() && method != "GET") {
+            auto replay = idempotentReplies_.find(idempotencyKey);
+            if (replay != idempotentReplies_.end()) {
+                ++stats_.replayedWrites;
+                return replay->second;
+            }
+        }
+    }
+
+    // "/api/<type>[/<id>][?query]"
+    const std::size_t queryStart = target.find('?');
+    const std::string path = target.substr(0, queryStart);
+    const std::string prefix = API_PREFIX;
+    if (path.compare(0, prefix.size(), prefix) != 0) {
+        return error(404, "Unknown path " + path);
+    }
+    const std::string rest = path.substr(prefix.size());
+    const std::size_t slash = rest.find('/');
+    const std::string type = rest.substr(0, slash);
+    const std::string id = (slash == std::string::npos) ? std::string() : urlDecode(rest.substr(slash + 1));
+    if (rest == "operations" && options_.atomicOperations) {
+        if (method != "POST") {
+            return error(405, "Atomic operations are POSTed");
+        }
+        Reply reply = operations(body);
+        if (!idempotencyKey.empty()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idempotentReplies_[idempotencyKey] = reply;
+        }
+        return reply;
+    }
+    if (std::find(std::begin(TYPES), std::end(TYPES), type) == std::end(TYPES)) {
+        return error(404, "Unknown resource type " + type);
+    }
+
+    if (method == "GET") {
+        return id.empty()
+            ? list(type, parseQuery(queryStart == std::string::npos ? std::string() : target.substr(queryStart + 1)))
+            : read(type, id);
+    }
+
+    Reply reply = write(method, type, id, body);
+    if (!idempotencyKey.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idempotentReplies_[idempotencyKey] = reply;
+    }
+    return reply;
+}
+
+MockMiddleware::Reply MockMiddleware::list(const std::string& type,
+                                           const std::map<std::string, std::string>& params) const {
+    std::vector<std::pair<std::string, std::string>> filters;
+    std::vector<std::string> fields;
+    bool sparse = false;
+    std::size_t limit = 0;
+    std::size_t offset = 0;
+    for (const auto& [name, value] : params) {
+        if (name == "fields[" + type + "]") {
+            sparse = true;
+            std::istringstream names(value);
+            std::string field;
+            while (std::getline(names, field, ',')) {
+                fields.push_back(field);
+            }
+        } else if (name.compare(0, 7, "filter[") == 0) {
+            filters.emplace_back(name.substr(7), value);  // "attr]" or "attr][op]"
+        } else if (name == "page[limit]" && options_.paging) {
+            limit = static_cast<std::size_t>(std::strtoull(value.c_str(), nullptr, 10));
+        } else if (name == "page[offset]" && options_.paging) {
+            offset = static_cast<std::size_t>(std::strtoull(value.c_str(), nullptr, 10));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Resources& resources = data_.resources.at(type);
+
+    std::vector<Resources::const_iterator> matched;
+    for (auto it = resources.begin(); it != resources.end(); ++it) {
+        const bool keep = std::all_of(filters.begin(), filters.end(), [&it](const auto& filter) {
+            return matches(it->second, filter.first, filter.second);
+        });
+        if (keep) {
+            matched.push_back(it);
+        }
+    }
+    std::sort(matched.begin(), matched.end(), [](const auto& a, const auto& b) { return idLess(a->first, b->first); });
+
+    const std::size_t begin = std::min(offset, matched.size());
+    const std::size_t end = limit ? std::min(begin + limit, matched.size()) : matched.size();
+
+    std::string body = "{\"data\":[";
+    for (std::size_t i = begin; i < end; ++i) {
+        if (i != begin) {
+            body += ',';
+        }
+        body += resource(type, matched[i]->first,
+                         sparse ? sparseAttributes(matched[i]->second, fields) : matched[i]->second);
+    }
+    body += "],\"meta\":{\"count\":" + std::to_string(matched.size());
+    // A delta query (changed since) also lists what was deleted since
+    auto since = params.find("filter[updated_at][gte]");
+    if (since != params.end()) {
+        body += ",\"deleted\":[";
+        bool first = true;
+        auto deleted = data_.deletedAt.find(type);
+        if (deleted != data_.deletedAt.end()) {
+            for (const auto& [id, deletedAt] : deleted->second) {
+                if (deletedAt >= since->second) {
+                    body += (first ? "\"" : ",\"") + id + "\"";
+                    first = false;
+                }
+            }
+        }
+        body += "]";
+    }
+    body += "}";
+    if (limit) {
+        body += ",\"links\":{";
+        if (end < matched.size()) {
+            // Same query with the offset moved on, so filters carry over
+            std::map<std::string, std::string> next = params;
+            next["page[offset]"] = std::to_string(end);
+            std::string query;
+            for (const auto& [name, value] : next) {
+                query += (query.empty() ? "?" : "&") + urlEncode(name) + "=" + urlEncode(value);
+            }
+            body += "\"next\":\"" + baseUrl() + "/" + type + query + "\"";
+        }
+        body += "}";
+    }
+    body += "}";
+    return Reply{200, body};
+}
+
+MockMiddleware::Reply MockMiddleware::read(const std::string& type, const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Resources& resources = data_.resources.at(type);
+    auto found = resources.find(id);
+    if (found == resources.end()) {
+        return error(404, type + " " + id + " not found");
+    }
+    return Reply{200, "{\"data\":" + resource(type, id, found->second) + "}"};
+}
+
+MockMiddleware::Reply MockMiddleware::write(const std::string& method, const std::string& type,
+                                            const std::string& id, const std::string& body) {
+    Wt::Json::Object document;
+    if (method != "DELETE") {
+        Wt::Json::ParseError parseError;
+        if (!Wt::Json::parse(body, document, parseError)) {
+            return error(400, "Request body is not a JSON object");
+        }
+    }
+
+    // Accept a bare resource (what the repositories send) or {"data": resource}
+    Wt::Json::Object resourceObject = document;
+    if (document.contains("data") && document.get("data").type() == Wt::Json::Type::Object) {
+        resourceObject = static_cast<const Wt::Json::Object&>(document.get("data"));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return apply(method, type, id, resourceObject, data_);
+}
+
+MockMiddleware::Reply MockMiddleware::operations(const std::string& body) {
+    Wt::Json::Object document;
+    Wt::Json::ParseError parseError;
+    if (!Wt::Json::parse(body, document, parseError) ||
+        document.get("atomic:operations").type() != Wt::Json::Type::Array) {
+        return error(400, "Request body has no atomic:operations");
+    }
+    const Wt::Json::Array& operations = document.get("atomic:operations");
+
+    // Applied to a copy, which replaces the store only if every operation succeeds
+    std::lock_guard<std::mutex> lock(mutex_);
+    Dataset staged = data_;
+
+    std::string results;
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        const std::string pointer = "/atomic:operations/" + std::to_string(i);
+        if (operations[i].type() != Wt::Json::Type::Object) {
+            return error(400, "Operation is not an object", pointer);
+        }
+        const Wt::Json::Object& operation = operations[i];
+        Wt::Json::Object data;
+        if (operation.get("data").type() == Wt::Json::Type::Object) {
+            data = static_cast<const Wt::Json::Object&>(operation.get("data"));
+        }
+        Wt::Json::Object ref = data;
+        if (operation.get("ref").type() == Wt::Json::Type::Object) {
+            ref = static_cast<const Wt::Json::Object&>(operation.get("ref"));
+        }
+
+        const std::string op = text(operation, "op");
+        const std::string type = text(ref, "type");
+        const std::string method = op == "add" ? "POST" : op == "update" ? "PATCH" : op == "remove" ? "DELETE" : "";
+        if (method.empty() || std::find(std::begin(TYPES), std::end(TYPES), type) == std::end(TYPES)) {
+            return error(400, "Unsupported operation " + op + " on " + type, pointer);
+        }
+
+        Reply reply = apply(method, type, method == "POST" ? std::string() : idOf(ref.get("id")), data, staged);
+        if (reply.status >= 400) {
+            Wt::Json::Object problem;
+            Wt::Json::ParseError ignored;
+            Wt::Json::parse(reply.body, problem, ignored);
+            const Wt::Json::Value& errors = problem.get("errors");
+            std::string detail = reply.body;
+            if (errors.type() == Wt::Json::Type::Array && !static_cast<const Wt::Json::Array&>(errors).empty()) {
+                detail = text(static_cast<const Wt::Json::Array&>(errors)[0], "detail");
+            }
+            return error(reply.status, detail, pointer);
+        }
+        results += (i > 0 ? "," : "") + (reply.body.empty() ? std::string("{}") : reply.body);
+    }
+
+    data_ = std::move(staged);
+    return Reply{200, "{\"atomic:results\":[" + results + "]}"};
+}
+
+MockMiddleware::Reply MockMiddleware::apply(const std::string& method, const std::string& type,
+                                            const std::string& id, const Wt::Json::Object& resourceObject,
+                                            Dataset& data) {
+    // Called with mutex_ held
+    Wt::Json::Object attributes;
+    if (resourceObject.contains("attributes") && resourceObject.get("attributes").type() == Wt::Json::Type::Object) {
+        attributes = static_cast<const Wt::Json::Object&>(resourceObject.get("attributes"));
+    }
+    const std::string updatedAt = timestamp();
+    attributes["updated_at"] = Wt::Json::Value(updatedAt);
+    Resources& resources = data.resources[type];
+
+    if (method == "POST") {
+        if (!id.empty()) {
+            return error(400, "POST goes to the collection");
+        }
+        std::string newId = idOf(resourceObject.get("id"));
+        if (newId.empty() || newId == "0") {
+            newId = std::to_string(data.nextIds[type]++);
+        } else if (resources.count(newId)) {
+            return error(409, type + " " + newId + " already exists");
+        }
+        resources[newId] = attributes;
+        data.deletedAt[type].erase(newId);
+        return Reply{201, "{\"data\":" + resource(type, newId, attributes) + "}"};
+    }
+
+    auto found = resources.find(id);
+    if (id.empty() || found == resources.end()) {
+        return error(404, type + " " + id + " not found");
+    }
+    if (method == "DELETE") {
+        resources.erase(found);
+        data.deletedAt[type][id] = updatedAt;
+        return Reply{204, std::string()};
+    }
+    if (method == "PUT") {
+        found->second = attributes;
+    } else if (method == "PATCH") {
+        for (auto& [name, value] : attributes) {
+            found->second[name] = value;
+        }
+    } else {
+        return error(400, "Unsupported method " + method);
+    }
+    return Reply{200, "{\"data\":" + resource(type, id, found->second) + "}"};
+}
+
+bool MockMiddleware::matches(const Wt::Json::Object& attributes, const std::string& filter,
+                             const std::string& value) {
+    // filter is "attr]" or "attr][op]"
+    const std::size_t close = filter.find(']');
+    const std::string name = filter.substr(0, close);
+    std::string op;
+    if (close != std::string::npos && filter.compare(close, 2, "][") == 0) {
+        op = filter.substr(close + 2, filter.find(']', close + 2) - close - 2);
+    }
+
+    if (!attributes.contains(name)) {
+        return false;
+    }
+    const Wt::Json::Value& attribute = attributes.get(name);
+
+    if (attribute.type() == Wt::Json::Type::Number) {
+        const double actual = static_cast<double>(attribute);
+        if (op == "gte") return actual >= std::atof(value.c_str());
+        if (op == "lte") return actual <= std::atof(value.c_str());
+        std::istringstream options(value);
+        std::string option;
+        while (std::getline(options, option, ',')) {
+            if (!option.empty() && actual == std::atof(option.c_str())) {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (attribute.type() == Wt::Json::Type::Bool) {
+        return static_cast<bool>(attribute) == (value == "true" || value == "1");
+    }
+    if (attribute.type() != Wt::Json::Type::String) {
+        return false;
+    }
+
+    const std::string actual = attribute;
+    if (op == "gte") return actual >= value;
+    if (op == "lte") return actual <= value;
+    if (op == "like") return lower(actual).find(lower(value)) != std::string::npos;
+    std::istringstream options(value);
+    std::string option;
+    while (std::getline(options, option, ',')) {
+        if (actual == option) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string MockMiddleware::resource(const std::string& type, const std::string& id,
+                                     const Wt::Json::Object& attributes) {
+    return "{\"type\":\"" + type + "\",\"id\":\"" + id + "\",\"attributes\":" +
+           Wt::Json::serialize(attributes, 0) + "}";
+}
+
+Wt::Json::Object MockMiddleware::sparseAttributes(const Wt::Json::Object& attributes,
+                                                  const std::vector<std::string>& fields) {
+    Wt::Json::Object sparse;
+    for (const std::string& name : fields) {
+        auto found = attributes.find(name);
+        if (found != attributes.end()) {
+            sparse[name] = found->second;
+        } else if (name == "item_count") {
+            // Derived, like a server would: orders store their items
+            auto items = attributes.find("items");
+            if (items != attributes.end() && items->second.type() == Wt::Json::Type::Array) {
+                const Wt::Json::Array& lines = items->second;
+                sparse[name] = Wt::Json::Value(static_cast<int>(lines.size()));
+            }
+        }
+    }
+    return sparse;
+}
+
+MockMiddleware::Reply MockMiddleware::error(int status, const std::string& detail, const std::string& pointer) {
+    Wt::Json::Object problem;
+    problem["status"] = Wt::Json::Value(std::to_string(status));
+    problem["detail"] = Wt::Json::Value(detail);
+    if (!pointer.empty()) {
+        Wt::Json::Object source;
+        source["pointer"] = Wt::Json::Value(pointer);
+        problem["source"] = Wt::Json::Value(std::move(source));
+    }
+    Wt::Json::Array errors;
+    errors.push_back(Wt::Json::Value(std::move(problem)));
+    Wt::Json::Object document;
+    document["errors"] = Wt::Json::Value(std::move(errors));
+    return Reply{status, Wt::Json::serialize(document, 0)};
+}
@@ -0,0 +1,189 @@
+/**
+ * @file MockMiddleware.hpp
+ * @brief In-process stand-in for the JSON:API middleware
+ *
+ * Serves /Order, /MenuItem and /Employee on 127.0.0.1 the way the
+ * repositories expect them, so APIClient benchmarks and integration tests
+ * run without outside services:
+ *
+ * - GET <type> with filter[attr]=a,b, filter[attr][gte|lte|like]=v,
+ *   page[limit] and page[offset] (with links.next when more follow); paging
+ *   can be switched off to act like a server that ignores page[...]
+ * - Sparse fieldsets on lists: fields[<type>]=a,b; Order also derives
+ *   item_count from its items
+ * - Replies of 1 KB or more are gzipped for clients that send
+ *   Accept-Encoding: gzip, and gzip request bodies are decoded (both need
+ *   zlib, POS_HAVE_ZLIB)
+ * - Every write stamps updated_at; a query with filter[updated_at][gte]
+ *   also lists the ids deleted since then in meta.deleted
+ * - GET/PUT/PATCH/DELETE <type>/<id> and POST <type>
+ * - POST operations with JSON:API atomic operations (add, update, remove),
+ *   applied all-or-nothing
+ * - Writes with an Idempotency-Key are applied once; repeats get the first
+ *   answer again
+ *
+ * Latency, jitter and an error rate can be injected, and changed while the
+ * server runs. Requests are served by a small Boost.Asio thread pool; the
+ * injected delay does not hold a thread.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#ifndef MOCKMIDDLEWARE_HPP
+#define MOCKMIDDLEWARE_HPP
+
+#include <Wt/Json/Object.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class MockMiddleware
+ * @brief Local JSON:API server seeded with orders, menu items and employees
+ */
+class MockMiddleware {
+public:
+    /**
+     * @struct Options
+     * @brief Server address, seed data and injected faults
+     */
+    struct Options {
+        unsigned short port = 0;                  ///< 0 picks a free port
+        std::size_t threads = 2;                  ///< Threads serving requests
+        std::size_t orders = 500;                 ///< Seeded /Order resources
+        std::size_t menuItems = 60;               ///< Seeded /MenuItem resources
+        std::size_t employees = 25;               ///< Seeded /Employee resources
+        std::chrono::milliseconds latency{0};     ///< Added before every answer
+        std::chrono::milliseconds jitter{0};      ///< Up to this much more, at random
+        double errorRate = 0.0;                   ///< Share of requests failed with errorStatus
+        int errorStatus = 503;
+        unsigned seed = 42;                       ///< Seed data and fault injection
+        bool atomicOperations = true;             ///< Serve POST /operations
+        bool paging = true;                       ///< Honour page[...]; false sends every list whole, without links
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters since start()
+     */
+    struct Stats {
+        std::uint64_t requests = 0;
+        std::uint64_t injectedErrors = 0;
+        std::uint64_t replayedWrites = 0;         ///< Answered from an Idempotency-Key
+        std::uint64_t connections = 0;
+        std::uint64_t compressedReplies = 0;      ///< Sent with Content-Encoding: gzip
+    };
+
+    MockMiddleware();
+    explicit MockMiddleware(const Options& options);
+    ~MockMiddleware();
+
+    // Prevent copying
+    MockMiddleware(const MockMiddleware&) = delete;
+    MockMiddleware& operator=(const MockMiddleware&) = delete;
+
+    /**
+     * @brief Binds the port and starts serving
+     * @throws std::runtime_error if the port cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Stops serving and closes all connections
+     */
+    void stop();
+
+    unsigned short port() const;
+
+    /**
+     * @brief Base URL to give APIClient, e.g. "http://127.0.0.1:40123/api"
+     */
+    std::string baseUrl() const;
+
+    void setLatency(std::chrono::milliseconds latency, std::chrono::milliseconds jitter);
+    void setErrorRate(double errorRate, int errorStatus = 503);
+
+    /**
+     * @brief Number of stored resources of a type ("Order", ...)
+     */
+    std::size_t count(const std::string& type) const;
+
+    /**
+     * @brief Stored attributes of one resource (empty if it does not exist)
+     */
+    Wt::Json::Object attributes(const std::string& type, const std::string& id) const;
+
+    Stats getStats() const;
+
+    /**
+     * @struct Reply
+     * @brief Status and JSON body of an answer
+     */
+    struct Reply {
+        int status = 200;
+        std::string body;
+    };
+
+    /**
+     * @brief Answers one request without going through the network
+     * @param method HTTP method
+     * @param target Path and query, e.g. "/api/Order?page[limit]=10"
+     * @param body Request body
+     * @param idempotencyKey Idempotency-Key header value (may be empty)
+     */
+    Reply handle(const std::string& method, const std::string& target,
+                 const std::string& body, const std::string& idempotencyKey = std::string());
+
+private:
+    struct Server;
+    class Connection;
+
+    using Resources = std::map<std::string, Wt::Json::Object>;  // id -> attributes
+
+    struct Dataset {
+        std::map<std::string, Resources> resources;                         // type -> resources
+        std::map<std::string, int> nextIds;                                 // type -> next free id
+        std::map<std::string, std::map<std::string, std::string>> deletedAt; // type -> id -> updated_at of the delete
+    };
+
+    void seed();
+    Reply list(const std::string& type, const std::map<std::string, std::string>& params) const;
+    Reply read(const std::string& type, const std::string& id) const;
+    Reply write(const std::string& method, const std::string& type, const std::string& id,
+                const std::string& body);
+    Reply operations(const std::string& body);
+    static Reply apply(const std::string& method, const std::string& type, const std::string& id,
+                       const Wt::Json::Object& resourceObject, Dataset& data);
+    std::chrono::milliseconds nextDelay();
+    bool nextFails();
+
+    static bool matches(const Wt::Json::Object& attributes, const std::string& filter,
+                        const std::string& value);
+    static std::string resource(const std::string& type, const std::string& id,
+                                const Wt::Json::Object& attributes);
+    static Wt::Json::Object sparseAttributes(const Wt::Json::Object& attributes,
+                                             const std::vector<std::string>& fields);
+    static Reply error(int status, const std::string& detail, const std::string& pointer = std::string());
+
+    Options options_;
+    mutable std::mutex mutex_;
+    Dataset data_;
+    std::map<std::string, Reply> idempotentReplies_;
+    std::uint64_t random_;
+    Stats stats_;
+
+    std::unique_ptr<Server> server_;
+    std::vector<std::thread> threads_;
+    std::atomic<unsigned short> port_{0};
+};
+
+#endif // MOCKMIDDLEWARE_HPP
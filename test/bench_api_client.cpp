@@ -0,0 +1,228 @@
+/**
+ * @file bench_api_client.cpp
+ * @brief End-to-end benchmark of the repository layer against MockMiddleware
+ *
+ * Starts an in-process MockMiddleware on a free localhost port and measures
+ * full round trips through OrderRepository, MenuItemRepository and
+ * EmployeeRepository: request building, the HTTP transport, JSON:API
+ * decoding and callback delivery. No outside service is used.
+ *
+ * Usage:
+ *   bench_api_client [latency-ms [jitter-ms [error-rate]]]
+ *
+ * Build with -DPOS_BUILD_BENCHMARKS=ON, or:
+ *   g++ -std=c++17 -O2 -Iinclude test/bench_api_client.cpp test/MockMiddleware.cpp \
+ *       src/api/[A-Z]*.cpp src/Order.cpp src/MenuItem.cpp src/Employee.cpp \
+ *       src/utils/Logging.cpp src/utils/AsyncLogSink.cpp src/utils/LogArchiver.cpp \
+ *       src/utils/PropertyTable.cpp src/utils/StartupProfile.cpp src/utils/Compression.cpp \
+ *       -DPOS_HAVE_ZLIB -lwt -lz -lpthread -o bench_api_client
+ *   ./bench_api_client 2 1
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "MockMiddleware.hpp"
+
+#include "../include/api/APIClient.hpp"
+#include "../include/api/CircuitBreaker.hpp"
+#include "../include/api/HttpTransport.hpp"
+#include "../include/api/repositories/EmployeeRepository.hpp"
+#include "../include/api/repositories/MenuItemRepository.hpp"
+#include "../include/api/repositories/OrderRepository.hpp"
+
+#include <Wt/Json/Serializer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int ROUNDS = 40;
+    constexpr int CONCURRENT = 64;
+    constexpr int BATCH = 16;
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Counts callbacks down; callbacks run on the transport thread here
+     */
+    class Latch {
+    public:
+        explicit Latch(int count) : count_(count) {}
+
+        void countDown() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--count_ == 0) {
+                done_.notify_all();
+            }
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this]() { return count_ <= 0; });
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable done_;
+        int count_;
+    };
+
+    double percentile(std::vector<double> samples, double share) {
+        std::sort(samples.begin(), samples.end());
+        return samples[static_cast<std::size_t>(share * static_cast<double>(samples.size() - 1))];
+    }
+
+    /**
+     * Runs body ROUNDS times; body starts `width` requests and calls done()
+     * once per response
+     */
+    void run(const std::string& name, int width,
+             const std::function<void(std::function<void(bool)>)>& body) {
+        std::vector<double> roundMs;
+        std::atomic<int> failures{0};
+        const auto start = Clock::now();
+
+        for (int round = 0; round < ROUNDS; ++round) {
+            Latch latch(width);
+            const auto roundStart = Clock::now();
+            for (int i = 0; i < width; ++i) {
+                body([&latch, &failures](bool success) {
+                    if (!success) {
+                        ++failures;
+                    }
+                    latch.countDown();
+                });
+            }
+            latch.wait();
+            roundMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - roundStart).count());
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "  " << std::left << std::setw(26) << name << std::right << std::fixed
+                  << std::setprecision(2)
+                  << std::setw(9) << percentile(roundMs, 0.5) << " ms p50"
+                  << std::setw(9) << percentile(roundMs, 0.99) << " ms p99"
+                  << std::setw(10) << std::setprecision(0) << (ROUNDS * width) / seconds << " req/s"
+                  << "  failures " << failures.load() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Logger::getInstance().setLogLevel(LogLevel::WARN);
+
+    MockMiddleware::Options options;
+    options.latency = std::chrono::milliseconds(argc > 1 ? std::atoi(argv[1]) : 0);
+    options.jitter = std::chrono::milliseconds(argc > 2 ? std::atoi(argv[2]) : 0);
+    options.errorRate = argc > 3 ? std::atof(argv[3]) : 0.0;
+    MockMiddleware middleware(options);
+    middleware.start();
+
+    // Injected errors must not open circuits and stop the run
+    CircuitBreaker::Settings breaker;
+    breaker.failureThreshold = 1 << 30;
+    CircuitBreaker::getInstance().setSettings(breaker);
+
+    auto client = std::make_shared<APIClient>(middleware.baseUrl());
+    client->setRetryPolicy(0, 0);
+    auto pipelinedClient = std::make_shared<APIClient>(middleware.baseUrl());
+    pipelinedClient->setRetryPolicy(0, 0);
+    pipelinedClient->setAtomicOperations(false);
+    OrderRepository orders(client);
+    MenuItemRepository menuItems(client);
+    EmployeeRepository employees(client);
+    OrderRepository mappedOrders(client);
+    mappedOrders.setIdentityMap(true);
+
+    std::cout << "\nRepository round trips against " << middleware.baseUrl() << " (latency "
+              << options.latency.count() << " ms + up to " << options.jitter.count() << " ms, error rate "
+              << options.errorRate << ", " << ROUNDS << " rounds)" << std::endl;
+
+    run("findAll /Order (500)", 1, [&](std::function<void(bool)> done) {
+        orders.findAll({}, [done](std::vector<Order> result, bool success) { done(success && result.size() == 500); });
+    });
+
+    run("findAllPaged /Order (5x100)", 1, [&](std::function<void(bool)> done) {
+        orders.findAllPaged({}, [](std::vector<Order>) {}, done, 100);
+    });
+
+    run("findAll /MenuItem", 1, [&](std::function<void(bool)> done) {
+        menuItems.findAll({}, [done](std::vector<MenuItem>, bool success) { done(success); });
+    });
+
+    run("findByRole /Employee", 1, [&](std::function<void(bool)> done) {
+        employees.findByRole("server", [done](std::vector<Employee>, bool success) { done(success); });
+    });
+
+    // Full load once, then only changes; nothing changes between rounds here
+    run("syncActive /Order delta", 1, [&](std::function<void(bool)> done) {
+        orders.syncActive([done](std::vector<std::shared_ptr<Order>> result, bool success) {
+            done(success && !result.empty());
+        });
+    });
+
+    // Whole orders against the attributes a list shows
+    run("activeSummaries whole", 1, [&](std::function<void(bool)> done) {
+        orders.findActiveSummaries([done](std::vector<OrderSummary> result, bool success) {
+            done(success && !result.empty());
+        }, APIView());
+    });
+
+    run("activeSummaries sparse", 1, [&](std::function<void(bool)> done) {
+        orders.findActiveSummaries([done](std::vector<OrderSummary> result, bool success) {
+            done(success && !result.empty());
+        });
+    });
+
+    std::atomic<int> nextId{1};
+    run("findById /Order x64", CONCURRENT, [&](std::function<void(bool)> done) {
+        const int id = 1 + nextId++ % 500;
+        orders.findById(id, [done](std::unique_ptr<Order> order, bool success) { done(success && order); });
+    });
+
+    // The first round fetches, later rounds are answered from memory
+    run("findShared /Order x64", CONCURRENT, [&](std::function<void(bool)> done) {
+        const int id = 1 + nextId++ % 500;
+        mappedOrders.findShared(id, [done](std::shared_ptr<Order> order, bool success) { done(success && order); });
+    });
+
+    run("update /Order x64", CONCURRENT, [&](std::function<void(bool)> done) {
+        Order order(1 + nextId++ % 500, "table 7");
+        order.setStatus(Order::PREPARING);
+        orders.update(order.getOrderId(), order, [done](std::unique_ptr<Order>, bool success) { done(success); });
+    });
+
+    // BATCH order writes per round: one atomic request, then one request each
+    auto writeBatch = [&](APIClient& target, std::function<void(bool)> done) {
+        std::vector<APIClient::Operation> operations;
+        for (int i = 0; i < BATCH; ++i) {
+            Order order(1 + nextId++ % 500, "table 3");
+            order.setStatus(Order::SENT_TO_KITCHEN);
+            operations.push_back(APIClient::Operation{"PUT", "/Order/" + std::to_string(order.getOrderId()),
+                                                      Wt::Json::serialize(orders.toResource(order), 0), ""});
+        }
+        target.batch(std::move(operations),
+                     [done](const APIClient::BatchResponse& response) { done(response.success()); });
+    };
+    run("batch /Order x16 atomic", 1, [&](std::function<void(bool)> done) { writeBatch(*client, done); });
+    run("batch /Order x16 single", 1, [&](std::function<void(bool)> done) { writeBatch(*pipelinedClient, done); });
+
+    const MockMiddleware::Stats stats = middleware.getStats();
+    std::cout << "  " << stats.requests << " requests on " << stats.connections << " connections, "
+              << stats.injectedErrors << " injected errors, " << stats.compressedReplies << " gzipped replies"
+              << std::endl;
+    const HttpTransport::Stats transport = HttpTransport::getInstance().getStats();
+    std::cout << "  " << transport.bodyBytesReceived << " body bytes received, " << transport.bodyBytesDecoded
+              << " after decoding" << std::endl;
+    return 0;
+}
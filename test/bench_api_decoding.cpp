@@ -0,0 +1,170 @@
+/**
+ * @file bench_api_decoding.cpp
+ * @brief Micro-benchmark for decoding a JSON:API order list
+ *
+ * Decodes a 500-order /Order response the way OrderRepository::findAll does
+ * (APIClient::parseResponse, then fromJson per entity, moved into the
+ * result) and reports time and heap allocations per response. For
+ * comparison, the "legacy" run repeats what the client did before: parse
+ * once to validate, parse again, copy the data array, copy every entity
+ * into the result and copy the result for the callback.
+ *
+ * Build with -DPOS_BUILD_BENCHMARKS=ON, or:
+ *   g++ -std=c++17 -O2 -Iinclude test/bench_api_decoding.cpp src/api/[A-Z]*.cpp \
+ *       src/Order.cpp src/MenuItem.cpp src/utils/Logging.cpp src/utils/AsyncLogSink.cpp \
+ *       src/utils/LogArchiver.cpp src/utils/PropertyTable.cpp src/utils/StartupProfile.cpp \
+ *       -lwt -lpthread -o bench_api_decoding
+ *   ./bench_api_decoding
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "../include/api/APIClient.hpp"
+#include "../include/api/repositories/OrderRepository.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Allocation counting
+// ----------------------------------------------------------------------------
+
+namespace {
+    std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+// Out of line, so the compiler does not pair the free() with a
+// new-expression it inlined the delete into (-Wmismatched-new-delete)
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    constexpr int ORDERS = 500;
+    constexpr int ITEMS_PER_ORDER = 3;
+    constexpr int ITERATIONS = 50;
+
+    // Exposes the protected decoding steps to the benchmark
+    class ResponseParser : public APIClient {
+    public:
+        using APIClient::parseResponse;
+    };
+
+    class OrderDecoder : public OrderRepository {
+    public:
+        OrderDecoder() : OrderRepository(nullptr) {}
+        using OrderRepository::fromJson;
+    };
+
+    std::string buildOrderList() {
+        std::ostringstream json;
+        json << "{\"data\":[";
+        for (int i = 0; i < ORDERS; ++i) {
+            json << (i ? "," : "") << "{\"type\":\"Order\",\"id\":" << (1000 + i)
+                 << ",\"attributes\":{\"table_identifier\":\"table " << (i % 40 + 1)
+                 << "\",\"status\":" << (i % 4) << ",\"total\":" << (12.5 * ITEMS_PER_ORDER)
+                 << ",\"items\":[";
+            for (int j = 0; j < ITEMS_PER_ORDER; ++j) {
+                json << (j ? "," : "") << "{\"menu_item_id\":" << (j + 1)
+                     << ",\"name\":\"Item " << (j + 1) << "\",\"price\":12.5,\"quantity\":1"
+                     << ",\"special_instructions\":\"no onions\"}";
+            }
+            json << "]}}";
+        }
+        json << "],\"meta\":{\"count\":" << ORDERS << "}}";
+        return json.str();
+    }
+
+    void run(const std::string& name, const std::function<std::size_t()>& body) {
+        body(); // Warm up
+
+        const std::size_t before = allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t decoded = 0;
+        for (int i = 0; i < ITERATIONS; ++i) {
+            decoded += body();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const std::size_t allocated = allocations.load() - before;
+
+        std::cout << "  " << std::left << std::setw(10) << name << std::right << std::fixed
+                  << std::setprecision(1)
+                  << std::setw(10) << std::chrono::duration<double, std::micro>(elapsed).count() / ITERATIONS
+                  << " us/response" << std::setw(10) << allocated / ITERATIONS << " allocations/response"
+                  << "  (" << decoded / ITERATIONS << " orders)" << std::endl;
+    }
+}
+
+int main() {
+    Logger::getInstance().setLogLevel(LogLevel::WARN);
+
+    HttpTransport::Response raw;
+    raw.statusCode = 200;
+    raw.body = buildOrderList();
+    OrderDecoder decoder;
+
+    std::cout << "\nDecoding a " << ORDERS << "-order JSON:API response (" << raw.body.size()
+              << " bytes, " << ITERATIONS << " iterations)" << std::endl;
+
+    run("legacy", [&]() {
+        Wt::Json::Value validated;
+        Wt::Json::parse(raw.body, validated);
+        Wt::Json::Object document;
+        Wt::Json::parse(raw.body, document);
+        Wt::Json::Array data = static_cast<const Wt::Json::Array&>(document.get("data"));
+
+        std::vector<Order> orders;
+        for (const auto& item : data) {
+            auto order = decoder.fromJson(item);
+            if (order) {
+                orders.push_back(*order);
+            }
+        }
+        std::vector<Order> delivered = orders;
+        return delivered.size();
+    });
+
+    run("current", [&]() {
+        APIClient::APIResponse response = ResponseParser::parseResponse(raw);
+
+        std::vector<Order> orders;
+        orders.reserve(response.dataArray.size());
+        for (const auto& item : response.dataArray) {
+            auto order = decoder.fromJson(item);
+            if (order) {
+                orders.push_back(std::move(*order));
+            }
+        }
+        std::vector<Order> delivered = std::move(orders);
+        return delivered.size();
+    });
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file bench_kitchen_tickets.cpp
+ * @brief Micro-benchmark of the kitchen ticket queue
+ *
+ * Fills a KitchenInterface with 150 and 1500 open tickets and measures the
+ * calls kitchen screens make on every refresh: status changes, lookups by
+ * order id, the wait estimate, and reading the queue in place against
+ * copying it with getActiveTickets(). The same orders are then routed to
+ * four stations to time sending them and updating one station's part.
+ *
+ * To compile and run:
+ *   g++ -std=c++17 -O2 -Iinclude test/bench_kitchen_tickets.cpp \
+ *       src/KitchenInterface.cpp src/Order.cpp src/MenuItem.cpp -lwt -o bench_kitchen_tickets
+ *   ./bench_kitchen_tickets
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "../include/KitchenInterface.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t ITERATIONS = 200000;
+
+    // Keeps the optimizer from discarding the loop body
+    volatile std::size_t sink = 0;
+
+    double nanosecondsPerCall(std::size_t iterations, const std::function<void(std::size_t)>& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            body(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    }
+
+    void report(const std::string& name, double ns) {
+        std::cout << "  " << std::left << std::setw(32) << name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << ns << " ns/call" << std::endl;
+    }
+
+    std::shared_ptr<Order> makeOrder(int orderId) {
+        static const MenuItem dishes[] = {
+            MenuItem(1, "Burger", 12.5, MenuItem::MAIN_COURSE),
+            MenuItem(2, "Fries", 4.0, MenuItem::APPETIZER),
+            MenuItem(3, "Salad", 8.0, MenuItem::APPETIZER),
+            MenuItem(4, "Lemonade", 3.5, MenuItem::BEVERAGE),
+        };
+        auto order = std::make_shared<Order>(orderId, "table " + std::to_string(1 + orderId % 30));
+        for (int line = 0; line < 1 + orderId % 4; ++line) {
+            order->addItem(OrderItem(dishes[(orderId + line) % 4], 1 + line % 2));
+        }
+        return order;
+    }
+
+    void run(int tickets) {
+        KitchenInterface kitchen;
+        std::vector<std::shared_ptr<Order>> orders;
+        for (int id = 1; id <= tickets; ++id) {
+            orders.push_back(makeOrder(id));
+            kitchen.sendOrderToKitchen(orders.back());
+        }
+
+        std::cout << "\nKitchen queue with " << tickets << " open tickets (" << ITERATIONS << " iterations)"
+                  << std::endl;
+
+        report("updateKitchenStatus", nanosecondsPerCall(ITERATIONS, [&](std::size_t i) {
+            const auto status = static_cast<KitchenInterface::KitchenStatus>(i % 3);
+            sink = kitchen.updateKitchenStatus(1 + static_cast<int>(i % tickets), status);
+        }));
+
+        report("getTicketByOrderId", nanosecondsPerCall(ITERATIONS, [&](std::size_t i) {
+            sink = kitchen.getTicketByOrderId(1 + static_cast<int>(i % tickets)) != nullptr;
+        }));
+
+        report("getEstimatedWaitTime", nanosecondsPerCall(ITERATIONS / 100, [&](std::size_t) {
+            sink = static_cast<std::size_t>(kitchen.getEstimatedWaitTime());
+        }));
+
+        report("getTickets (view)", nanosecondsPerCall(ITERATIONS / 100, [&](std::size_t) {
+            std::size_t items = 0;
+            for (const auto& ticket : kitchen.getTickets()) {
+                items += ticket.items.size();
+            }
+            sink = items;
+        }));
+
+        report("getActiveTickets (copy)", nanosecondsPerCall(ITERATIONS / 100, [&](std::size_t) {
+            std::size_t items = 0;
+            for (const auto& ticket : kitchen.getActiveTickets()) {
+                items += ticket.items.size();
+            }
+            sink = items;
+        }));
+
+        // Serve the oldest ticket and send its order again, keeping the queue full
+        report("removeTicket + send", nanosecondsPerCall(ITERATIONS / 10, [&](std::size_t) {
+            const int oldest = kitchen.getTickets().begin()->orderId;
+            kitchen.removeTicket(oldest);
+            sink = kitchen.sendOrderToKitchen(orders[oldest - 1]);
+        }));
+
+        KitchenInterface stations;
+        stations.setStationRouting(KitchenInterface::StationRouting::parse(
+            {"appetizer=fryer", "main_course=grill", "beverage=bar"}, {"3=cold"}));
+        for (const auto& order : orders) {
+            stations.sendOrderToKitchen(order);
+        }
+
+        report("updateStationStatus", nanosecondsPerCall(ITERATIONS, [&](std::size_t i) {
+            const auto status = static_cast<KitchenInterface::KitchenStatus>(i % 2);
+            sink = stations.updateStationStatus("grill", 1 + static_cast<int>(i % tickets), status);
+        }));
+
+        report("removeTicket + send (stations)", nanosecondsPerCall(ITERATIONS / 10, [&](std::size_t) {
+            const int oldest = stations.getTickets().begin()->orderId;
+            stations.removeTicket(oldest);
+            sink = stations.sendOrderToKitchen(orders[oldest - 1]);
+        }));
+    }
+}
+
+int main() {
+    run(150);
+    run(1500);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file bench_logging.cpp
+ * @brief Micro-benchmark for the cost of suppressed log calls
+ *
+ * Compares a DEBUG call made while the logger runs at INFO in three forms:
+ *   - eager:    logger.debug(LoggingUtils::formatKeyValue(...)) (pre-gating style)
+ *   - gated:    LOG_KEY_VALUE(logger, debug, ...) (runtime level check first)
+ *   - stream:   LOG_STREAM(logger, LogLevel::DEBUG, ...)
+ *
+ * Build with -DPOS_LOG_COMPILED_LEVEL=3 to see DEBUG calls compiled out.
+ *
+ * Build with -DPOS_BUILD_BENCHMARKS=ON, or:
+ *   g++ -std=c++17 -O2 -Iinclude test/bench_logging.cpp \
+ *       src/utils/Logging.cpp src/utils/AsyncLogSink.cpp src/utils/LogArchiver.cpp \
+ *       src/utils/PropertyTable.cpp src/utils/StartupProfile.cpp -lpthread -o bench_logging
+ *   ./bench_logging
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "../include/utils/Logging.hpp"
+#include "../include/utils/LoggingUtils.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+    constexpr std::size_t ITERATIONS = 10000000;
+
+    // Keeps the optimizer from discarding the loop body
+    volatile std::size_t sink = 0;
+
+    double nanosecondsPerCall(const std::function<void(std::size_t)>& body) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < ITERATIONS; ++i) {
+            body(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / ITERATIONS;
+    }
+
+    void report(const std::string& name, double ns) {
+        std::cout << "  " << std::left << std::setw(28) << name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << ns << " ns/call" << std::endl;
+    }
+}
+
+int main() {
+    Logger& logger = Logger::getInstance();
+    logger.setLogLevel(LogLevel::INFO);
+
+    std::cout << "\nSuppressed DEBUG call cost (" << ITERATIONS << " iterations, level INFO, "
+              << "POS_LOG_COMPILED_LEVEL=" << POS_LOG_COMPILED_LEVEL << ")" << std::endl;
+
+    report("baseline (empty loop)", nanosecondsPerCall([](std::size_t i) {
+        sink = i;
+    }));
+
+    report("eager formatKeyValue", nanosecondsPerCall([&logger](std::size_t i) {
+        logger.debug(LoggingUtils::formatKeyValue("Total subscriptions", i));
+        sink = i;
+    }));
+
+    report("LOG_KEY_VALUE", nanosecondsPerCall([&logger](std::size_t i) {
+        LOG_KEY_VALUE(logger, debug, "Total subscriptions", i);
+        sink = i;
+    }));
+
+    report("LOG_STREAM", nanosecondsPerCall([&logger](std::size_t i) {
+        LOG_STREAM(logger, LogLevel::DEBUG, "[PUBLISH] bench -> ORDER_CREATED (" << i << " subscribers)");
+        sink = i;
+    }));
+
+    return 0;
+}
@@ -0,0 +1,394 @@
+/**
+ * @file test_api_repositories.cpp
+ * @brief Integration tests of the repository layer against MockMiddleware
+ *
+ * Starts an in-process MockMiddleware on a free localhost port and checks
+ * what OrderRepository, MenuItemRepository and EmployeeRepository do over
+ * real HTTP: create/read/update/delete, filters, paging (also against a
+ * server that ignores page[...]), resources with string ids, and failures
+ * injected by the middleware. No outside service is used.
+ *
+ * Build with -DPOS_BUILD_TESTS=ON and run through ctest, or:
+ *   g++ -std=c++17 -Iinclude test/test_api_repositories.cpp test/MockMiddleware.cpp \
+ *       src/api/[A-Z]*.cpp src/Order.cpp src/MenuItem.cpp src/Employee.cpp \
+ *       src/utils/Logging.cpp src/utils/AsyncLogSink.cpp src/utils/LogArchiver.cpp \
+ *       src/utils/PropertyTable.cpp src/utils/StartupProfile.cpp src/utils/Compression.cpp \
+ *       -DPOS_HAVE_ZLIB -lwt -lz -lpthread -o test_api_repositories
+ *   ./test_api_repositories
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "MockMiddleware.hpp"
+
+#include "../include/api/APIClient.hpp"
+#include "../include/api/CircuitBreaker.hpp"
+#include "../include/api/repositories/EmployeeRepository.hpp"
+#include "../include/api/repositories/MenuItemRepository.hpp"
+#include "../include/api/repositories/OrderRepository.hpp"
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Simple test framework, as in test_pos.cpp
+ */
+class TestFramework {
+public:
+    static void runTest(const std::string& testName, const std::function<void()>& testFunction) {
+        std::cout << "Running: " << testName << "... ";
+        try {
+            testFunction();
+            std::cout << "PASSED" << std::endl;
+            passedTests_++;
+        } catch (const std::exception& e) {
+            std::cout << "FAILED: " << e.what() << std::endl;
+            failedTests_++;
+        }
+        totalTests_++;
+    }
+
+    static void printSummary() {
+        std::cout << "\n" << std::string(50, '=') << std::endl;
+        std::cout << "Total Tests:  " << totalTests_ << std::endl;
+        std::cout << "Passed:       " << passedTests_ << std::endl;
+        std::cout << "Failed:       " << failedTests_ << std::endl;
+        std::cout << std::string(50, '=') << std::endl;
+    }
+
+    static bool allTestsPassed() {
+        return failedTests_ == 0 && totalTests_ > 0;
+    }
+
+private:
+    static int totalTests_;
+    static int passedTests_;
+    static int failedTests_;
+};
+
+int TestFramework::totalTests_ = 0;
+int TestFramework::passedTests_ = 0;
+int TestFramework::failedTests_ = 0;
+
+#define ASSERT_TRUE(condition, message) \
+    if (!(condition)) { \
+        throw std::runtime_error(message); \
+    }
+
+#define ASSERT_FALSE(condition, message) \
+    if (condition) { \
+        throw std::runtime_error(message); \
+    }
+
+#define ASSERT_EQ(expected, actual, message) \
+    if ((expected) != (actual)) { \
+        throw std::runtime_error(std::string(message) + " (expected: " + std::to_string(expected) + \
+                                 ", actual: " + std::to_string(actual) + ")"); \
+    }
+
+namespace {
+    constexpr std::chrono::seconds CALLBACK_TIMEOUT{10};
+
+    /**
+     * Starts an asynchronous call and waits for its callback, whose
+     * arguments are returned as a tuple
+     */
+    template<typename... Results, typename Start>
+    std::tuple<Results...> await(Start start) {
+        auto promise = std::make_shared<std::promise<std::tuple<Results...>>>();
+        auto future = promise->get_future();
+        start([promise](Results... results) { promise->set_value(std::make_tuple(std::move(results)...)); });
+        if (future.wait_for(CALLBACK_TIMEOUT) != std::future_status::ready) {
+            throw std::runtime_error("no callback within " + std::to_string(CALLBACK_TIMEOUT.count()) + " s");
+        }
+        return future.get();
+    }
+
+    /**
+     * Reads a whole collection a page at a time
+     * @return Rows, pages delivered and the final success flag
+     */
+    template<typename T, typename Repository>
+    std::tuple<std::size_t, int, bool> readPaged(Repository& repository,
+                                                 const std::map<std::string, std::string>& params, int pageSize) {
+        auto rows = std::make_shared<std::size_t>(0);
+        std::shared_ptr<typename Repository::PagedQuery> query;
+        auto [success] = await<bool>([&](auto done) {
+            query = repository.findAllPaged(params, [rows](std::vector<T> page) { *rows += page.size(); },
+                                            done, pageSize);
+        });
+        return std::make_tuple(*rows, query->getPagesDelivered(), success);
+    }
+
+    Employee makeEmployee(const std::string& id, const std::string& role) {
+        return Employee(id, "E9001", "Test", "Person", "test.person@example.com", "555-010-9001",
+                        role, "main", true, 18.5);
+    }
+}
+
+/**
+ * @brief Repository tests against one shared middleware
+ *
+ * The seed data is fixed (see MockMiddleware::seed()): 60 menu items with
+ * category id % 5 and price 4.5 + id % 20, 500 orders, and 25 employees
+ * with role "server", "cook", "cashier", "manager", "host" by id % 5.
+ */
+class RepositoryTests {
+public:
+    explicit RepositoryTests(MockMiddleware& middleware)
+        : middleware_(middleware)
+        , client_(std::make_shared<APIClient>(middleware.baseUrl()))
+        , orders_(client_)
+        , menuItems_(client_)
+        , employees_(client_) {
+        client_->setRetryPolicy(0, 0);
+    }
+
+    void testMenuItemCrud() {
+        const std::size_t seeded = middleware_.count("MenuItem");
+
+        auto [created, createdOk] = await<std::unique_ptr<MenuItem>, bool>([&](auto done) {
+            menuItems_.create(MenuItem(0, "Test Tart", 6.25, MenuItem::DESSERT), done);
+        });
+        ASSERT_TRUE(createdOk && created, "create failed");
+        ASSERT_EQ(seeded + 1, middleware_.count("MenuItem"), "Stored menu items after create");
+        const int id = created->getId();
+        ASSERT_TRUE(id > 0, "Created menu item has no id");
+
+        auto [read, readOk] = await<std::unique_ptr<MenuItem>, bool>([&](auto done) {
+            menuItems_.findById(id, done);
+        });
+        ASSERT_TRUE(readOk && read, "findById failed after create");
+        ASSERT_TRUE(read->getName() == "Test Tart", "Read back a different name");
+
+        MenuItem changed = *read;
+        changed.setPrice(7.75);
+        auto [updated, updatedOk] = await<std::unique_ptr<MenuItem>, bool>([&](auto done) {
+            menuItems_.update(id, changed, done);
+        });
+        ASSERT_TRUE(updatedOk && updated, "update failed");
+        ASSERT_TRUE(static_cast<double>(middleware_.attributes("MenuItem", std::to_string(id)).get("price")) == 7.75,
+                    "Middleware holds the old price");
+
+        auto [deleted] = await<bool>([&](auto done) { menuItems_.delete_(id, done); });
+        ASSERT_TRUE(deleted, "delete failed");
+        ASSERT_EQ(seeded, middleware_.count("MenuItem"), "Stored menu items after delete");
+
+        auto [gone, goneOk] = await<std::unique_ptr<MenuItem>, bool>([&](auto done) {
+            menuItems_.findById(id, done);
+        });
+        ASSERT_FALSE(goneOk || gone, "Deleted menu item still found");
+    }
+
+    void testOrderCreateAndFilter() {
+        auto [created, createdOk] = await<std::unique_ptr<Order>, bool>([&](auto done) {
+            orders_.create(Order(0, "table 42"), done);
+        });
+        ASSERT_TRUE(createdOk && created, "create failed");
+
+        auto [found, foundOk] = await<std::vector<Order>, bool>([&](auto done) {
+            orders_.findByTableIdentifier("table 42", done);
+        });
+        ASSERT_TRUE(foundOk, "findByTableIdentifier failed");
+        ASSERT_EQ(1u, found.size(), "Orders at the new table");
+        ASSERT_EQ(created->getOrderId(), found[0].getOrderId(), "Order found by table");
+
+        auto [deleted] = await<bool>([&](auto done) { orders_.delete_(created->getOrderId(), done); });
+        ASSERT_TRUE(deleted, "delete failed");
+    }
+
+    void testFilters() {
+        auto [desserts, dessertsOk] = await<std::vector<MenuItem>, bool>([&](auto done) {
+            menuItems_.findByCategory(MenuItem::DESSERT, done);
+        });
+        ASSERT_TRUE(dessertsOk, "findByCategory failed");
+        ASSERT_EQ(12u, desserts.size(), "Menu items in one category");
+        for (const auto& item : desserts) {
+            ASSERT_TRUE(item.getCategory() == MenuItem::DESSERT, "findByCategory returned another category");
+        }
+
+        auto [priced, pricedOk] = await<std::vector<MenuItem>, bool>([&](auto done) {
+            menuItems_.findByPriceRange(10.0, 12.0, done);
+        });
+        ASSERT_TRUE(pricedOk, "findByPriceRange failed");
+        ASSERT_EQ(6u, priced.size(), "Menu items priced 10-12");
+
+        auto [named, namedOk] = await<std::vector<MenuItem>, bool>([&](auto done) {
+            menuItems_.searchByName("pAsTa", done);
+        });
+        ASSERT_TRUE(namedOk && !named.empty(), "searchByName found nothing");
+        for (const auto& item : named) {
+            ASSERT_TRUE(item.getName().compare(0, 5, "Pasta") == 0, "searchByName returned " + item.getName());
+        }
+
+        auto [cooks, cooksOk] = await<std::vector<Employee>, bool>([&](auto done) {
+            employees_.findByRole("cook", done);
+        });
+        ASSERT_TRUE(cooksOk, "findByRole failed");
+        ASSERT_EQ(5u, cooks.size(), "Employees with role cook");
+    }
+
+    void testPaging() {
+        auto [orderRows, orderPages, ordersOk] = readPaged<Order>(orders_, {}, 100);
+        ASSERT_TRUE(ordersOk, "Paged order read failed");
+        ASSERT_EQ(middleware_.count("Order"), orderRows, "Orders read page by page");
+        ASSERT_TRUE(orderPages >= 5, "Orders came in fewer than 5 pages");
+
+        auto [itemRows, itemPages, itemsOk] = readPaged<MenuItem>(menuItems_, {{"filter[category]", "3"}}, 5);
+        ASSERT_TRUE(itemsOk, "Paged filtered read failed");
+        ASSERT_EQ(12u, itemRows, "Filtered menu items read page by page");
+        ASSERT_TRUE(itemPages >= 3, "Filtered menu items came in fewer than 3 pages");
+    }
+
+    void testStringIds() {
+        auto [created, createdOk] = await<std::unique_ptr<Employee>, bool>([&](auto done) {
+            employees_.create(makeEmployee("emp-test-7", "host"), done);
+        });
+        ASSERT_TRUE(createdOk && created, "create failed");
+        ASSERT_TRUE(created->getEmployeeId() == "emp-test-7", "Created employee has id " + created->getEmployeeId());
+
+        auto [read, readOk] = await<std::unique_ptr<Employee>, bool>([&](auto done) {
+            employees_.findById("emp-test-7", done);
+        });
+        ASSERT_TRUE(readOk && read, "findById with a string id failed");
+        ASSERT_TRUE(read->getEmployeeNumber() == "E9001", "Read back a different employee");
+
+        auto [updated, updatedOk] = await<std::unique_ptr<Employee>, bool>([&](auto done) {
+            employees_.update("emp-test-7", makeEmployee("emp-test-7", "manager"), done);
+        });
+        ASSERT_TRUE(updatedOk && updated && updated->getRole() == "manager", "update with a string id failed");
+
+        auto [deleted] = await<bool>([&](auto done) { employees_.delete_("emp-test-7", done); });
+        ASSERT_TRUE(deleted, "delete with a string id failed");
+        ASSERT_TRUE(middleware_.attributes("Employee", "emp-test-7").empty(), "Employee still stored");
+    }
+
+    void testIdentityMapVersions() {
+        auto [created, createdOk] = await<std::unique_ptr<Employee>, bool>([&](auto done) {
+            employees_.create(makeEmployee("emp-test-8", "server"), done);
+        });
+        ASSERT_TRUE(createdOk && created, "create failed");
+
+        // Written through another repository, so the identity map only
+        // learns of the change by reading it
+        EmployeeRepository writer(client_);
+        employees_.setIdentityMap(true);
+        auto [first, firstOk] = await<std::shared_ptr<Employee>, bool>([&](auto done) {
+            employees_.findShared("emp-test-8", done);
+        });
+        employees_.invalidate("emp-test-8");
+        auto [unchanged, unchangedOk] = await<std::shared_ptr<Employee>, bool>([&](auto done) {
+            employees_.findShared("emp-test-8", done);
+        });
+        ASSERT_TRUE(firstOk && unchangedOk && first, "findShared failed");
+        ASSERT_TRUE(first == unchanged, "An unchanged employee got a new object");
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));  // A later updated_at
+        auto [updated, updatedOk] = await<std::unique_ptr<Employee>, bool>([&](auto done) {
+            writer.update("emp-test-8", makeEmployee("emp-test-8", "manager"), done);
+        });
+        ASSERT_TRUE(updatedOk && updated, "update failed");
+        employees_.invalidate("emp-test-8");
+        auto [changed, changedOk] = await<std::shared_ptr<Employee>, bool>([&](auto done) {
+            employees_.findShared("emp-test-8", done);
+        });
+        employees_.setIdentityMap(false);
+        ASSERT_TRUE(changedOk && changed, "findShared failed after the update");
+        ASSERT_TRUE(changed != first && changed->getRole() == "manager", "The identity map kept the old employee");
+
+        auto [deleted] = await<bool>([&](auto done) { employees_.delete_("emp-test-8", done); });
+        ASSERT_TRUE(deleted, "delete failed");
+    }
+
+    void testInjectedErrors() {
+        const std::size_t seeded = middleware_.count("MenuItem");
+        middleware_.setErrorRate(1.0, 503);
+
+        auto [items, itemsOk] = await<std::vector<MenuItem>, bool>([&](auto done) {
+            menuItems_.findAll({}, done);
+        });
+        auto [created, createdOk] = await<std::unique_ptr<MenuItem>, bool>([&](auto done) {
+            menuItems_.create(MenuItem(0, "Never Stored", 1.0, MenuItem::BEVERAGE), done);
+        });
+        middleware_.setErrorRate(0.0);
+
+        ASSERT_FALSE(itemsOk, "findAll succeeded although the middleware failed it");
+        ASSERT_TRUE(items.empty(), "findAll returned entities from a failed request");
+        ASSERT_FALSE(createdOk || created, "create succeeded although the middleware failed it");
+        ASSERT_EQ(seeded, middleware_.count("MenuItem"), "Stored menu items after a failed create");
+
+        auto [recovered, recoveredOk] = await<std::vector<MenuItem>, bool>([&](auto done) {
+            menuItems_.findAll({}, done);
+        });
+        ASSERT_TRUE(recoveredOk, "findAll failed after the middleware recovered");
+        ASSERT_EQ(seeded, recovered.size(), "Menu items after recovery");
+    }
+
+private:
+    MockMiddleware& middleware_;
+    std::shared_ptr<APIClient> client_;
+    OrderRepository orders_;
+    MenuItemRepository menuItems_;
+    EmployeeRepository employees_;
+};
+
+/**
+ * @brief A middleware that ignores page[...] must not make paging loop
+ */
+void testPagingIgnored() {
+    MockMiddleware::Options options;
+    options.paging = false;
+    MockMiddleware middleware(options);
+    middleware.start();
+    auto client = std::make_shared<APIClient>(middleware.baseUrl());
+    MenuItemRepository menuItems(client);
+
+    // Larger than the page: page[limit] was ignored
+    auto [smallRows, smallPages, smallOk] = readPaged<MenuItem>(menuItems, {}, 10);
+    // Exactly one page: the repeated page shows page[offset] was ignored
+    auto [fullRows, fullPages, fullOk] = readPaged<MenuItem>(menuItems, {}, 60);
+    middleware.stop();
+
+    ASSERT_TRUE(smallOk && fullOk, "Paged read failed");
+    ASSERT_EQ(1, smallPages, "Pages when the collection exceeds the page size");
+    ASSERT_EQ(60u, smallRows, "Rows when the collection exceeds the page size");
+    ASSERT_EQ(1, fullPages, "Pages when the collection fills one page");
+    ASSERT_EQ(60u, fullRows, "Rows when the collection fills one page");
+}
+
+int main() {
+    Logger::getInstance().setLogLevel(LogLevel::WARN);
+
+    // Injected errors must not open circuits for the tests after them
+    CircuitBreaker::Settings breaker;
+    breaker.failureThreshold = 1 << 30;
+    CircuitBreaker::getInstance().setSettings(breaker);
+
+    MockMiddleware middleware;
+    middleware.start();
+    std::cout << "Repository tests against " << middleware.baseUrl() << "\n" << std::endl;
+
+    RepositoryTests tests(middleware);
+    TestFramework::runTest("MenuItem create/read/update/delete", [&]() { tests.testMenuItemCrud(); });
+    TestFramework::runTest("Order create and find by table", [&]() { tests.testOrderCreateAndFilter(); });
+    TestFramework::runTest("Filters", [&]() { tests.testFilters(); });
+    TestFramework::runTest("Paging", [&]() { tests.testPaging(); });
+    TestFramework::runTest("String ids", [&]() { tests.testStringIds(); });
+    TestFramework::runTest("Identity map versions", [&]() { tests.testIdentityMapVersions(); });
+    TestFramework::runTest("Injected errors", [&]() { tests.testInjectedErrors(); });
+    TestFramework::runTest("Paging against a server ignoring page[...]", testPagingIgnored);
+
+    middleware.stop();
+    TestFramework::printSummary();
+    return TestFramework::allTestsPassed() ? 0 : 1;
+}
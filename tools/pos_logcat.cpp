@@ -0,0 +1,284 @@
+/**
+ * @file pos_logcat.cpp
+ * @brief Offline decoder for binary POS log files (logging.binary = true)
+ *
+ * Reads .binlog files written by Logger in binary mode and prints them in the
+ * regular text log format:
+ *   [YYYY-mm-dd HH:MM:SS.mmm] [LEVEL] message
+ *
+ * Usage:
+ *   pos-logcat [--level LEVEL] [file ...]     (reads stdin when no file given)
+ *
+ * To compile:
+ *   g++ -std=c++17 -O2 -Iinclude tools/pos_logcat.cpp -o pos-logcat
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "../include/utils/BinaryLogFormat.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    struct Descriptor {
+        std::uint8_t level;
+        std::string format;
+    };
+
+    /**
+     * @brief Bounds-checked reader over one record payload
+     */
+    class PayloadReader {
+    public:
+        explicit PayloadReader(const std::string& payload) : data_(payload), pos_(0) {}
+
+        template<typename T>
+        bool read(T& value) {
+            if (pos_ + sizeof(T) > data_.size()) return false;
+            std::memcpy(&value, data_.data() + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return true;
+        }
+
+        bool readBytes(std::size_t length, std::string& out) {
+            if (pos_ + length > data_.size()) return false;
+            out.assign(data_.data() + pos_, length);
+            pos_ += length;
+            return true;
+        }
+
+        bool atEnd() const { return pos_ >= data_.size(); }
+
+    private:
+        const std::string& data_;
+        std::size_t pos_;
+    };
+
+    std::string formatTimestamp(std::int64_t nanoseconds) {
+        std::time_t seconds = static_cast<std::time_t>(nanoseconds / 1000000000);
+        long millis = static_cast<long>((nanoseconds / 1000000) % 1000);
+
+        std::ostringstream ss;
+        ss << std::put_time(std::localtime(&seconds), "%Y-%m-%d %H:%M:%S")
+           << '.' << std::setfill('0') << std::setw(3) << millis;
+        return ss.str();
+    }
+
+    bool decodeArgument(PayloadReader& reader, std::ostringstream& oss) {
+        std::uint8_t tag;
+        if (!reader.read(tag)) return false;
+
+        switch (tag) {
+            case BinaryLogFormat::ARG_INT: {
+                std::int64_t value;
+                if (!reader.read(value)) return false;
+                oss << value;
+                return true;
+            }
+            case BinaryLogFormat::ARG_UINT: {
+                std::uint64_t value;
+                if (!reader.read(value)) return false;
+                oss << value;
+                return true;
+            }
+            case BinaryLogFormat::ARG_DOUBLE: {
+                double value;
+                if (!reader.read(value)) return false;
+                oss << value;
+                return true;
+            }
+            case BinaryLogFormat::ARG_BOOL: {
+                std::uint8_t value;
+                if (!reader.read(value)) return false;
+                oss << BinaryLogFormat::boolText(value != 0);
+                return true;
+            }
+            case BinaryLogFormat::ARG_STRING: {
+                std::uint32_t length;
+                std::string value;
+                if (!reader.read(length) || !reader.readBytes(length, value)) return false;
+                oss << value;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Decodes one binary log stream into text on stdout
+     * @return Number of malformed or unknown records skipped
+     */
+    std::size_t decodeStream(std::istream& in, const std::string& name, int maxLevel) {
+        std::unordered_map<std::uint32_t, Descriptor> descriptors;
+        std::size_t skipped = 0;
+        std::string payload;
+
+        for (;;) {
+            int first = in.peek();
+            if (first == std::char_traits<char>::eof()) break;
+
+            // File header (also accepted mid-stream for concatenated files)
+            if (first == BinaryLogFormat::MAGIC[0]) {
+                char header[BinaryLogFormat::HEADER_SIZE];
+                if (!in.read(header, sizeof(header)) ||
+                    std::memcmp(header, BinaryLogFormat::MAGIC, sizeof(BinaryLogFormat::MAGIC)) != 0) {
+                    std::cerr << name << ": bad file header" << std::endl;
+                    return skipped + 1;
+                }
+
+                std::uint32_t version;
+                std::uint32_t endian;
+                std::memcpy(&version, header + sizeof(BinaryLogFormat::MAGIC), sizeof(version));
+                std::memcpy(&endian, header + sizeof(BinaryLogFormat::MAGIC) + sizeof(version), sizeof(endian));
+                if (endian != BinaryLogFormat::ENDIAN_MARKER || version != BinaryLogFormat::VERSION) {
+                    std::cerr << name << ": unsupported version or byte order" << std::endl;
+                    return skipped + 1;
+                }
+                descriptors.clear();
+                continue;
+            }
+
+            char prefix[BinaryLogFormat::RECORD_PREFIX_SIZE];
+            if (!in.read(prefix, sizeof(prefix))) {
+                std::cerr << name << ": truncated record at end of file" << std::endl;
+                return skipped + 1;
+            }
+
+            std::uint8_t type = static_cast<std::uint8_t>(prefix[0]);
+            std::uint32_t length;
+            std::memcpy(&length, prefix + 1, sizeof(length));
+
+            payload.resize(length);
+            if (!in.read(&payload[0], length)) {
+                std::cerr << name << ": truncated record at end of file" << std::endl;
+                return skipped + 1;
+            }
+
+            PayloadReader reader(payload);
+            std::uint32_t id;
+            if (!reader.read(id)) {
+                ++skipped;
+                continue;
+            }
+
+            if (type == BinaryLogFormat::RECORD_DESCRIPTOR) {
+                Descriptor descriptor;
+                std::uint16_t formatLength;
+                if (reader.read(descriptor.level) && reader.read(formatLength) &&
+                    reader.readBytes(formatLength, descriptor.format)) {
+                    descriptors[id] = std::move(descriptor);
+                } else {
+                    ++skipped;
+                }
+                continue;
+            }
+
+            auto it = descriptors.find(id);
+            std::int64_t timestamp;
+            if (type != BinaryLogFormat::RECORD_EVENT || it == descriptors.end() || !reader.read(timestamp)) {
+                ++skipped;
+                continue;
+            }
+
+            if (it->second.level > maxLevel) {
+                continue;
+            }
+
+            // Substitute arguments into the "{}" placeholders
+            const std::string& format = it->second.format;
+            std::ostringstream message;
+            std::size_t pos = 0;
+            bool ok = true;
+            while (!reader.atEnd()) {
+                BinaryLogFormat::appendLiteralUntilPlaceholder(message, format, pos);
+                if (!decodeArgument(reader, message)) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (!ok) {
+                ++skipped;
+                continue;
+            }
+            message << format.substr(pos);
+
+            std::cout << '[' << formatTimestamp(timestamp) << "] "
+                      << '[' << BinaryLogFormat::levelLabel(it->second.level) << "] "
+                      << message.str() << '\n';
+        }
+
+        return skipped;
+    }
+
+    int levelFromString(std::string level) {
+        std::transform(level.begin(), level.end(), level.begin(), ::toupper);
+        if (level == "NONE")  return 0;
+        if (level == "ERROR") return 1;
+        if (level == "WARN")  return 2;
+        if (level == "INFO")  return 3;
+        return 4;
+    }
+
+    void printUsage(const char* programName) {
+        std::cout << "Usage: " << programName << " [--level LEVEL] [file ...]" << std::endl;
+        std::cout << "Decodes binary POS logs (.binlog) to the text log format." << std::endl;
+        std::cout << "  --level LEVEL   Only print records at LEVEL or more severe" << std::endl;
+        std::cout << "                  (ERROR, WARN, INFO, DEBUG; default DEBUG)" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::ios::sync_with_stdio(false);
+
+    int maxLevel = 4;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--level" && i + 1 < argc) {
+            maxLevel = levelFromString(argv[++i]);
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    std::size_t skipped = 0;
+
+    if (files.empty()) {
+        skipped += decodeStream(std::cin, "<stdin>", maxLevel);
+    }
+
+    for (const auto& file : files) {
+        std::ifstream in(file, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Could not open " << file << std::endl;
+            ++skipped;
+            continue;
+        }
+        skipped += decodeStream(in, file, maxLevel);
+    }
+
+    std::cout.flush();
+    if (skipped > 0) {
+        std::cerr << skipped << " record(s) could not be decoded" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file pos_mock_middleware.cpp
+ * @brief Runs MockMiddleware as a standalone local JSON:API server
+ *
+ * Point api.base_url at the printed URL to run the application against
+ * seeded data with controlled latency and failures.
+ *
+ * Usage:
+ *   pos-mock-middleware [--port N] [--threads N] [--orders N]
+ *                       [--latency-ms N] [--jitter-ms N]
+ *                       [--error-rate R] [--error-status N]
+ *
+ * Stops on SIGINT (Ctrl-C) or SIGTERM and prints request counts.
+ *
+ * @author Restaurant POS Team
+ * @version 1.0.0
+ */
+
+#include "../test/MockMiddleware.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <csignal>
+#include <pthread.h>
+
+namespace {
+    void usage() {
+        std::cerr << "usage: pos-mock-middleware [--port N] [--threads N] [--orders N]\n"
+                     "                           [--latency-ms N] [--jitter-ms N]\n"
+                     "                           [--error-rate R] [--error-status N]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    MockMiddleware::Options options;
+    options.port = 5656;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag == "--help" || flag == "-h") {
+            usage();
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (flag == "--port") {
+            options.port = static_cast<unsigned short>(std::atoi(value));
+        } else if (flag == "--threads") {
+            options.threads = static_cast<std::size_t>(std::atoi(value));
+        } else if (flag == "--orders") {
+            options.orders = static_cast<std::size_t>(std::atoi(value));
+        } else if (flag == "--latency-ms") {
+            options.latency = std::chrono::milliseconds(std::atoi(value));
+        } else if (flag == "--jitter-ms") {
+            options.jitter = std::chrono::milliseconds(std::atoi(value));
+        } else if (flag == "--error-rate") {
+            options.errorRate = std::atof(value);
+        } else if (flag == "--error-status") {
+            options.errorStatus = std::atoi(value);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    // Block the stop signals in every thread, so main can wait for them
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    try {
+        MockMiddleware middleware(options);
+        middleware.start();
+        std::cout << "Mock middleware serving " << middleware.baseUrl() << " ("
+                  << middleware.count("Order") << " orders, "
+                  << middleware.count("MenuItem") << " menu items, "
+                  << middleware.count("Employee") << " employees)" << std::endl;
+
+        int signal = 0;
+        sigwait(&stopSignals, &signal);
+        middleware.stop();
+
+        const MockMiddleware::Stats stats = middleware.getStats();
+        std::cout << stats.requests << " requests, " << stats.injectedErrors << " injected errors" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}